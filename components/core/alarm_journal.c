@@ -0,0 +1,584 @@
+/**
+ * @file alarm_journal.c
+ * @brief Persistent Alarm Event Journal Implementation for SNRv9 Irrigation Control System
+ */
+
+#include "alarm_journal.h"
+#include "psram_manager.h"
+#include "storage_manager.h"
+#include "debug_config.h"
+#include "esp_timer.h"
+#include <string.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#ifdef DEBUG_ALARM_SYSTEM
+static const char* TAG = DEBUG_ALARM_SYSTEM_TAG;
+#endif
+
+/**
+ * @brief Longest wait for the file mutex in a query
+ */
+#define ALARM_JOURNAL_QUERY_TIMEOUT_MS 5000
+
+/**
+ * @brief Longest wait for the flush task to exit (it may be mid-flush)
+ */
+#define ALARM_JOURNAL_STOP_TIMEOUT_MS 5000
+
+/**
+ * @brief Query position, kept between batches so the file mutex can be released
+ */
+typedef struct {
+    uint32_t segment_sequence;          ///< Segment being read (0 = none yet)
+    uint32_t record_offset;             ///< Records of that segment already read
+    uint32_t last_sequence;             ///< Highest record sequence read
+} alarm_journal_cursor_t;
+
+// Forward declarations
+static void alarm_journal_flush_task(void* parameters);
+
+/**
+ * @brief LittleFS path of a segment slot
+ */
+static void alarm_journal_segment_path(const alarm_journal_t* journal, int slot, char* path, size_t path_size)
+{
+    snprintf(path, path_size, "%s_%d.bin", journal->base_path, slot);
+}
+
+/**
+ * @brief Extend a segment's time range with a record
+ */
+static void alarm_journal_index_record(alarm_journal_segment_t* segment, const alarm_journal_record_t* record)
+{
+    if (segment->record_count == 0 || record->timestamp_ms < segment->first_ms) {
+        segment->first_ms = record->timestamp_ms;
+    }
+    if (segment->record_count == 0 || record->timestamp_ms > segment->last_ms) {
+        segment->last_ms = record->timestamp_ms;
+    }
+    segment->record_count++;
+}
+
+/**
+ * @brief Rebuild the index entry of a slot from its file
+ *
+ * Reads the file once in batch-sized chunks. A trailing partial record
+ * (interrupted write) is ignored, and the segment is marked full so that
+ * later appends start a new, aligned segment.
+ */
+static void alarm_journal_index_slot(alarm_journal_t* journal, int slot)
+{
+    alarm_journal_segment_t* segment = &journal->segments[slot];
+    memset(segment, 0, sizeof(alarm_journal_segment_t));
+
+    char path[40];
+    alarm_journal_segment_path(journal, slot, path, sizeof(path));
+    FILE* file = storage_manager_open_file(path, "rb");
+    if (!file) {
+        return;
+    }
+
+    alarm_journal_segment_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != ALARM_JOURNAL_MAGIC ||
+        header.record_size != sizeof(alarm_journal_record_t) || header.segment_sequence == 0) {
+        fclose(file);
+        return;
+    }
+
+    size_t count;
+    while ((count = fread(journal->batch, sizeof(alarm_journal_record_t), ALARM_JOURNAL_BATCH_RECORDS, file)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            alarm_journal_index_record(segment, &journal->batch[i]);
+            if (journal->batch[i].sequence >= journal->next_sequence) {
+                journal->next_sequence = journal->batch[i].sequence + 1;
+            }
+        }
+    }
+    bool partial = !feof(file) || (ftell(file) - (long)sizeof(header)) % (long)sizeof(alarm_journal_record_t) != 0;
+    fclose(file);
+
+    segment->segment_sequence = header.segment_sequence;
+    if (partial && segment->record_count < ALARM_JOURNAL_SEGMENT_RECORDS) {
+        // Readers stop at end of file, so only the append position changes
+        segment->record_count = ALARM_JOURNAL_SEGMENT_RECORDS;
+    }
+}
+
+esp_err_t alarm_journal_init(alarm_journal_t* journal, const char* base_path)
+{
+    if (!journal || !base_path || strlen(base_path) >= ALARM_JOURNAL_PATH_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(journal, 0, sizeof(alarm_journal_t));
+    strcpy(journal->base_path, base_path);
+    portMUX_INITIALIZE(&journal->ring_lock);
+    journal->current_slot = -1;
+    journal->next_sequence = 1;
+
+    journal->ring = psram_smart_malloc(ALARM_JOURNAL_RING_RECORDS * sizeof(alarm_journal_record_t), ALLOC_LARGE_BUFFER);
+    journal->batch = psram_smart_malloc(ALARM_JOURNAL_BATCH_RECORDS * sizeof(alarm_journal_record_t), ALLOC_LARGE_BUFFER);
+    journal->file_mutex = xSemaphoreCreateMutex();
+    if (!journal->ring || !journal->batch || !journal->file_mutex) {
+#ifdef DEBUG_ALARM_SYSTEM
+        printf("[%s] No memory for alarm journal\n", TAG);
+#endif
+        psram_smart_free(journal->ring);
+        psram_smart_free(journal->batch);
+        if (journal->file_mutex) {
+            vSemaphoreDelete(journal->file_mutex);
+        }
+        memset(journal, 0, sizeof(alarm_journal_t));
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Resume in the most recent segment
+    uint32_t latest = 0;
+    for (int slot = 0; slot < ALARM_JOURNAL_SEGMENT_COUNT; slot++) {
+        alarm_journal_index_slot(journal, slot);
+        if (journal->segments[slot].segment_sequence > latest) {
+            latest = journal->segments[slot].segment_sequence;
+            journal->current_slot = slot;
+        }
+    }
+
+    journal->initialized = true;
+
+#ifdef DEBUG_ALARM_SYSTEM
+    printf("[%s] Alarm journal initialized (current segment %d, next record %lu)\n",
+           TAG, journal->current_slot, (unsigned long)journal->next_sequence);
+#endif
+
+    return ESP_OK;
+}
+
+esp_err_t alarm_journal_start(alarm_journal_t* journal, UBaseType_t task_priority, uint32_t task_stack_size)
+{
+    if (!journal || !journal->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (journal->flush_task_running) {
+        return ESP_ERR_INVALID_STATE; // Already running
+    }
+
+    if (!journal->flush_task_exited) {
+        journal->flush_task_exited = xSemaphoreCreateBinary();
+        if (!journal->flush_task_exited) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (journal->flush_task_handle) {
+        // A stop timed out; the previous task must be gone before another starts
+        if (xSemaphoreTake(journal->flush_task_exited, 0) != pdTRUE) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        journal->flush_task_handle = NULL;
+    }
+
+    journal->flush_task_running = true;
+
+    BaseType_t result = xTaskCreate(alarm_journal_flush_task, "alarm_journal",
+                                    task_stack_size, journal,
+                                    task_priority, &journal->flush_task_handle);
+    if (result != pdPASS) {
+        journal->flush_task_running = false;
+        journal->flush_task_handle = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+void alarm_journal_append(alarm_journal_t* journal, uint32_t point_key, uint8_t alarm_type,
+                          alarm_journal_event_t event, float value)
+{
+    if (!journal || !journal->initialized) {
+        return;
+    }
+
+    struct timeval now;
+    gettimeofday(&now, NULL);
+
+    bool batch_ready = false;
+    portENTER_CRITICAL(&journal->ring_lock);
+    if (journal->ring_count < ALARM_JOURNAL_RING_RECORDS) {
+        alarm_journal_record_t* record =
+            &journal->ring[(journal->ring_head + journal->ring_count) % ALARM_JOURNAL_RING_RECORDS];
+        record->timestamp_ms = (int64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+        record->sequence = journal->next_sequence++;
+        record->point_key = point_key;
+        record->value = value;
+        record->alarm_type = alarm_type;
+        record->event = (uint8_t)event;
+        record->reserved = 0;
+        journal->ring_count++;
+        journal->stats.appended++;
+        batch_ready = (journal->ring_count % ALARM_JOURNAL_BATCH_RECORDS) == 0;
+    } else {
+        journal->stats.dropped++;
+    }
+    portEXIT_CRITICAL(&journal->ring_lock);
+
+    if (batch_ready && journal->flush_task_handle) {
+        xTaskNotifyGive(journal->flush_task_handle);
+    }
+}
+
+/**
+ * @brief Append records to the current segment, starting new segments as they fill
+ *
+ * Caller must hold file_mutex.
+ */
+static esp_err_t alarm_journal_write_records(alarm_journal_t* journal, const alarm_journal_record_t* records,
+                                             uint32_t count)
+{
+    char path[40];
+
+    while (count > 0) {
+        FILE* file = NULL;
+        int slot = journal->current_slot;
+
+        if (slot < 0 || journal->segments[slot].record_count >= ALARM_JOURNAL_SEGMENT_RECORDS) {
+            // Reuse the next slot (the oldest segment once every slot is used)
+            uint32_t sequence = (slot < 0) ? 1 : journal->segments[slot].segment_sequence + 1;
+            slot = (slot + 1) % ALARM_JOURNAL_SEGMENT_COUNT;
+            alarm_journal_segment_path(journal, slot, path, sizeof(path));
+
+            file = storage_manager_open_file(path, "wb");
+            alarm_journal_segment_header_t header = {
+                .magic = ALARM_JOURNAL_MAGIC,
+                .segment_sequence = sequence,
+                .record_size = sizeof(alarm_journal_record_t),
+                .reserved = 0
+            };
+            if (!file || fwrite(&header, sizeof(header), 1, file) != 1) {
+                if (file) {
+                    fclose(file);
+                }
+                return ESP_FAIL;
+            }
+
+            memset(&journal->segments[slot], 0, sizeof(alarm_journal_segment_t));
+            journal->segments[slot].segment_sequence = sequence;
+            journal->current_slot = slot;
+        } else {
+            alarm_journal_segment_path(journal, slot, path, sizeof(path));
+            file = storage_manager_open_file(path, "ab");
+            if (!file) {
+                return ESP_FAIL;
+            }
+        }
+
+        alarm_journal_segment_t* segment = &journal->segments[slot];
+        uint32_t room = ALARM_JOURNAL_SEGMENT_RECORDS - segment->record_count;
+        uint32_t chunk = count < room ? count : room;
+        size_t written = fwrite(records, sizeof(alarm_journal_record_t), chunk, file);
+        bool closed = fclose(file) == 0;
+        for (size_t i = 0; i < written; i++) {
+            alarm_journal_index_record(segment, &records[i]);
+        }
+        if (written != chunk || !closed) {
+            // Start a fresh segment rather than append after a partial record
+            segment->record_count = ALARM_JOURNAL_SEGMENT_RECORDS;
+            return ESP_FAIL;
+        }
+
+        records += chunk;
+        count -= chunk;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t alarm_journal_flush(alarm_journal_t* journal)
+{
+    if (!journal || !journal->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xSemaphoreTake(journal->file_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t ret = ESP_OK;
+    int64_t start = esp_timer_get_time();
+    for (;;) {
+        // Copy one batch out; records leave the ring only once written
+        uint32_t count = 0;
+        portENTER_CRITICAL(&journal->ring_lock);
+        count = journal->ring_count < ALARM_JOURNAL_BATCH_RECORDS ? journal->ring_count : ALARM_JOURNAL_BATCH_RECORDS;
+        for (uint32_t i = 0; i < count; i++) {
+            journal->batch[i] = journal->ring[(journal->ring_head + i) % ALARM_JOURNAL_RING_RECORDS];
+        }
+        portEXIT_CRITICAL(&journal->ring_lock);
+
+        if (count == 0) {
+            break;
+        }
+
+        ret = alarm_journal_write_records(journal, journal->batch, count);
+        if (ret != ESP_OK) {
+            journal->stats.write_errors++;
+#ifdef DEBUG_ALARM_SYSTEM
+            printf("[%s] Alarm journal write failed (segment %d)\n", TAG, journal->current_slot);
+#endif
+            break;
+        }
+
+        portENTER_CRITICAL(&journal->ring_lock);
+        journal->ring_head = (journal->ring_head + count) % ALARM_JOURNAL_RING_RECORDS;
+        journal->ring_count -= count;
+        portEXIT_CRITICAL(&journal->ring_lock);
+
+        journal->stats.flushed += count;
+        journal->stats.flush_count++;
+    }
+
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+    journal->stats.last_flush_us = elapsed_us;
+    if (elapsed_us > journal->stats.max_flush_us) {
+        journal->stats.max_flush_us = elapsed_us;
+    }
+
+    xSemaphoreGive(journal->file_mutex);
+    return ret;
+}
+
+/**
+ * @brief Keep the records read into records[found..found + count) that match the query
+ *
+ * Records at or before the cursor's last sequence were already read (from
+ * the ring before they were flushed) and are dropped.
+ *
+ * @return uint32_t New number of kept records
+ */
+static uint32_t alarm_journal_keep_matches(alarm_journal_cursor_t* cursor, alarm_journal_record_t* records,
+                                           uint32_t found, uint32_t count, int64_t from_ms, int64_t to_ms,
+                                           uint32_t point_key)
+{
+    uint32_t kept = found;
+    for (uint32_t i = found; i < found + count; i++) {
+        const alarm_journal_record_t* record = &records[i];
+        if (record->sequence <= cursor->last_sequence) {
+            continue;
+        }
+        cursor->last_sequence = record->sequence;
+        if (record->timestamp_ms >= from_ms && record->timestamp_ms <= to_ms &&
+            (point_key == 0 || record->point_key == point_key)) {
+            records[kept++] = *record;
+        }
+    }
+    return kept;
+}
+
+/**
+ * @brief Copy the next matching records after the cursor
+ *
+ * Caller must hold file_mutex. Reads segments oldest first from the cursor,
+ * skipping those whose time range misses the query, then the records still
+ * in the ring, and advances the cursor past every record read. A segment
+ * overwritten since the previous batch is skipped.
+ *
+ * @return uint32_t Records copied; less than max once the journal is exhausted
+ */
+static uint32_t alarm_journal_collect(alarm_journal_t* journal, alarm_journal_cursor_t* cursor, int64_t from_ms,
+                                      int64_t to_ms, uint32_t point_key, alarm_journal_record_t* records,
+                                      uint32_t max)
+{
+    uint32_t found = 0;
+    char path[40];
+
+    while (found < max) {
+        // Oldest segment at or after the cursor with records left to read
+        int slot = -1;
+        for (int n = 0; n < ALARM_JOURNAL_SEGMENT_COUNT; n++) {
+            const alarm_journal_segment_t* segment = &journal->segments[n];
+            if (segment->segment_sequence == 0 || segment->segment_sequence < cursor->segment_sequence ||
+                (segment->segment_sequence == cursor->segment_sequence &&
+                 cursor->record_offset >= segment->record_count)) {
+                continue;
+            }
+            if (slot < 0 || segment->segment_sequence < journal->segments[slot].segment_sequence) {
+                slot = n;
+            }
+        }
+        if (slot < 0) {
+            break;
+        }
+
+        const alarm_journal_segment_t* segment = &journal->segments[slot];
+        if (segment->segment_sequence != cursor->segment_sequence) {
+            cursor->segment_sequence = segment->segment_sequence;
+            cursor->record_offset = 0;
+        }
+        if (segment->last_ms < from_ms || segment->first_ms > to_ms) {
+            cursor->record_offset = segment->record_count;
+            continue;
+        }
+
+        alarm_journal_segment_path(journal, slot, path, sizeof(path));
+        FILE* file = storage_manager_open_file(path, "rb");
+        long position = (long)sizeof(alarm_journal_segment_header_t) +
+                        (long)cursor->record_offset * (long)sizeof(alarm_journal_record_t);
+        if (!file || fseek(file, position, SEEK_SET) != 0) {
+            if (file) {
+                fclose(file);
+            }
+            cursor->record_offset = segment->record_count;
+            continue;
+        }
+
+        while (found < max && cursor->record_offset < segment->record_count) {
+            uint32_t want = max - found;
+            if (want > segment->record_count - cursor->record_offset) {
+                want = segment->record_count - cursor->record_offset;
+            }
+            size_t count = fread(&records[found], sizeof(alarm_journal_record_t), want, file);
+            if (count == 0) {
+                // Segment marked full after an interrupted write ends early
+                cursor->record_offset = segment->record_count;
+                break;
+            }
+            cursor->record_offset += count;
+            found = alarm_journal_keep_matches(cursor, records, found, count, from_ms, to_ms, point_key);
+        }
+        fclose(file);
+    }
+
+    // Then records not yet flushed; their sequences are consecutive from the ring head
+    while (found < max) {
+        uint32_t count = 0;
+        portENTER_CRITICAL(&journal->ring_lock);
+        if (journal->ring_count > 0) {
+            uint32_t first = journal->ring[journal->ring_head].sequence;
+            uint32_t skip = cursor->last_sequence >= first ? cursor->last_sequence - first + 1 : 0;
+            if (skip < journal->ring_count) {
+                count = journal->ring_count - skip;
+                if (count > max - found) {
+                    count = max - found;
+                }
+                for (uint32_t i = 0; i < count; i++) {
+                    records[found + i] = journal->ring[(journal->ring_head + skip + i) % ALARM_JOURNAL_RING_RECORDS];
+                }
+            }
+        }
+        portEXIT_CRITICAL(&journal->ring_lock);
+
+        if (count == 0) {
+            break;
+        }
+        found = alarm_journal_keep_matches(cursor, records, found, count, from_ms, to_ms, point_key);
+    }
+
+    return found;
+}
+
+esp_err_t alarm_journal_query(alarm_journal_t* journal, int64_t from_ms, int64_t to_ms, uint32_t point_key,
+                              alarm_journal_visit_fn_t visit, void* context)
+{
+    if (!journal || !journal->initialized || !visit) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    alarm_journal_record_t* records =
+        psram_smart_malloc(ALARM_JOURNAL_BATCH_RECORDS * sizeof(alarm_journal_record_t), ALLOC_NORMAL);
+    if (!records) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // The file mutex is held only while a batch is copied, never while the visitor runs
+    alarm_journal_cursor_t cursor = {0};
+    esp_err_t ret = ESP_OK;
+    bool keep_going = true;
+    while (keep_going) {
+        if (xSemaphoreTake(journal->file_mutex, pdMS_TO_TICKS(ALARM_JOURNAL_QUERY_TIMEOUT_MS)) != pdTRUE) {
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+        uint32_t count = alarm_journal_collect(journal, &cursor, from_ms, to_ms, point_key, records,
+                                               ALARM_JOURNAL_BATCH_RECORDS);
+        xSemaphoreGive(journal->file_mutex);
+
+        for (uint32_t i = 0; keep_going && i < count; i++) {
+            keep_going = visit(&records[i], context);
+        }
+        if (count < ALARM_JOURNAL_BATCH_RECORDS) {
+            break;
+        }
+    }
+
+    psram_smart_free(records);
+    return ret;
+}
+
+esp_err_t alarm_journal_get_stats(alarm_journal_t* journal, alarm_journal_stats_t* stats)
+{
+    if (!journal || !journal->initialized || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&journal->ring_lock);
+    *stats = journal->stats;
+    stats->pending = journal->ring_count;
+    portEXIT_CRITICAL(&journal->ring_lock);
+
+    return ESP_OK;
+}
+
+void alarm_journal_destroy(alarm_journal_t* journal)
+{
+    if (!journal || !journal->initialized) {
+        return;
+    }
+
+    if (journal->flush_task_running) {
+        journal->flush_task_running = false;
+        if (journal->flush_task_handle) {
+            // Wake the task and wait until it has left its loop; it may be mid-flush
+            xTaskNotifyGive(journal->flush_task_handle);
+            if (xSemaphoreTake(journal->flush_task_exited, pdMS_TO_TICKS(ALARM_JOURNAL_STOP_TIMEOUT_MS)) != pdTRUE) {
+#ifdef DEBUG_ALARM_SYSTEM
+                printf("[%s] Alarm journal flush task did not stop, journal not freed\n", TAG);
+#endif
+                return;
+            }
+            journal->flush_task_handle = NULL;
+        }
+    }
+
+    alarm_journal_flush(journal);
+
+    if (journal->flush_task_exited) {
+        vSemaphoreDelete(journal->flush_task_exited);
+    }
+    vSemaphoreDelete(journal->file_mutex);
+    psram_smart_free(journal->ring);
+    psram_smart_free(journal->batch);
+    memset(journal, 0, sizeof(alarm_journal_t));
+}
+
+// Private functions
+
+/**
+ * @brief Flush task: writes a batch when one is ready, or whatever is pending each interval
+ */
+static void alarm_journal_flush_task(void* parameters)
+{
+    alarm_journal_t* journal = (alarm_journal_t*)parameters;
+
+    while (journal->flush_task_running) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ALARM_JOURNAL_FLUSH_INTERVAL_MS));
+        if (!journal->flush_task_running) {
+            break;
+        }
+
+        if (journal->ring_count > 0) {
+            alarm_journal_flush(journal);
+        }
+    }
+
+    xSemaphoreGive(journal->flush_task_exited);
+    vTaskDelete(NULL);
+}
@@ -4,6 +4,7 @@
  */
 
 #include "alarm_manager.h"
+#include "psram_manager.h"
 #include "debug_config.h"
 #include "esp_timer.h"
 #include "esp_log.h"
@@ -15,14 +16,18 @@ static const char* TAG = DEBUG_ALARM_SYSTEM_TAG;
 #endif
 
 // Forward declarations
-static void alarm_monitoring_task(void* pvParameters);
-static esp_err_t alarm_check_rate_of_change(alarm_manager_t* manager, int point_index, const alarm_config_t* config);
-static esp_err_t alarm_check_disconnected(alarm_manager_t* manager, int point_index, const alarm_config_t* config);
-static esp_err_t alarm_check_max_value(alarm_manager_t* manager, int point_index, const alarm_config_t* config);
-static esp_err_t alarm_check_stuck_signal(alarm_manager_t* manager, int point_index, const alarm_config_t* config);
+static esp_err_t alarm_build_points(alarm_manager_t* manager);
+static void alarm_table_release(alarm_point_table_t* table);
+static void alarm_window_push(alarm_window_t* window, float value);
+static void alarm_evaluate_batch(alarm_manager_t* manager, alarm_sample_t* samples, int count);
 static int alarm_find_point_index(alarm_manager_t* manager, const char* point_id);
+static uint32_t alarm_interlocks_tripped(alarm_manager_t* manager);
 static void alarm_activate(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type);
 static void alarm_clear(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type);
+static void alarm_update_notifications(alarm_manager_t* manager, int point_index, uint64_t now_us);
+static void alarm_unshelve(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type);
+static void alarm_record_event(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type,
+                               alarm_journal_event_t event, float value);
 
 esp_err_t alarm_manager_init(alarm_manager_t* manager, config_manager_t* config_manager)
 {
@@ -49,42 +54,13 @@ esp_err_t alarm_manager_init(alarm_manager_t* manager, config_manager_t* config_
     // Store configuration manager reference
     manager->config_manager = config_manager;
 
-    // Load IO configuration and initialize alarm states
-    io_point_config_t io_points[CONFIG_MAX_IO_POINTS];
-    int actual_count = 0;
-    esp_err_t ret = config_manager_get_all_io_points(config_manager, io_points, CONFIG_MAX_IO_POINTS, &actual_count);
+    esp_err_t ret = alarm_build_points(manager);
     if (ret != ESP_OK) {
-#ifdef DEBUG_ALARM_SYSTEM
-        printf("[%s] Failed to load IO configuration: %s\n", TAG, esp_err_to_name(ret));
-#endif
         vSemaphoreDelete(manager->alarm_mutex);
+        memset(manager, 0, sizeof(alarm_manager_t));
         return ret;
     }
 
-    // Initialize alarm states for points with alarm configuration
-    manager->active_point_count = 0;
-    for (int i = 0; i < actual_count && manager->active_point_count < CONFIG_MAX_IO_POINTS; i++) {
-        const io_point_config_t* point = &io_points[i];
-        
-        // Only monitor analog inputs with alarm configuration enabled
-        if (point->type == IO_POINT_TYPE_GPIO_AI && point->alarm_config.enabled) {
-            // Store point ID
-            strncpy(manager->point_ids[manager->active_point_count], point->id, CONFIG_MAX_ID_LENGTH - 1);
-            manager->point_ids[manager->active_point_count][CONFIG_MAX_ID_LENGTH - 1] = '\0';
-            
-            // Initialize alarm state
-            alarm_state_t* state = &manager->point_alarms[manager->active_point_count];
-            memset(state, 0, sizeof(alarm_state_t));
-            state->trust_restored = true; // Start with trust
-            
-#ifdef DEBUG_ALARM_SYSTEM
-            printf("[%s] Initialized alarm monitoring for point '%s'\n", TAG, point->id);
-#endif
-            
-            manager->active_point_count++;
-        }
-    }
-
     manager->initialized = true;
 
 #ifdef DEBUG_ALARM_SYSTEM
@@ -94,67 +70,54 @@ esp_err_t alarm_manager_init(alarm_manager_t* manager, config_manager_t* config_
     return ESP_OK;
 }
 
-esp_err_t alarm_manager_start_monitoring(alarm_manager_t* manager, uint32_t check_interval_ms,
-                                        UBaseType_t task_priority, uint32_t task_stack_size)
+esp_err_t alarm_manager_attach_journal(alarm_manager_t* manager, alarm_journal_t* journal)
 {
     if (!manager || !manager->initialized) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    if (manager->alarm_task_running) {
-        return ESP_ERR_INVALID_STATE; // Already running
-    }
-
-    // Create alarm monitoring task
-    BaseType_t result = xTaskCreate(
-        alarm_monitoring_task,
-        "alarm_monitor",
-        task_stack_size,
-        manager,
-        task_priority,
-        &manager->alarm_task_handle
-    );
-
-    if (result != pdPASS) {
-#ifdef DEBUG_ALARM_SYSTEM
-        printf("[%s] Failed to create alarm monitoring task\n", TAG);
-#endif
-        return ESP_ERR_NO_MEM;
+    if (xSemaphoreTake(manager->alarm_mutex, portMAX_DELAY) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
-
-    manager->alarm_task_running = true;
-
-#ifdef DEBUG_ALARM_SYSTEM
-    printf("[%s] Alarm monitoring task started (interval: %lu ms, priority: %u, stack: %lu)\n", 
-           TAG, check_interval_ms, (unsigned int)task_priority, task_stack_size);
-#endif
+    manager->journal = journal;
+    xSemaphoreGive(manager->alarm_mutex);
 
     return ESP_OK;
 }
 
-esp_err_t alarm_manager_stop_monitoring(alarm_manager_t* manager)
+esp_err_t alarm_manager_find_point_by_key(alarm_manager_t* manager, uint32_t point_key,
+                                          char* point_id, size_t point_id_size)
 {
-    if (!manager || !manager->initialized) {
-        return ESP_ERR_INVALID_STATE;
+    if (!manager || !manager->initialized || !point_id || point_id_size == 0) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    if (!manager->alarm_task_running) {
-        return ESP_OK; // Already stopped
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
 
-    // Delete task
-    if (manager->alarm_task_handle) {
-        vTaskDelete(manager->alarm_task_handle);
-        manager->alarm_task_handle = NULL;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        if (manager->points.point_keys[i] == point_key) {
+            strncpy(point_id, manager->point_ids[i], point_id_size - 1);
+            point_id[point_id_size - 1] = '\0';
+            ret = ESP_OK;
+            break;
+        }
     }
 
-    manager->alarm_task_running = false;
+    xSemaphoreGive(manager->alarm_mutex);
+    return ret;
+}
 
-#ifdef DEBUG_ALARM_SYSTEM
-    printf("[%s] Alarm monitoring task stopped\n", TAG);
-#endif
+esp_err_t alarm_manager_resolve_point(alarm_manager_t* manager, const char* point_id, alarm_point_handle_t* handle)
+{
+    if (!manager || !manager->initialized || !point_id || !handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
 
-    return ESP_OK;
+    *handle = alarm_find_point_index(manager, point_id);
+    return (*handle < 0) ? ESP_ERR_NOT_FOUND : ESP_OK;
 }
 
 esp_err_t alarm_manager_update_value(alarm_manager_t* manager, const char* point_id, float conditioned_value)
@@ -169,18 +132,25 @@ esp_err_t alarm_manager_update_value(alarm_manager_t* manager, const char* point
         return ESP_ERR_NOT_FOUND; // Point not monitored
     }
 
+    return alarm_manager_update_value_by_handle(manager, point_index, conditioned_value);
+}
+
+esp_err_t alarm_manager_update_value_by_handle(alarm_manager_t* manager, alarm_point_handle_t handle, 
+                                              float conditioned_value)
+{
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int point_index = handle;
+    if (point_index < 0 || point_index >= manager->active_point_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
     // Update history buffer (thread-safe)
     if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        alarm_state_t* state = &manager->point_alarms[point_index];
-        
-        // Add value to history buffer (circular)
-        state->last_values[state->history_index] = conditioned_value;
-        state->history_index = (state->history_index + 1) % 20;
-        
-        if (state->history_count < 20) {
-            state->history_count++;
-        }
-
+        alarm_window_push(&manager->points.windows[point_index], conditioned_value);
+        manager->points.latest_value[point_index] = conditioned_value;
         xSemaphoreGive(manager->alarm_mutex);
     } else {
 #ifdef DEBUG_ALARM_SYSTEM
@@ -192,6 +162,63 @@ esp_err_t alarm_manager_update_value(alarm_manager_t* manager, const char* point
     return ESP_OK;
 }
 
+esp_err_t alarm_manager_process_samples(alarm_manager_t* manager, alarm_sample_t* samples, int count,
+                                        uint64_t timestamp, uint32_t* interlock_tripped)
+{
+    if (!manager || !manager->initialized || (!samples && count > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (count <= 0) {
+        return ESP_OK;
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // Handles are validated under the mutex, a reload may have shrunk the table
+    for (int i = 0; i < count; i++) {
+        if (samples[i].handle < 0 || samples[i].handle >= manager->active_point_count) {
+            xSemaphoreGive(manager->alarm_mutex);
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    alarm_point_table_t* table = &manager->points;
+    for (int i = 0; i < count; i++) {
+        alarm_window_push(&table->windows[samples[i].handle], samples[i].value);
+        table->latest_value[samples[i].handle] = samples[i].value;
+    }
+
+    alarm_evaluate_batch(manager, samples, count);
+    manager->check_cycle_count += (uint32_t)count;
+    manager->last_check_time = timestamp;
+    if (interlock_tripped) {
+        *interlock_tripped = alarm_interlocks_tripped(manager);
+    }
+
+    xSemaphoreGive(manager->alarm_mutex);
+    return ESP_OK;
+}
+
+esp_err_t alarm_manager_process_sample(alarm_manager_t* manager, alarm_point_handle_t handle, 
+                                       float conditioned_value, uint64_t timestamp, bool* any_active)
+{
+    alarm_sample_t sample = {
+        .handle = handle,
+        .value = conditioned_value,
+        .source_index = 0,
+        .active = false
+    };
+
+    esp_err_t ret = alarm_manager_process_samples(manager, &sample, 1, timestamp, NULL);
+    if (ret == ESP_OK && any_active) {
+        *any_active = sample.active;
+    }
+    return ret;
+}
+
 esp_err_t alarm_manager_check_point(alarm_manager_t* manager, const char* point_id)
 {
     if (!manager || !manager->initialized || !point_id) {
@@ -204,36 +231,36 @@ esp_err_t alarm_manager_check_point(alarm_manager_t* manager, const char* point_
         return ESP_ERR_NOT_FOUND;
     }
 
-    // Get alarm configuration
-    io_point_config_t point_config;
-    esp_err_t ret = config_manager_get_io_point_config(manager->config_manager, point_id, &point_config);
-    if (ret != ESP_OK) {
-        return ret;
-    }
-
-    if (!point_config.alarm_config.enabled) {
-        return ESP_OK; // Alarms disabled for this point
-    }
-
-    const alarm_config_t* alarm_config = &point_config.alarm_config;
+    return alarm_manager_check_point_by_handle(manager, point_index);
+}
 
-    // Check each alarm type
-    if (alarm_config->rules.check_rate_of_change) {
-        alarm_check_rate_of_change(manager, point_index, alarm_config);
+esp_err_t alarm_manager_check_point_by_handle(alarm_manager_t* manager, alarm_point_handle_t handle)
+{
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    if (alarm_config->rules.check_disconnected) {
-        alarm_check_disconnected(manager, point_index, alarm_config);
+    int point_index = handle;
+    if (point_index < 0 || point_index >= manager->active_point_count) {
+        return ESP_ERR_NOT_FOUND;
     }
 
-    if (alarm_config->rules.check_max_value) {
-        alarm_check_max_value(manager, point_index, alarm_config);
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
     }
 
-    if (alarm_config->rules.check_stuck_signal) {
-        alarm_check_stuck_signal(manager, point_index, alarm_config);
+    // Re-evaluate the latest sample as a batch of one
+    if (manager->points.windows[point_index].count > 0) {
+        alarm_sample_t sample = {
+            .handle = point_index,
+            .value = manager->points.latest_value[point_index],
+            .source_index = 0,
+            .active = false
+        };
+        alarm_evaluate_batch(manager, &sample, 1);
     }
 
+    xSemaphoreGive(manager->alarm_mutex);
     return ESP_OK;
 }
 
@@ -250,7 +277,34 @@ esp_err_t alarm_manager_get_alarm_status(alarm_manager_t* manager, const char* p
     }
 
     if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        *is_active = manager->point_alarms[point_index].active[alarm_type];
+        *is_active = (manager->points.active_mask[point_index] & ALARM_RULE_BIT(alarm_type)) != 0;
+        xSemaphoreGive(manager->alarm_mutex);
+        return ESP_OK;
+    }
+
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t alarm_manager_get_all_alarms(alarm_manager_t* manager, const char* point_id,
+                                      bool* active_alarms, int alarm_count)
+{
+    if (!manager || !manager->initialized || !point_id || !active_alarms || alarm_count <= 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int point_index = alarm_find_point_index(manager, point_id);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (alarm_count > ALARM_TYPE_COUNT) {
+        alarm_count = ALARM_TYPE_COUNT;
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        for (int type = 0; type < alarm_count; type++) {
+            active_alarms[type] = (manager->points.active_mask[point_index] & ALARM_RULE_BIT(type)) != 0;
+        }
         xSemaphoreGive(manager->alarm_mutex);
         return ESP_OK;
     }
@@ -258,6 +312,160 @@ esp_err_t alarm_manager_get_alarm_status(alarm_manager_t* manager, const char* p
     return ESP_ERR_TIMEOUT;
 }
 
+esp_err_t alarm_manager_reload_config(alarm_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = alarm_build_points(manager);
+
+#ifdef DEBUG_ALARM_SYSTEM
+    printf("[%s] Alarm configuration reloaded: %d monitored points (%s)\n", 
+           TAG, manager->active_point_count, esp_err_to_name(ret));
+#endif
+
+    return ret;
+}
+
+esp_err_t alarm_manager_shelve(alarm_manager_t* manager, const char* point_id, alarm_type_t alarm_type,
+                               uint32_t duration_ms)
+{
+    if (!manager || !manager->initialized || !point_id || alarm_type > ALARM_TYPE_COUNT ||
+        duration_ms > ALARM_SHELVE_MAX_MS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int point_index = alarm_find_point_index(manager, point_id);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    alarm_point_table_t* table = &manager->points;
+    uint64_t now_us = esp_timer_get_time();
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        if (alarm_type != ALARM_TYPE_COUNT && type != (int)alarm_type) {
+            continue;
+        }
+        if (duration_ms > 0) {
+            table->shelved_mask[point_index] |= ALARM_RULE_BIT(type);
+            table->shelve_expiry[type][point_index] = now_us + (uint64_t)duration_ms * 1000;
+            alarm_record_event(manager, point_index, (alarm_type_t)type, ALARM_JOURNAL_SHELVED,
+                               (float)duration_ms / 1000.0f);
+        } else {
+            alarm_unshelve(manager, point_index, (alarm_type_t)type);
+        }
+    }
+
+    // Alarms that were only held back by the shelve are notified now
+    alarm_update_notifications(manager, point_index, now_us);
+
+#ifdef DEBUG_ALARM_SYSTEM
+    printf("[%s] Point '%s' alarm type %d %s for %lu ms\n", TAG, point_id, alarm_type,
+           duration_ms > 0 ? "shelved" : "unshelved", (unsigned long)duration_ms);
+#endif
+
+    xSemaphoreGive(manager->alarm_mutex);
+    return ESP_OK;
+}
+
+esp_err_t alarm_manager_get_summary(alarm_manager_t* manager, alarm_summary_t* summary,
+                                    alarm_point_summary_t* points, int max_points, int* point_count)
+{
+    if (!manager || !manager->initialized || !summary || (points && max_points < 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(summary, 0, sizeof(alarm_summary_t));
+    if (point_count) {
+        *point_count = 0;
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    const alarm_point_table_t* table = &manager->points;
+    int stored = 0;
+    summary->monitored_points = (uint16_t)manager->active_point_count;
+    for (int p = 0; p < manager->active_point_count; p++) {
+        uint32_t active = table->active_mask[p];
+        uint32_t shelved = table->shelved_mask[p];
+        uint32_t visible = table->notified_mask[p] & ~shelved;
+
+        summary->active_alarms += (uint16_t)__builtin_popcount(active);
+        summary->notified_alarms += (uint16_t)__builtin_popcount(visible);
+        summary->shelved_alarms += (uint16_t)__builtin_popcount(shelved);
+        if (visible) {
+            summary->points_in_alarm++;
+        }
+        for (int type = 0; active != 0 && type < ALARM_TYPE_COUNT; type++) {
+            if (active & ALARM_RULE_BIT(type)) {
+                summary->active_by_type[type]++;
+            }
+        }
+
+        if (points && (active | shelved) && stored < max_points) {
+            alarm_point_summary_t* point = &points[stored++];
+            strncpy(point->point_id, manager->point_ids[p], CONFIG_MAX_ID_LENGTH - 1);
+            point->point_id[CONFIG_MAX_ID_LENGTH - 1] = '\0';
+            point->active_mask = active;
+            point->notified_mask = table->notified_mask[p];
+            point->shelved_mask = shelved;
+            point->first_out_type = table->first_out_type[p];
+        }
+    }
+    summary->notified_transitions = manager->notified_count;
+    summary->rate_limited = manager->rate_limited_count;
+    summary->shelved_suppressed = manager->shelved_suppressed_count;
+    summary->grouped = manager->grouped_count;
+
+    xSemaphoreGive(manager->alarm_mutex);
+
+    if (point_count) {
+        *point_count = stored;
+    }
+    return ESP_OK;
+}
+
+int alarm_manager_get_interlock_count(alarm_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        return 0;
+    }
+
+    return manager->interlock_count;
+}
+
+esp_err_t alarm_manager_get_interlock(alarm_manager_t* manager, int index, alarm_interlock_info_t* info)
+{
+    if (!manager || !manager->initialized || !info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    if (index < 0 || index >= manager->interlock_count) {
+        xSemaphoreGive(manager->alarm_mutex);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const alarm_interlock_t* interlock = &manager->interlocks[index];
+    memcpy(info->point_id, manager->point_ids[interlock->point], CONFIG_MAX_ID_LENGTH);
+    memcpy(info->output_point_id, manager->interlock_outputs[index], CONFIG_MAX_ID_LENGTH);
+    info->alarm_mask = interlock->alarm_mask;
+    info->forced_state = interlock->forced_state;
+
+    xSemaphoreGive(manager->alarm_mutex);
+    return ESP_OK;
+}
+
 esp_err_t alarm_manager_get_statistics(alarm_manager_t* manager, uint32_t* total_alarms,
                                       uint32_t* check_cycles, uint64_t* last_check_time)
 {
@@ -283,15 +491,18 @@ void alarm_manager_destroy(alarm_manager_t* manager)
         return;
     }
 
-    // Stop monitoring task
-    alarm_manager_stop_monitoring(manager);
-
     // Delete mutex
     if (manager->alarm_mutex) {
         vSemaphoreDelete(manager->alarm_mutex);
         manager->alarm_mutex = NULL;
     }
 
+    alarm_table_release(&manager->points);
+    psram_smart_free(manager->point_ids);
+    point_id_index_release(&manager->id_index);
+    psram_smart_free(manager->interlocks);
+    psram_smart_free(manager->interlock_outputs);
+
     // Clear structure
     memset(manager, 0, sizeof(alarm_manager_t));
 
@@ -302,267 +513,796 @@ void alarm_manager_destroy(alarm_manager_t* manager)
 
 // Private functions
 
-static void alarm_monitoring_task(void* pvParameters)
+/**
+ * @brief Compile a point's alarm configuration into a rule mask and thresholds
+ */
+static void alarm_compile_rules(const alarm_config_t* config, alarm_point_rules_t* rules)
 {
-    alarm_manager_t* manager = (alarm_manager_t*)pvParameters;
-    
-#ifdef DEBUG_ALARM_SYSTEM
-    printf("[%s] Alarm monitoring task started\n", TAG);
-#endif
+    const alarm_rules_t* source = &config->rules;
 
-    while (manager->alarm_task_running) {
-        // Check all monitored points
-        for (int i = 0; i < manager->active_point_count; i++) {
-            alarm_manager_check_point(manager, manager->point_ids[i]);
-        }
+    memset(rules, 0, sizeof(alarm_point_rules_t));
 
-        // Update statistics
-        if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            manager->check_cycle_count++;
-            manager->last_check_time = esp_timer_get_time();
-            xSemaphoreGive(manager->alarm_mutex);
-        }
+    int history = config->history_samples_for_analysis;
+    if (history < ALARM_MIN_HISTORY_SAMPLES) {
+        history = ALARM_MIN_HISTORY_SAMPLES;
+    } else if (history > ALARM_MAX_HISTORY_SAMPLES) {
+        history = ALARM_MAX_HISTORY_SAMPLES;
+    }
+    rules->history_samples = (uint16_t)history;
 
-        // Wait for next check interval
-        vTaskDelay(pdMS_TO_TICKS(DEBUG_ALARM_CHECK_INTERVAL_MS));
+    if (source->check_rate_of_change) {
+        rules->rule_mask |= ALARM_RULE_BIT(ALARM_TYPE_RATE_OF_CHANGE);
+    }
+    if (source->check_disconnected) {
+        rules->rule_mask |= ALARM_RULE_BIT(ALARM_TYPE_DISCONNECTED);
+    }
+    if (source->check_max_value) {
+        rules->rule_mask |= ALARM_RULE_BIT(ALARM_TYPE_MAX_VALUE);
+    }
+    // A stuck window longer than the analysis window could never fill
+    if (source->check_stuck_signal && source->stuck_signal_window_samples > 0 &&
+        source->stuck_signal_window_samples <= history) {
+        rules->rule_mask |= ALARM_RULE_BIT(ALARM_TYPE_STUCK_SIGNAL);
+        rules->stuck_window = (uint16_t)source->stuck_signal_window_samples;
+    }
+    if (source->check_noise_band) {
+        rules->rule_mask |= ALARM_RULE_BIT(ALARM_TYPE_NOISE_BAND);
     }
 
-#ifdef DEBUG_ALARM_SYSTEM
-    printf("[%s] Alarm monitoring task ended\n", TAG);
-#endif
+    rules->persistence_samples = source->alarm_persistence_samples > 0 ? (uint32_t)source->alarm_persistence_samples : 0;
+    rules->clear_samples = source->samples_to_clear_alarm_condition > 0 ? 
+                           (uint32_t)source->samples_to_clear_alarm_condition : 0;
+    rules->rate_of_change_threshold = source->rate_of_change_threshold;
+    rules->disconnected_threshold = source->disconnected_threshold;
+    rules->max_value_threshold = source->max_value_threshold;
+    rules->stuck_delta_threshold = source->stuck_signal_delta_threshold;
+    rules->noise_band_threshold = source->noise_band_threshold;
+}
 
-    vTaskDelete(NULL);
+/**
+ * @brief Carve an array of n entries out of a block at an 8-byte aligned offset
+ * 
+ * With a NULL base only the offset advances, so the same layout pass both
+ * sizes a block and assigns its array pointers.
+ */
+#define ALARM_CARVE(base, offset, ptr, n) do {                  \
+        (offset) = ((offset) + 7) & ~(size_t)7;                 \
+        if (base) {                                             \
+            (ptr) = (void*)((base) + (offset));                 \
+        }                                                       \
+        (offset) += (size_t)(n) * sizeof(*(ptr));               \
+    } while (0)
+
+/**
+ * @brief Lay out the point table arrays over its hot and cold blocks
+ * 
+ * Sets hot_bytes and cold_bytes; array pointers are assigned only for the
+ * blocks already allocated.
+ */
+static void alarm_table_layout(alarm_point_table_t* table, int count)
+{
+    uint8_t* hot = table->hot_block;
+    uint8_t* cold = table->cold_block;
+    size_t hot_offset = 0;
+    size_t cold_offset = 0;
+
+    ALARM_CARVE(hot, hot_offset, table->rule_mask, count);
+    ALARM_CARVE(hot, hot_offset, table->active_mask, count);
+    ALARM_CARVE(hot, hot_offset, table->notified_mask, count);
+    ALARM_CARVE(hot, hot_offset, table->shelved_mask, count);
+    ALARM_CARVE(hot, hot_offset, table->grouped_mask, count);
+    ALARM_CARVE(hot, hot_offset, table->latest_value, count);
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        ALARM_CARVE(hot, hot_offset, table->thresholds[type], count);
+    }
+    ALARM_CARVE(hot, hot_offset, table->windows, count);
+    ALARM_CARVE(hot, hot_offset, table->persistence_samples, count);
+    ALARM_CARVE(hot, hot_offset, table->clear_samples, count);
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        ALARM_CARVE(hot, hot_offset, table->persistence_count[type], count);
+        ALARM_CARVE(hot, hot_offset, table->clear_count[type], count);
+    }
+
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        ALARM_CARVE(cold, cold_offset, table->activation_time[type], count);
+        ALARM_CARVE(cold, cold_offset, table->shelve_expiry[type], count);
+        ALARM_CARVE(cold, cold_offset, table->activation_count[type], count);
+    }
+    ALARM_CARVE(cold, cold_offset, table->good_samples_count, count);
+    ALARM_CARVE(cold, cold_offset, table->point_keys, count);
+    ALARM_CARVE(cold, cold_offset, table->rate_window_start, count);
+    ALARM_CARVE(cold, cold_offset, table->first_out_time, count);
+    ALARM_CARVE(cold, cold_offset, table->rate_point_count, count);
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        ALARM_CARVE(cold, cold_offset, table->rate_type_count[type], count);
+    }
+    ALARM_CARVE(cold, cold_offset, table->first_out_type, count);
+    ALARM_CARVE(cold, cold_offset, table->trust_restored, count);
+
+    table->hot_bytes = hot_offset;
+    table->cold_bytes = cold_offset;
 }
 
-static esp_err_t alarm_check_rate_of_change(alarm_manager_t* manager, int point_index, const alarm_config_t* config)
+/**
+ * @brief Free a point table's blocks
+ */
+static void alarm_table_release(alarm_point_table_t* table)
 {
-    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+    psram_smart_free(table->hot_block);
+    psram_smart_free(table->cold_block);
+    psram_smart_free(table->window_pool);
+    memset(table, 0, sizeof(alarm_point_table_t));
+}
+
+/**
+ * @brief Clamp a sample count to the 16-bit counters of the point table
+ */
+static uint16_t alarm_clamp_samples(uint32_t samples)
+{
+    return samples > UINT16_MAX ? UINT16_MAX : (uint16_t)samples;
+}
+
+/**
+ * @brief Scatter a point's compiled rules into the point table
+ */
+static void alarm_table_set_rules(alarm_point_table_t* table, int index, const alarm_point_rules_t* rules)
+{
+    table->rule_mask[index] = rules->rule_mask;
+    table->point_keys[index] = rules->point_key;
+    table->persistence_samples[index] = alarm_clamp_samples(rules->persistence_samples);
+    table->clear_samples[index] = alarm_clamp_samples(rules->clear_samples);
+    table->thresholds[ALARM_TYPE_RATE_OF_CHANGE][index] = rules->rate_of_change_threshold;
+    table->thresholds[ALARM_TYPE_DISCONNECTED][index] = rules->disconnected_threshold;
+    table->thresholds[ALARM_TYPE_MAX_VALUE][index] = rules->max_value_threshold;
+    table->thresholds[ALARM_TYPE_STUCK_SIGNAL][index] = rules->stuck_delta_threshold;
+    // Compared against the variance, so squared once here
+    table->thresholds[ALARM_TYPE_NOISE_BAND][index] = rules->noise_band_threshold * rules->noise_band_threshold;
+    table->trust_restored[index] = true; // Start with trust
+    table->first_out_type[index] = ALARM_FIRST_OUT_NONE;
+}
+
+/**
+ * @brief Carry a point's alarm state over from a previous table
+ */
+static void alarm_table_copy_state(alarm_point_table_t* table, int index,
+                                   const alarm_point_table_t* previous, int previous_index)
+{
+    table->active_mask[index] = previous->active_mask[previous_index];
+    table->notified_mask[index] = previous->notified_mask[previous_index];
+    table->shelved_mask[index] = previous->shelved_mask[previous_index];
+    table->grouped_mask[index] = previous->grouped_mask[previous_index];
+    table->latest_value[index] = previous->latest_value[previous_index];
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        table->persistence_count[type][index] = previous->persistence_count[type][previous_index];
+        table->clear_count[type][index] = previous->clear_count[type][previous_index];
+        table->activation_count[type][index] = previous->activation_count[type][previous_index];
+        table->activation_time[type][index] = previous->activation_time[type][previous_index];
+        table->shelve_expiry[type][index] = previous->shelve_expiry[type][previous_index];
+        table->rate_type_count[type][index] = previous->rate_type_count[type][previous_index];
     }
+    table->good_samples_count[index] = previous->good_samples_count[previous_index];
+    table->trust_restored[index] = previous->trust_restored[previous_index];
+    table->rate_window_start[index] = previous->rate_window_start[previous_index];
+    table->rate_point_count[index] = previous->rate_point_count[previous_index];
+    table->first_out_time[index] = previous->first_out_time[previous_index];
+    table->first_out_type[index] = previous->first_out_type[previous_index];
+}
 
-    alarm_state_t* state = &manager->point_alarms[point_index];
-    
-    // Need at least 2 samples for rate of change
-    if (state->history_count < 2) {
-        xSemaphoreGive(manager->alarm_mutex);
-        return ESP_OK;
+/**
+ * @brief Deque storage size, padded to keep the next block aligned
+ */
+static size_t alarm_deque_size(uint16_t stuck_window)
+{
+    return (stuck_window * sizeof(uint16_t) + 3) & ~(size_t)3;
+}
+
+/**
+ * @brief Window pool bytes needed by a point
+ */
+static size_t alarm_window_size(const alarm_point_rules_t* rules)
+{
+    return rules->history_samples * sizeof(float) + 2 * alarm_deque_size(rules->stuck_window);
+}
+
+/**
+ * @brief Lay out an empty window over pool storage
+ */
+static void alarm_window_setup(alarm_window_t* window, const alarm_point_rules_t* rules, uint8_t* storage)
+{
+    memset(window, 0, sizeof(alarm_window_t));
+    window->capacity = rules->history_samples;
+    window->stuck_window = rules->stuck_window;
+    window->samples = (float*)storage;
+    storage += rules->history_samples * sizeof(float);
+    if (rules->stuck_window > 0) {
+        window->min_deque = (uint16_t*)storage;
+        window->max_deque = (uint16_t*)(storage + alarm_deque_size(rules->stuck_window));
     }
+}
 
-    // Get current and previous values
-    int current_idx = (state->history_index - 1 + 20) % 20;
-    int previous_idx = (state->history_index - 2 + 20) % 20;
-    
-    float current_value = state->last_values[current_idx];
-    float previous_value = state->last_values[previous_idx];
-    
-    float rate_of_change = fabsf(current_value - previous_value);
-    
-    if (rate_of_change > config->rules.rate_of_change_threshold) {
-        // Alarm condition detected
-        state->persistence_count[ALARM_TYPE_RATE_OF_CHANGE]++;
-        
-        if (state->persistence_count[ALARM_TYPE_RATE_OF_CHANGE] >= config->rules.alarm_persistence_samples) {
-            if (!state->active[ALARM_TYPE_RATE_OF_CHANGE]) {
-                alarm_activate(manager, point_index, ALARM_TYPE_RATE_OF_CHANGE);
-            }
+/**
+ * @brief Carry a previous window's contents over when its geometry is unchanged
+ */
+static void alarm_window_restore(alarm_window_t* window, const alarm_window_t* previous)
+{
+    if (previous->capacity != window->capacity || previous->stuck_window != window->stuck_window) {
+        return;
+    }
+
+    alarm_window_t layout = *window;
+    *window = *previous;
+    window->samples = layout.samples;
+    window->min_deque = layout.min_deque;
+    window->max_deque = layout.max_deque;
+
+    memcpy(window->samples, previous->samples, window->capacity * sizeof(float));
+    if (window->stuck_window > 0) {
+        memcpy(window->min_deque, previous->min_deque, window->stuck_window * sizeof(uint16_t));
+        memcpy(window->max_deque, previous->max_deque, window->stuck_window * sizeof(uint16_t));
+    }
+}
+
+/**
+ * @brief Append a sample to a monotonic deque, dropping entries it dominates
+ * 
+ * For the max deque, entries not greater than the new sample can never be
+ * the window maximum again; for the min deque, entries not less than it.
+ */
+static void alarm_deque_push(uint16_t* deque, uint16_t* front, uint16_t* count, uint16_t size,
+                             const float* samples, uint16_t position, bool keep_max)
+{
+    float value = samples[position];
+
+    while (*count > 0) {
+        float back = samples[deque[(*front + *count - 1) % size]];
+        if (keep_max ? (back > value) : (back < value)) {
+            break;
         }
+        (*count)--;
+    }
+
+    deque[(*front + *count) % size] = position;
+    (*count)++;
+}
+
+/**
+ * @brief Add a sample to a window in constant time
+ * 
+ * Updates the running mean and variance (sliding Welford: add the new
+ * sample and, once the ring is full, remove the one it overwrites), the
+ * lap statistics that periodically replace them, and the min/max deques of
+ * the stuck window.
+ */
+static void alarm_window_push(alarm_window_t* window, float value)
+{
+    uint16_t position = window->head;
+
+    if (window->count < window->capacity) {
+        window->count++;
+        float delta = value - window->mean;
+        window->mean += delta / window->count;
+        window->m2 += delta * (value - window->mean);
     } else {
-        // No alarm condition
-        state->clear_count[ALARM_TYPE_RATE_OF_CHANGE]++;
-        
-        if (state->clear_count[ALARM_TYPE_RATE_OF_CHANGE] >= config->rules.samples_to_clear_alarm_condition) {
-            if (state->active[ALARM_TYPE_RATE_OF_CHANGE]) {
-                alarm_clear(manager, point_index, ALARM_TYPE_RATE_OF_CHANGE);
-            }
-            state->persistence_count[ALARM_TYPE_RATE_OF_CHANGE] = 0;
+        float oldest = window->samples[position];
+        float previous_mean = window->mean;
+        window->mean += (value - oldest) / window->count;
+        window->m2 += (value - oldest) * (value - window->mean + oldest - previous_mean);
+        // Rounding can push a near-zero sum slightly negative
+        if (window->m2 < 0.0f) {
+            window->m2 = 0.0f;
         }
     }
 
-    xSemaphoreGive(manager->alarm_mutex);
-    return ESP_OK;
+    if (window->stuck_window > 0) {
+        // Only the sample stuck_window positions back leaves the min/max window,
+        // and if it is still a candidate it is at the front
+        uint16_t leaving = (uint16_t)((position + window->capacity - window->stuck_window) % window->capacity);
+        if (window->min_count > 0 && window->min_deque[window->min_front] == leaving) {
+            window->min_front = (uint16_t)((window->min_front + 1) % window->stuck_window);
+            window->min_count--;
+        }
+        if (window->max_count > 0 && window->max_deque[window->max_front] == leaving) {
+            window->max_front = (uint16_t)((window->max_front + 1) % window->stuck_window);
+            window->max_count--;
+        }
+    }
+
+    window->samples[position] = value;
+
+    // Exact statistics of this lap become the ring's statistics when it wraps
+    float lap_delta = value - window->lap_mean;
+    window->lap_mean += lap_delta / (float)(position + 1);
+    window->lap_m2 += lap_delta * (value - window->lap_mean);
+    if (position + 1 == window->capacity) {
+        window->mean = window->lap_mean;
+        window->m2 = window->lap_m2;
+        window->lap_mean = 0.0f;
+        window->lap_m2 = 0.0f;
+        window->head = 0;
+    } else {
+        window->head = position + 1;
+    }
+
+    if (window->stuck_window > 0) {
+        alarm_deque_push(window->min_deque, &window->min_front, &window->min_count, window->stuck_window,
+                         window->samples, position, false);
+        alarm_deque_push(window->max_deque, &window->max_front, &window->max_count, window->stuck_window,
+                         window->samples, position, true);
+    }
 }
 
-static esp_err_t alarm_check_disconnected(alarm_manager_t* manager, int point_index, const alarm_config_t* config)
+/**
+ * @brief (Re)build the monitored point set from the configuration manager
+ * 
+ * Monitors analog inputs with alarm configuration enabled. Points already
+ * monitored (matched by ID) keep their state, and their window contents
+ * when the window geometry is unchanged.
+ */
+static esp_err_t alarm_build_points(alarm_manager_t* manager)
 {
-    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+    // Configurations are read one at a time into a single scratch copy
+    io_point_config_t* point = psram_smart_malloc(sizeof(io_point_config_t), ALLOC_LARGE_BUFFER);
+    if (!point) {
+        return ESP_ERR_NO_MEM;
     }
 
-    alarm_state_t* state = &manager->point_alarms[point_index];
-    
-    if (state->history_count < 1) {
-        xSemaphoreGive(manager->alarm_mutex);
-        return ESP_OK;
+    int config_count = config_manager_get_io_point_count(manager->config_manager);
+    int monitored_count = 0;
+    int interlock_total = 0;
+    for (int i = 0; i < config_count; i++) {
+        if (config_manager_get_io_point_config_by_index(manager->config_manager, i, point) == ESP_OK &&
+            point->type == IO_POINT_TYPE_GPIO_AI && point->alarm_config.enabled) {
+            monitored_count++;
+            interlock_total += point->alarm_config.interlock_count;
+        }
+    }
+    if (interlock_total > ALARM_MAX_INTERLOCKS) {
+#ifdef DEBUG_ALARM_SYSTEM
+        printf("[%s] %d interlocks configured, only the first %d are kept\n", 
+               TAG, interlock_total, ALARM_MAX_INTERLOCKS);
+#endif
+        interlock_total = ALARM_MAX_INTERLOCKS;
     }
 
-    // Get current value
-    int current_idx = (state->history_index - 1 + 20) % 20;
-    float current_value = state->last_values[current_idx];
-    
-    if (current_value <= config->rules.disconnected_threshold) {
-        // Alarm condition detected
-        state->persistence_count[ALARM_TYPE_DISCONNECTED]++;
-        
-        if (state->persistence_count[ALARM_TYPE_DISCONNECTED] >= config->rules.alarm_persistence_samples) {
-            if (!state->active[ALARM_TYPE_DISCONNECTED]) {
-                alarm_activate(manager, point_index, ALARM_TYPE_DISCONNECTED);
-            }
+    // Rules are compiled into scratch, then scattered into the table; IDs are only used on lookups
+    alarm_point_rules_t* rules = NULL;
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH] = NULL;
+    alarm_point_table_t table = {0};
+    point_id_index_t id_index = {0};
+    alarm_interlock_t* interlocks = NULL;
+    char (*interlock_outputs)[CONFIG_MAX_ID_LENGTH] = NULL;
+    if (monitored_count > 0) {
+        rules = psram_smart_malloc(monitored_count * sizeof(alarm_point_rules_t), ALLOC_NORMAL);
+        point_ids = psram_smart_malloc(monitored_count * CONFIG_MAX_ID_LENGTH, ALLOC_LARGE_BUFFER);
+        if (!rules || !point_ids) {
+            goto no_memory;
         }
-    } else {
-        // No alarm condition
-        state->clear_count[ALARM_TYPE_DISCONNECTED]++;
-        
-        if (state->clear_count[ALARM_TYPE_DISCONNECTED] >= config->rules.samples_to_clear_alarm_condition) {
-            if (state->active[ALARM_TYPE_DISCONNECTED]) {
-                alarm_clear(manager, point_index, ALARM_TYPE_DISCONNECTED);
-            }
-            state->persistence_count[ALARM_TYPE_DISCONNECTED] = 0;
+    }
+    if (interlock_total > 0) {
+        // Checked on every scan pass; output IDs are only read when the IO manager resolves them
+        interlocks = psram_smart_malloc(interlock_total * sizeof(alarm_interlock_t), ALLOC_CRITICAL);
+        interlock_outputs = psram_smart_malloc(interlock_total * CONFIG_MAX_ID_LENGTH, ALLOC_LARGE_BUFFER);
+        if (!interlocks || !interlock_outputs) {
+            goto no_memory;
         }
     }
 
-    xSemaphoreGive(manager->alarm_mutex);
-    return ESP_OK;
-}
+    int count = 0;
+    int interlock_count = 0;
+    size_t pool_size = 0;
+    for (int i = 0; i < config_count && count < monitored_count; i++) {
+        if (config_manager_get_io_point_config_by_index(manager->config_manager, i, point) != ESP_OK ||
+            point->type != IO_POINT_TYPE_GPIO_AI || !point->alarm_config.enabled) {
+            continue;
+        }
 
-static esp_err_t alarm_check_max_value(alarm_manager_t* manager, int point_index, const alarm_config_t* config)
-{
-    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        strncpy(point_ids[count], point->id, CONFIG_MAX_ID_LENGTH - 1);
+        point_ids[count][CONFIG_MAX_ID_LENGTH - 1] = '\0';
+        alarm_compile_rules(&point->alarm_config, &rules[count]);
+        rules[count].point_key = point_id_index_hash(point_ids[count]);
+        pool_size += alarm_window_size(&rules[count]);
+
+        const alarm_config_t* alarm_config = &point->alarm_config;
+        for (int k = 0; k < alarm_config->interlock_count && interlock_count < interlock_total; k++) {
+            // Configuration type bits follow alarm_type_t order
+            interlocks[interlock_count].point = (uint16_t)count;
+            interlocks[interlock_count].alarm_mask = 
+                alarm_config->interlocks[k].alarm_mask & (ALARM_RULE_BIT(ALARM_TYPE_COUNT) - 1);
+            interlocks[interlock_count].forced_state = alarm_config->interlocks[k].forced_state;
+            memcpy(interlock_outputs[interlock_count], alarm_config->interlocks[k].output_point_id, 
+                   CONFIG_MAX_ID_LENGTH);
+            interlock_outputs[interlock_count][CONFIG_MAX_ID_LENGTH - 1] = '\0';
+            interlock_count++;
+        }
+        count++;
+    }
+    psram_smart_free(point);
+    point = NULL;
+
+    if (count > 0) {
+        // Sizing pass, then the same layout over the allocated blocks
+        alarm_table_layout(&table, count);
+        table.hot_block = psram_smart_malloc(table.hot_bytes, ALLOC_CRITICAL);
+        table.cold_block = psram_smart_malloc(table.cold_bytes, ALLOC_LARGE_BUFFER);
+        // Windows can hold hundreds of samples per point; each sample touches O(1) of them
+        table.window_pool = psram_smart_malloc(pool_size, ALLOC_NORMAL);
+        if (!table.hot_block || !table.cold_block || !table.window_pool) {
+            goto no_memory;
+        }
+        memset(table.hot_block, 0, table.hot_bytes);
+        memset(table.cold_block, 0, table.cold_bytes);
+        table.window_bytes = pool_size;
+        alarm_table_layout(&table, count);
+
+        for (int i = 0; i < count; i++) {
+            alarm_table_set_rules(&table, i, &rules[i]);
+        }
+
+        point_id_index_build(&id_index, point_ids[0], CONFIG_MAX_ID_LENGTH, count);
+    }
+
+    if (xSemaphoreTake(manager->alarm_mutex, portMAX_DELAY) != pdTRUE) {
+        psram_smart_free(rules);
+        psram_smart_free(point_ids);
+        alarm_table_release(&table);
+        point_id_index_release(&id_index);
+        psram_smart_free(interlocks);
+        psram_smart_free(interlock_outputs);
         return ESP_ERR_TIMEOUT;
     }
 
-    alarm_state_t* state = &manager->point_alarms[point_index];
-    
-    if (state->history_count < 1) {
-        xSemaphoreGive(manager->alarm_mutex);
-        return ESP_OK;
+    size_t pool_offset = 0;
+    for (int i = 0; i < count; i++) {
+        alarm_window_setup(&table.windows[i], &rules[i], table.window_pool + pool_offset);
+        pool_offset += alarm_window_size(&rules[i]);
+
+        int previous = alarm_find_point_index(manager, point_ids[i]);
+        if (previous >= 0) {
+            alarm_table_copy_state(&table, i, &manager->points, previous);
+            alarm_window_restore(&table.windows[i], &manager->points.windows[previous]);
+        } else {
+#ifdef DEBUG_ALARM_SYSTEM
+            printf("[%s] Initialized alarm monitoring for point '%s'\n", TAG, point_ids[i]);
+#endif
+        }
     }
 
-    // Get current value
-    int current_idx = (state->history_index - 1 + 20) % 20;
-    float current_value = state->last_values[current_idx];
-    
-    if (current_value >= config->rules.max_value_threshold) {
-        // Alarm condition detected
-        state->persistence_count[ALARM_TYPE_MAX_VALUE]++;
-        
-        if (state->persistence_count[ALARM_TYPE_MAX_VALUE] >= config->rules.alarm_persistence_samples) {
-            if (!state->active[ALARM_TYPE_MAX_VALUE]) {
-                alarm_activate(manager, point_index, ALARM_TYPE_MAX_VALUE);
-            }
+    alarm_table_release(&manager->points);
+    psram_smart_free(manager->point_ids);
+    point_id_index_release(&manager->id_index);
+    manager->points = table;
+    manager->point_ids = point_ids;
+    manager->id_index = id_index;
+    manager->active_point_count = count;
+    psram_smart_free(manager->interlocks);
+    psram_smart_free(manager->interlock_outputs);
+    manager->interlocks = interlocks;
+    manager->interlock_outputs = interlock_outputs;
+    manager->interlock_count = interlock_count;
+
+    xSemaphoreGive(manager->alarm_mutex);
+    psram_smart_free(rules);
+    return ESP_OK;
+
+no_memory:
+#ifdef DEBUG_ALARM_SYSTEM
+    printf("[%s] No memory for %d monitored points\n", TAG, monitored_count);
+#endif
+    psram_smart_free(point);
+    psram_smart_free(rules);
+    psram_smart_free(point_ids);
+    alarm_table_release(&table);
+    psram_smart_free(interlocks);
+    psram_smart_free(interlock_outputs);
+    return ESP_ERR_NO_MEM;
+}
+
+/**
+ * @brief Apply one check's outcome to its persistence and clear counters
+ */
+static void alarm_apply_condition(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type, 
+                                  bool condition)
+{
+    alarm_point_table_t* table = &manager->points;
+    uint16_t* persistence_count = &table->persistence_count[alarm_type][point_index];
+    uint16_t* clear_count = &table->clear_count[alarm_type][point_index];
+    bool active = (table->active_mask[point_index] & ALARM_RULE_BIT(alarm_type)) != 0;
+
+    if (condition) {
+        // Alarm condition detected; clearing needs consecutive good samples
+        if (*persistence_count < UINT16_MAX) {
+            (*persistence_count)++;
+        }
+        *clear_count = 0;
+
+        if (*persistence_count >= table->persistence_samples[point_index] && !active) {
+            alarm_activate(manager, point_index, alarm_type);
         }
     } else {
         // No alarm condition
-        state->clear_count[ALARM_TYPE_MAX_VALUE]++;
-        
-        if (state->clear_count[ALARM_TYPE_MAX_VALUE] >= config->rules.samples_to_clear_alarm_condition) {
-            if (state->active[ALARM_TYPE_MAX_VALUE]) {
-                alarm_clear(manager, point_index, ALARM_TYPE_MAX_VALUE);
+        if (*clear_count < UINT16_MAX) {
+            (*clear_count)++;
+        }
+
+        if (*clear_count >= table->clear_samples[point_index]) {
+            if (active) {
+                alarm_clear(manager, point_index, alarm_type);
             }
-            state->persistence_count[ALARM_TYPE_MAX_VALUE] = 0;
+            *persistence_count = 0;
         }
     }
-
-    xSemaphoreGive(manager->alarm_mutex);
-    return ESP_OK;
 }
 
-static esp_err_t alarm_check_stuck_signal(alarm_manager_t* manager, int point_index, const alarm_config_t* config)
+/**
+ * @brief Run every rule over a batch of samples already pushed into their windows
+ * 
+ * Each rule is one loop over the batch reading only that rule's arrays and
+ * the window statistics, so the cost does not depend on the window length.
+ * Rules enabled by no point of the batch are skipped as a whole. Caller
+ * must hold alarm_mutex.
+ */
+static void alarm_evaluate_batch(alarm_manager_t* manager, alarm_sample_t* samples, int count)
 {
-    if (xSemaphoreTake(manager->alarm_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return ESP_ERR_TIMEOUT;
+    alarm_point_table_t* table = &manager->points;
+    const uint32_t* rule_mask = table->rule_mask;
+    const float* latest_value = table->latest_value;
+
+    uint32_t batch_mask = 0;
+    for (int i = 0; i < count; i++) {
+        batch_mask |= rule_mask[samples[i].handle];
     }
 
-    alarm_state_t* state = &manager->point_alarms[point_index];
-    
-    // Need enough samples for stuck signal detection
-    int required_samples = config->rules.stuck_signal_window_samples;
-    if (state->history_count < required_samples) {
-        xSemaphoreGive(manager->alarm_mutex);
-        return ESP_OK;
+    // Rate of change: change from the previous sample (needs at least 2 samples)
+    if (batch_mask & ALARM_RULE_BIT(ALARM_TYPE_RATE_OF_CHANGE)) {
+        const float* threshold = table->thresholds[ALARM_TYPE_RATE_OF_CHANGE];
+        for (int i = 0; i < count; i++) {
+            int p = samples[i].handle;
+            const alarm_window_t* window = &table->windows[p];
+            if (!(rule_mask[p] & ALARM_RULE_BIT(ALARM_TYPE_RATE_OF_CHANGE)) || window->count < 2) {
+                continue;
+            }
+            float previous_value = window->samples[(window->head + window->capacity - 2) % window->capacity];
+            alarm_apply_condition(manager, p, ALARM_TYPE_RATE_OF_CHANGE,
+                                  fabsf(latest_value[p] - previous_value) > threshold[p]);
+        }
     }
 
-    // Check if signal has been stuck within the window
-    bool signal_stuck = true;
-    float reference_value = state->last_values[(state->history_index - 1 + 20) % 20];
-    
-    for (int i = 1; i < required_samples; i++) {
-        int idx = (state->history_index - 1 - i + 20) % 20;
-        float value = state->last_values[idx];
-        
-        if (fabsf(value - reference_value) > config->rules.stuck_signal_delta_threshold) {
-            signal_stuck = false;
-            break;
+    if (batch_mask & ALARM_RULE_BIT(ALARM_TYPE_DISCONNECTED)) {
+        const float* threshold = table->thresholds[ALARM_TYPE_DISCONNECTED];
+        for (int i = 0; i < count; i++) {
+            int p = samples[i].handle;
+            if (rule_mask[p] & ALARM_RULE_BIT(ALARM_TYPE_DISCONNECTED)) {
+                alarm_apply_condition(manager, p, ALARM_TYPE_DISCONNECTED, latest_value[p] <= threshold[p]);
+            }
         }
     }
-    
-    if (signal_stuck) {
-        // Alarm condition detected
-        state->persistence_count[ALARM_TYPE_STUCK_SIGNAL]++;
-        
-        if (state->persistence_count[ALARM_TYPE_STUCK_SIGNAL] >= config->rules.alarm_persistence_samples) {
-            if (!state->active[ALARM_TYPE_STUCK_SIGNAL]) {
-                alarm_activate(manager, point_index, ALARM_TYPE_STUCK_SIGNAL);
+
+    if (batch_mask & ALARM_RULE_BIT(ALARM_TYPE_MAX_VALUE)) {
+        const float* threshold = table->thresholds[ALARM_TYPE_MAX_VALUE];
+        for (int i = 0; i < count; i++) {
+            int p = samples[i].handle;
+            if (rule_mask[p] & ALARM_RULE_BIT(ALARM_TYPE_MAX_VALUE)) {
+                alarm_apply_condition(manager, p, ALARM_TYPE_MAX_VALUE, latest_value[p] >= threshold[p]);
             }
         }
-    } else {
-        // No alarm condition
-        state->clear_count[ALARM_TYPE_STUCK_SIGNAL]++;
-        
-        if (state->clear_count[ALARM_TYPE_STUCK_SIGNAL] >= config->rules.samples_to_clear_alarm_condition) {
-            if (state->active[ALARM_TYPE_STUCK_SIGNAL]) {
-                alarm_clear(manager, point_index, ALARM_TYPE_STUCK_SIGNAL);
+    }
+
+    // Stuck signal: every sample of the stuck window within the delta of the latest
+    if (batch_mask & ALARM_RULE_BIT(ALARM_TYPE_STUCK_SIGNAL)) {
+        const float* threshold = table->thresholds[ALARM_TYPE_STUCK_SIGNAL];
+        for (int i = 0; i < count; i++) {
+            int p = samples[i].handle;
+            const alarm_window_t* window = &table->windows[p];
+            if (!(rule_mask[p] & ALARM_RULE_BIT(ALARM_TYPE_STUCK_SIGNAL)) || window->count < window->stuck_window) {
+                continue;
             }
-            state->persistence_count[ALARM_TYPE_STUCK_SIGNAL] = 0;
+            float window_min = window->samples[window->min_deque[window->min_front]];
+            float window_max = window->samples[window->max_deque[window->max_front]];
+            bool signal_stuck = (window_max - latest_value[p]) <= threshold[p] &&
+                                (latest_value[p] - window_min) <= threshold[p];
+            alarm_apply_condition(manager, p, ALARM_TYPE_STUCK_SIGNAL, signal_stuck);
         }
     }
 
-    xSemaphoreGive(manager->alarm_mutex);
-    return ESP_OK;
+    // Noise band: variance over a full window above the squared threshold
+    if (batch_mask & ALARM_RULE_BIT(ALARM_TYPE_NOISE_BAND)) {
+        const float* threshold = table->thresholds[ALARM_TYPE_NOISE_BAND];
+        for (int i = 0; i < count; i++) {
+            int p = samples[i].handle;
+            const alarm_window_t* window = &table->windows[p];
+            if (!(rule_mask[p] & ALARM_RULE_BIT(ALARM_TYPE_NOISE_BAND)) || window->count != window->capacity) {
+                continue;
+            }
+            float variance = window->m2 / (float)(window->count - 1);
+            alarm_apply_condition(manager, p, ALARM_TYPE_NOISE_BAND, variance > threshold[p]);
+        }
+    }
+
+    // Suppression layer: only points with unnotified or shelved alarms need it
+    uint64_t now_us = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+        int p = samples[i].handle;
+        if ((table->active_mask[p] & ~table->notified_mask[p]) || table->shelved_mask[p]) {
+            alarm_update_notifications(manager, p, now_us);
+        }
+        samples[i].active = (table->notified_mask[p] & ~table->shelved_mask[p]) != 0;
+    }
 }
 
-static int alarm_find_point_index(alarm_manager_t* manager, const char* point_id)
+/**
+ * @brief Interlocks whose point has a tripping alarm active (raw state, before suppression)
+ */
+static uint32_t alarm_interlocks_tripped(alarm_manager_t* manager)
 {
-    for (int i = 0; i < manager->active_point_count; i++) {
-        if (strcmp(manager->point_ids[i], point_id) == 0) {
-            return i;
+    const uint32_t* active_mask = manager->points.active_mask;
+    uint32_t tripped = 0;
+    for (int i = 0; i < manager->interlock_count; i++) {
+        if (active_mask[manager->interlocks[i].point] & manager->interlocks[i].alarm_mask) {
+            tripped |= 1U << i;
         }
     }
-    return -1;
+    return tripped;
+}
+
+static int alarm_find_point_index(alarm_manager_t* manager, const char* point_id)
+{
+    if (manager->active_point_count == 0) {
+        return -1;
+    }
+    return point_id_index_find(&manager->id_index, manager->point_ids[0], CONFIG_MAX_ID_LENGTH, point_id);
+}
+
+/**
+ * @brief Append an event of a point to the attached journal
+ */
+static void alarm_record_event(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type,
+                               alarm_journal_event_t event, float value)
+{
+    if (manager->journal) {
+        alarm_journal_append(manager->journal, manager->points.point_keys[point_index], (uint8_t)alarm_type,
+                             event, value);
+    }
 }
 
+/**
+ * @brief Record an activation; notification is left to alarm_update_notifications
+ * 
+ * The first alarm of a point to activate becomes its first-out; alarms
+ * activating within ALARM_FIRST_OUT_WINDOW_MS of it are grouped under it.
+ */
 static void alarm_activate(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type)
 {
-    alarm_state_t* state = &manager->point_alarms[point_index];
+    alarm_point_table_t* table = &manager->points;
     
-    if (!state->active[alarm_type]) {
-        state->active[alarm_type] = true;
-        state->activation_count[alarm_type]++;
-        state->activation_time[alarm_type] = esp_timer_get_time();
-        state->trust_restored = false;
+    if (!(table->active_mask[point_index] & ALARM_RULE_BIT(alarm_type))) {
+        uint64_t now_us = esp_timer_get_time();
+        uint32_t now_ms = (uint32_t)(now_us / 1000);
+
+        table->active_mask[point_index] |= ALARM_RULE_BIT(alarm_type);
+        table->activation_count[alarm_type][point_index]++;
+        table->activation_time[alarm_type][point_index] = now_us;
+        table->trust_restored[point_index] = false;
         manager->total_alarm_count++;
 
-#ifdef DEBUG_ALARM_SYSTEM
-        printf("[%s] ALARM ACTIVATED: Point '%s', Type %d\n", 
-               TAG, manager->point_ids[point_index], alarm_type);
-#endif
+        uint8_t first_out = table->first_out_type[point_index];
+        if (first_out == ALARM_FIRST_OUT_NONE) {
+            table->first_out_type[point_index] = (uint8_t)alarm_type;
+            table->first_out_time[point_index] = now_ms;
+        } else if (now_ms - table->first_out_time[point_index] <= ALARM_FIRST_OUT_WINDOW_MS) {
+            table->grouped_mask[point_index] |= ALARM_RULE_BIT(alarm_type);
+            manager->grouped_count++;
+        }
     }
 }
 
+/**
+ * @brief Record a clear, notifying it if the activation was notified
+ * 
+ * When the first-out clears, alarms grouped under it that are still
+ * active stand on their own and are notified.
+ */
 static void alarm_clear(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type)
 {
-    alarm_state_t* state = &manager->point_alarms[point_index];
+    alarm_point_table_t* table = &manager->points;
+    uint32_t bit = ALARM_RULE_BIT(alarm_type);
     
-    if (state->active[alarm_type]) {
-        state->active[alarm_type] = false;
-        state->clear_count[alarm_type] = 0;
+    if (table->active_mask[point_index] & bit) {
+        table->active_mask[point_index] &= ~bit;
+        table->clear_count[alarm_type][point_index] = 0;
         
         // Check if trust should be restored
-        state->good_samples_count++;
+        table->good_samples_count[point_index]++;
         // Trust restoration logic would be implemented here based on configuration
 
+        if (table->notified_mask[point_index] & bit) {
+            table->notified_mask[point_index] &= ~bit;
+            manager->notified_count++;
+            alarm_record_event(manager, point_index, alarm_type, ALARM_JOURNAL_CLEARED,
+                               table->latest_value[point_index]);
+#ifdef DEBUG_ALARM_SYSTEM
+            printf("[%s] ALARM CLEARED: Point '%s', Type %d\n", 
+                   TAG, manager->point_ids[point_index], alarm_type);
+#endif
+        } else if (table->shelved_mask[point_index] & bit) {
+            manager->shelved_suppressed_count++;
+        } else if (!(table->grouped_mask[point_index] & bit)) {
+            manager->rate_limited_count++;
+        }
+        table->grouped_mask[point_index] &= ~bit;
+
+        if (table->first_out_type[point_index] == (uint8_t)alarm_type) {
+            table->first_out_type[point_index] = ALARM_FIRST_OUT_NONE;
+            table->grouped_mask[point_index] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Lift a point's shelve of one alarm type
+ */
+static void alarm_unshelve(alarm_manager_t* manager, int point_index, alarm_type_t alarm_type)
+{
+    alarm_point_table_t* table = &manager->points;
+
+    if (table->shelved_mask[point_index] & ALARM_RULE_BIT(alarm_type)) {
+        table->shelved_mask[point_index] &= ~ALARM_RULE_BIT(alarm_type);
+        alarm_record_event(manager, point_index, alarm_type, ALARM_JOURNAL_UNSHELVED,
+                           table->latest_value[point_index]);
+    }
+}
+
+/**
+ * @brief Expire shelves and notify active alarms that are no longer suppressed
+ * 
+ * An active alarm is notified once it is neither shelved nor grouped and
+ * the point's rate limit window has room for it. Caller must hold
+ * alarm_mutex.
+ */
+static void alarm_update_notifications(alarm_manager_t* manager, int point_index, uint64_t now_us)
+{
+    alarm_point_table_t* table = &manager->points;
+
+    uint32_t shelved = table->shelved_mask[point_index];
+    for (int type = 0; shelved != 0 && type < ALARM_TYPE_COUNT; type++) {
+        if ((shelved & ALARM_RULE_BIT(type)) && now_us >= table->shelve_expiry[type][point_index]) {
+            shelved &= ~ALARM_RULE_BIT(type);
+            alarm_unshelve(manager, point_index, (alarm_type_t)type);
+        }
+    }
+
+    uint32_t pending = table->active_mask[point_index] & ~table->notified_mask[point_index] &
+                       ~table->shelved_mask[point_index] & ~table->grouped_mask[point_index];
+    if (pending == 0) {
+        return;
+    }
+
+    uint32_t now_ms = (uint32_t)(now_us / 1000);
+    if (now_ms - table->rate_window_start[point_index] >= ALARM_RATE_WINDOW_MS) {
+        table->rate_window_start[point_index] = now_ms;
+        table->rate_point_count[point_index] = 0;
+        for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+            table->rate_type_count[type][point_index] = 0;
+        }
+    }
+
+    for (int type = 0; type < ALARM_TYPE_COUNT; type++) {
+        if (!(pending & ALARM_RULE_BIT(type)) || table->rate_type_count[type][point_index] >= ALARM_RATE_MAX_PER_TYPE) {
+            continue;
+        }
+        if (table->rate_point_count[point_index] >= ALARM_RATE_MAX_PER_POINT) {
+            break;
+        }
+
+        table->rate_type_count[type][point_index]++;
+        table->rate_point_count[point_index]++;
+        table->notified_mask[point_index] |= ALARM_RULE_BIT(type);
+        manager->notified_count++;
+        alarm_record_event(manager, point_index, (alarm_type_t)type, ALARM_JOURNAL_ACTIVATED,
+                           table->latest_value[point_index]);
+
 #ifdef DEBUG_ALARM_SYSTEM
-        printf("[%s] ALARM CLEARED: Point '%s', Type %d\n", 
-               TAG, manager->point_ids[point_index], alarm_type);
+        printf("[%s] ALARM ACTIVATED: Point '%s', Type %d%s\n", TAG, manager->point_ids[point_index], type,
+               table->first_out_type[point_index] == type ? " (first out)" : "");
 #endif
     }
 }
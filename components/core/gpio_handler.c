@@ -4,15 +4,431 @@
  */
 
 #include "gpio_handler.h"
+#include "psram_manager.h"
 #include "debug_config.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
 #include "driver/gpio.h"
-#include "driver/adc.h"
-#include "esp_adc_cal.h"
 #include <string.h>
 
 static const char* TAG = DEBUG_GPIO_HANDLER_TAG;
 
+/**
+ * @brief Convert GPIO pin to ADC1 channel
+ */
+static esp_err_t pin_to_adc_channel(int pin, adc_channel_t* channel) {
+    switch (pin) {
+        case 32: *channel = ADC_CHANNEL_4; break;
+        case 33: *channel = ADC_CHANNEL_5; break;
+        case 34: *channel = ADC_CHANNEL_6; break;
+        case 35: *channel = ADC_CHANNEL_7; break;
+        case 36: *channel = ADC_CHANNEL_0; break;
+        case 39: *channel = ADC_CHANNEL_3; break;
+        default:
+            return ESP_ERR_INVALID_ARG;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Push one sample into a channel ring, keeping the window sum current
+ */
+static void adc_ring_push(gpio_adc_ring_t* ring, int oversample, uint16_t sample) {
+    if (ring->count >= oversample) {
+        // Drop the sample leaving the averaging window
+        ring->window_sum -= ring->samples[(ring->head + GPIO_HANDLER_ADC_RING_SIZE - oversample) % GPIO_HANDLER_ADC_RING_SIZE];
+    }
+    ring->samples[ring->head] = sample;
+    ring->window_sum += sample;
+    ring->head = (ring->head + 1) % GPIO_HANDLER_ADC_RING_SIZE;
+    if (ring->count < GPIO_HANDLER_ADC_RING_SIZE) {
+        ring->count++;
+    }
+    ring->total_samples++;
+}
+
+/**
+ * @brief Allocate and reset the sample rings
+ */
+static esp_err_t adc_rings_init(gpio_handler_t* handler, int oversample) {
+    if (oversample < GPIO_HANDLER_ADC_MIN_OVERSAMPLE || oversample > GPIO_HANDLER_ADC_MAX_OVERSAMPLE) {
+        ESP_LOGE(TAG, "Oversample %d out of range (%d-%d)", oversample, 
+                 GPIO_HANDLER_ADC_MIN_OVERSAMPLE, GPIO_HANDLER_ADC_MAX_OVERSAMPLE);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!handler->adc_rings) {
+        handler->adc_rings = psram_smart_malloc(GPIO_HANDLER_ADC_CHANNELS * sizeof(gpio_adc_ring_t), 
+                                                ALLOC_LARGE_BUFFER);
+    }
+    if (!handler->adc_frame_buffer) {
+        handler->adc_frame_buffer = psram_smart_malloc(GPIO_HANDLER_ADC_FRAME_SIZE, ALLOC_CRITICAL);
+    }
+    if (!handler->adc_rings || !handler->adc_frame_buffer) {
+        psram_smart_free(handler->adc_rings);
+        psram_smart_free(handler->adc_frame_buffer);
+        handler->adc_rings = NULL;
+        handler->adc_frame_buffer = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    memset(handler->adc_rings, 0, GPIO_HANDLER_ADC_CHANNELS * sizeof(gpio_adc_ring_t));
+    handler->adc_oversample = oversample;
+    handler->adc_frames_drained = 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief Drain pending conversion frames from the continuous driver (non-blocking)
+ */
+static void adc_drain(gpio_handler_t* handler) {
+    for (int frame = 0; frame < GPIO_HANDLER_ADC_MAX_DRAIN_FRAMES; frame++) {
+        uint32_t length = 0;
+        esp_err_t ret = adc_continuous_read(handler->adc_continuous_handle, handler->adc_frame_buffer, 
+                                            GPIO_HANDLER_ADC_FRAME_SIZE, &length, 0);
+        if (ret != ESP_OK || length == 0) {
+            break; // ESP_ERR_TIMEOUT: no frame pending
+        }
+        gpio_handler_adc_feed_frame(handler, handler->adc_frame_buffer, length);
+    }
+}
+
+/*
+ * Interrupt-driven inputs
+ */
+
+/**
+ * @brief Record an accepted edge (caller holds the input lock)
+ */
+static void IRAM_ATTR edge_input_accept(gpio_edge_input_t* input, bool level, int64_t timestamp_us) {
+    input->level = level;
+    input->last_edge_us = timestamp_us;
+    input->edge_count++;
+    if (level && input->count_pulses) {
+        input->pulse_count++;
+    }
+    
+    gpio_edge_event_t* event = &input->history[(input->edge_count - 1) % GPIO_HANDLER_EDGE_HISTORY];
+    event->timestamp_us = timestamp_us;
+    event->sequence = input->edge_count;
+    event->level = level;
+}
+
+/**
+ * @brief Apply one level change to an input (caller holds the input lock)
+ */
+static void IRAM_ATTR edge_input_process(gpio_edge_input_t* input, bool raw_level, int64_t timestamp_us) {
+    input->raw_level = raw_level;
+    input->last_raw_us = timestamp_us;
+    
+    if (raw_level == input->level) {
+        return; // Bounce back to the debounced level
+    }
+    if (input->edge_count > 0 && timestamp_us - input->last_edge_us < (int64_t)input->debounce_us) {
+        input->rejected_count++;
+        return;
+    }
+    
+    edge_input_accept(input, raw_level, timestamp_us);
+}
+
+/**
+ * @brief Accept a level the line settled on inside a debounce window (caller holds the input lock)
+ */
+static void IRAM_ATTR edge_input_settle(gpio_edge_input_t* input, int64_t now_us) {
+    if (input->raw_level != input->level && now_us - input->last_raw_us >= (int64_t)input->debounce_us) {
+        edge_input_accept(input, input->raw_level, input->last_raw_us);
+    }
+}
+
+/**
+ * @brief GPIO ISR for interrupt-driven inputs
+ */
+static void IRAM_ATTR edge_input_isr(void* arg) {
+    gpio_edge_input_t* input = (gpio_edge_input_t*)arg;
+    int64_t now_us = esp_timer_get_time();
+    bool level = gpio_get_level(input->pin) != 0;
+    
+    portENTER_CRITICAL_ISR(&input->lock);
+    edge_input_settle(input, now_us);
+    edge_input_process(input, level, now_us);
+    portEXIT_CRITICAL_ISR(&input->lock);
+}
+
+/**
+ * @brief Find the edge input slot of a pin
+ */
+static gpio_edge_input_t* find_edge_input(gpio_handler_t* handler, int pin) {
+    if (!handler || !handler->edge_inputs || pin < 0 || pin >= GPIO_HANDLER_MAX_PINS || 
+        handler->edge_slots[pin] == 0) {
+        return NULL;
+    }
+    return &handler->edge_inputs[handler->edge_slots[pin] - 1];
+}
+
+#if SOC_PCNT_SUPPORTED
+/**
+ * @brief Count rising edges of an input with a PCNT unit
+ * 
+ * The unit accumulates across its limit, so the count is a plain running total.
+ */
+static esp_err_t edge_input_start_pcnt(gpio_edge_input_t* input) {
+    pcnt_unit_config_t unit_config = {
+        .low_limit = -1,
+        .high_limit = GPIO_HANDLER_PCNT_LIMIT,
+        .flags.accum_count = 1,
+    };
+    esp_err_t ret = pcnt_new_unit(&unit_config, &input->pcnt_unit);
+    if (ret != ESP_OK) {
+        input->pcnt_unit = NULL;
+        return ret;
+    }
+    
+    pcnt_chan_config_t channel_config = {
+        .edge_gpio_num = input->pin,
+        .level_gpio_num = -1,
+    };
+    uint32_t glitch_ns = input->debounce_us * 1000U;
+    pcnt_glitch_filter_config_t filter_config = {
+        .max_glitch_ns = glitch_ns < GPIO_HANDLER_PCNT_MAX_GLITCH_NS ? glitch_ns : GPIO_HANDLER_PCNT_MAX_GLITCH_NS,
+    };
+    
+    ret = pcnt_new_channel(input->pcnt_unit, &channel_config, &input->pcnt_channel);
+    if (ret == ESP_OK) {
+        ret = pcnt_channel_set_edge_action(input->pcnt_channel, PCNT_CHANNEL_EDGE_ACTION_INCREASE, 
+                                           PCNT_CHANNEL_EDGE_ACTION_HOLD);
+    }
+    if (ret == ESP_OK && filter_config.max_glitch_ns > 0) {
+        ret = pcnt_unit_set_glitch_filter(input->pcnt_unit, &filter_config);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_add_watch_point(input->pcnt_unit, GPIO_HANDLER_PCNT_LIMIT);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_enable(input->pcnt_unit);
+    }
+    if (ret == ESP_OK) {
+        pcnt_unit_clear_count(input->pcnt_unit);
+        ret = pcnt_unit_start(input->pcnt_unit);
+    }
+    
+    if (ret != ESP_OK) {
+        if (input->pcnt_channel) {
+            pcnt_del_channel(input->pcnt_channel);
+        }
+        pcnt_del_unit(input->pcnt_unit);
+        input->pcnt_unit = NULL;
+        input->pcnt_channel = NULL;
+    }
+    return ret;
+}
+
+/**
+ * @brief Release an input's PCNT unit
+ */
+static void edge_input_stop_pcnt(gpio_edge_input_t* input) {
+    if (!input->pcnt_unit) {
+        return;
+    }
+    pcnt_unit_stop(input->pcnt_unit);
+    pcnt_unit_disable(input->pcnt_unit);
+    pcnt_del_channel(input->pcnt_channel);
+    pcnt_del_unit(input->pcnt_unit);
+    input->pcnt_unit = NULL;
+    input->pcnt_channel = NULL;
+}
+#endif
+
+esp_err_t gpio_handler_configure_edge_input(gpio_handler_t* handler, int pin, bool pullup, 
+                                            uint32_t debounce_us, bool count_pulses) {
+    if (!handler || !handler->initialized || pin < 0 || pin >= GPIO_HANDLER_MAX_PINS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    gpio_handler_release_edge_input(handler, pin);
+    
+    // ISR state lives in internal RAM
+    if (!handler->edge_inputs) {
+        handler->edge_inputs = psram_smart_malloc(GPIO_HANDLER_MAX_EDGE_INPUTS * sizeof(gpio_edge_input_t), 
+                                                  ALLOC_CRITICAL);
+        if (!handler->edge_inputs) {
+            return ESP_ERR_NO_MEM;
+        }
+        for (int i = 0; i < GPIO_HANDLER_MAX_EDGE_INPUTS; i++) {
+            handler->edge_inputs[i].pin = -1;
+        }
+    }
+    
+    int slot = -1;
+    for (int i = 0; i < GPIO_HANDLER_MAX_EDGE_INPUTS; i++) {
+        if (handler->edge_inputs[i].pin < 0) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        ESP_LOGE(TAG, "No free edge input slot for GPIO %d (max %d)", pin, GPIO_HANDLER_MAX_EDGE_INPUTS);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    gpio_edge_input_t* input = &handler->edge_inputs[slot];
+    memset(input, 0, sizeof(gpio_edge_input_t));
+    portMUX_INITIALIZE(&input->lock);
+    input->pin = pin;
+    input->debounce_us = debounce_us;
+    input->count_pulses = count_pulses;
+    
+    if (!handler->synthetic) {
+        gpio_config_t io_conf = {
+            .pin_bit_mask = (1ULL << pin),
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = pullup ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_ANYEDGE
+        };
+        esp_err_t ret = gpio_config(&io_conf);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to configure GPIO %d as edge input: %s", pin, esp_err_to_name(ret));
+            input->pin = -1;
+            return ret;
+        }
+        input->level = gpio_get_level(pin) != 0;
+        input->raw_level = input->level;
+        
+#if SOC_PCNT_SUPPORTED
+        // Hardware counting keeps high pulse rates out of the ISR entirely
+        if (count_pulses && edge_input_start_pcnt(input) == ESP_OK) {
+            gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+        }
+        if (!input->pcnt_unit)
+#endif
+        {
+            ret = gpio_install_isr_service(0);
+            if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) { // INVALID_STATE: already installed
+                ESP_LOGE(TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+                input->pin = -1;
+                return ret;
+            }
+            ret = gpio_isr_handler_add(pin, edge_input_isr, input);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to attach ISR to GPIO %d: %s", pin, esp_err_to_name(ret));
+                input->pin = -1;
+                return ret;
+            }
+        }
+    }
+    
+    handler->edge_slots[pin] = (int8_t)(slot + 1);
+    handler->input_pins |= (1ULL << pin);
+    handler->configured_pins |= (1ULL << pin);
+    
+#ifdef DEBUG_GPIO_HANDLER
+    ESP_LOGI(TAG, "Configured GPIO %d as edge input (debounce %lu us%s)", pin, debounce_us,
+             !count_pulses ? "" : 
+#if SOC_PCNT_SUPPORTED
+             input->pcnt_unit ? ", PCNT pulse counter" :
+#endif
+             ", ISR pulse counter");
+#endif
+    
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_release_edge_input(gpio_handler_t* handler, int pin) {
+    gpio_edge_input_t* input = find_edge_input(handler, pin);
+    if (!input) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    if (!handler->synthetic) {
+#if SOC_PCNT_SUPPORTED
+        if (input->pcnt_unit) {
+            edge_input_stop_pcnt(input);
+        } else
+#endif
+        {
+            gpio_isr_handler_remove(pin);
+        }
+        gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+    }
+    
+    input->pin = -1;
+    handler->edge_slots[pin] = 0;
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_read_edge_input(gpio_handler_t* handler, int pin, gpio_edge_status_t* status) {
+    gpio_edge_input_t* input = find_edge_input(handler, pin);
+    if (!input || !status) {
+        return input ? ESP_ERR_INVALID_ARG : ESP_ERR_NOT_FOUND;
+    }
+    
+#if SOC_PCNT_SUPPORTED
+    if (input->pcnt_unit) {
+        int count = 0;
+        pcnt_unit_get_count(input->pcnt_unit, &count);
+        memset(status, 0, sizeof(gpio_edge_status_t));
+        status->level = gpio_get_level(pin) != 0;
+        status->pulse_count = (uint32_t)count;
+        status->hardware_counter = true;
+        handler->read_count++;
+        return ESP_OK;
+    }
+#endif
+    
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&input->lock);
+    edge_input_settle(input, now_us);
+    status->level = input->level;
+    status->edge_count = input->edge_count;
+    status->rejected_count = input->rejected_count;
+    status->pulse_count = input->pulse_count;
+    status->last_edge_us = input->last_edge_us;
+    status->hardware_counter = false;
+    portEXIT_CRITICAL(&input->lock);
+    
+    handler->read_count++;
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_get_edges(gpio_handler_t* handler, int pin, uint32_t since_sequence,
+                                 gpio_edge_event_t* events, int max_events, int* event_count) {
+    gpio_edge_input_t* input = find_edge_input(handler, pin);
+    if (!input || !events || !event_count) {
+        return input ? ESP_ERR_INVALID_ARG : ESP_ERR_NOT_FOUND;
+    }
+    
+    int count = 0;
+    portENTER_CRITICAL(&input->lock);
+    uint32_t newest = input->edge_count;
+    uint32_t oldest = newest > GPIO_HANDLER_EDGE_HISTORY ? newest - GPIO_HANDLER_EDGE_HISTORY + 1 : 1;
+    if (since_sequence + 1 > oldest) {
+        oldest = since_sequence + 1;
+    }
+    for (uint32_t sequence = oldest; sequence <= newest && count < max_events; sequence++) {
+        events[count++] = input->history[(sequence - 1) % GPIO_HANDLER_EDGE_HISTORY];
+    }
+    portEXIT_CRITICAL(&input->lock);
+    
+    *event_count = count;
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_inject_edge(gpio_handler_t* handler, int pin, bool level, int64_t timestamp_us) {
+    gpio_edge_input_t* input = find_edge_input(handler, pin);
+    if (!input) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    portENTER_CRITICAL(&input->lock);
+    edge_input_settle(input, timestamp_us);
+    edge_input_process(input, level, timestamp_us);
+    portEXIT_CRITICAL(&input->lock);
+    
+    return ESP_OK;
+}
+
 esp_err_t gpio_handler_init(gpio_handler_t* handler) {
     if (!handler) {
         return ESP_ERR_INVALID_ARG;
@@ -22,9 +438,13 @@ esp_err_t gpio_handler_init(gpio_handler_t* handler) {
     memset(handler, 0, sizeof(gpio_handler_t));
     
     // Initialize ADC1 for analog inputs
-    esp_err_t ret = adc1_config_width(ADC_WIDTH_BIT_12);
+    adc_oneshot_unit_init_cfg_t unit_config = {
+        .unit_id = ADC_UNIT_1,
+        .ulp_mode = ADC_ULP_MODE_DISABLE,
+    };
+    esp_err_t ret = adc_oneshot_new_unit(&unit_config, &handler->adc_handle);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to configure ADC width: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "Failed to create ADC unit: %s", esp_err_to_name(ret));
         return ret;
     }
     
@@ -42,6 +462,8 @@ esp_err_t gpio_handler_configure_input(gpio_handler_t* handler, int pin, bool pu
         return ESP_ERR_INVALID_ARG;
     }
     
+    gpio_handler_release_edge_input(handler, pin); // Back to a polled input
+    
     gpio_config_t io_conf = {
         .pin_bit_mask = (1ULL << pin),
         .mode = GPIO_MODE_INPUT,
@@ -112,24 +534,22 @@ esp_err_t gpio_handler_configure_analog(gpio_handler_t* handler, int pin) {
     }
     
     // Convert GPIO pin to ADC channel
-    adc1_channel_t channel;
-    switch (pin) {
-        case 32: channel = ADC1_CHANNEL_4; break;
-        case 33: channel = ADC1_CHANNEL_5; break;
-        case 34: channel = ADC1_CHANNEL_6; break;
-        case 35: channel = ADC1_CHANNEL_7; break;
-        case 36: channel = ADC1_CHANNEL_0; break;
-        case 39: channel = ADC1_CHANNEL_3; break;
-        default:
-            ESP_LOGE(TAG, "GPIO %d is not a valid ADC pin", pin);
-            return ESP_ERR_INVALID_ARG;
+    adc_channel_t channel;
+    if (pin_to_adc_channel(pin, &channel) != ESP_OK) {
+        ESP_LOGE(TAG, "GPIO %d is not a valid ADC pin", pin);
+        return ESP_ERR_INVALID_ARG;
     }
     
-    esp_err_t ret = adc1_config_channel_atten(channel, ADC_ATTEN_DB_11);
+    adc_oneshot_chan_cfg_t channel_config = {
+        .atten = ADC_ATTEN_DB_12,
+        .bitwidth = ADC_BITWIDTH_12,
+    };
+    esp_err_t ret = adc_oneshot_config_channel(handler->adc_handle, channel, &channel_config);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to configure ADC channel for GPIO %d: %s", pin, esp_err_to_name(ret));
         return ret;
     }
+    handler->analog_pins |= (1ULL << pin);
     
 #ifdef DEBUG_GPIO_HANDLER
     ESP_LOGI(TAG, "Configured GPIO %d as analog input (ADC channel %d)", pin, channel);
@@ -169,31 +589,185 @@ esp_err_t gpio_handler_read_analog(gpio_handler_t* handler, int pin, int* raw_va
     }
     
     // Convert GPIO pin to ADC channel
-    adc1_channel_t channel;
-    switch (pin) {
-        case 32: channel = ADC1_CHANNEL_4; break;
-        case 33: channel = ADC1_CHANNEL_5; break;
-        case 34: channel = ADC1_CHANNEL_6; break;
-        case 35: channel = ADC1_CHANNEL_7; break;
-        case 36: channel = ADC1_CHANNEL_0; break;
-        case 39: channel = ADC1_CHANNEL_3; break;
-        default:
-            ESP_LOGE(TAG, "GPIO %d is not a valid ADC pin", pin);
-            return ESP_ERR_INVALID_ARG;
+    adc_channel_t channel;
+    if (pin_to_adc_channel(pin, &channel) != ESP_OK) {
+        ESP_LOGE(TAG, "GPIO %d is not a valid ADC pin", pin);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (handler->adc_continuous) {
+        if (handler->adc_continuous_handle) {
+            adc_drain(handler);
+        }
+        
+        const gpio_adc_ring_t* ring = &handler->adc_rings[channel];
+        if (ring->count == 0) {
+            return ESP_ERR_INVALID_STATE; // No sample yet
+        }
+        int window = (ring->count < handler->adc_oversample) ? ring->count : handler->adc_oversample;
+        *raw_value = (int)((ring->window_sum + window / 2) / window);
+        handler->read_count++;
+        return ESP_OK;
     }
     
-    int adc_reading = adc1_get_raw(channel);
-    if (adc_reading < 0) {
-        ESP_LOGE(TAG, "Failed to read ADC from GPIO %d", pin);
+    int adc_reading = 0;
+    esp_err_t ret = adc_oneshot_read(handler->adc_handle, channel, &adc_reading);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read ADC from GPIO %d: %s", pin, esp_err_to_name(ret));
+        handler->error_count++;
         return ESP_ERR_INVALID_RESPONSE;
     }
     
     *raw_value = adc_reading;
+    handler->read_count++;
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_start_adc_continuous(gpio_handler_t* handler, int oversample, uint32_t sample_freq_hz) {
+    if (!handler || !handler->initialized) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (handler->adc_continuous) {
+        gpio_handler_stop_adc_continuous(handler);
+    }
+    
+    // Build round-robin pattern from configured analog pins
+    adc_digi_pattern_config_t pattern[GPIO_HANDLER_ADC_CHANNELS];
+    uint32_t pattern_count = 0;
+    for (int pin = 0; pin < GPIO_HANDLER_MAX_PINS && pattern_count < GPIO_HANDLER_ADC_CHANNELS; pin++) {
+        adc_channel_t channel;
+        if (!(handler->analog_pins & (1ULL << pin)) || pin_to_adc_channel(pin, &channel) != ESP_OK) {
+            continue;
+        }
+        pattern[pattern_count].atten = ADC_ATTEN_DB_12;
+        pattern[pattern_count].channel = channel;
+        pattern[pattern_count].unit = ADC_UNIT_1;
+        pattern[pattern_count].bit_width = ADC_BITWIDTH_12;
+        pattern_count++;
+    }
+    if (pattern_count == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    if (sample_freq_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) {
+        sample_freq_hz = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+    }
+    
+    esp_err_t ret = adc_rings_init(handler, oversample);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = GPIO_HANDLER_ADC_FRAME_SIZE * 4,
+        .conv_frame_size = GPIO_HANDLER_ADC_FRAME_SIZE,
+        .flags.flush_pool = 1, // Keep the newest frames when reads fall behind
+    };
+    ret = adc_continuous_new_handle(&handle_config, &handler->adc_continuous_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create continuous ADC handle: %s", esp_err_to_name(ret));
+        handler->adc_continuous_handle = NULL;
+        return ret;
+    }
+    
+    adc_continuous_config_t config = {
+        .pattern_num = pattern_count,
+        .adc_pattern = pattern,
+        .sample_freq_hz = sample_freq_hz,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+    };
+    ret = adc_continuous_config(handler->adc_continuous_handle, &config);
+    if (ret == ESP_OK) {
+        ret = adc_continuous_start(handler->adc_continuous_handle);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start continuous ADC: %s", esp_err_to_name(ret));
+        adc_continuous_deinit(handler->adc_continuous_handle);
+        handler->adc_continuous_handle = NULL;
+        return ret;
+    }
+    
+    handler->adc_continuous = true;
+    
+#ifdef DEBUG_GPIO_HANDLER
+    ESP_LOGI(TAG, "Continuous ADC started: %lu channels, %lu Hz, %dx oversample", 
+             pattern_count, sample_freq_hz, oversample);
+#endif
+    
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_stop_adc_continuous(gpio_handler_t* handler) {
+    if (!handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (handler->adc_continuous_handle) {
+        adc_continuous_stop(handler->adc_continuous_handle);
+        adc_continuous_deinit(handler->adc_continuous_handle);
+        handler->adc_continuous_handle = NULL;
+    }
+    handler->adc_continuous = false;
+    
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_init_synthetic(gpio_handler_t* handler, uint64_t analog_pins, int oversample) {
+    if (!handler) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memset(handler, 0, sizeof(gpio_handler_t));
+    handler->analog_pins = analog_pins;
+    handler->synthetic = true;
+    
+    esp_err_t ret = adc_rings_init(handler, oversample);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    handler->adc_continuous = true;
+    handler->initialized = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_handler_adc_feed_frame(gpio_handler_t* handler, const uint8_t* frame, uint32_t length) {
+    if (!handler || !handler->adc_continuous || !handler->adc_rings || !frame) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= length; offset += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t* result = (const adc_digi_output_data_t*)&frame[offset];
+        uint32_t channel = result->type1.channel;
+        if (channel < GPIO_HANDLER_ADC_CHANNELS) {
+            adc_ring_push(&handler->adc_rings[channel], handler->adc_oversample, result->type1.data);
+        }
+    }
+    handler->adc_frames_drained++;
+    
     return ESP_OK;
 }
 
 void gpio_handler_destroy(gpio_handler_t* handler) {
     if (handler && handler->initialized) {
+        gpio_handler_stop_adc_continuous(handler);
+        psram_smart_free(handler->adc_rings);
+        psram_smart_free(handler->adc_frame_buffer);
+        handler->adc_rings = NULL;
+        handler->adc_frame_buffer = NULL;
+        
+        for (int pin = 0; pin < GPIO_HANDLER_MAX_PINS; pin++) {
+            gpio_handler_release_edge_input(handler, pin);
+        }
+        psram_smart_free(handler->edge_inputs);
+        handler->edge_inputs = NULL;
+        
+        if (handler->adc_handle) {
+            adc_oneshot_del_unit(handler->adc_handle);
+            handler->adc_handle = NULL;
+        }
         handler->initialized = false;
         
 #ifdef DEBUG_GPIO_HANDLER
@@ -0,0 +1,257 @@
+/**
+ * @file alarm_journal.h
+ * @brief Persistent Alarm Event Journal for SNRv9 Irrigation Control System
+ *
+ * Records alarm activations and clears as fixed-size binary records.
+ * Appends go to a ring buffer in PSRAM and never touch flash; a flush task
+ * writes them to LittleFS in batches of ALARM_JOURNAL_BATCH_RECORDS, or
+ * whatever is pending every ALARM_JOURNAL_FLUSH_INTERVAL_MS, so the number
+ * of flash writes depends on the batch size and interval rather than on the
+ * alarm rate.
+ *
+ * Flushed records live in ALARM_JOURNAL_SEGMENT_COUNT segment files used
+ * as a ring of slots: when the current segment is full the oldest slot is
+ * truncated and reused. Each segment's time range is kept in RAM, so a
+ * query opens only the segments overlapping its range and streams their
+ * records in small chunks, followed by the records still in the ring.
+ */
+
+#ifndef ALARM_JOURNAL_H
+#define ALARM_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Records held in the PSRAM ring awaiting flush
+ */
+#define ALARM_JOURNAL_RING_RECORDS 512
+
+/**
+ * @brief Pending records that trigger a flush
+ */
+#define ALARM_JOURNAL_BATCH_RECORDS 32
+
+/**
+ * @brief Longest time a record waits in the ring before being flushed
+ */
+#define ALARM_JOURNAL_FLUSH_INTERVAL_MS 60000
+
+/**
+ * @brief Records per segment file
+ */
+#define ALARM_JOURNAL_SEGMENT_RECORDS 1024
+
+/**
+ * @brief Segment file slots (oldest is overwritten when all are full)
+ */
+#define ALARM_JOURNAL_SEGMENT_COUNT 8
+
+/**
+ * @brief Base path of the live journal's segment files (slot N is <base>_N.bin)
+ */
+#define ALARM_JOURNAL_DEFAULT_PATH "/alarm_journal"
+
+/**
+ * @brief Longest segment file base path, including the terminator
+ */
+#define ALARM_JOURNAL_PATH_MAX 24
+
+/**
+ * @brief Segment file header magic ("ALJ1")
+ */
+#define ALARM_JOURNAL_MAGIC 0x314A4C41
+
+/**
+ * @brief Journal event kinds
+ */
+typedef enum {
+    ALARM_JOURNAL_ACTIVATED = 0,        ///< Alarm became active
+    ALARM_JOURNAL_CLEARED,              ///< Alarm cleared
+    ALARM_JOURNAL_SHELVED,              ///< Alarm type shelved (value: duration in seconds)
+    ALARM_JOURNAL_UNSHELVED             ///< Shelve ended or was lifted
+} alarm_journal_event_t;
+
+/**
+ * @brief Journal record (as stored in the ring and in segment files)
+ */
+typedef struct {
+    int64_t timestamp_ms;               ///< Wall-clock time (Unix milliseconds)
+    uint32_t sequence;                  ///< Journal-wide record sequence number
+    uint32_t point_key;                 ///< FNV-1a hash of the point ID (point_id_index_hash)
+    float value;                        ///< Latest sample when the event occurred (shelve: duration)
+    uint8_t alarm_type;                 ///< alarm_type_t
+    uint8_t event;                      ///< alarm_journal_event_t
+    uint16_t reserved;                  ///< Zero
+} alarm_journal_record_t;
+
+/**
+ * @brief Segment file header
+ */
+typedef struct {
+    uint32_t magic;                     ///< ALARM_JOURNAL_MAGIC
+    uint32_t segment_sequence;          ///< Increases with every segment started
+    uint16_t record_size;               ///< sizeof(alarm_journal_record_t)
+    uint16_t reserved;                  ///< Zero
+} alarm_journal_segment_header_t;
+
+/**
+ * @brief In-RAM index entry of a segment slot
+ */
+typedef struct {
+    uint32_t segment_sequence;          ///< Segment sequence (0 = slot unused)
+    uint32_t record_count;              ///< Records in the file
+    int64_t first_ms;                   ///< Earliest record timestamp
+    int64_t last_ms;                    ///< Latest record timestamp
+} alarm_journal_segment_t;
+
+/**
+ * @brief Journal statistics
+ */
+typedef struct {
+    uint32_t appended;                  ///< Records appended
+    uint32_t dropped;                   ///< Records dropped because the ring was full
+    uint32_t flushed;                   ///< Records written to flash
+    uint32_t flush_count;               ///< Flash writes (batches)
+    uint32_t write_errors;              ///< Failed flash writes
+    uint32_t pending;                   ///< Records in the ring
+    uint32_t last_flush_us;             ///< Duration of the last flush
+    uint32_t max_flush_us;              ///< Longest flush
+} alarm_journal_stats_t;
+
+/**
+ * @brief Alarm Journal Structure
+ */
+typedef struct {
+    bool initialized;                                   ///< Initialization status
+
+    // Ring of records not yet flushed (PSRAM)
+    alarm_journal_record_t* ring;                       ///< Pending records
+    uint32_t ring_head;                                 ///< Oldest pending record
+    uint32_t ring_count;                                ///< Pending records
+    portMUX_TYPE ring_lock;                             ///< Guards the ring indices (held for a record copy)
+    uint32_t next_sequence;                             ///< Sequence of the next record
+
+    // Flash segments
+    char base_path[ALARM_JOURNAL_PATH_MAX];             ///< Segment file base path
+    alarm_journal_record_t* batch;                      ///< Flush scratch (ALARM_JOURNAL_BATCH_RECORDS)
+    alarm_journal_segment_t segments[ALARM_JOURNAL_SEGMENT_COUNT]; ///< Segment index by slot
+    int current_slot;                                   ///< Slot being appended to (-1 = none yet)
+    SemaphoreHandle_t file_mutex;                       ///< Serializes segment writes, reads and the index
+
+    // Flush task
+    TaskHandle_t flush_task_handle;                     ///< Flush task
+    volatile bool flush_task_running;                   ///< Flush task run flag
+    SemaphoreHandle_t flush_task_exited;                ///< Given by the flush task when it exits
+
+    alarm_journal_stats_t stats;                        ///< Statistics (appended/dropped under ring_lock)
+} alarm_journal_t;
+
+/**
+ * @brief Query callback, called once per matching record in time order per segment
+ *
+ * @param record Matching record
+ * @param context Caller context
+ * @return bool True to continue, false to stop the query
+ */
+typedef bool (*alarm_journal_visit_fn_t)(const alarm_journal_record_t* record, void* context);
+
+/**
+ * @brief Initialize the journal and index existing segment files
+ *
+ * @param journal Pointer to journal structure
+ * @param base_path Segment file base path (ALARM_JOURNAL_DEFAULT_PATH for the live journal)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG if the path is too
+ *         long, ESP_ERR_NO_MEM on allocation failure
+ */
+esp_err_t alarm_journal_init(alarm_journal_t* journal, const char* base_path);
+
+/**
+ * @brief Start the flush task
+ *
+ * @param journal Pointer to journal structure
+ * @param task_priority Flush task priority
+ * @param task_stack_size Flush task stack size
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_journal_start(alarm_journal_t* journal, UBaseType_t task_priority, uint32_t task_stack_size);
+
+/**
+ * @brief Append an event to the ring
+ *
+ * Constant time and never blocks on flash; safe to call from the IO scan
+ * with the alarm mutex held. When the ring is full the record is dropped
+ * and counted.
+ *
+ * @param journal Pointer to journal structure
+ * @param point_key Hash of the point ID (point_id_index_hash)
+ * @param alarm_type Alarm type
+ * @param event Event kind
+ * @param value Latest sample of the point
+ */
+void alarm_journal_append(alarm_journal_t* journal, uint32_t point_key, uint8_t alarm_type,
+                          alarm_journal_event_t event, float value);
+
+/**
+ * @brief Write every pending record to flash now
+ *
+ * @param journal Pointer to journal structure
+ * @return esp_err_t ESP_OK on success, ESP_FAIL if a segment write failed
+ */
+esp_err_t alarm_journal_flush(alarm_journal_t* journal);
+
+/**
+ * @brief Visit the records in a time range
+ *
+ * Segments outside the range are skipped using the in-RAM index; the rest
+ * are read oldest segment first, followed by pending records. Matching
+ * records are copied out ALARM_JOURNAL_BATCH_RECORDS at a time under the
+ * file mutex and visited after it is released, so a slow visitor (e.g. an
+ * HTTP client) never holds up flushes or segment rotation. Records flushed
+ * between batches are visited once; records in a segment overwritten
+ * between batches are lost to the query.
+ *
+ * @param journal Pointer to journal structure
+ * @param from_ms Earliest timestamp (inclusive)
+ * @param to_ms Latest timestamp (inclusive)
+ * @param point_key Only records of this point (0 = all points)
+ * @param visit Callback per matching record
+ * @param context Callback context
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if the journal is busy,
+ *         ESP_ERR_NO_MEM if the batch buffer cannot be allocated
+ */
+esp_err_t alarm_journal_query(alarm_journal_t* journal, int64_t from_ms, int64_t to_ms, uint32_t point_key,
+                              alarm_journal_visit_fn_t visit, void* context);
+
+/**
+ * @brief Get journal statistics
+ *
+ * @param journal Pointer to journal structure
+ * @param stats Pointer to store statistics
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_journal_get_stats(alarm_journal_t* journal, alarm_journal_stats_t* stats);
+
+/**
+ * @brief Stop the flush task, flush pending records and free resources
+ *
+ * Waits for the flush task to exit. If it does not exit in time the
+ * journal is left allocated rather than freed under a running task.
+ *
+ * @param journal Pointer to journal structure
+ */
+void alarm_journal_destroy(alarm_journal_t* journal);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALARM_JOURNAL_H
@@ -3,7 +3,44 @@
  * @brief Alarm Management System for SNRv9 Irrigation Control System
  * 
  * Provides comprehensive alarm monitoring for analog inputs including
- * rate of change, disconnection, stuck signal, and max value detection.
+ * rate of change, disconnection, stuck signal, max value and noise band
+ * detection.
+ *
+ * Alarm evaluation is a stage of the IO scan: once attached to the IO
+ * manager, every new conditioned sample of a monitored point is evaluated
+ * in one batch per scan pass with alarm_manager_process_samples. Each point's
+ * alarm configuration is compiled at init (and reload) into a rule mask
+ * and thresholds, so evaluation never reads the configuration manager.
+ *
+ * Each point keeps a sliding window of its last historySamplesForAnalysis
+ * samples with running statistics updated in O(1) per sample: min/max over
+ * the stuck signal window via monotonic deques, and mean/variance over the
+ * whole window via a sliding Welford update. Window-based checks therefore
+ * cost the same whether the window holds ten samples or hundreds.
+ *
+ * Activations and clears pass a suppression layer before they are
+ * notified (journaled and reported to the IO scan as alarm_active):
+ * - rate limiting: at most ALARM_RATE_MAX_PER_TYPE notified activations per
+ *   point and type, and ALARM_RATE_MAX_PER_POINT per point, in each
+ *   ALARM_RATE_WINDOW_MS; a limited alarm that is still active is notified
+ *   once the limit allows;
+ * - shelving: an operator shelves a point's alarms for a time, during which
+ *   new activations are not notified;
+ * - first-out grouping: alarms of a point activating within
+ *   ALARM_FIRST_OUT_WINDOW_MS of its first-out (root cause) alarm are
+ *   grouped under it and notified only if they outlast it.
+ * The clear of a notified activation is always notified, so consumers see
+ * matched transitions. alarm_manager_get_summary reports both views.
+ *
+ * With a journal attached, every notified transition and every shelve
+ * change is appended to the persistent alarm journal (alarm_journal.h).
+ *
+ * Interlocks configured on a point (alarmConfig.interlocks) are compiled
+ * into a flat list. They follow the raw alarm state, not the notified one:
+ * rate limiting, shelving and grouping only affect annunciation, never
+ * protection. alarm_manager_process_samples reports which interlocks are
+ * tripped after the batch so the IO scan can force the outputs in the
+ * same pass.
  */
 
 #ifndef ALARM_MANAGER_H
@@ -15,6 +52,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "config_manager.h"
+#include "point_id_index.h"
+#include "alarm_journal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -28,24 +67,219 @@ typedef enum {
     ALARM_TYPE_DISCONNECTED,            ///< Sensor disconnection detection
     ALARM_TYPE_MAX_VALUE,               ///< Over-range detection
     ALARM_TYPE_STUCK_SIGNAL,            ///< Unchanging signal detection
+    ALARM_TYPE_NOISE_BAND,              ///< Excessive signal noise detection
     ALARM_TYPE_COUNT                    ///< Number of alarm types
 } alarm_type_t;
 
 /**
- * @brief Alarm state for a single point
+ * @brief Rule mask bit of an alarm type
+ */
+#define ALARM_RULE_BIT(type) (1U << (type))
+
+/**
+ * @brief Largest analysis window (samples per point)
+ */
+#define ALARM_MAX_HISTORY_SAMPLES 1024
+
+/**
+ * @brief Smallest analysis window (rate of change needs two samples)
+ */
+#define ALARM_MIN_HISTORY_SAMPLES 2
+
+/**
+ * @brief Rate limit window
+ */
+#define ALARM_RATE_WINDOW_MS 60000
+
+/**
+ * @brief Notified activations per point and alarm type in a rate limit window
+ */
+#define ALARM_RATE_MAX_PER_TYPE 3
+
+/**
+ * @brief Notified activations per point in a rate limit window
+ */
+#define ALARM_RATE_MAX_PER_POINT 6
+
+/**
+ * @brief Activations within this time of a point's first-out alarm are grouped under it
+ */
+#define ALARM_FIRST_OUT_WINDOW_MS 2000
+
+/**
+ * @brief Longest shelve duration
+ */
+#define ALARM_SHELVE_MAX_MS (24UL * 60 * 60 * 1000)
+
+/**
+ * @brief first_out_type of a point without a first-out alarm
+ */
+#define ALARM_FIRST_OUT_NONE 0xFF
+
+/**
+ * @brief Largest number of interlocks across all points (one bit each in the tripped mask)
+ */
+#define ALARM_MAX_INTERLOCKS 32
+
+/**
+ * @brief Alarm point handle (index of a monitored point)
+ */
+typedef int alarm_point_handle_t;
+
+/**
+ * @brief Compiled alarm rules of a point (scattered into the point table)
+ */
+typedef struct {
+    uint32_t rule_mask;                         ///< ALARM_RULE_BIT of each enabled check
+    uint32_t point_key;                         ///< Journal key of the point (point_id_index_hash of its ID)
+    uint32_t persistence_samples;               ///< Samples in alarm before activation
+    uint32_t clear_samples;                     ///< Samples out of alarm before clearing
+    uint16_t history_samples;                   ///< Analysis window length (samples)
+    uint16_t stuck_window;                      ///< Stuck signal window (samples, at most history_samples)
+    float rate_of_change_threshold;             ///< Rate of change threshold (change from the previous sample)
+    float disconnected_threshold;               ///< At or below: disconnected
+    float max_value_threshold;                  ///< At or above: over range
+    float stuck_delta_threshold;                ///< Largest change still considered stuck
+    float noise_band_threshold;                 ///< Largest standard deviation over the window
+} alarm_point_rules_t;
+
+/**
+ * @brief Sliding analysis window of a point
+ * 
+ * samples is a ring of the last capacity samples. min_deque and max_deque
+ * hold ring positions of the stuck window's candidate minima and maxima in
+ * sample order, with increasing and decreasing values respectively, so the
+ * window min/max is always at the front. mean and m2 are the Welford
+ * running mean and sum of squared deviations over the samples in the ring.
+ * Sliding removal accumulates rounding error, so lap_mean and lap_m2 track
+ * the samples written since the ring last wrapped with plain Welford adds;
+ * at the next wrap those are exactly the ring contents and replace mean
+ * and m2, bounding the drift to one lap.
+ */
+typedef struct {
+    float* samples;                             ///< Sample ring (capacity entries)
+    uint16_t* min_deque;                        ///< Candidate minima (stuck_window entries)
+    uint16_t* max_deque;                        ///< Candidate maxima (stuck_window entries)
+    uint16_t capacity;                          ///< Ring length (analysis window)
+    uint16_t stuck_window;                      ///< Min/max window (0 = deques not kept)
+    uint16_t head;                              ///< Ring position of the next sample
+    uint16_t count;                             ///< Samples in the ring
+    uint16_t min_front;                         ///< First entry of min_deque
+    uint16_t min_count;                         ///< Entries in min_deque
+    uint16_t max_front;                         ///< First entry of max_deque
+    uint16_t max_count;                         ///< Entries in max_deque
+    float mean;                                 ///< Running mean of the ring
+    float m2;                                   ///< Running sum of squared deviations of the ring
+    float lap_mean;                             ///< Mean of the samples written since the ring last wrapped
+    float lap_m2;                               ///< Squared deviations of the samples written since the last wrap
+} alarm_window_t;
+
+/**
+ * @brief Alarm state of every monitored point, as structure-of-arrays
+ * 
+ * Entry i of every array belongs to monitored point i (its alarm point
+ * handle). Only points with alarm configuration enabled have entries. Each
+ * rule is evaluated as one loop over a batch of points, touching only the
+ * arrays that rule needs: the rule masks, its threshold array, its
+ * persistence/clear counters and the latest values or windows.
+ * 
+ * Arrays read or written on every sample share one internal RAM block;
+ * bookkeeping written only on activation and clear shares one PSRAM block.
+ */
+typedef struct {
+    // Compiled rules (hot)
+    uint32_t* rule_mask;                        ///< ALARM_RULE_BIT of each enabled check
+    float* thresholds[ALARM_TYPE_COUNT];        ///< Threshold per type (noise band: squared standard deviation)
+    uint16_t* persistence_samples;              ///< Samples in alarm before activation
+    uint16_t* clear_samples;                    ///< Samples out of alarm before clearing
+
+    // Evaluation state (hot)
+    uint32_t* active_mask;                      ///< ALARM_RULE_BIT of each active alarm
+    uint32_t* notified_mask;                    ///< Active alarms whose activation was notified
+    uint32_t* shelved_mask;                     ///< Shelved alarm types
+    uint32_t* grouped_mask;                     ///< Active alarms grouped under the first-out
+    uint16_t* persistence_count[ALARM_TYPE_COUNT]; ///< Consecutive samples in alarm per type (saturating)
+    uint16_t* clear_count[ALARM_TYPE_COUNT];    ///< Consecutive samples out of alarm per type (saturating)
+    float* latest_value;                        ///< Most recent sample
+    alarm_window_t* windows;                    ///< Sliding analysis windows
+
+    // Bookkeeping (cold)
+    uint32_t* activation_count[ALARM_TYPE_COUNT]; ///< Number of activations per type
+    uint64_t* activation_time[ALARM_TYPE_COUNT]; ///< Last activation time per type
+    uint32_t* good_samples_count;               ///< Clears since the last activation
+    bool* trust_restored;                       ///< Trust status after alarm
+    uint32_t* point_keys;                       ///< Journal key of the point (point_id_index_hash of its ID)
+    uint64_t* shelve_expiry[ALARM_TYPE_COUNT];  ///< End of the shelve per type (esp_timer microseconds)
+    uint32_t* rate_window_start;                ///< Start of the current rate limit window (milliseconds)
+    uint8_t* rate_point_count;                  ///< Activations notified in the window
+    uint8_t* rate_type_count[ALARM_TYPE_COUNT]; ///< Activations notified in the window per type
+    uint32_t* first_out_time;                   ///< First-out activation time (milliseconds)
+    uint8_t* first_out_type;                    ///< First-out alarm type (ALARM_FIRST_OUT_NONE = none)
+
+    // Storage
+    uint8_t* hot_block;                         ///< Hot arrays (internal RAM)
+    uint8_t* cold_block;                        ///< Cold arrays (PSRAM)
+    uint8_t* window_pool;                       ///< Window samples and deques
+    size_t hot_bytes;                           ///< Size of hot_block
+    size_t cold_bytes;                          ///< Size of cold_block
+    size_t window_bytes;                        ///< Size of window_pool
+} alarm_point_table_t;
+
+/**
+ * @brief One sample of a batch evaluated by alarm_manager_process_samples
+ */
+typedef struct {
+    alarm_point_handle_t handle;                ///< Monitored point
+    float value;                                ///< New conditioned value
+    uint16_t source_index;                      ///< Caller's index of the sample source (not used here)
+    bool active;                                ///< Out: any notified, unshelved alarm of the point active
+} alarm_sample_t;
+
+/**
+ * @brief Alarm summary across all monitored points
+ */
+typedef struct {
+    uint16_t monitored_points;                  ///< Monitored points
+    uint16_t points_in_alarm;                   ///< Points with a notified, unshelved active alarm
+    uint16_t active_alarms;                     ///< Active alarms, suppressed or not
+    uint16_t notified_alarms;                   ///< Active alarms notified and not shelved
+    uint16_t shelved_alarms;                    ///< Shelved alarm types
+    uint16_t active_by_type[ALARM_TYPE_COUNT];  ///< Active alarms per type
+    uint32_t notified_transitions;              ///< Activations and clears notified
+    uint32_t rate_limited;                      ///< Activations cleared before the rate limit allowed them
+    uint32_t shelved_suppressed;                ///< Activations cleared while shelved
+    uint32_t grouped;                           ///< Activations grouped under a first-out alarm
+} alarm_summary_t;
+
+/**
+ * @brief Alarm summary of one point with an active or shelved alarm
+ */
+typedef struct {
+    char point_id[CONFIG_MAX_ID_LENGTH];        ///< Point ID
+    uint32_t active_mask;                       ///< Active alarms
+    uint32_t notified_mask;                     ///< Active alarms notified
+    uint32_t shelved_mask;                      ///< Shelved alarm types
+    uint8_t first_out_type;                     ///< First-out alarm type (ALARM_FIRST_OUT_NONE = none)
+} alarm_point_summary_t;
+
+/**
+ * @brief Compiled interlock
  */
 typedef struct {
-    bool active[ALARM_TYPE_COUNT];              ///< Active alarm flags
-    uint32_t activation_count[ALARM_TYPE_COUNT]; ///< Number of activations
-    uint64_t activation_time[ALARM_TYPE_COUNT];  ///< Activation timestamps
-    uint32_t persistence_count[ALARM_TYPE_COUNT]; ///< Persistence counters
-    uint32_t clear_count[ALARM_TYPE_COUNT];      ///< Clear condition counters
-    uint32_t good_samples_count;                 ///< Consecutive good samples
-    bool trust_restored;                         ///< Trust status after alarm
-    float last_values[20];                       ///< History buffer for analysis
-    int history_index;                           ///< Current history index
-    int history_count;                           ///< Number of samples in history
-} alarm_state_t;
+    uint16_t point;                             ///< Monitored point whose alarms trip it
+    uint32_t alarm_mask;                        ///< ALARM_RULE_BIT of each tripping alarm type
+    bool forced_state;                          ///< Output state while tripped
+} alarm_interlock_t;
+
+/**
+ * @brief Interlock description (alarm_manager_get_interlock)
+ */
+typedef struct {
+    char point_id[CONFIG_MAX_ID_LENGTH];        ///< Monitored point
+    char output_point_id[CONFIG_MAX_ID_LENGTH]; ///< Output it forces
+    uint32_t alarm_mask;                        ///< ALARM_RULE_BIT of each tripping alarm type
+    bool forced_state;                          ///< Output state while tripped
+} alarm_interlock_info_t;
 
 /**
  * @brief Alarm Manager Structure
@@ -56,22 +290,31 @@ typedef struct {
     // Configuration
     config_manager_t* config_manager;          ///< Configuration manager
     
-    // Alarm states for all points
-    alarm_state_t point_alarms[CONFIG_MAX_IO_POINTS]; ///< Alarm states
-    char point_ids[CONFIG_MAX_IO_POINTS][CONFIG_MAX_ID_LENGTH]; ///< Point ID mapping
+    // Alarm state of monitored points, sized at init and reload
+    alarm_point_table_t points;                 ///< Structure-of-arrays point state
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH];    ///< Point ID mapping (PSRAM)
+    point_id_index_t id_index;                  ///< Point ID index into point_ids
     int active_point_count;                     ///< Number of monitored points
     
+    // Interlocks, rebuilt with the point set
+    alarm_interlock_t* interlocks;              ///< Compiled interlocks (internal RAM)
+    char (*interlock_outputs)[CONFIG_MAX_ID_LENGTH]; ///< Output point ID per interlock (PSRAM)
+    int interlock_count;                        ///< Number of interlocks
+    
+    // Event journal (NULL = not recorded)
+    alarm_journal_t* journal;                   ///< Attached alarm journal
+    
     // Thread safety
-    SemaphoreHandle_t alarm_mutex;              ///< Alarm state mutex
+    SemaphoreHandle_t alarm_mutex;              ///< Alarm state mutex (taken once per evaluated sample)
     
     // Statistics
     uint32_t total_alarm_count;                 ///< Total alarms triggered
-    uint32_t check_cycle_count;                 ///< Number of check cycles
-    uint64_t last_check_time;                   ///< Last check timestamp
-    
-    // Task management
-    TaskHandle_t alarm_task_handle;             ///< Alarm task handle
-    bool alarm_task_running;                    ///< Alarm task status
+    uint32_t notified_count;                    ///< Transitions notified
+    uint32_t rate_limited_count;                ///< Activations cleared before the rate limit allowed them
+    uint32_t shelved_suppressed_count;          ///< Activations cleared while shelved
+    uint32_t grouped_count;                     ///< Activations grouped under a first-out alarm
+    uint32_t check_cycle_count;                 ///< Number of samples evaluated
+    uint64_t last_check_time;                   ///< Timestamp of the last evaluated sample
 } alarm_manager_t;
 
 /**
@@ -84,24 +327,94 @@ typedef struct {
 esp_err_t alarm_manager_init(alarm_manager_t* manager, config_manager_t* config_manager);
 
 /**
- * @brief Start alarm monitoring task
+ * @brief Record activations and clears in an alarm journal
  * 
  * @param manager Pointer to alarm manager structure
- * @param check_interval_ms Alarm check interval in milliseconds
- * @param task_priority Task priority
- * @param task_stack_size Task stack size
+ * @param journal Initialized journal (NULL detaches)
  * @return esp_err_t ESP_OK on success, error code on failure
  */
-esp_err_t alarm_manager_start_monitoring(alarm_manager_t* manager, uint32_t check_interval_ms,
-                                        UBaseType_t task_priority, uint32_t task_stack_size);
+esp_err_t alarm_manager_attach_journal(alarm_manager_t* manager, alarm_journal_t* journal);
+
+/**
+ * @brief Find the ID of a monitored point from its journal key
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param point_key Journal key (point_id_index_hash of the ID)
+ * @param point_id Buffer to store the ID
+ * @param point_id_size Size of the buffer
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if no monitored point has the key
+ */
+esp_err_t alarm_manager_find_point_by_key(alarm_manager_t* manager, uint32_t point_key,
+                                          char* point_id, size_t point_id_size);
+
+/**
+ * @brief Resolve a point ID to an alarm point handle
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param point_id IO point ID
+ * @param handle Pointer to store handle
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the point is not monitored
+ */
+esp_err_t alarm_manager_resolve_point(alarm_manager_t* manager, const char* point_id, alarm_point_handle_t* handle);
+
+/**
+ * @brief Evaluate new samples of a batch of monitored points
+ * 
+ * Pushes every sample into its point's window, then runs each rule as one
+ * loop over the batch, all under a single acquisition of the alarm mutex.
+ * The IO scan calls this once per pass with the analog samples it applied.
+ * Handles in a batch should be distinct.
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param samples Samples to evaluate; active is set for each
+ * @param count Number of samples
+ * @param timestamp Sample timestamp (microseconds)
+ * @param interlock_tripped Pointer to store the tripped interlocks after the batch,
+ *        bit i = interlock i (can be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if a handle is unknown (nothing evaluated),
+ *         ESP_ERR_TIMEOUT if the alarm mutex was busy
+ */
+esp_err_t alarm_manager_process_samples(alarm_manager_t* manager, alarm_sample_t* samples, int count,
+                                        uint64_t timestamp, uint32_t* interlock_tripped);
+
+/**
+ * @brief Evaluate a new sample of a monitored point
+ * 
+ * Batch of one (alarm_manager_process_samples). Cost is independent of
+ * the window length.
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param handle Alarm point handle
+ * @param conditioned_value New conditioned analog value
+ * @param timestamp Sample timestamp (microseconds)
+ * @param any_active Pointer to store whether any alarm of the point is active (can be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for an unknown handle,
+ *         ESP_ERR_TIMEOUT if the alarm mutex was busy
+ */
+esp_err_t alarm_manager_process_sample(alarm_manager_t* manager, alarm_point_handle_t handle, 
+                                       float conditioned_value, uint64_t timestamp, bool* any_active);
 
 /**
- * @brief Stop alarm monitoring task
+ * @brief Update alarm analysis with new analog value by handle
  * 
  * @param manager Pointer to alarm manager structure
+ * @param handle Alarm point handle
+ * @param conditioned_value New conditioned analog value
  * @return esp_err_t ESP_OK on success, error code on failure
  */
-esp_err_t alarm_manager_stop_monitoring(alarm_manager_t* manager);
+esp_err_t alarm_manager_update_value_by_handle(alarm_manager_t* manager, alarm_point_handle_t handle, 
+                                              float conditioned_value);
+
+/**
+ * @brief Check all alarm conditions for a point by handle
+ * 
+ * Re-evaluates the point's latest sample without adding to its window.
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param handle Alarm point handle
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_manager_check_point_by_handle(alarm_manager_t* manager, alarm_point_handle_t handle);
 
 /**
  * @brief Update alarm analysis with new analog value
@@ -156,6 +469,57 @@ esp_err_t alarm_manager_get_all_alarms(alarm_manager_t* manager, const char* poi
  */
 esp_err_t alarm_manager_acknowledge_alarm(alarm_manager_t* manager, const char* point_id, alarm_type_t alarm_type);
 
+/**
+ * @brief Shelve or unshelve alarms of a point
+ * 
+ * While shelved, new activations of the type are not notified; an
+ * activation still active when the shelve ends is notified then. Shelving
+ * hides an already notified alarm from alarm_active, and its clear is
+ * still notified. Shelve changes are journaled.
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param point_id IO point ID
+ * @param alarm_type Alarm type, or ALARM_TYPE_COUNT for every type
+ * @param duration_ms Shelve duration (0 = unshelve, at most ALARM_SHELVE_MAX_MS)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the point is not monitored,
+ *         ESP_ERR_INVALID_ARG for an invalid type or duration
+ */
+esp_err_t alarm_manager_shelve(alarm_manager_t* manager, const char* point_id, alarm_type_t alarm_type,
+                               uint32_t duration_ms);
+
+/**
+ * @brief Get the alarm summary and the points with active or shelved alarms
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param summary Pointer to store the summary
+ * @param points Array to store point summaries (can be NULL)
+ * @param max_points Capacity of points
+ * @param point_count Pointer to store the number of point summaries stored (can be NULL)
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_manager_get_summary(alarm_manager_t* manager, alarm_summary_t* summary,
+                                    alarm_point_summary_t* points, int max_points, int* point_count);
+
+/**
+ * @brief Get the number of compiled interlocks
+ * 
+ * Interlock indices are stable until the next reload.
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @return int Number of interlocks (0 if not initialized)
+ */
+int alarm_manager_get_interlock_count(alarm_manager_t* manager);
+
+/**
+ * @brief Describe an interlock
+ * 
+ * @param manager Pointer to alarm manager structure
+ * @param index Interlock index (bit of the tripped mask)
+ * @param info Pointer to store the description
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for an unknown index
+ */
+esp_err_t alarm_manager_get_interlock(alarm_manager_t* manager, int index, alarm_interlock_info_t* info);
+
 /**
  * @brief Get alarm statistics
  * 
@@ -171,6 +535,11 @@ esp_err_t alarm_manager_get_statistics(alarm_manager_t* manager, uint32_t* total
 /**
  * @brief Reload alarm configuration
  * 
+ * Recompiles the monitored point set from the configuration manager. Points
+ * that stay monitored keep their alarm state, and their window when its
+ * length is unchanged. Handles and interlock indices change;
+ * an attached IO manager resolves them again on its own reload.
+ * 
  * @param manager Pointer to alarm manager structure
  * @return esp_err_t ESP_OK on success, error code on failure
  */
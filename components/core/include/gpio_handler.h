@@ -14,6 +14,12 @@
 #include "esp_err.h"
 #include "driver/gpio.h"
 #include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_continuous.h"
+#include "freertos/FreeRTOS.h"
+#include "soc/soc_caps.h"
+#if SOC_PCNT_SUPPORTED
+#include "driver/pulse_cnt.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +30,115 @@ extern "C" {
  */
 #define GPIO_HANDLER_MAX_PINS 40
 
+/**
+ * @brief Number of ADC1 channels with a sample ring
+ */
+#define GPIO_HANDLER_ADC_CHANNELS 8
+
+/**
+ * @brief Samples kept per channel ring (upper bound for oversampling)
+ */
+#define GPIO_HANDLER_ADC_RING_SIZE 64
+
+/**
+ * @brief Oversampling limits for continuous acquisition
+ */
+#define GPIO_HANDLER_ADC_MIN_OVERSAMPLE 4
+#define GPIO_HANDLER_ADC_MAX_OVERSAMPLE 64
+
+/**
+ * @brief Continuous mode DMA conversion frame size in bytes
+ */
+#define GPIO_HANDLER_ADC_FRAME_SIZE 256
+
+/**
+ * @brief Maximum frames drained per analog read
+ */
+#define GPIO_HANDLER_ADC_MAX_DRAIN_FRAMES 8
+
+/**
+ * @brief Per-channel sample ring for continuous acquisition
+ * 
+ * window_sum always holds the sum of the newest min(count, oversample) samples.
+ */
+typedef struct {
+    uint16_t samples[GPIO_HANDLER_ADC_RING_SIZE]; ///< Raw 12-bit samples
+    uint32_t window_sum;                ///< Sum of the averaging window
+    uint16_t head;                      ///< Next write position
+    uint16_t count;                     ///< Valid samples in the ring
+    uint32_t total_samples;             ///< Samples received since start
+} gpio_adc_ring_t;
+
+/**
+ * @brief Interrupt-driven inputs supported at once
+ */
+#define GPIO_HANDLER_MAX_EDGE_INPUTS 8
+
+/**
+ * @brief Recent accepted edges kept per interrupt-driven input
+ */
+#define GPIO_HANDLER_EDGE_HISTORY 16
+
+/**
+ * @brief PCNT unit count limit (the unit accumulates across it)
+ */
+#define GPIO_HANDLER_PCNT_LIMIT 32000
+
+/**
+ * @brief Longest glitch the PCNT filter can reject (1023 APB cycles)
+ */
+#define GPIO_HANDLER_PCNT_MAX_GLITCH_NS 12000
+
+/**
+ * @brief Accepted (debounced) edge
+ */
+typedef struct {
+    int64_t timestamp_us;               ///< esp_timer time of the edge
+    uint32_t sequence;                  ///< Edge number (1 = first accepted edge)
+    bool level;                         ///< Level after the edge
+} gpio_edge_event_t;
+
+/**
+ * @brief Interrupt-driven input state
+ * 
+ * Written by the GPIO ISR (or gpio_handler_inject_edge) under lock. An
+ * edge is accepted when the level differs from the debounced level and at
+ * least debounce_us has passed since the last accepted edge;
+ * transitions inside that window are counted as rejected. If the line
+ * settles on the other level inside the window, the next read accepts it
+ * once it has been stable for debounce_us.
+ */
+typedef struct {
+    portMUX_TYPE lock;                  ///< Guards the state against the ISR
+    int pin;                            ///< GPIO pin (-1 = slot free)
+    uint32_t debounce_us;               ///< Debounce window
+    bool count_pulses;                  ///< Count rising edges
+    bool level;                         ///< Debounced level
+    bool raw_level;                     ///< Level seen at the last interrupt
+    int64_t last_edge_us;               ///< Time of the last accepted edge
+    int64_t last_raw_us;                ///< Time of the last interrupt
+    uint32_t edge_count;                ///< Accepted edges
+    uint32_t rejected_count;            ///< Transitions rejected as bounce
+    uint32_t pulse_count;               ///< Rising edges counted in software
+    gpio_edge_event_t history[GPIO_HANDLER_EDGE_HISTORY]; ///< Ring of recent accepted edges
+#if SOC_PCNT_SUPPORTED
+    pcnt_unit_handle_t pcnt_unit;       ///< Hardware pulse counter (NULL = software counting)
+    pcnt_channel_handle_t pcnt_channel; ///< Pulse counter channel
+#endif
+} gpio_edge_input_t;
+
+/**
+ * @brief Interrupt-driven input status
+ */
+typedef struct {
+    bool level;                         ///< Debounced level
+    uint32_t edge_count;                ///< Accepted edges
+    uint32_t rejected_count;            ///< Transitions rejected as bounce
+    uint32_t pulse_count;               ///< Rising edges (hardware counter when available)
+    int64_t last_edge_us;               ///< Time of the last accepted edge (0 = none)
+    bool hardware_counter;              ///< Pulses counted by PCNT
+} gpio_edge_status_t;
+
 /**
  * @brief GPIO Handler Structure
  * 
@@ -39,6 +154,19 @@ typedef struct {
     uint32_t write_count;               ///< Number of write operations
     uint32_t error_count;               ///< Number of errors encountered
     adc_oneshot_unit_handle_t adc_handle; ///< ADC unit handle for analog operations
+    
+    // Continuous acquisition
+    bool adc_continuous;                ///< Analog reads served from sample rings
+    adc_continuous_handle_t adc_continuous_handle; ///< Continuous driver handle (NULL when fed synthetically)
+    gpio_adc_ring_t* adc_rings;         ///< Per-channel sample rings (PSRAM)
+    uint8_t* adc_frame_buffer;          ///< Drain buffer for one conversion frame
+    int adc_oversample;                 ///< Samples averaged per reading
+    uint32_t adc_frames_drained;        ///< Conversion frames consumed
+    
+    // Interrupt-driven inputs
+    bool synthetic;                     ///< Owns no hardware (gpio_handler_init_synthetic)
+    gpio_edge_input_t* edge_inputs;     ///< GPIO_HANDLER_MAX_EDGE_INPUTS slots (internal RAM, ISR access)
+    int8_t edge_slots[GPIO_HANDLER_MAX_PINS]; ///< Pin to edge input slot + 1 (0 = none)
 } gpio_handler_t;
 
 /**
@@ -78,6 +206,73 @@ esp_err_t gpio_handler_configure_output(gpio_handler_t* handler, int pin, bool i
  */
 esp_err_t gpio_handler_configure_analog(gpio_handler_t* handler, int pin);
 
+/**
+ * @brief Configure a pin as an interrupt-driven digital input
+ * 
+ * Every edge is timestamped in the GPIO ISR and debounced. With
+ * count_pulses, rising edges are also totalised: by a PCNT unit where one
+ * is free (glitch filter set to min(debounce_us, ~12 us), no interrupts per
+ * pulse), otherwise in the ISR. Reconfiguring a pin replaces its previous
+ * setup.
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param pin GPIO pin number
+ * @param pullup Enable internal pullup resistor
+ * @param debounce_us Debounce window in microseconds
+ * @param count_pulses Count rising edges
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if all edge input slots are used,
+ *         error code on failure
+ */
+esp_err_t gpio_handler_configure_edge_input(gpio_handler_t* handler, int pin, bool pullup, 
+                                            uint32_t debounce_us, bool count_pulses);
+
+/**
+ * @brief Stop interrupt-driven capture on a pin
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param pin GPIO pin number
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the pin is not interrupt-driven
+ */
+esp_err_t gpio_handler_release_edge_input(gpio_handler_t* handler, int pin);
+
+/**
+ * @brief Read an interrupt-driven input
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param pin GPIO pin number
+ * @param status Pointer to store the input status
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the pin is not interrupt-driven
+ */
+esp_err_t gpio_handler_read_edge_input(gpio_handler_t* handler, int pin, gpio_edge_status_t* status);
+
+/**
+ * @brief Copy recent accepted edges of an interrupt-driven input
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param pin GPIO pin number
+ * @param since_sequence Return edges with a sequence above this (0 = all kept)
+ * @param events Buffer for the edges, oldest first
+ * @param max_events Buffer capacity
+ * @param event_count Pointer to store the number of edges copied
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the pin is not interrupt-driven
+ */
+esp_err_t gpio_handler_get_edges(gpio_handler_t* handler, int pin, uint32_t since_sequence,
+                                 gpio_edge_event_t* events, int max_events, int* event_count);
+
+/**
+ * @brief Feed a level change to an interrupt-driven input as if from the ISR
+ * 
+ * Timestamps must not decrease. Used to test debouncing and counting with
+ * synthetic edge trains.
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param pin GPIO pin number
+ * @param level Level after the change
+ * @param timestamp_us Time of the change (esp_timer time base)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the pin is not interrupt-driven
+ */
+esp_err_t gpio_handler_inject_edge(gpio_handler_t* handler, int pin, bool level, int64_t timestamp_us);
+
 /**
  * @brief Read digital pin value
  * 
@@ -101,13 +296,65 @@ esp_err_t gpio_handler_write_digital(gpio_handler_t* handler, int pin, bool valu
 /**
  * @brief Read analog pin value
  * 
+ * In continuous mode, drains pending conversion frames without blocking
+ * and returns the average of the newest adc_oversample samples.
+ * 
  * @param handler Pointer to GPIO handler structure
  * @param pin GPIO pin number
  * @param value Pointer to store raw ADC value (0-4095)
- * @return esp_err_t ESP_OK on success, error code on failure
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if no sample
+ *         has arrived yet in continuous mode, other error code on failure
  */
 esp_err_t gpio_handler_read_analog(gpio_handler_t* handler, int pin, int* value);
 
+/**
+ * @brief Start continuous (DMA) ADC acquisition
+ * 
+ * Samples every configured analog pin round-robin into per-channel rings.
+ * Call after all analog pins are configured; restart to pick up new pins.
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param oversample Samples averaged per reading (4-64)
+ * @param sample_freq_hz Total conversion rate across all channels
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t gpio_handler_start_adc_continuous(gpio_handler_t* handler, int oversample, uint32_t sample_freq_hz);
+
+/**
+ * @brief Stop continuous ADC acquisition and return to one-shot reads
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t gpio_handler_stop_adc_continuous(gpio_handler_t* handler);
+
+/**
+ * @brief Initialize a handler that owns no hardware
+ * 
+ * Analog reads are served from frames pushed with gpio_handler_adc_feed_frame,
+ * so decimation and averaging can be exercised without the ADC. Edge inputs
+ * configured on it take level changes only from gpio_handler_inject_edge.
+ * 
+ * @param handler Pointer to GPIO handler structure
+ * @param analog_pins Bitmask of pins to treat as analog
+ * @param oversample Samples averaged per reading (4-64)
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t gpio_handler_init_synthetic(gpio_handler_t* handler, uint64_t analog_pins, int oversample);
+
+/**
+ * @brief Feed one conversion frame into the sample rings
+ * 
+ * Frame layout matches the continuous driver output on ESP32
+ * (adc_digi_output_data_t, TYPE1 format).
+ * 
+ * @param handler Pointer to GPIO handler structure (continuous mode)
+ * @param frame Conversion results
+ * @param length Frame length in bytes
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t gpio_handler_adc_feed_frame(gpio_handler_t* handler, const uint8_t* frame, uint32_t length);
+
 /**
  * @brief Get pin configuration information
  * 
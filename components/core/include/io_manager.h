@@ -3,7 +3,7 @@
  * @brief IO Manager for SNRv9 Irrigation Control System
  * 
  * Central coordinator for all IO operations including GPIO, shift registers,
- * signal conditioning, and alarm monitoring.
+ * signal conditioning, alarm monitoring and trending.
  */
 
 #ifndef IO_MANAGER_H
@@ -14,9 +14,14 @@
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "esp_timer.h"
 #include "gpio_handler.h"
 #include "shift_register_handler.h"
+#include "signal_conditioner.h"
 #include "config_manager.h"
+#include "point_id_index.h"
+#include "alarm_manager.h"
+#include "trending_manager.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,8 +29,69 @@ extern "C" {
 
 /**
  * @brief Maximum number of IO points supported
+ * 
+ * Bounds handles and output batches only; the point tables are allocated
+ * to the configured point count when the configuration is loaded.
+ */
+#define IO_MANAGER_MAX_POINTS CONFIG_MAX_IO_POINTS
+
+/**
+ * @brief Default polling interval (normal scan class) in milliseconds
+ */
+#define IO_MANAGER_DEFAULT_POLLING_INTERVAL_MS 1000
+
+/**
+ * @brief Time io_manager_stop_polling waits for the polling task to exit, in milliseconds
+ */
+#define IO_MANAGER_POLLING_STOP_TIMEOUT_MS 1000
+
+/**
+ * @brief Scan class mask selecting every class
+ */
+#define IO_MANAGER_ALL_SCAN_CLASSES ((1U << IO_SCAN_CLASS_COUNT) - 1)
+
+/**
+ * @brief Retry delay when the pulse timer finds a mutex busy or a switch-off fails (microseconds)
+ */
+#define IO_MANAGER_PULSE_RETRY_US 200
+
+/**
+ * @brief Snapshot read attempts before a reader gives up
+ */
+#define IO_MANAGER_SNAPSHOT_MAX_RETRIES 8
+
+/**
+ * @brief IO point handle
+ * 
+ * Resolved once from a point ID with io_manager_resolve_handle. Encodes the
+ * point table index and the table generation; handles go stale (and the
+ * *_by_handle functions return ESP_ERR_NOT_FOUND) after a configuration reload.
+ */
+typedef uint32_t io_point_handle_t;
+
+/**
+ * @brief Invalid point handle
+ */
+#define IO_POINT_HANDLE_INVALID ((io_point_handle_t)0xFFFFFFFF)
+
+/**
+ * @brief Words in an output batch point bitmap
+ */
+#define IO_OUTPUT_BATCH_WORDS ((IO_MANAGER_MAX_POINTS + 31) / 32)
+
+/**
+ * @brief Staged output batch
+ * 
+ * Caller-owned. Opened with io_manager_begin_outputs, filled with
+ * io_manager_set_output and applied with io_manager_commit_outputs. Staging
+ * the same point twice keeps the last state.
  */
-#define IO_MANAGER_MAX_POINTS 32
+typedef struct {
+    uint32_t generation;                          ///< Point table generation at begin
+    uint32_t staged[IO_OUTPUT_BATCH_WORDS];       ///< Points with a staged change
+    uint32_t states[IO_OUTPUT_BATCH_WORDS];       ///< Staged logical states
+    int staged_count;                             ///< Number of staged points
+} io_output_batch_t;
 
 /**
  * @brief IO Point Runtime State
@@ -40,21 +106,219 @@ typedef struct {
     uint32_t error_count;               ///< Number of errors
     
     // Signal conditioning state
-    float sma_buffer[32];               ///< SMA filter buffer (increased to match config max)
-    int sma_index;                      ///< Current SMA buffer index
-    int sma_count;                      ///< Number of samples in SMA buffer
-    float sma_sum;                      ///< Running sum for SMA calculation
+    void* filter_state;                 ///< Filter stage state from the manager's filter pool (NULL = none)
     
     // Alarm state
     bool alarm_active;                  ///< Alarm currently active
     uint32_t alarm_count;               ///< Number of alarm activations
     uint64_t alarm_start_time;          ///< Alarm start timestamp
+    bool interlocked;                   ///< Output held by a tripped interlock (writes refused)
+    
+    // Interrupt-driven binary inputs
+    uint32_t edge_count;                ///< Accepted edges (edge and counter modes)
+    uint32_t pulse_count;               ///< Pulse count at the last sample (counter mode)
+    
+    // Change-of-value reporting
+    uint32_t change_sequence;           ///< Global change sequence of the last report (0 = never reported)
+    float reported_value;               ///< Conditioned value at the last report
+    bool reported_digital_state;        ///< Digital state at the last report
+    bool reported_error_state;          ///< Error state at the last report
+    uint32_t reported_edge_count;       ///< Edge count at the last report
+    uint64_t last_report_time;          ///< Timestamp of the last report (microseconds)
+    
+    // Timed output pulses (binary outputs)
+    bool timed_pulse_active;            ///< Pulse switch-off pending
+    uint64_t timed_pulse_start_time;    ///< Time the last pulse switched ON (microseconds)
+    uint64_t timed_pulse_requested_us;  ///< Requested on-time of the last pulse
+    uint64_t timed_pulse_achieved_us;   ///< Measured on-time of the last pulse (0 while active)
 } io_point_runtime_state_t;
 
 /**
- * @brief IO Manager Structure
+ * @brief Timed output pulse result
+ */
+typedef struct {
+    bool active;                        ///< Pulse switch-off pending
+    uint64_t start_time;                ///< Time the output switched ON (microseconds)
+    uint64_t requested_us;              ///< Requested on-time
+    uint64_t achieved_us;               ///< Measured ON-to-OFF time (0 while active)
+} io_pulse_result_t;
+
+/**
+ * @brief Published IO point state
+ * 
+ * Compact reader view of io_point_runtime_state_t, published by the IO
+ * manager after every scan and output change.
+ */
+typedef struct {
+    float raw_value;                    ///< Raw ADC/digital value
+    float conditioned_value;            ///< Signal conditioned value
+    uint64_t last_update_time;          ///< Last update timestamp (microseconds)
+    uint32_t update_count;              ///< Number of updates
+    uint32_t error_count;               ///< Number of errors
+    uint32_t change_sequence;           ///< Global change sequence of the last reported change
+    uint32_t edge_count;                ///< Accepted edges (interrupt-driven binary inputs)
+    bool digital_state;                 ///< Digital state (for binary points)
+    bool error_state;                   ///< Error condition present
+    bool alarm_active;                  ///< Alarm currently active
+} io_point_snapshot_t;
+
+/**
+ * @brief Reported point change
+ */
+typedef struct {
+    io_point_handle_t handle;           ///< Point handle
+    io_point_snapshot_t point;          ///< Point state at the change
+} io_point_change_t;
+
+/**
+ * @brief Snapshot buffer
+ * 
+ * sequence is odd while the writer fills the buffer.
+ */
+typedef struct {
+    uint32_t sequence;                                  ///< Buffer write sequence
+    uint32_t publish_count;                             ///< Publish number of this content
+    uint32_t change_sequence;                           ///< Latest global change sequence in this content
+    uint16_t generation;                                ///< Point table generation of this content
+    int point_count;                                    ///< Number of valid points
+    io_point_snapshot_t* points;                        ///< Point states, indexed like point_ids (PSRAM)
+} io_snapshot_buffer_t;
+
+/**
+ * @brief Buckets per timing histogram
+ * 
+ * Bucket 0 counts 0 us, bucket k counts [2^(k-1), 2^k) us, and the last
+ * bucket also takes everything longer (from ~0.5 s up).
+ */
+#define IO_TIMING_BUCKETS 20
+
+/**
+ * @brief Scan timing metrics
+ */
+typedef enum {
+    IO_TIMING_WAKE_JITTER = 0,          ///< |actual - intended| interval between starts of a scan class
+    IO_TIMING_SHIFT_REGISTER,           ///< Shift register input chain read
+    IO_TIMING_INPUT_READS,              ///< ADC and GPIO input reads of the due classes
+    IO_TIMING_CONDITIONING,             ///< Applying samples: conditioning, filters, COV, alarms and trends
+    IO_TIMING_MUTEX_WAIT,               ///< Waiting for the scan and state mutexes
+    IO_TIMING_SCAN_CYCLE,               ///< Whole scan pass
+    IO_TIMING_INTERLOCK_LATENCY,        ///< Start of the scan pass that tripped an interlock to its output write
+    IO_TIMING_METRIC_COUNT
+} io_timing_metric_t;
+
+/**
+ * @brief Log2-bucket timing histogram (microseconds)
+ */
+typedef struct {
+    uint32_t buckets[IO_TIMING_BUCKETS];    ///< Sample counts per bucket
+    uint32_t count;                         ///< Samples recorded
+    uint32_t max_us;                        ///< Largest sample
+    uint64_t total_us;                      ///< Sum of samples (for the mean)
+} io_timing_histogram_t;
+
+/**
+ * @brief Scan timing instrumentation
+ */
+typedef struct {
+    io_timing_histogram_t histograms[IO_TIMING_METRIC_COUNT];  ///< Histogram per io_timing_metric_t
+    uint32_t deadline_misses;                                  ///< Scan slots skipped because a pass overran
+} io_scan_timing_t;
+
+struct io_manager;
+
+/**
+ * @brief Per-type point read function
+ * 
+ * Acquires one raw sample from hardware: ADC counts for analog inputs,
+ * 0 or 1 for polled binary inputs, (accepted edge count << 1) | debounced
+ * level for edge-mode inputs, and the running pulse count for counter-mode
+ * inputs. Runs without state_mutex held.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param point_index Index into the compiled point table
+ * @param raw Pointer to store raw sample
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+typedef esp_err_t (*io_point_read_fn_t)(struct io_manager* manager, int point_index, int32_t* raw);
+
+/**
+ * @brief Chip index of a shift register point whose chip or bit lies outside the chain
+ */
+#define IO_CHIP_INDEX_UNMAPPED 0xFF
+
+/**
+ * @brief Compiled IO point descriptor
+ * 
+ * Hot-path view of an io_point_config_t, built once when points are configured.
+ * The polling loop reads only this table; names, descriptions and calibration
+ * notes stay in the configuration.
+ */
+typedef struct {
+    io_point_read_fn_t read;            ///< Input read function (NULL for outputs)
+    signal_pipeline_t pipeline;         ///< Compiled signal conditioning (AI only)
+    float range_min;                    ///< Engineering range minimum (AI only)
+    float range_scale;                  ///< Engineering units per ADC count (AI only)
+    int16_t pin;                        ///< GPIO pin number (GPIO types)
+    int16_t alarm_handle;               ///< Alarm point handle of the attached alarm manager (-1 = not monitored)
+    int16_t trend_handle;               ///< Trend handle of the attached trending manager (-1 = not trended)
+    uint8_t type;                       ///< io_point_type_t
+    uint8_t scan_class;                 ///< io_scan_class_t
+    uint8_t chip_index;                 ///< Chip index (shift register types, IO_CHIP_INDEX_UNMAPPED if invalid)
+    uint8_t bit_index;                  ///< Bit index (shift register types)
+    bool is_inverted;                   ///< Invert logic
+    uint8_t input_mode;                 ///< io_input_mode_t (GPIO BI only)
+    float units_per_pulse;              ///< 1 / pulses_per_unit (counter mode)
+    float rate_time_base_s;             ///< Rate time base in seconds (counter mode)
+    float deadband;                     ///< Change-of-value deadband (AI and counter mode)
+    uint32_t cov_heartbeat_us;          ///< Unchanged-value report interval (0 = never)
+} io_point_descriptor_t;
+
+/**
+ * @brief One acquired input sample awaiting conditioning
+ */
+typedef struct {
+    uint16_t point_index;               ///< Point table index
+    esp_err_t result;                   ///< Read result
+    int32_t raw;                        ///< Raw sample
+} io_scan_sample_t;
+
+/**
+ * @brief Pending output switch-off
+ */
+typedef struct {
+    uint64_t deadline;                  ///< Switch-off time (esp_timer microseconds)
+    uint64_t start_time;                ///< Time the output switched ON
+    uint16_t point_index;               ///< Point table index
+    uint16_t retries;                   ///< Failed switch-off attempts
+} io_pulse_deadline_t;
+
+/**
+ * @brief Interlock of the attached alarm manager, resolved to an output
  */
 typedef struct {
+    int16_t output_index;               ///< Point table index of the forced output (-1 = unresolved)
+    bool forced_state;                  ///< Output state while tripped
+} io_interlock_t;
+
+/**
+ * @brief Interlock statistics
+ */
+typedef struct {
+    uint32_t trip_count;                ///< Outputs forced by a newly tripped interlock
+    uint32_t forced_outputs;            ///< Outputs currently held
+    uint32_t last_latency_us;           ///< Scan pass start to output write of the last trip
+    uint32_t worst_latency_us;          ///< Largest trip latency seen
+} io_interlock_stats_t;
+
+/**
+ * @brief IO Manager Structure
+ * 
+ * Per-point tables are sized to the configured point count. Tables the scan
+ * touches every cycle (point_table, runtime_states, scan_lists,
+ * scan_samples, alarm_samples, trend_samples, trend_outputs) live in internal RAM; point IDs, the reader snapshot and
+ * the point configurations live in PSRAM.
+ */
+typedef struct io_manager {
     bool initialized;                                           ///< Initialization status
     
     // Hardware handlers
@@ -63,24 +327,74 @@ typedef struct {
     
     // Configuration
     config_manager_t* config_manager;                          ///< Configuration manager
-    io_config_t current_config;                                ///< Current IO configuration
+    io_config_t current_config;                                ///< Current IO configuration (points in PSRAM)
+    io_point_descriptor_t* point_table;                        ///< Compiled hot-path point table
+    
+    // Scan scheduling
+    uint16_t* scan_lists[IO_SCAN_CLASS_COUNT];                 ///< Input point indices per scan class
+    uint16_t scan_list_counts[IO_SCAN_CLASS_COUNT];            ///< Number of inputs per scan class
+    bool scan_class_reads_shift_register[IO_SCAN_CLASS_COUNT]; ///< Scan class contains shift register inputs
+    uint32_t scan_interval_ms[IO_SCAN_CLASS_COUNT];            ///< Scan class intervals
+    uint32_t scan_class_cycle_counts[IO_SCAN_CLASS_COUNT];     ///< Scans completed per class
     
     // Runtime state
-    io_point_runtime_state_t runtime_states[IO_MANAGER_MAX_POINTS]; ///< Runtime states
+    io_point_runtime_state_t* runtime_states;                  ///< Runtime states
+    io_scan_sample_t* scan_samples;                            ///< Samples of one scan pass
+    alarm_sample_t* alarm_samples;                             ///< Alarm stage batch of one scan pass
+    trending_sample_t* trend_samples;                          ///< Trend stage batch of one scan pass
+    io_pulse_deadline_t* pulse_heap;                           ///< Pending switch-offs, min-heap by deadline
+    int pulse_heap_count;                                      ///< Pending switch-offs
+    signal_filter_pool_t filter_pool;                          ///< Per-point filter state, sized per compiled filter
     int active_point_count;                                    ///< Number of active points
-    char point_ids[IO_MANAGER_MAX_POINTS][CONFIG_MAX_ID_LENGTH]; ///< Point ID mapping
+    int point_capacity;                                        ///< Points the per-point tables hold
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH];                   ///< Point ID mapping
+    point_id_index_t id_index;                                 ///< Point ID index into point_ids
+    uint16_t point_generation;                                 ///< Point table generation (for handles)
+    
+    // Published snapshot
+    io_snapshot_buffer_t snapshot_buffers[2];                  ///< Double-buffered reader snapshot
+    uint32_t snapshot_front;                                   ///< Index of the published buffer
+    uint32_t snapshot_publish_count;                           ///< Number of snapshots published
+    uint32_t change_sequence;                                  ///< Global change sequence (monotonic, survives reloads)
+    
+    // Table storage
+    void* hot_storage;                                         ///< Internal RAM block of the scan tables
+    void* cold_storage;                                        ///< PSRAM block of point IDs and snapshot points
+    void* retired_storage[2];                                  ///< Blocks replaced by the last resize
     
     // Thread safety
-    SemaphoreHandle_t state_mutex;                             ///< State access mutex
+    SemaphoreHandle_t state_mutex;                             ///< Runtime state and publish mutex
+    SemaphoreHandle_t scan_mutex;                              ///< Serializes input hardware scans
+    SemaphoreHandle_t pulse_mutex;                             ///< Pulse heap mutex (taken before state_mutex)
+    
+    // Timed outputs
+    esp_timer_handle_t pulse_timer;                            ///< One-shot timer armed for the earliest deadline
+    uint32_t pulse_completed_count;                            ///< Pulses switched off by the timer
+    int64_t pulse_worst_error_us;                              ///< Largest |achieved - requested| on-time seen
     
     // Statistics
-    uint32_t update_cycle_count;                               ///< Number of update cycles
+    uint32_t update_cycle_count;                               ///< Number of scheduler passes
     uint32_t total_error_count;                                ///< Total error count
     uint64_t last_update_time;                                 ///< Last update timestamp
+    io_scan_timing_t timing;                                   ///< Scan timing histograms (written under scan_mutex)
+    
+    // Pipeline stages
+    alarm_manager_t* alarm_manager;                            ///< Alarm evaluation stage (NULL = none)
+    io_interlock_t interlocks[ALARM_MAX_INTERLOCKS];           ///< Alarm manager interlocks by index
+    int interlock_count;                                       ///< Number of interlocks
+    uint32_t interlock_tripped;                                ///< Interlocks tripped after the last alarm stage
+    io_interlock_stats_t interlock_stats;                      ///< Interlock statistics (written under state_mutex)
+    trending_manager_t* trending_manager;                      ///< Trend recording stage (NULL = none)
+    uint16_t* trend_outputs;                                   ///< Trended binary outputs, recorded every pass
+    int trend_output_count;                                    ///< Number of trended binary outputs
     
     // Task management
     TaskHandle_t polling_task_handle;                          ///< Polling task handle
     bool polling_task_running;                                 ///< Polling task status
+    SemaphoreHandle_t polling_task_exited;                     ///< Given by the polling task when it exits
+    uint32_t polling_interval_ms;                              ///< Normal scan class interval
+    UBaseType_t polling_task_priority;                         ///< Polling task priority
+    uint32_t polling_task_stack_size;                          ///< Polling task stack size
 } io_manager_t;
 
 /**
@@ -95,8 +409,12 @@ esp_err_t io_manager_init(io_manager_t* manager, config_manager_t* config_manage
 /**
  * @brief Start IO polling task
  * 
+ * The task schedules each scan class by deadline: the normal class runs at
+ * polling_interval_ms, the fast and slow classes at the intervals from the
+ * scan class configuration.
+ * 
  * @param manager Pointer to IO manager structure
- * @param polling_interval_ms Polling interval in milliseconds
+ * @param polling_interval_ms Polling interval in milliseconds (normal scan class)
  * @param task_priority Task priority
  * @param task_stack_size Task stack size
  * @return esp_err_t ESP_OK on success, error code on failure
@@ -107,19 +425,34 @@ esp_err_t io_manager_start_polling(io_manager_t* manager, uint32_t polling_inter
 /**
  * @brief Stop IO polling task
  * 
+ * Wakes the task and waits until it has left its scan loop.
+ * 
  * @param manager Pointer to IO manager structure
- * @return esp_err_t ESP_OK on success, error code on failure
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if the task did not
+ *         exit within IO_MANAGER_POLLING_STOP_TIMEOUT_MS
  */
 esp_err_t io_manager_stop_polling(io_manager_t* manager);
 
 /**
  * @brief Update all input points (manual update)
  * 
+ * Runs one full scan cycle over the compiled point table.
+ * 
  * @param manager Pointer to IO manager structure
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t io_manager_update_inputs(io_manager_t* manager);
 
+/**
+ * @brief Resolve a point ID to a handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param point_id IO point ID
+ * @param handle Pointer to store point handle (IO_POINT_HANDLE_INVALID if not found)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the ID is unknown
+ */
+esp_err_t io_manager_resolve_handle(io_manager_t* manager, const char* point_id, io_point_handle_t* handle);
+
 /**
  * @brief Set binary output state
  * 
@@ -130,6 +463,17 @@ esp_err_t io_manager_update_inputs(io_manager_t* manager);
  */
 esp_err_t io_manager_set_binary_output(io_manager_t* manager, const char* point_id, bool state);
 
+/**
+ * @brief Set binary output state by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param state Desired state (true = ON, false = OFF)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if an interlock holds
+ *         the output, error code on failure
+ */
+esp_err_t io_manager_set_binary_output_by_handle(io_manager_t* manager, io_point_handle_t handle, bool state);
+
 /**
  * @brief Get binary output state
  * 
@@ -140,6 +484,140 @@ esp_err_t io_manager_set_binary_output(io_manager_t* manager, const char* point_
  */
 esp_err_t io_manager_get_binary_output(io_manager_t* manager, const char* point_id, bool* state);
 
+/**
+ * @brief Get binary output state by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param state Pointer to store current state
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_binary_output_by_handle(io_manager_t* manager, io_point_handle_t handle, bool* state);
+
+/**
+ * @brief Switch a binary output ON for a fixed time
+ * 
+ * The output switches ON immediately and a one-shot esp_timer switches it
+ * OFF at the deadline, so the on-time does not depend on the caller, the
+ * polling task or web load. Pending deadlines are kept in a min-heap; the
+ * timer is always armed for the earliest. Pulsing an output that is already
+ * pulsing restarts its on-time. Any other write to the output (set or batch
+ * commit) cancels the pending switch-off and wins. A reload keeps the
+ * pulses of outputs it keeps and drops those of outputs it releases.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle (must be a binary output)
+ * @param duration_us On-time in microseconds
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for a stale or unknown
+ *         handle, ESP_ERR_INVALID_ARG if the point is not a binary output or the
+ *         duration is 0, ESP_ERR_INVALID_STATE if an interlock holds the output,
+ *         error code on failure
+ */
+esp_err_t io_manager_pulse_output_by_handle(io_manager_t* manager, io_point_handle_t handle, uint64_t duration_us);
+
+/**
+ * @brief Switch a binary output ON for a fixed time
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param point_id IO point ID
+ * @param duration_us On-time in microseconds
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_pulse_output(io_manager_t* manager, const char* point_id, uint64_t duration_us);
+
+/**
+ * @brief Deliver a volume through a binary output
+ * 
+ * Pulses the output for volume_ml / flow_rate_ml_per_second of the point.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle (must be a binary output)
+ * @param volume_ml Volume in mL
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if the point has no
+ *         flow rate configured, error code on failure
+ */
+esp_err_t io_manager_dose_volume_by_handle(io_manager_t* manager, io_point_handle_t handle, float volume_ml);
+
+/**
+ * @brief Deliver a volume through a binary output
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param point_id IO point ID
+ * @param volume_ml Volume in mL
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_dose_volume(io_manager_t* manager, const char* point_id, float volume_ml);
+
+/**
+ * @brief Get the requested and achieved on-time of an output's last pulse
+ * 
+ * The achieved time runs from the completed ON write to the completed OFF
+ * write (or to the cancelling write).
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle (must be a binary output)
+ * @param result Pointer to store the result
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for a stale or unknown
+ *         handle, ESP_ERR_TIMEOUT if the state mutex was busy
+ */
+esp_err_t io_manager_get_pulse_result_by_handle(io_manager_t* manager, io_point_handle_t handle, 
+                                                io_pulse_result_t* result);
+
+/**
+ * @brief Open an output batch
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param batch Pointer to caller-owned batch to initialize
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_begin_outputs(io_manager_t* manager, io_output_batch_t* batch);
+
+/**
+ * @brief Stage a binary output change in a batch
+ * 
+ * Nothing reaches hardware until io_manager_commit_outputs.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param batch Pointer to open batch
+ * @param handle Point handle (must be a binary output)
+ * @param state Desired state (true = ON, false = OFF)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for a stale or unknown
+ *         handle, ESP_ERR_INVALID_ARG if the point is not a binary output,
+ *         ESP_ERR_INVALID_STATE if an interlock holds the output
+ */
+esp_err_t io_manager_set_output(io_manager_t* manager, io_output_batch_t* batch, io_point_handle_t handle, bool state);
+
+/**
+ * @brief Check whether a batch stages an output
+ * 
+ * After io_manager_commit_outputs refused part of a batch, tells the
+ * applied outputs (still staged) from the refused ones.
+ * 
+ * @param batch Pointer to batch
+ * @param handle Point handle the output was staged with
+ * @return true if the output is staged, false otherwise
+ */
+bool io_manager_output_staged(const io_output_batch_t* batch, io_point_handle_t handle);
+
+/**
+ * @brief Apply all staged output changes
+ * 
+ * Shift register outputs are merged into the chain image and latched in a
+ * single write, so they all switch on the same latch edge. Direct GPIO
+ * outputs are written immediately after the latch. The batch is emptied on
+ * success. Outputs held by an interlock, or mapped outside the shift
+ * register chain, are dropped from the batch and the rest is applied; the
+ * batch then keeps only the applied outputs staged.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param batch Pointer to open batch
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if the
+ *         configuration was reloaded since the batch was opened or an interlock
+ *         held a staged output, ESP_ERR_INVALID_ARG if a staged output is
+ *         outside the chain, error code on failure
+ */
+esp_err_t io_manager_commit_outputs(io_manager_t* manager, io_output_batch_t* batch);
+
 /**
  * @brief Get binary input state
  * 
@@ -150,6 +628,16 @@ esp_err_t io_manager_get_binary_output(io_manager_t* manager, const char* point_
  */
 esp_err_t io_manager_get_binary_input(io_manager_t* manager, const char* point_id, bool* state);
 
+/**
+ * @brief Get binary input state by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param state Pointer to store current state
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_binary_input_by_handle(io_manager_t* manager, io_point_handle_t handle, bool* state);
+
 /**
  * @brief Get analog input raw value
  * 
@@ -160,6 +648,16 @@ esp_err_t io_manager_get_binary_input(io_manager_t* manager, const char* point_i
  */
 esp_err_t io_manager_get_analog_raw(io_manager_t* manager, const char* point_id, float* value);
 
+/**
+ * @brief Get analog input raw value by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param value Pointer to store raw value
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_analog_raw_by_handle(io_manager_t* manager, io_point_handle_t handle, float* value);
+
 /**
  * @brief Get analog input conditioned value
  * 
@@ -170,6 +668,16 @@ esp_err_t io_manager_get_analog_raw(io_manager_t* manager, const char* point_id,
  */
 esp_err_t io_manager_get_analog_conditioned(io_manager_t* manager, const char* point_id, float* value);
 
+/**
+ * @brief Get analog input conditioned value by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param value Pointer to store conditioned value
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_analog_conditioned_by_handle(io_manager_t* manager, io_point_handle_t handle, float* value);
+
 /**
  * @brief Get IO point runtime state
  * 
@@ -180,6 +688,17 @@ esp_err_t io_manager_get_analog_conditioned(io_manager_t* manager, const char* p
  */
 esp_err_t io_manager_get_runtime_state(io_manager_t* manager, const char* point_id, io_point_runtime_state_t* state);
 
+/**
+ * @brief Get IO point runtime state by handle
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle
+ * @param state Pointer to store runtime state
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_runtime_state_by_handle(io_manager_t* manager, io_point_handle_t handle, 
+                                              io_point_runtime_state_t* state);
+
 /**
  * @brief Get all active IO point IDs
  * 
@@ -192,14 +711,147 @@ esp_err_t io_manager_get_runtime_state(io_manager_t* manager, const char* point_
 esp_err_t io_manager_get_all_point_ids(io_manager_t* manager, char point_ids[][CONFIG_MAX_ID_LENGTH], 
                                       int max_points, int* actual_count);
 
+/**
+ * @brief Get a consistent snapshot of all IO point states
+ * 
+ * Wait-free for readers: copies the last published buffer without taking
+ * any lock. Entries are indexed like io_manager_get_all_point_ids.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param points Array to store point states
+ * @param max_points Maximum number of points to return
+ * @param actual_count Pointer to store actual number of points returned
+ * @param sequence Pointer to store snapshot publish number (can be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if the writer kept
+ *         overwriting the buffer for IO_MANAGER_SNAPSHOT_MAX_RETRIES attempts
+ */
+esp_err_t io_manager_get_snapshot(io_manager_t* manager, io_point_snapshot_t* points, 
+                                 int max_points, int* actual_count, uint32_t* sequence);
+
+/**
+ * @brief Get the points that changed since a change sequence number
+ * 
+ * Report-by-exception view of the published snapshot, wait-free like
+ * io_manager_get_snapshot. A point reports a change when its conditioned
+ * value moves beyond its deadband, its digital or error state flips, or its
+ * COV heartbeat expires. Start with since = 0 and pass the returned latest
+ * value on the next call.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param since Last change sequence already processed
+ * @param changes Array to store changed points
+ * @param max_changes Capacity of @p changes (the active point count never truncates)
+ * @param change_count Pointer to store number of changed points returned
+ * @param latest Pointer to store the sequence to pass next time; when the
+ *        result was truncated it is set so skipped points are returned next
+ *        (some returned points may repeat)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if the writer kept
+ *         overwriting the buffer for IO_MANAGER_SNAPSHOT_MAX_RETRIES attempts
+ */
+esp_err_t io_manager_get_changes_since(io_manager_t* manager, uint32_t since, io_point_change_t* changes,
+                                      int max_changes, int* change_count, uint32_t* latest);
+
+/**
+ * @brief Get recent edges of an interrupt-driven binary input
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param handle Point handle (GPIO BI in edge or counter mode)
+ * @param since_sequence Return edges with a sequence above this (0 = all kept)
+ * @param events Buffer for the edges, oldest first, with microsecond timestamps
+ * @param max_events Buffer capacity
+ * @param event_count Pointer to store the number of edges copied
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for a stale handle or a
+ *         point without interrupt-driven capture
+ */
+esp_err_t io_manager_get_input_edges(io_manager_t* manager, io_point_handle_t handle, uint32_t since_sequence,
+                                     gpio_edge_event_t* events, int max_events, int* event_count);
+
+/**
+ * @brief Compile an IO point configuration into a hot-path descriptor
+ * 
+ * The descriptor references config->signal_config, so config must outlive it.
+ * 
+ * @param config IO point configuration
+ * @param descriptor Pointer to store compiled descriptor
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_compile_point(const io_point_config_t* config, io_point_descriptor_t* descriptor);
+
+/**
+ * @brief Scan the input points of the selected scan classes
+ * 
+ * Reads the shift register inputs only when a selected class contains
+ * shift register inputs.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param class_mask Bit mask of io_scan_class_t values (IO_MANAGER_ALL_SCAN_CLASSES for all)
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_scan_classes(io_manager_t* manager, uint32_t class_mask);
+
 /**
  * @brief Reload configuration
  * 
+ * Diffs the new point list against the current one by point ID. Points
+ * whose type and hardware mapping are unchanged keep their values,
+ * counters, alarm state, filter state and output level and are not
+ * reconfigured, so an output that stays ON is never pulsed. New or
+ * remapped points are configured in their safe state, and outputs that
+ * no point drives any more are switched OFF. Continuous ADC restarts only
+ * when the analog channel set or ADC settings change. Handles stay valid
+ * unless an existing index now holds a different point (e.g. a point was
+ * inserted or removed before it).
+ * 
+ * Polling restarts with the interval, priority and stack size it was started with.
+ * Attached alarm and trending managers are reloaded first and their handles
+ * resolved again.
+ * Scans are blocked for the whole reload and readers and output writes
+ * wait while the point table is replaced.
+ * 
  * @param manager Pointer to IO manager structure
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t io_manager_reload_config(io_manager_t* manager);
 
+/**
+ * @brief Attach an alarm manager as a scan pipeline stage
+ * 
+ * The new samples of monitored analog inputs are evaluated as one batch
+ * right after a scan pass is conditioned, in the scan that read them, and the point's alarm_active,
+ * alarm_count and alarm_start_time follow the result. Waits for a running
+ * scan to finish.
+ * 
+ * The alarm manager's interlocks are resolved to binary outputs. In the
+ * same pass, every output of a tripped interlock is driven to its forced
+ * state (the lowest tripped interlock wins if several name it), shift
+ * register outputs with one latch of the chain. While held, writes to the
+ * output (set, pulse, pulse switch-off and batch commit) fail with
+ * ESP_ERR_INVALID_STATE. When no interlock holds it any more the output
+ * is released and keeps the forced state until written. The time from the
+ * start of the tripping pass to the output write is recorded as
+ * IO_TIMING_INTERLOCK_LATENCY. Interlocks are released on reload and
+ * attach, and re-applied by the next pass that evaluates their points.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param alarm_manager Initialized alarm manager on the same configuration (NULL to detach)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if a scan held the scan mutex
+ */
+esp_err_t io_manager_attach_alarm_manager(io_manager_t* manager, alarm_manager_t* alarm_manager);
+
+/**
+ * @brief Attach a trending manager as a scan pipeline stage
+ * 
+ * After the alarm stage of every scan pass, the new samples of trended
+ * inputs and the states of trended binary outputs are recorded as one
+ * batch, stamped with the wall-clock time of the pass. Output changes are
+ * therefore recorded at scan resolution. Waits for a running scan to finish.
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param trending_manager Initialized trending manager on the same configuration (NULL to detach)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if a scan held the scan mutex
+ */
+esp_err_t io_manager_attach_trending_manager(io_manager_t* manager, trending_manager_t* trending_manager);
+
 /**
  * @brief Get IO manager statistics
  * 
@@ -207,10 +859,39 @@ esp_err_t io_manager_reload_config(io_manager_t* manager);
  * @param update_cycles Pointer to store update cycle count (can be NULL)
  * @param total_errors Pointer to store total error count (can be NULL)
  * @param last_update_time Pointer to store last update time (can be NULL)
+ * @param timing Pointer to store scan timing histograms (can be NULL)
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t io_manager_get_statistics(io_manager_t* manager, uint32_t* update_cycles, 
-                                   uint32_t* total_errors, uint64_t* last_update_time);
+                                   uint32_t* total_errors, uint64_t* last_update_time,
+                                   io_scan_timing_t* timing);
+
+/**
+ * @brief Get interlock statistics
+ * 
+ * @param manager Pointer to IO manager structure
+ * @param stats Pointer to store the statistics
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_manager_get_interlock_stats(io_manager_t* manager, io_interlock_stats_t* stats);
+
+/**
+ * @brief Clear the scan timing histograms
+ * 
+ * @param manager Pointer to IO manager structure
+ * @return esp_err_t ESP_OK on success, ESP_ERR_TIMEOUT if a scan held the scan mutex too long
+ */
+esp_err_t io_manager_reset_timing(io_manager_t* manager);
+
+/**
+ * @brief Estimate a percentile from a timing histogram
+ * 
+ * @param histogram Timing histogram
+ * @param percentile Percentile (0-100)
+ * @return uint32_t Upper bound in microseconds of the bucket holding the
+ *         percentile (capped at max_us), 0 if the histogram is empty
+ */
+uint32_t io_manager_timing_percentile(const io_timing_histogram_t* histogram, float percentile);
 
 /**
  * @brief Destroy IO manager and cleanup resources
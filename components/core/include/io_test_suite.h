@@ -0,0 +1,325 @@
+/**
+ * @file io_test_suite.h
+ * @brief IO system benchmark and self-test suite for SNRv9 Irrigation Control System
+ * 
+ * This header provides on-target benchmarks and self-tests for the IO scan
+ * path. Tests run against the live IO manager and synthetic configurations
+ * and never drive outputs.
+ */
+
+#ifndef IO_TEST_SUITE_H
+#define IO_TEST_SUITE_H
+
+#include <stdbool.h>
+#include "io_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * PUBLIC FUNCTION DECLARATIONS
+ * =============================================================================
+ */
+
+/**
+ * @brief Benchmark per-cycle point access at 32 points
+ * 
+ * Compares the legacy scan pattern (two config_manager_get_io_point_config
+ * copies per point per cycle) against the compiled point table, then times
+ * a full live scan cycle including hardware reads.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if the compiled table is faster, false otherwise
+ */
+bool io_test_suite_benchmark_point_table(io_manager_t* manager);
+
+/**
+ * @brief Benchmark scan work from 32 to 256 points
+ * 
+ * Times the per-point scan work (scaling, conditioning, deadband and state
+ * update) over a compiled table for each point count, with runtime states
+ * in internal RAM and, for comparison, in PSRAM.
+ * 
+ * @param manager Pointer to initialized IO manager (source of the cloned points)
+ * @return true if the per-point cost stays within 1.5x of the 32-point cost, false otherwise
+ */
+bool io_test_suite_benchmark_scaling(io_manager_t* manager);
+
+/**
+ * @brief Verify and benchmark point ID lookup
+ * 
+ * Checks that every ID in a 32-point synthetic configuration resolves through
+ * the hashed ID index, times it against a linear strcmp scan, and checks that
+ * every live point resolves to a handle for its own table index.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if all lookups resolve correctly, false otherwise
+ */
+bool io_test_suite_benchmark_id_lookup(io_manager_t* manager);
+
+/**
+ * @brief Verify and benchmark the compiled signal conditioning pipeline
+ * 
+ * Checks the compiled pipeline against a stage-by-stage reference evaluation
+ * and reports per-sample cost for pass-through, scale + round and
+ * scale + SMA + round pipelines.
+ * 
+ * @return true if compiled and reference results agree, false otherwise
+ */
+bool io_test_suite_benchmark_conditioning(void);
+
+/**
+ * @brief Verify and benchmark lookup table interpolation
+ * 
+ * Checks binary-search interpolation over a full-size non-uniform table
+ * against a linear segment scan, including clamping at both ends, and
+ * reports per-lookup cost of each.
+ * 
+ * @return true if all interpolations agree, false otherwise
+ */
+bool io_test_suite_lookup_table(void);
+
+/**
+ * @brief Benchmark the configuration load paths
+ * 
+ * Loads the live configuration file into a temporary config manager via
+ * the cJSON DOM, the streaming parser and the binary cache, reporting load
+ * time and peak heap use of each, and checks every path produces the
+ * same configuration as the one currently loaded.
+ * 
+ * @param manager IO manager (source of the live configuration)
+ * @return true if every available path loads an identical configuration
+ */
+bool io_test_suite_benchmark_config_load(io_manager_t* manager);
+
+/**
+ * @brief Verify the EMA, median, Hampel and biquad filter stages
+ * 
+ * Feeds each filter a step preceded by a single spike and checks that it
+ * settles on the step and, for median and Hampel, that the spike is
+ * rejected. Also checks that unstable biquad coefficients are refused and
+ * reports the size of the live filter state pool.
+ * 
+ * @param manager Pointer to initialized IO manager (pool report only, may be NULL)
+ * @return true if all filters behave as expected, false otherwise
+ */
+bool io_test_suite_filters(io_manager_t* manager);
+
+/**
+ * @brief Verify continuous-mode ADC decimation and averaging
+ * 
+ * Feeds synthetic conversion frames into a handler that owns no hardware and
+ * checks noise averaging, pass-through, step response and empty channels.
+ * 
+ * @return true if all averaged values match, false otherwise
+ */
+bool io_test_suite_adc_oversampling(void);
+
+/**
+ * @brief Verify debouncing, edge history and pulse counting of interrupt-driven inputs
+ * 
+ * Injects timestamped edge trains into a handler that owns no hardware and
+ * checks bounce rejection, settling of a level held inside the debounce
+ * window, edge timestamps and sequence numbers, history wrap and pulse counts.
+ * 
+ * @return true if all counts and timestamps match, false otherwise
+ */
+bool io_test_suite_edge_inputs(void);
+
+/**
+ * @brief Benchmark shift register cycles at 1, 8 and 32 chips
+ * 
+ * Times the live chain on its active backend (re-latching the current output
+ * image) and a detached SPI chain with no pins attached.
+ * 
+ * @param manager Pointer to initialized IO manager (may be NULL to skip the live chain)
+ * @return true if every timed run completed
+ */
+bool io_test_suite_benchmark_shift_register(io_manager_t* manager);
+
+/**
+ * @brief Verify wait-free snapshot reads
+ * 
+ * Reads the published snapshot repeatedly while manual scans publish new
+ * buffers, checking point count and sequence monotonicity and reporting the
+ * worst-case read time.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if every read returned a consistent snapshot, false otherwise
+ */
+bool io_test_suite_snapshot(io_manager_t* manager);
+
+/**
+ * @brief Verify report-by-exception change sequencing
+ * 
+ * Runs manual scans and checks that io_manager_get_changes_since returns
+ * only changes inside the requested sequence window, then reports how many
+ * point updates were actually passed on.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if sequencing is consistent, false otherwise
+ */
+bool io_test_suite_change_reporting(io_manager_t* manager);
+
+/**
+ * @brief Verify that reloading an unchanged configuration resets nothing
+ * 
+ * Reloads the live configuration and checks that handles, counters,
+ * output levels and change sequences survive, reporting the reload time.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if every point kept its state, false otherwise
+ */
+bool io_test_suite_reload(io_manager_t* manager);
+
+/**
+ * @brief Verify that output batches commit atomically
+ * 
+ * Stages up to 4 shift register outputs at their current levels and checks
+ * that the commit takes a single latch, that an output held by an interlock
+ * is dropped from the batch and reported while the rest still applies, and
+ * that a batch from an older point generation is rejected without a write.
+ * Passes with fewer than 2 free shift register outputs.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if every commit behaves, false otherwise
+ */
+bool io_test_suite_output_batch(io_manager_t* manager);
+
+/**
+ * @brief Verify timed output pulses on the first configured binary output
+ * 
+ * Pulses the output for 20, 50 and 100 ms while the calling task spins,
+ * checks each achieved on-time against the request, then checks that an
+ * explicit write cancels a pending switch-off. The output's initial state
+ * is restored. Passes without a binary output configured.
+ * 
+ * Energizes a live output, so io_test_suite_run only calls it when
+ * DEBUG_IO_TEST_DRIVE_OUTPUTS is enabled.
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if every on-time is within 1 ms of the request, false otherwise
+ */
+bool io_test_suite_pulse_outputs(io_manager_t* manager);
+
+/**
+ * @brief Verify the alarm pipeline stage on a synthetic configuration
+ * 
+ * Builds an alarm manager over synthetic analog points with a max value
+ * rule, checks activation after the persistence count and clearing after
+ * the clear count, then times the per-sample cost of the stage.
+ * 
+ * @return true if the alarm sequence matches, false otherwise
+ */
+bool io_test_suite_alarm_stage(void);
+
+/**
+ * @brief Verify the sliding alarm window against brute-force statistics
+ * 
+ * Feeds a 1024-sample window point random samples with constant stretches
+ * and compares the deque min/max and Welford mean/variance with values
+ * recomputed over the raw samples after every sample, along with the stuck
+ * signal alarm. Then checks the per-sample cost of a 1024-sample window
+ * stays within 1.5x that of a 16-sample window.
+ * 
+ * @return true if statistics match and cost is flat, false otherwise
+ */
+bool io_test_suite_alarm_window(void);
+
+/**
+ * @brief Benchmark batched structure-of-arrays alarm rule evaluation
+ * 
+ * Runs 32 and 128 points with every rule enabled through one batch per
+ * scan pass and, on a second manager, one call per point; checks that both
+ * give the same alarms and logs the cost per point and the point table
+ * size against the former fixed array-of-structs state.
+ * 
+ * @return true if batched and per-point evaluation agree, false otherwise
+ */
+bool io_test_suite_benchmark_alarm_rules(void);
+
+/**
+ * @brief Verify alarm rate limiting, first-out grouping and shelving
+ * 
+ * Flaps a disconnected alarm and checks that only the rate limit's worth
+ * of activations is notified, trips a rate of change and a disconnected
+ * alarm together and checks the second is grouped under the first until
+ * it clears, and checks that a shelved alarm is notified once the shelve
+ * expires.
+ * 
+ * @return true if notifications match the suppression rules, false otherwise
+ */
+bool io_test_suite_alarm_suppression(void);
+
+/**
+ * @brief Verify alarm interlocks and report their latency
+ * 
+ * Checks that interlocks are compiled from the alarm configuration and
+ * that the tripped mask follows the raw alarm state, shelved or not. With
+ * an alarm manager attached to the IO manager, reports the measured scan
+ * start to output latency, the worst-case sensor to relay latency, and
+ * checks that a held output refuses writes.
+ * 
+ * @param manager Pointer to initialized IO manager (can be NULL)
+ * @return true if the tripped masks and held outputs behave, false otherwise
+ */
+bool io_test_suite_interlocks(io_manager_t* manager);
+
+/**
+ * @brief Verify that the alarm journal returns records in append order
+ * 
+ * Appends records for two points to a journal on its own segment files,
+ * flushing every 256 records so the first segment fills and the journal
+ * rolls into a second one. Queries the journal with records still pending
+ * in the ring, then again after a forced flush, and checks that every
+ * record comes back once, in append order, and that a point filter keeps
+ * only that point's records. The test segment files are removed afterwards.
+ * 
+ * @return true if every query returns the records in order, false otherwise
+ */
+bool io_test_suite_alarm_journal(void);
+
+/**
+ * @brief Verify trend compression and report its density
+ * 
+ * Feeds an hour of 1 s analog samples with in-slot jitter and a toggling
+ * binary input to a trending manager on a synthetic configuration, checks
+ * that every sample and state change decodes exactly, and reports bytes
+ * per sample against uncompressed records and how many analog points the
+ * pool holds a day of history for. Skipped if PSRAM has no room for a
+ * second trend pool.
+ * 
+ * @param manager Pointer to initialized IO manager (can be NULL)
+ * @return true if the history round-trips exactly, false otherwise
+ */
+bool io_test_suite_trending(io_manager_t* manager);
+
+/**
+ * @brief Verify trend rollups and report what a month-long chart reads
+ * 
+ * Feeds 31 days of samples at the default interval to a trending manager
+ * on a synthetic configuration, then charts the last 30 days at a
+ * resolution for 500 points: checks the hourly tier is picked and that
+ * every bucket's min, max, mean and count match statistics recomputed from
+ * the fed samples, and compares its cost with reading the raw samples.
+ * Also checks one day at 1 min reads the 1 min tier. Skipped if PSRAM has
+ * no room for a second trend pool.
+ * 
+ * @return true if the tiers and bucket statistics match, false otherwise
+ */
+bool io_test_suite_trend_rollups(void);
+
+/**
+ * @brief Run all IO benchmarks and self-tests
+ * 
+ * @param manager Pointer to initialized IO manager
+ * @return true if all tests pass, false if any test fails
+ */
+bool io_test_suite_run(io_manager_t* manager);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IO_TEST_SUITE_H */
@@ -4,6 +4,13 @@
  * 
  * Provides hardware abstraction for 74HC595 (output) and 74HC165 (input)
  * shift register chains for IO expansion.
+ * 
+ * Two backends are available. The GPIO backend bit-bangs each clock edge.
+ * The SPI backend clocks the output and input chains together in a single
+ * DMA transaction per cycle: SCLK drives the 74HC595 chain in SPI mode 0 and
+ * is routed inverted to the 74HC165 clock pin, so the master samples each
+ * input bit half a period after the 74HC165 shifts it out. If the SPI bus
+ * cannot be set up the handler falls back to the GPIO backend.
  */
 
 #ifndef SHIFT_REGISTER_HANDLER_H
@@ -14,6 +21,7 @@
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "driver/spi_master.h"
 #include "config_manager.h"
 
 #ifdef __cplusplus
@@ -23,7 +31,7 @@ extern "C" {
 /**
  * @brief Maximum number of shift register chips supported
  */
-#define SHIFT_REGISTER_MAX_CHIPS 8
+#define SHIFT_REGISTER_MAX_CHIPS 32
 
 
 /**
@@ -35,6 +43,11 @@ typedef struct {
     uint8_t output_states[SHIFT_REGISTER_MAX_CHIPS];          ///< Output register states
     uint8_t input_states[SHIFT_REGISTER_MAX_CHIPS];           ///< Input register states
     SemaphoreHandle_t mutex;                                   ///< Thread safety mutex
+    shift_register_backend_t backend;                          ///< Active backend (GPIO after SPI fallback)
+    spi_host_device_t spi_host;                                ///< SPI peripheral (SPI backend)
+    spi_device_handle_t spi_device;                            ///< SPI device handle (SPI backend)
+    uint8_t* spi_tx_buffer;                                    ///< DMA transmit buffer, SHIFT_REGISTER_MAX_CHIPS bytes
+    uint8_t* spi_rx_buffer;                                    ///< DMA receive buffer, SHIFT_REGISTER_MAX_CHIPS bytes
     uint32_t read_count;                                       ///< Number of read operations
     uint32_t write_count;                                      ///< Number of write operations
     uint32_t error_count;                                      ///< Number of errors
@@ -54,6 +67,8 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
  * 
  * Updates internal input state buffer with current values from all input shift registers.
  * This operation is thread-safe and performs parallel load followed by serial read.
+ * With the SPI backend the same transaction also re-latches the current output
+ * state buffer.
  * 
  * @param handler Pointer to shift register handler structure
  * @return esp_err_t ESP_OK on success, error code on failure
@@ -65,12 +80,29 @@ esp_err_t shift_register_read_inputs(shift_register_handler_t* handler);
  * 
  * Writes current output state buffer to all output shift registers.
  * This operation is thread-safe and performs serial write followed by latch.
+ * With the SPI backend the same transaction also refreshes the input state buffer.
  * 
  * @param handler Pointer to shift register handler structure
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t shift_register_write_outputs(shift_register_handler_t* handler);
 
+/**
+ * @brief Apply masked changes to the output state buffer and latch them in one write
+ * 
+ * Bits set in @p masks take the corresponding bit of @p values; all other
+ * bits keep their current state. The buffer update and the write happen
+ * under one lock, so every changed output switches on the same latch edge.
+ * 
+ * @param handler Pointer to shift register handler structure
+ * @param masks Per-chip mask of bits to change
+ * @param values Per-chip new bit values
+ * @param chip_count Number of entries in @p masks and @p values (at most the configured output count)
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t shift_register_update_outputs(shift_register_handler_t* handler, const uint8_t* masks, 
+                                        const uint8_t* values, int chip_count);
+
 /**
  * @brief Set output bit state
  * 
@@ -145,6 +177,23 @@ esp_err_t shift_register_get_input_byte(shift_register_handler_t* handler, int c
  */
 esp_err_t shift_register_get_statistics(shift_register_handler_t* handler, uint32_t* reads, uint32_t* writes, uint32_t* errors);
 
+/**
+ * @brief Time full input/output cycles over a chain of a given length
+ * 
+ * Runs complete cycles (output shift and latch, input load and shift) as if
+ * the chain held @p chips chips on each side. Bytes for chips beyond the
+ * configured count are zero-padded ahead of the output image so they fall
+ * off the end of the real chain, and the real chips are re-latched with
+ * their current state. Inputs read from configured chips are stored as usual.
+ * 
+ * @param handler Pointer to shift register handler structure
+ * @param chips Simulated chain length (1 to SHIFT_REGISTER_MAX_CHIPS)
+ * @param cycles Number of cycles to run
+ * @param cycle_ns Pointer to store average cycle time in nanoseconds
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t shift_register_benchmark_cycle(shift_register_handler_t* handler, int chips, int cycles, uint32_t* cycle_ns);
+
 /**
  * @brief Destroy shift register handler and cleanup resources
  * 
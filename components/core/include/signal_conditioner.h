@@ -1,9 +1,20 @@
 /**
  * @file signal_conditioner.h
  * @brief Signal Conditioning for SNRv9 Irrigation Control System
- * 
+ *
  * Provides signal conditioning algorithms including filtering, scaling,
  * lookup table interpolation, and precision control for analog inputs.
+ *
+ * A point's signal configuration is compiled once at config load into a
+ * signal_pipeline_t: offset, gain and scaling factor fold into one
+ * multiply-add, the precision multiplier is precomputed, and the filter
+ * stage is a function pointer. Per-sample work is then
+ * signal_conditioner_process():
+ * 1. Scale: value * scale + bias
+ * 2. Lookup table interpolation (if enabled)
+ * 3. Filter (if configured): SMA, EMA, median, Hampel or biquad IIR, with
+ *    per-point state carved from a signal_filter_pool_t
+ * 4. Precision rounding
  */
 
 #ifndef SIGNAL_CONDITIONER_H
@@ -11,6 +22,8 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
 #include "config_manager.h"
 
 #ifdef __cplusplus
@@ -18,90 +31,150 @@ extern "C" {
 #endif
 
 /**
- * @brief Apply signal conditioning to raw analog value
- * 
- * Applies the complete signal conditioning pipeline:
- * 1. Offset application
- * 2. Gain application  
- * 3. Scaling factor
- * 4. Lookup table interpolation (if enabled)
- * 5. Precision rounding
- * 6. SMA filtering (if enabled)
- * 
- * @param raw_value Raw analog input value (0-4095 for 12-bit ADC)
+ * @brief Largest supported SMA window
+ */
+#define SIGNAL_CONDITIONER_MAX_SMA_WINDOW 32
+
+/**
+ * @brief Largest supported median/Hampel window (sorted once or twice per sample)
+ */
+#define SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW 15
+
+/**
+ * @brief Largest supported precision (decimal places)
+ */
+#define SIGNAL_CONDITIONER_MAX_PRECISION 6
+
+struct signal_pipeline;
+
+/**
+ * @brief Filter stage function
+ *
+ * @param pipeline Compiled pipeline (filter parameters)
+ * @param state Per-point filter state (pipeline->state_size bytes)
+ * @param sample New sample
+ * @return float Filtered value
+ */
+typedef float (*signal_filter_fn_t)(const struct signal_pipeline* pipeline, void* state, float sample);
+
+/**
+ * @brief Compiled signal conditioning pipeline
+ */
+typedef struct signal_pipeline {
+    bool enabled;                       ///< Conditioning enabled (false = pass-through)
+    float scale;                        ///< gain * scaling_factor
+    float bias;                         ///< offset * scale
+    const signal_config_t* lookup;      ///< Lookup table source (NULL = no lookup stage)
+    signal_filter_fn_t filter;          ///< Filter stage (NULL = no filter)
+    uint16_t window_size;               ///< SMA/median/Hampel window size
+    uint16_t state_size;                ///< Filter state bytes per point (0 = stateless)
+    float coefficients[5];              ///< EMA alpha, Hampel threshold, or biquad b0 b1 b2 a1 a2
+    float precision_multiplier;         ///< 10^precision_digits
+    float precision_inverse;            ///< 1 / precision_multiplier
+} signal_pipeline_t;
+
+/**
+ * @brief Filter state pool
+ *
+ * One allocation holding the filter state of every point, carved up
+ * according to what each compiled pipeline needs.
+ */
+typedef struct {
+    uint8_t* storage;                   ///< Pool memory
+    size_t capacity;                    ///< Pool size in bytes
+    size_t used;                        ///< Bytes handed out
+} signal_filter_pool_t;
+
+/**
+ * @brief Compile a signal configuration into a pipeline
+ *
+ * The pipeline references config for its lookup table, so config (and the
+ * config manager's table it points to) must outlive it.
+ *
  * @param config Signal configuration
- * @param sma_buffer SMA filter buffer
- * @param sma_index Current SMA buffer index (modified)
- * @param sma_count Number of samples in SMA buffer (modified)
- * @param sma_sum Running sum for SMA calculation (modified)
- * @return float Conditioned signal value
+ * @param pipeline Pointer to store compiled pipeline
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on NULL arguments
+ */
+esp_err_t signal_conditioner_compile(const signal_config_t* config, signal_pipeline_t* pipeline);
+
+/**
+ * @brief Condition one sample
+ *
+ * @param pipeline Compiled pipeline
+ * @param state Per-point filter state (modified by the filter stage; NULL skips the filter)
+ * @param value Input value in engineering units
+ * @return float Conditioned value
  */
-float signal_conditioner_apply(float raw_value, 
-                              const signal_config_t* config,
-                              float* sma_buffer,
-                              int* sma_index,
-                              int* sma_count,
-                              float* sma_sum);
+float signal_conditioner_process(const signal_pipeline_t* pipeline, void* state, float value);
+
+/**
+ * @brief Reset per-point filter state
+ *
+ * @param pipeline Compiled pipeline the state belongs to
+ * @param state Filter state to reset
+ */
+void signal_conditioner_reset_state(const signal_pipeline_t* pipeline, void* state);
+
+/**
+ * @brief Size a filter state pool, discarding previous allocations
+ *
+ * The pool memory is reused when large enough and reallocated otherwise.
+ *
+ * @param pool Pool to size
+ * @param capacity Total bytes required (sum of signal_conditioner_pool_size() per pipeline)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t signal_conditioner_pool_reserve(signal_filter_pool_t* pool, size_t capacity);
+
+/**
+ * @brief Pool bytes needed for a pipeline's filter state
+ *
+ * @param pipeline Compiled pipeline
+ * @return size_t State size rounded up to the pool alignment
+ */
+size_t signal_conditioner_pool_size(const signal_pipeline_t* pipeline);
+
+/**
+ * @brief Allocate zeroed filter state for a pipeline from the pool
+ *
+ * @param pool Pool to allocate from
+ * @param pipeline Compiled pipeline
+ * @return void* Filter state, or NULL if the pipeline is stateless or the pool is exhausted
+ */
+void* signal_conditioner_pool_alloc(signal_filter_pool_t* pool, const signal_pipeline_t* pipeline);
+
+/**
+ * @brief Free the pool memory
+ *
+ * @param pool Pool to release
+ */
+void signal_conditioner_pool_release(signal_filter_pool_t* pool);
 
 /**
  * @brief Apply lookup table interpolation
- * 
- * Performs linear interpolation using the configured lookup table.
+ *
+ * Binary-searches the sorted table for the segment containing input and
+ * interpolates with the segment's precomputed slope (O(log n)).
  * If input is outside table range, returns nearest boundary value.
- * 
+ *
  * @param input Input value
  * @param config Signal configuration with lookup table
  * @return float Interpolated output value
  */
 float signal_conditioner_lookup_table(float input, const signal_config_t* config);
 
-/**
- * @brief Apply Simple Moving Average filter
- * 
- * Updates the SMA filter with a new sample and returns the filtered value.
- * 
- * @param new_sample New sample to add to filter
- * @param sma_buffer SMA filter buffer
- * @param sma_index Current SMA buffer index (modified)
- * @param sma_count Number of samples in SMA buffer (modified)
- * @param sma_sum Running sum for SMA calculation (modified)
- * @param window_size SMA window size
- * @return float Filtered value
- */
-float signal_conditioner_sma_filter(float new_sample,
-                                   float* sma_buffer,
-                                   int* sma_index,
-                                   int* sma_count,
-                                   float* sma_sum,
-                                   int window_size);
-
 /**
  * @brief Round value to specified precision
- * 
+ *
  * @param value Value to round
  * @param precision_digits Number of decimal places
  * @return float Rounded value
  */
 float signal_conditioner_round_precision(float value, int precision_digits);
 
-/**
- * @brief Initialize SMA filter state
- * 
- * @param sma_buffer SMA filter buffer to initialize
- * @param sma_index SMA buffer index to initialize
- * @param sma_count SMA sample count to initialize
- * @param sma_sum SMA running sum to initialize
- * @param buffer_size Size of SMA buffer
- */
-void signal_conditioner_init_sma(float* sma_buffer,
-                                int* sma_index,
-                                int* sma_count,
-                                float* sma_sum,
-                                int buffer_size);
-
 /**
  * @brief Validate signal configuration
- * 
+ *
  * @param config Signal configuration to validate
  * @return bool True if configuration is valid, false otherwise
  */
@@ -0,0 +1,454 @@
+/**
+ * @file trending_manager.h
+ * @brief Trend History Manager for SNRv9 Irrigation Control System
+ *
+ * Keeps the recent history of every IO point with trendConfig enabled in
+ * compressed rings in PSRAM. Samples are fed by the IO scan: once attached
+ * to the IO manager, every scan pass hands the trended points' new values
+ * to trending_manager_record_samples.
+ *
+ * One PSRAM pool of TRENDING_POOL_BYTES (PSRAM_ALLOC_TRENDING) holds raw
+ * samples and rollups. The raw part is split into TRENDING_BLOCK_BYTES
+ * blocks and shared out as one ring of blocks per point; an analog point
+ * gets TRENDING_ANALOG_WEIGHT times the blocks of a binary point. When a
+ * ring is full its oldest block is reused, so every point keeps as much
+ * history as its share holds.
+ *
+ * Each block starts with a header holding its first sample uncompressed,
+ * so blocks decode on their own:
+ * - analog points (AI, and BI in counter mode) are sampled once per
+ *   sampleIntervalSeconds slot, stamped with the slot start, and encoded
+ *   Gorilla-style: timestamps as delta-of-delta in 1, 9, 12, 16 or 36
+ *   bits (1 while no slot is missed), values as the XOR with the previous
+ *   value, 1 bit when unchanged and otherwise only the bits that changed;
+ * - binary points (BI, BO) are run-length encoded: the block header holds
+ *   the initial state and each state change adds the length of the run
+ *   that ended, in milliseconds, as a varint. The state toggles per run.
+ *
+ * Every sample the scan hands over (not only the encoded ones) is also
+ * folded into 1 min, 15 min and 1 h rollup buckets holding min, max, mean
+ * and count (binary points: of the state, so the mean is the on-fraction).
+ * Closed 1 min buckets are merged into the 15 min bucket and those into
+ * the 1 h bucket, so each tier costs O(1) per sample. Closed buckets go to
+ * a ring per point and tier in the rollup part of the pool
+ * (TRENDING_ROLLUP_PERCENT), shared equally by the points and split
+ * between the tiers in proportion to TRENDING_ROLLUP_TARGET_*.
+ * trending_manager_query_resolution answers from the coarsest tier that
+ * is still at least as fine as the requested resolution, so a 30-day chart
+ * reads about 720 hourly buckets instead of every raw sample.
+ *
+ * Timestamps are wall-clock Unix milliseconds. A clock step backwards
+ * starts a new block.
+ */
+
+#ifndef TRENDING_MANAGER_H
+#define TRENDING_MANAGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "config_manager.h"
+#include "point_id_index.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief PSRAM pool shared by all trend rings
+ */
+#define TRENDING_POOL_BYTES (2 * 1024 * 1024)
+
+/**
+ * @brief Ring block size (header and encoded samples)
+ */
+#define TRENDING_BLOCK_BYTES 256
+
+/**
+ * @brief Ring share of an analog point relative to a binary point
+ */
+#define TRENDING_ANALOG_WEIGHT 4
+
+/**
+ * @brief Fewest blocks per ring (one being written, one or more complete)
+ */
+#define TRENDING_MIN_BLOCKS 2
+
+/**
+ * @brief Share of the pool holding rollup rings (percent)
+ */
+#define TRENDING_ROLLUP_PERCENT 50
+
+/**
+ * @brief Rollup bucket lengths
+ */
+#define TRENDING_TIER_1MIN_MS   60000
+#define TRENDING_TIER_15MIN_MS  900000
+#define TRENDING_TIER_1H_MS     3600000
+
+/**
+ * @brief Rollup ring proportions: 12 h of 1 min, 7 days of 15 min and 31 days of 1 h buckets
+ */
+#define TRENDING_ROLLUP_TARGET_1MIN     720
+#define TRENDING_ROLLUP_TARGET_15MIN    672
+#define TRENDING_ROLLUP_TARGET_1H       744
+
+/**
+ * @brief Analog sample interval limits (seconds)
+ */
+#define TRENDING_MIN_INTERVAL_S 1
+#define TRENDING_MAX_INTERVAL_S 3600
+
+/**
+ * @brief Trend handle (index of a trended point)
+ */
+typedef int trending_handle_t;
+
+/**
+ * @brief Trended point kinds
+ */
+typedef enum {
+    TRENDING_KIND_ANALOG = 0,           ///< Sampled value, Gorilla encoded
+    TRENDING_KIND_BINARY                ///< State changes, run-length encoded
+} trending_kind_t;
+
+/**
+ * @brief History tiers, finest first
+ */
+typedef enum {
+    TRENDING_TIER_RAW = 0,              ///< Encoded samples
+    TRENDING_TIER_1MIN,                 ///< 1 min rollups
+    TRENDING_TIER_15MIN,                ///< 15 min rollups
+    TRENDING_TIER_1H,                   ///< 1 h rollups
+    TRENDING_TIER_COUNT                 ///< Number of tiers
+} trending_tier_t;
+
+/**
+ * @brief Number of rollup tiers (rollup tier k is trending_tier_t k + 1)
+ */
+#define TRENDING_ROLLUP_TIERS (TRENDING_TIER_COUNT - 1)
+
+/**
+ * @brief Closed rollup bucket (as stored in the rollup rings)
+ */
+typedef struct {
+    uint32_t start_s;                   ///< Bucket start (Unix seconds)
+    uint32_t count;                     ///< Samples in the bucket
+    float min;                          ///< Smallest sample
+    float max;                          ///< Largest sample
+    float mean;                         ///< Mean of the samples
+} trending_rollup_t;
+
+/**
+ * @brief Rollup bucket being filled
+ */
+typedef struct {
+    int64_t start_ms;                   ///< Bucket start
+    float min;                          ///< Smallest sample
+    float max;                          ///< Largest sample
+    float sum;                          ///< Sum of the samples
+    uint32_t count;                     ///< Samples so far (0 = no bucket open)
+} trending_open_bucket_t;
+
+/**
+ * @brief Block header (followed by the encoded samples)
+ */
+typedef struct {
+    int64_t first_ms;                   ///< Time of the first sample
+    int64_t last_ms;                    ///< Time of the last sample
+    float first_value;                  ///< First value (binary: initial state, 0 or 1)
+    uint16_t count;                     ///< Samples (binary: state records) in the block
+    uint16_t used_bits;                 ///< Encoded bits after the header
+} trending_block_header_t;
+
+/**
+ * @brief Payload bytes of a block
+ */
+#define TRENDING_BLOCK_PAYLOAD (TRENDING_BLOCK_BYTES - sizeof(trending_block_header_t))
+
+/**
+ * @brief Ring and encoder state of a trended point
+ *
+ * Block sequence s of the ring lives at ring position s % block_count;
+ * blocks first_sequence..next_sequence-1 hold data, the last one is being
+ * written.
+ */
+typedef struct {
+    // Ring
+    uint32_t first_block;               ///< First pool block of the ring
+    uint16_t block_count;               ///< Blocks in the ring
+    uint8_t kind;                       ///< trending_kind_t
+    uint32_t first_sequence;            ///< Oldest block still held
+    uint32_t next_sequence;             ///< Sequence of the next block started
+    uint32_t interval_ms;               ///< Analog sample interval
+
+    // Encoder state of the block being written
+    int64_t previous_ms;                ///< Time of the last sample
+    int32_t previous_delta;             ///< Last timestamp delta (analog)
+    uint32_t previous_bits;             ///< Last value as float bits (analog)
+    uint8_t previous_leading;           ///< Leading zeros of the last XOR window (0xFF = none yet)
+    uint8_t previous_trailing;          ///< Trailing zeros of the last XOR window
+    bool state;                         ///< Last recorded state (binary)
+
+    // Held history
+    uint32_t held_samples;              ///< Samples (binary: state records) in the ring
+    uint32_t held_bytes;                ///< Block bytes holding them (headers included)
+
+    // Rollups, by rollup tier
+    uint32_t rollup_first[TRENDING_ROLLUP_TIERS];           ///< First record of the ring in the rollup area
+    uint32_t rollup_capacity[TRENDING_ROLLUP_TIERS];        ///< Records in the ring
+    uint32_t rollup_next[TRENDING_ROLLUP_TIERS];            ///< Buckets closed (next record at rollup_next % capacity)
+    trending_open_bucket_t rollup_open[TRENDING_ROLLUP_TIERS]; ///< Bucket being filled
+} trending_series_t;
+
+/**
+ * @brief One sample of a batch recorded by trending_manager_record_samples
+ */
+typedef struct {
+    trending_handle_t handle;           ///< Trended point
+    float value;                        ///< Conditioned value (analog points)
+    bool state;                         ///< Digital state (binary points)
+} trending_sample_t;
+
+/**
+ * @brief Trend history of one point (trending_manager_get_series_info)
+ */
+typedef struct {
+    char point_id[CONFIG_MAX_ID_LENGTH];    ///< Point ID
+    trending_kind_t kind;                   ///< Point kind
+    uint32_t interval_ms;                   ///< Analog sample interval (0 for binary points)
+    uint32_t samples;                       ///< Samples (binary: state records) held
+    int64_t first_ms;                       ///< Oldest sample held (0 = none)
+    int64_t last_ms;                        ///< Newest sample held
+    uint32_t bytes_used;                    ///< Block bytes holding samples (headers included)
+    uint32_t bytes_allocated;               ///< Ring size
+    uint32_t rollup_held[TRENDING_ROLLUP_TIERS];     ///< Closed buckets held per rollup tier
+    uint32_t rollup_capacity[TRENDING_ROLLUP_TIERS]; ///< Bucket capacity per rollup tier
+} trending_series_info_t;
+
+/**
+ * @brief One result of a resolution query
+ *
+ * Raw samples are reported as buckets of one sample with no length.
+ */
+typedef struct {
+    int64_t start_ms;                   ///< Bucket start (raw: sample time)
+    uint32_t duration_ms;               ///< Bucket length (raw: 0)
+    uint32_t count;                     ///< Samples in the bucket
+    float min;                          ///< Smallest sample
+    float max;                          ///< Largest sample
+    float mean;                         ///< Mean of the samples
+} trending_bucket_t;
+
+/**
+ * @brief Trending statistics
+ */
+typedef struct {
+    uint16_t analog_points;             ///< Analog points trended
+    uint16_t binary_points;             ///< Binary points trended
+    uint32_t pool_bytes;                ///< Pool size
+    uint32_t samples_recorded;          ///< Samples encoded since init
+    uint32_t blocks_recycled;           ///< Oldest blocks dropped to make room
+    uint32_t samples_held;              ///< Samples currently held across all rings
+    uint32_t bytes_held;                ///< Block bytes holding them (headers included)
+    uint32_t rollups_held;              ///< Closed rollup buckets held across all tiers
+    uint32_t rollup_bytes;              ///< Rollup area size
+} trending_stats_t;
+
+/**
+ * @brief Trending Manager Structure
+ */
+typedef struct {
+    bool initialized;                                   ///< Initialization status
+
+    // Configuration
+    config_manager_t* config_manager;                   ///< Configuration manager
+
+    // Trended points, rebuilt on reload
+    trending_series_t* series;                          ///< Ring and encoder state (internal RAM)
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH];            ///< Point ID per series (PSRAM)
+    point_id_index_t id_index;                          ///< Point ID index into point_ids
+    int series_count;                                   ///< Number of trended points
+
+    // Pool (PSRAM_ALLOC_TRENDING): raw blocks, then rollup records
+    uint8_t* pool;                                      ///< Pool
+    uint32_t pool_blocks;                               ///< Raw TRENDING_BLOCK_BYTES blocks
+    trending_rollup_t* rollups;                         ///< Rollup records after the raw blocks
+    uint32_t rollup_records;                            ///< Rollup records in the pool
+    uint32_t generation;                                ///< Increases when the series table is rebuilt
+    portMUX_TYPE lock;                                  ///< Guards ring state and block contents (held per sample)
+
+    // Statistics
+    uint32_t samples_recorded;                          ///< Samples encoded since init
+    uint32_t blocks_recycled;                           ///< Oldest blocks dropped to make room
+} trending_manager_t;
+
+/**
+ * @brief Query callback, called once per sample in time order
+ *
+ * @param time_ms Sample time (Unix milliseconds)
+ * @param value Sample value (binary points: the state from time_ms on, 0 or 1)
+ * @param context Caller context
+ * @return bool True to continue, false to stop the query
+ */
+typedef bool (*trending_visit_fn_t)(int64_t time_ms, float value, void* context);
+
+/**
+ * @brief Resolution query callback, called once per bucket in time order
+ *
+ * @param bucket Bucket (or raw sample)
+ * @param context Caller context
+ * @return bool True to continue, false to stop the query
+ */
+typedef bool (*trending_bucket_fn_t)(const trending_bucket_t* bucket, void* context);
+
+/**
+ * @brief Initialize the trending manager and allocate the block pool
+ *
+ * @param manager Pointer to trending manager structure
+ * @param config_manager Pointer to configuration manager
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the pool or tables cannot be allocated
+ */
+esp_err_t trending_manager_init(trending_manager_t* manager, config_manager_t* config_manager);
+
+/**
+ * @brief Rebuild the trended point set from the configuration manager
+ *
+ * When the trended points, their kinds and intervals are unchanged the
+ * history is kept; otherwise the pool is shared out again and all history
+ * is cleared. Handles change; an attached IO manager resolves them again
+ * on its own reload.
+ *
+ * @param manager Pointer to trending manager structure
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trending_manager_reload_config(trending_manager_t* manager);
+
+/**
+ * @brief Resolve a point ID to a trend handle
+ *
+ * @param manager Pointer to trending manager structure
+ * @param point_id IO point ID
+ * @param handle Pointer to store handle
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the point is not trended
+ */
+esp_err_t trending_manager_resolve_point(trending_manager_t* manager, const char* point_id,
+                                         trending_handle_t* handle);
+
+/**
+ * @brief Record the new values of a batch of trended points
+ *
+ * Every sample updates the point's rollup buckets. Analog points are
+ * encoded on the first sample of each interval slot, binary points when
+ * their state changed.
+ * Never blocks: the pool lock is held for one sample's encoding at a time.
+ * The IO scan calls this once per pass.
+ *
+ * @param manager Pointer to trending manager structure
+ * @param samples Samples to record
+ * @param count Number of samples
+ * @param time_ms Sample time (Unix milliseconds)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for an unknown handle (later samples skipped)
+ */
+esp_err_t trending_manager_record_samples(trending_manager_t* manager, const trending_sample_t* samples,
+                                          int count, int64_t time_ms);
+
+/**
+ * @brief Visit the samples of a point in a time range
+ *
+ * Blocks outside the range are skipped by their header; each other block
+ * is copied out under the lock and decoded without it. A binary point's
+ * visit starts with its state at from_ms when the range starts within a run.
+ *
+ * @param manager Pointer to trending manager structure
+ * @param point_id IO point ID
+ * @param from_ms Earliest time (inclusive)
+ * @param to_ms Latest time (inclusive)
+ * @param visit Callback per sample
+ * @param context Callback context
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the point is not trended
+ */
+esp_err_t trending_manager_query(trending_manager_t* manager, const char* point_id, int64_t from_ms,
+                                 int64_t to_ms, trending_visit_fn_t visit, void* context);
+
+/**
+ * @brief Pick the tier serving a resolution
+ *
+ * @param resolution_ms Coarsest acceptable spacing of results
+ * @return trending_tier_t Coarsest tier whose bucket length does not exceed
+ *         resolution_ms (TRENDING_TIER_RAW below 1 min)
+ */
+trending_tier_t trending_manager_select_tier(uint32_t resolution_ms);
+
+/**
+ * @brief Get the bucket length of a tier
+ *
+ * @param tier History tier
+ * @return uint32_t Bucket length in milliseconds (0 for TRENDING_TIER_RAW)
+ */
+uint32_t trending_manager_tier_duration_ms(trending_tier_t tier);
+
+/**
+ * @brief Visit the history of a point in a time range at a resolution
+ *
+ * Reads the tier trending_manager_select_tier picks for resolution_ms.
+ * Rollup rings are searched by bucket start, so only buckets in the range
+ * are read; the bucket still being filled (including the finer buckets not
+ * yet merged into it) is visited last. Raw samples are visited as buckets
+ * of one sample, as trending_manager_query returns them.
+ *
+ * @param manager Pointer to trending manager structure
+ * @param point_id IO point ID
+ * @param from_ms Earliest time (buckets ending at or before it are skipped)
+ * @param to_ms Latest time (inclusive)
+ * @param resolution_ms Coarsest acceptable spacing of results
+ * @param visit Callback per bucket
+ * @param context Callback context
+ * @param tier Pointer to store the tier read (can be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the point is not trended
+ */
+esp_err_t trending_manager_query_resolution(trending_manager_t* manager, const char* point_id,
+                                            int64_t from_ms, int64_t to_ms, uint32_t resolution_ms,
+                                            trending_bucket_fn_t visit, void* context, trending_tier_t* tier);
+
+/**
+ * @brief Get the number of trended points
+ *
+ * @param manager Pointer to trending manager structure
+ * @return int Number of trended points (0 if not initialized)
+ */
+int trending_manager_get_series_count(trending_manager_t* manager);
+
+/**
+ * @brief Describe the history of a trended point
+ *
+ * @param manager Pointer to trending manager structure
+ * @param handle Trend handle (0 .. series count - 1)
+ * @param info Pointer to store the description
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND for an unknown handle
+ */
+esp_err_t trending_manager_get_series_info(trending_manager_t* manager, trending_handle_t handle,
+                                           trending_series_info_t* info);
+
+/**
+ * @brief Get trending statistics
+ *
+ * @param manager Pointer to trending manager structure
+ * @param stats Pointer to store statistics
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trending_manager_get_stats(trending_manager_t* manager, trending_stats_t* stats);
+
+/**
+ * @brief Free the pool and tables
+ *
+ * @param manager Pointer to trending manager structure
+ */
+void trending_manager_destroy(trending_manager_t* manager);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRENDING_MANAGER_H
@@ -4,356 +4,1706 @@
  */
 
 #include "io_manager.h"
-#include "debug_config.h"
 #include "psram_manager.h"
+#include "debug_config.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "freertos/task.h"
 #include <string.h>
 #include <math.h>
+#include <sys/time.h>
 
 static const char* TAG = DEBUG_IO_MANAGER_TAG;
 
+#define IO_MANAGER_POINT_GROWTH 8   ///< Per-point tables are sized in multiples of this
+
 /**
  * @brief Find IO point index by ID
  */
 static int find_point_index(io_manager_t* manager, const char* point_id) {
-    for (int i = 0; i < manager->active_point_count; i++) {
-        if (strcmp(manager->point_ids[i], point_id) == 0) {
-            return i;
-        }
+    return point_id_index_find(&manager->id_index, manager->point_ids[0], CONFIG_MAX_ID_LENGTH, point_id);
+}
+
+/**
+ * @brief Convert a point handle to a table index
+ * 
+ * @return int Point index, or -1 if the handle is invalid or stale
+ */
+static int handle_to_index(io_manager_t* manager, io_point_handle_t handle) {
+    int point_index = (int)(handle & 0xFFFF);
+    if ((handle >> 16) != manager->point_generation || point_index >= manager->active_point_count) {
+        return -1;
     }
-    return -1;
+    return point_index;
 }
 
 /**
- * @brief Apply signal conditioning to raw value
+ * @brief Record a change-of-value report for a point if it moved
+ * 
+ * Bumps the global change sequence when the conditioned value left the
+ * deadband around the last reported value, the digital or error state
+ * flipped, the point was never reported, or its COV heartbeat expired.
+ * Caller must hold state_mutex (or be the only writer).
  */
-static float apply_signal_conditioning(const io_point_config_t* config, 
-                                     io_point_runtime_state_t* state, 
-                                     float raw_value) {
-    if (!config->signal_config.enabled) {
-        return raw_value;
+static void record_change(io_manager_t* manager, int point_index, uint64_t timestamp) {
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    io_point_runtime_state_t* state = &manager->runtime_states[point_index];
+    bool changed;
+    
+    if (state->change_sequence == 0 || state->error_state != state->reported_error_state) {
+        changed = true;
+    } else if (point->type == IO_POINT_TYPE_GPIO_AI || point->input_mode == IO_INPUT_MODE_COUNTER) {
+        changed = fabsf(state->conditioned_value - state->reported_value) > point->deadband;
+    } else {
+        // A pulse shorter than the scan shows up as edges without a level change
+        changed = state->digital_state != state->reported_digital_state || 
+                  state->edge_count != state->reported_edge_count;
     }
     
-    float conditioned = raw_value;
+    if (!changed && point->cov_heartbeat_us > 0 && 
+        timestamp - state->last_report_time >= point->cov_heartbeat_us) {
+        changed = true;
+    }
     
-    // Apply offset
-    conditioned += config->signal_config.offset;
+    if (!changed) {
+        return;
+    }
     
-    // Apply gain
-    conditioned *= config->signal_config.gain;
+    state->change_sequence = ++manager->change_sequence;
+    state->reported_value = state->conditioned_value;
+    state->reported_digital_state = state->digital_state;
+    state->reported_error_state = state->error_state;
+    state->reported_edge_count = state->edge_count;
+    state->last_report_time = timestamp;
+}
+
+/**
+ * @brief Record one timing sample into a log2-bucket histogram
+ * 
+ * Caller must hold scan_mutex.
+ */
+static inline void record_timing(io_manager_t* manager, io_timing_metric_t metric, int64_t elapsed_us) {
+    io_timing_histogram_t* histogram = &manager->timing.histograms[metric];
+    uint32_t us = elapsed_us <= 0 ? 0 : (elapsed_us > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed_us);
+    int bucket = us ? 32 - __builtin_clz(us) : 0;
+    
+    histogram->buckets[bucket < IO_TIMING_BUCKETS ? bucket : IO_TIMING_BUCKETS - 1]++;
+    histogram->count++;
+    histogram->total_us += us;
+    if (us > histogram->max_us) {
+        histogram->max_us = us;
+    }
+}
+
+/**
+ * @brief Check a shift register point's chip and bit against the configured chain
+ * 
+ * Output masks are indexed by chip_index, so every staging path checks
+ * this before touching them.
+ */
+static inline bool shift_register_point_mapped(const io_manager_t* manager, const io_point_descriptor_t* point) {
+    int chips = (point->type == IO_POINT_TYPE_SHIFT_REG_BO) ? 
+                manager->shift_register_handler.config.num_output_registers : 
+                manager->shift_register_handler.config.num_input_registers;
+    return point->chip_index < chips && point->chip_index < SHIFT_REGISTER_MAX_CHIPS && point->bit_index < 8;
+}
+
+static esp_err_t read_analog_input(io_manager_t* manager, int point_index, int32_t* raw);
+static esp_err_t read_binary_input(io_manager_t* manager, int point_index, int32_t* raw);
+static esp_err_t read_edge_input(io_manager_t* manager, int point_index, int32_t* raw);
+static esp_err_t read_counter_input(io_manager_t* manager, int point_index, int32_t* raw);
+static void publish_snapshot(io_manager_t* manager);
+
+esp_err_t io_manager_compile_point(const io_point_config_t* config, io_point_descriptor_t* descriptor) {
+    if (!config || !descriptor) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Apply scaling factor
-    conditioned *= config->signal_config.scaling_factor;
+    memset(descriptor, 0, sizeof(io_point_descriptor_t));
+    descriptor->type = (uint8_t)config->type;
+    descriptor->pin = (int16_t)config->pin;
+    descriptor->alarm_handle = -1;
+    descriptor->trend_handle = -1;
+    bool chip_valid = config->chip_index >= 0 && config->chip_index < SHIFT_REGISTER_MAX_CHIPS && 
+                      config->bit_index >= 0 && config->bit_index < 8;
+    descriptor->chip_index = chip_valid ? (uint8_t)config->chip_index : (uint8_t)IO_CHIP_INDEX_UNMAPPED;
+    descriptor->bit_index = chip_valid ? (uint8_t)config->bit_index : 0;
+    descriptor->is_inverted = config->is_inverted;
+    descriptor->scan_class = (config->scan_class < IO_SCAN_CLASS_COUNT) ? 
+                             (uint8_t)config->scan_class : (uint8_t)IO_SCAN_CLASS_NORMAL;
+    descriptor->deadband = config->signal_config.deadband;
+    descriptor->cov_heartbeat_us = config->signal_config.cov_heartbeat_ms * 1000U;
+    
+    switch (config->type) {
+        case IO_POINT_TYPE_GPIO_AI:
+            descriptor->read = read_analog_input;
+            signal_conditioner_compile(&config->signal_config, &descriptor->pipeline);
+            descriptor->range_min = config->range_min;
+            descriptor->range_scale = (config->range_max - config->range_min) / 4095.0f;
+            break;
+            
+        case IO_POINT_TYPE_GPIO_BI:
+            descriptor->input_mode = (uint8_t)config->input_mode;
+            if (config->input_mode == IO_INPUT_MODE_EDGE) {
+                descriptor->read = read_edge_input;
+            } else if (config->input_mode == IO_INPUT_MODE_COUNTER) {
+                // The rate is a virtual analog value and runs through the point's conditioning
+                descriptor->read = read_counter_input;
+                signal_conditioner_compile(&config->signal_config, &descriptor->pipeline);
+                descriptor->units_per_pulse = config->pulses_per_unit > 0.0f ? 1.0f / config->pulses_per_unit : 1.0f;
+                descriptor->rate_time_base_s = config->rate_time_base_s > 0.0f ? 
+                                               config->rate_time_base_s : CONFIG_DEFAULT_RATE_TIME_BASE_S;
+            } else {
+                descriptor->read = read_binary_input;
+            }
+            break;
+            
+        case IO_POINT_TYPE_SHIFT_REG_BI:
+            descriptor->read = read_binary_input;
+            break;
+            
+        case IO_POINT_TYPE_GPIO_BO:
+        case IO_POINT_TYPE_SHIFT_REG_BO:
+            descriptor->read = NULL; // Outputs are driven, not scanned
+            break;
+            
+        default:
+            return ESP_ERR_INVALID_ARG;
+    }
     
-    // Apply SMA filtering if enabled
-    if (config->signal_config.filter_type == SIGNAL_FILTER_SMA && 
-        config->signal_config.sma_window_size > 0) {
-        
-        int window_size = config->signal_config.sma_window_size;
-        if (window_size > 32) window_size = 32; // Limit to buffer size
+    return ESP_OK;
+}
+
+/**
+ * @brief Resolve each analog input's handle in the attached alarm manager
+ */
+static void resolve_alarm_handles(io_manager_t* manager) {
+    int monitored = 0;
+    
+    for (int i = 0; i < manager->active_point_count; i++) {
+        io_point_descriptor_t* point = &manager->point_table[i];
+        alarm_point_handle_t handle = -1;
         
-        // Add new sample to circular buffer
-        state->sma_buffer[state->sma_index] = conditioned;
+        if (manager->alarm_manager && point->type == IO_POINT_TYPE_GPIO_AI &&
+            alarm_manager_resolve_point(manager->alarm_manager, manager->point_ids[i], &handle) == ESP_OK) {
+            monitored++;
+        }
+        point->alarm_handle = (int16_t)handle;
+    }
+    
+    // Interlock indices changed: release every output until the next alarm stage re-applies them
+    int interlock_count = manager->alarm_manager ? alarm_manager_get_interlock_count(manager->alarm_manager) : 0;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        manager->runtime_states[i].interlocked = false;
+    }
+    for (int k = 0; k < interlock_count; k++) {
+        io_interlock_t* interlock = &manager->interlocks[k];
+        alarm_interlock_info_t info;
+        interlock->output_index = -1;
+        interlock->forced_state = false;
+        if (alarm_manager_get_interlock(manager->alarm_manager, k, &info) != ESP_OK) {
+            continue;
+        }
         
-        // Update sum
-        if (state->sma_count < window_size) {
-            state->sma_sum += conditioned;
-            state->sma_count++;
+        int output_index = find_point_index(manager, info.output_point_id);
+        const io_point_descriptor_t* output = output_index >= 0 ? &manager->point_table[output_index] : NULL;
+        if (!output || (output->type != IO_POINT_TYPE_GPIO_BO && output->type != IO_POINT_TYPE_SHIFT_REG_BO)) {
+            ESP_LOGW(TAG, "Interlock %s -> %s ignored: not a binary output", info.point_id, info.output_point_id);
+        } else if (output->type == IO_POINT_TYPE_SHIFT_REG_BO && !shift_register_point_mapped(manager, output)) {
+            ESP_LOGW(TAG, "Interlock %s -> %s ignored: output outside the shift register chain", 
+                     info.point_id, info.output_point_id);
         } else {
-            // Remove oldest sample and add new one
-            int old_index = (state->sma_index + 1) % window_size;
-            state->sma_sum = state->sma_sum - state->sma_buffer[old_index] + conditioned;
+            interlock->output_index = (int16_t)output_index;
+            interlock->forced_state = info.forced_state;
         }
+    }
+    manager->interlock_count = interlock_count;
+    manager->interlock_tripped = 0;
+    manager->interlock_stats.forced_outputs = 0;
+    
+    ESP_LOGI(TAG, "Alarm stage: %d points monitored, %d interlocks", monitored, interlock_count);
+}
+
+/**
+ * @brief Resolve each point's handle in the attached trending manager
+ * 
+ * Trended binary outputs are not scanned, so they are listed to be
+ * recorded on every pass.
+ */
+static void resolve_trend_handles(io_manager_t* manager) {
+    int trended = 0;
+    
+    manager->trend_output_count = 0;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        io_point_descriptor_t* point = &manager->point_table[i];
+        trending_handle_t handle = -1;
         
-        // Update index
-        state->sma_index = (state->sma_index + 1) % window_size;
+        if (manager->trending_manager &&
+            trending_manager_resolve_point(manager->trending_manager, manager->point_ids[i], &handle) == ESP_OK) {
+            trended++;
+            if (point->type == IO_POINT_TYPE_GPIO_BO || point->type == IO_POINT_TYPE_SHIFT_REG_BO) {
+                manager->trend_outputs[manager->trend_output_count++] = (uint16_t)i;
+            }
+        }
+        point->trend_handle = (int16_t)handle;
+    }
+    
+    ESP_LOGI(TAG, "Trend stage: %d points trended (%d outputs)", trended, manager->trend_output_count);
+}
+
+/**
+ * @brief Build the per-class scan lists from the compiled point table
+ */
+static void build_scan_lists(io_manager_t* manager) {
+    memset(manager->scan_list_counts, 0, sizeof(manager->scan_list_counts));
+    memset(manager->scan_class_reads_shift_register, 0, sizeof(manager->scan_class_reads_shift_register));
+    
+    for (int i = 0; i < manager->active_point_count; i++) {
+        const io_point_descriptor_t* point = &manager->point_table[i];
+        if (!point->read) {
+            continue;
+        }
         
-        // Calculate average
-        if (state->sma_count > 0) {
-            conditioned = state->sma_sum / state->sma_count;
+        int scan_class = point->scan_class;
+        manager->scan_lists[scan_class][manager->scan_list_counts[scan_class]++] = (uint16_t)i;
+        if (point->type == IO_POINT_TYPE_SHIFT_REG_BI) {
+            manager->scan_class_reads_shift_register[scan_class] = true;
         }
     }
     
-    // Apply precision rounding
-    if (config->signal_config.precision_digits >= 0) {
-        float multiplier = powf(10.0f, config->signal_config.precision_digits);
-        conditioned = roundf(conditioned * multiplier) / multiplier;
+    ESP_LOGI(TAG, "Scan classes: %d fast, %d normal, %d slow inputs",
+             manager->scan_list_counts[IO_SCAN_CLASS_FAST],
+             manager->scan_list_counts[IO_SCAN_CLASS_NORMAL],
+             manager->scan_list_counts[IO_SCAN_CLASS_SLOW]);
+}
+
+/**
+ * @brief Resolve scan class intervals from the polling interval and configuration
+ */
+static void update_scan_intervals(io_manager_t* manager) {
+    const scan_class_config_t* config = &manager->current_config.scan_class_config;
+    
+    manager->scan_interval_ms[IO_SCAN_CLASS_FAST] = config->fast_interval_ms > 0 ? 
+        config->fast_interval_ms : CONFIG_DEFAULT_FAST_SCAN_INTERVAL_MS;
+    manager->scan_interval_ms[IO_SCAN_CLASS_NORMAL] = manager->polling_interval_ms;
+    manager->scan_interval_ms[IO_SCAN_CLASS_SLOW] = config->slow_interval_ms > 0 ? 
+        config->slow_interval_ms : CONFIG_DEFAULT_SLOW_SCAN_INTERVAL_MS;
+}
+
+/**
+ * @brief Start continuous ADC acquisition when configured
+ * 
+ * Falls back to one-shot reads if the continuous driver cannot start.
+ */
+static void start_adc_acquisition(io_manager_t* manager) {
+    const adc_acquisition_config_t* adc_config = &manager->current_config.adc_config;
+    if (adc_config->mode != ADC_ACQUISITION_CONTINUOUS) {
+        return;
     }
     
-    return conditioned;
+    esp_err_t ret = gpio_handler_start_adc_continuous(&manager->gpio_handler, adc_config->oversample, 
+                                                      adc_config->sample_freq_hz);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Continuous ADC unavailable (%s), using one-shot reads", esp_err_to_name(ret));
+    }
 }
 
+/**
+ * @brief Size the per-point tables for a number of points
+ * 
+ * The scan tables share one internal RAM block and the point IDs and
+ * snapshot points one PSRAM block. Tables only grow, in multiples of
+ * IO_MANAGER_POINT_GROWTH, and keep their contents. Replaced blocks are
+ * retired instead of freed because lock-free snapshot readers may still be
+ * copying from them; they are freed by the next resize or by destroy.
+ */
+static esp_err_t reserve_point_tables(io_manager_t* manager, int count) {
+    if (count <= manager->point_capacity) {
+        return ESP_OK;
+    }
+    if (count > IO_MANAGER_MAX_POINTS) {
+        ESP_LOGE(TAG, "%d IO points exceed the maximum of %d", count, IO_MANAGER_MAX_POINTS);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    int capacity = (count + IO_MANAGER_POINT_GROWTH - 1) / IO_MANAGER_POINT_GROWTH * IO_MANAGER_POINT_GROWTH;
+    int old_capacity = manager->point_capacity;
+    
+    // Largest alignment first: runtime states hold 64-bit timestamps
+    size_t hot_size = capacity * (sizeof(io_point_runtime_state_t) + sizeof(io_pulse_deadline_t) + 
+                                  sizeof(io_point_descriptor_t) + sizeof(io_scan_sample_t) + 
+                                  sizeof(alarm_sample_t) + sizeof(trending_sample_t) + 
+                                  (IO_SCAN_CLASS_COUNT + 1) * sizeof(uint16_t));
+    size_t cold_size = capacity * (2 * sizeof(io_point_snapshot_t) + CONFIG_MAX_ID_LENGTH);
+    uint8_t* hot = psram_smart_malloc(hot_size, ALLOC_CRITICAL);
+    uint8_t* cold = psram_smart_malloc(cold_size, ALLOC_LARGE_BUFFER);
+    if (!hot || !cold) {
+        ESP_LOGE(TAG, "No memory for %d-point tables (%u bytes internal, %u bytes PSRAM)", 
+                 capacity, (unsigned)hot_size, (unsigned)cold_size);
+        psram_smart_free(hot);
+        psram_smart_free(cold);
+        return ESP_ERR_NO_MEM;
+    }
+    memset(hot, 0, hot_size);
+    memset(cold, 0, cold_size);
+    
+    io_point_runtime_state_t* runtime_states = (io_point_runtime_state_t*)hot;
+    io_pulse_deadline_t* pulse_heap = (io_pulse_deadline_t*)(runtime_states + capacity);
+    io_point_descriptor_t* point_table = (io_point_descriptor_t*)(pulse_heap + capacity);
+    io_scan_sample_t* scan_samples = (io_scan_sample_t*)(point_table + capacity);
+    alarm_sample_t* alarm_samples = (alarm_sample_t*)(scan_samples + capacity);
+    trending_sample_t* trend_samples = (trending_sample_t*)(alarm_samples + capacity);
+    uint16_t* scan_lists = (uint16_t*)(trend_samples + capacity);
+    uint16_t* trend_outputs = scan_lists + IO_SCAN_CLASS_COUNT * capacity;
+    io_point_snapshot_t* snapshot_points = (io_point_snapshot_t*)cold;
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH] = (char (*)[CONFIG_MAX_ID_LENGTH])(snapshot_points + 2 * capacity);
+    
+    // Keep contents so readers running during a reload see the previous table
+    if (old_capacity > 0) {
+        memcpy(runtime_states, manager->runtime_states, old_capacity * sizeof(io_point_runtime_state_t));
+        memcpy(pulse_heap, manager->pulse_heap, manager->pulse_heap_count * sizeof(io_pulse_deadline_t));
+        memcpy(point_table, manager->point_table, old_capacity * sizeof(io_point_descriptor_t));
+        memcpy(point_ids, manager->point_ids, old_capacity * CONFIG_MAX_ID_LENGTH);
+        for (int b = 0; b < 2; b++) {
+            memcpy(snapshot_points + b * capacity, manager->snapshot_buffers[b].points, 
+                   old_capacity * sizeof(io_point_snapshot_t));
+        }
+        for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+            memcpy(scan_lists + c * capacity, manager->scan_lists[c], old_capacity * sizeof(uint16_t));
+        }
+        memcpy(trend_outputs, manager->trend_outputs, manager->trend_output_count * sizeof(uint16_t));
+    }
+    
+    manager->runtime_states = runtime_states;
+    manager->pulse_heap = pulse_heap;
+    manager->point_table = point_table;
+    manager->scan_samples = scan_samples;
+    manager->alarm_samples = alarm_samples;
+    manager->trend_samples = trend_samples;
+    manager->trend_outputs = trend_outputs;
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        manager->scan_lists[c] = scan_lists + c * capacity;
+    }
+    manager->point_ids = point_ids;
+    for (int b = 0; b < 2; b++) {
+        __atomic_store_n(&manager->snapshot_buffers[b].points, snapshot_points + b * capacity, __ATOMIC_RELEASE);
+    }
+    manager->point_capacity = capacity;
+    
+    psram_smart_free(manager->retired_storage[0]);
+    psram_smart_free(manager->retired_storage[1]);
+    manager->retired_storage[0] = manager->hot_storage;
+    manager->retired_storage[1] = manager->cold_storage;
+    manager->hot_storage = hot;
+    manager->cold_storage = cold;
+    
+    ESP_LOGI(TAG, "Point tables sized for %d points: %u bytes internal, %u bytes PSRAM", 
+             capacity, (unsigned)hot_size, (unsigned)cold_size);
+    return ESP_OK;
+}
 
 /**
- * @brief Configure IO points from configuration
+ * @brief Free the lookup table copies held by a set of point configurations
  */
-static esp_err_t configure_io_points(io_manager_t* manager) {
-    ESP_LOGI(TAG, "Starting IO point configuration...");
+static void release_lookup_tables(io_point_config_t* configs, int count) {
+    for (int i = 0; i < count; i++) {
+        psram_smart_free(configs[i].signal_config.lookup_table);
+        configs[i].signal_config.lookup_table = NULL;
+        configs[i].signal_config.lookup_table_count = 0;
+    }
+}
+
+/**
+ * @brief Free the per-point tables, point configurations and ID index
+ */
+static void release_point_tables(io_manager_t* manager) {
+    release_lookup_tables(manager->current_config.io_points, manager->current_config.io_point_count);
+    config_manager_release_io_points(&manager->current_config);
+    point_id_index_release(&manager->id_index);
+    psram_smart_free(manager->hot_storage);
+    psram_smart_free(manager->cold_storage);
+    psram_smart_free(manager->retired_storage[0]);
+    psram_smart_free(manager->retired_storage[1]);
+    manager->hot_storage = NULL;
+    manager->cold_storage = NULL;
+    manager->retired_storage[0] = NULL;
+    manager->retired_storage[1] = NULL;
+    manager->point_table = NULL;
+    manager->runtime_states = NULL;
+    manager->pulse_heap = NULL;
+    manager->pulse_heap_count = 0;
+    manager->scan_samples = NULL;
+    manager->alarm_samples = NULL;
+    manager->trend_samples = NULL;
+    manager->trend_outputs = NULL;
+    manager->trend_output_count = 0;
+    manager->point_ids = NULL;
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        manager->scan_lists[c] = NULL;
+        manager->scan_list_counts[c] = 0;
+    }
+    for (int b = 0; b < 2; b++) {
+        manager->snapshot_buffers[b].points = NULL;
+        manager->snapshot_buffers[b].point_count = 0;
+    }
+    manager->point_capacity = 0;
     manager->active_point_count = 0;
+}
+
+/**
+ * @brief Point table kept across a reload for diffing
+ * 
+ * The arrays share one PSRAM allocation sized to the previous point count.
+ */
+typedef struct {
+    io_point_config_t* configs;                                 ///< Previous point configurations
+    io_point_descriptor_t* descriptors;                         ///< Previous compiled descriptors
+    io_point_runtime_state_t* states;                           ///< Previous runtime states
+    int16_t* kept_by;                                           ///< New index reusing each previous point (-1 = none)
+    int count;                                                  ///< Previous point count
+    adc_acquisition_config_t adc_config;                        ///< Previous ADC acquisition configuration
+    uint8_t* filter_states;                                     ///< Copy of the previous filter pool contents
+    uint8_t* filter_pool_base;                                  ///< Previous pool storage (for state offsets)
+} io_previous_points_t;
+
+/**
+ * @brief True if two point configurations drive the same hardware the same way
+ */
+static bool same_hardware(const io_point_config_t* a, const io_point_config_t* b) {
+    if (a->type != b->type || a->is_inverted != b->is_inverted) {
+        return false;
+    }
+    
+    if (a->type == IO_POINT_TYPE_SHIFT_REG_BI || a->type == IO_POINT_TYPE_SHIFT_REG_BO) {
+        return a->chip_index == b->chip_index && a->bit_index == b->bit_index;
+    }
+    if (a->type == IO_POINT_TYPE_GPIO_BI && 
+        (a->input_mode != b->input_mode || a->debounce_us != b->debounce_us)) {
+        return false;
+    }
+    return a->pin == b->pin;
+}
+
+/**
+ * @brief True if two compiled filters keep interchangeable state
+ */
+static bool same_filter(const signal_pipeline_t* a, const signal_pipeline_t* b) {
+    return a->filter == b->filter && a->window_size == b->window_size && a->state_size == b->state_size &&
+           memcmp(a->coefficients, b->coefficients, sizeof(a->coefficients)) == 0;
+}
+
+/**
+ * @brief Bit mask of GPIO pins used by analog input points
+ */
+static uint64_t analog_pin_mask(const io_point_config_t* points, int count) {
+    uint64_t mask = 0;
+    for (int i = 0; i < count; i++) {
+        if (points[i].type == IO_POINT_TYPE_GPIO_AI && points[i].pin >= 0 && points[i].pin < 64) {
+            mask |= 1ULL << points[i].pin;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Carve per-point filter state out of the filter pool
+ * 
+ * The pool is sized to what the compiled filters need; points whose state
+ * cannot be allocated run without their filter stage. Points kept across a
+ * reload with an unchanged filter get their previous state back.
+ */
+static void allocate_filter_states(io_manager_t* manager, const io_previous_points_t* previous) {
+    size_t pool_bytes = 0;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        pool_bytes += signal_conditioner_pool_size(&manager->point_table[i].pipeline);
+    }
     
-    // Allocate configuration array in PSRAM to avoid stack overflow
-    size_t config_array_size = CONFIG_MAX_IO_POINTS * sizeof(io_point_config_t);
-    ESP_LOGI(TAG, "Allocating %zu bytes in PSRAM for IO configuration array", config_array_size);
+    esp_err_t ret = signal_conditioner_pool_reserve(&manager->filter_pool, pool_bytes);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Filter state pool (%u bytes) unavailable: %s", (unsigned)pool_bytes, esp_err_to_name(ret));
+    }
     
-    io_point_config_t* configs = psram_smart_malloc(config_array_size, ALLOC_LARGE_BUFFER);
-    if (!configs) {
-        ESP_LOGE(TAG, "Failed to allocate %zu bytes in PSRAM for IO config", config_array_size);
-        return ESP_ERR_NO_MEM;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        manager->runtime_states[i].filter_state = 
+            signal_conditioner_pool_alloc(&manager->filter_pool, &manager->point_table[i].pipeline);
+    }
+    
+    for (int j = 0; previous && previous->filter_states && j < previous->count; j++) {
+        int i = previous->kept_by[j];
+        const void* old_state = previous->states[j].filter_state;
+        void* new_state = (i >= 0) ? manager->runtime_states[i].filter_state : NULL;
+        if (!old_state || !new_state || 
+            !same_filter(&previous->descriptors[j].pipeline, &manager->point_table[i].pipeline)) {
+            continue;
+        }
+        
+        memcpy(new_state, previous->filter_states + ((const uint8_t*)old_state - previous->filter_pool_base),
+               manager->point_table[i].pipeline.state_size);
     }
     
+    ESP_LOGI(TAG, "Filter state pool: %u bytes", (unsigned)manager->filter_pool.used);
+}
+
+/**
+ * @brief Copy the point configurations into manager->current_config
+ * 
+ * Lookup tables are deep-copied: the configuration manager frees its own
+ * tables on load, reset, update and destroy, while the compiled pipelines
+ * interpolate through these copies until the next reload. A table that
+ * cannot be copied is dropped and the point scales linearly.
+ * 
+ * On success the caller owns the copies referenced by the previous
+ * configurations and frees them once nothing is compiled against them.
+ * On failure the configurations and point table are left as they were.
+ */
+static esp_err_t fetch_point_configs(io_manager_t* manager) {
+    io_config_t* current = &manager->current_config;
     int config_count = 0;
     
     ESP_LOGI(TAG, "Requesting IO points from configuration manager...");
-    esp_err_t ret = config_manager_get_all_io_points(manager->config_manager, 
-                                                    configs, CONFIG_MAX_IO_POINTS, 
-                                                    &config_count);
+    esp_err_t ret = config_manager_reserve_io_points(current, config_manager_get_io_point_count(manager->config_manager));
+    if (ret == ESP_OK) {
+        ret = config_manager_get_all_io_points(manager->config_manager, current->io_points, 
+                                               current->io_point_capacity, &config_count);
+    }
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "Failed to get IO points from config manager: %s", esp_err_to_name(ret));
-        psram_smart_free(configs);
         return ret;
     }
+    current->io_point_count = config_count;
+    for (int i = 0; i < config_count; i++) {
+        signal_config_t* signal = &current->io_points[i].signal_config;
+        if (!signal->lookup_table || signal->lookup_table_count <= 0) {
+            signal->lookup_table = NULL;
+            signal->lookup_table_count = 0;
+            continue;
+        }
+        size_t table_size = signal->lookup_table_count * sizeof(lookup_table_entry_t);
+        lookup_table_entry_t* table = psram_smart_malloc(table_size, ALLOC_LARGE_BUFFER);
+        if (table) {
+            memcpy(table, signal->lookup_table, table_size);
+        } else {
+            ESP_LOGW(TAG, "No memory to copy the lookup table of %s, scaling linearly", current->io_points[i].id);
+            signal->lookup_table_count = 0;
+        }
+        signal->lookup_table = table;
+    }
+    config_manager_get_shift_register_config(manager->config_manager, &current->shift_register_config);
+    config_manager_get_scan_class_config(manager->config_manager, &current->scan_class_config);
+    config_manager_get_adc_config(manager->config_manager, &current->adc_config);
     
     ESP_LOGI(TAG, "Configuration manager returned %d IO points", config_count);
+    return ESP_OK;
+}
+
+/**
+ * @brief Configure one point's hardware and reset its runtime state
+ */
+static void configure_point_hardware(io_manager_t* manager, int i) {
+    const io_point_config_t* config = &manager->current_config.io_points[i];
+    io_point_runtime_state_t* state = &manager->runtime_states[i];
+    memset(state, 0, sizeof(io_point_runtime_state_t));
+    
+    switch (config->type) {
+        case IO_POINT_TYPE_GPIO_AI:
+            if (config->pin >= 0) {
+                ESP_LOGI(TAG, "  Configuring GPIO analog input on pin %d", config->pin);
+                gpio_handler_configure_analog(&manager->gpio_handler, config->pin);
+            } else {
+                ESP_LOGW(TAG, "  Invalid pin %d for GPIO AI point %s", config->pin, config->id);
+            }
+            break;
+            
+        case IO_POINT_TYPE_GPIO_BI:
+            if (config->pin >= 0 && config->input_mode != IO_INPUT_MODE_POLLED) {
+                bool counter = (config->input_mode == IO_INPUT_MODE_COUNTER);
+                uint32_t debounce_us = config->debounce_us ? config->debounce_us : 
+                                       (counter ? CONFIG_DEFAULT_COUNTER_DEBOUNCE_US : CONFIG_DEFAULT_EDGE_DEBOUNCE_US);
+                ESP_LOGI(TAG, "  Configuring GPIO %s input on pin %d (debounce %lu us)", 
+                         counter ? "counter" : "edge", config->pin, (unsigned long)debounce_us);
+                esp_err_t ret = gpio_handler_configure_edge_input(&manager->gpio_handler, config->pin, true, 
+                                                                  debounce_us, counter);
+                if (ret != ESP_OK) {
+                    ESP_LOGE(TAG, "  Edge capture on pin %d failed: %s", config->pin, esp_err_to_name(ret));
+                }
+            } else if (config->pin >= 0) {
+                ESP_LOGI(TAG, "  Configuring GPIO binary input on pin %d", config->pin);
+                gpio_handler_configure_input(&manager->gpio_handler, config->pin, true);
+            } else {
+                ESP_LOGW(TAG, "  Invalid pin %d for GPIO BI point %s", config->pin, config->id);
+            }
+            break;
+            
+        case IO_POINT_TYPE_GPIO_BO:
+            if (config->pin >= 0) {
+                // SAFETY: Always start with safe state (OFF), gpio_handler now enforces this
+                ESP_LOGI(TAG, "  Configuring GPIO binary output on pin %d (SAFE INIT)", config->pin);
+                gpio_handler_configure_output(&manager->gpio_handler, config->pin, false);  // Always start OFF
+            } else {
+                ESP_LOGW(TAG, "  Invalid pin %d for GPIO BO point %s", config->pin, config->id);
+            }
+            break;
+            
+        case IO_POINT_TYPE_SHIFT_REG_BI:
+            ESP_LOGI(TAG, "  Configuring shift register binary input (chip: %d, bit: %d)", 
+                     config->chip_index, config->bit_index);
+            break;
+            
+        case IO_POINT_TYPE_SHIFT_REG_BO:
+            // SAFETY: The shift register handler initializes all outputs to 0, and outputs
+            // released by a reload are cleared before points are configured
+            ESP_LOGI(TAG, "  Configuring shift register binary output (chip: %d, bit: %d) (SAFE INIT)", 
+                     config->chip_index, config->bit_index);
+            break;
+            
+        default:
+            break;
+    }
+    
+    // Outputs are never scanned; report their safe initial state (OFF) once
+    if (config->type == IO_POINT_TYPE_GPIO_BO || config->type == IO_POINT_TYPE_SHIFT_REG_BO) {
+        record_change(manager, i, esp_timer_get_time());
+    }
+}
+
+/**
+ * @brief Release hardware of previous points that no point keeps
+ * 
+ * Outputs are driven back to the safe (OFF) level and edge capture is
+ * stopped on interrupt-driven inputs.
+ */
+static void release_previous_points(io_manager_t* manager, const io_previous_points_t* previous) {
+    bool shift_register_changed = false;
+    
+    for (int j = 0; j < previous->count; j++) {
+        const io_point_config_t* config = &previous->configs[j];
+        if (previous->kept_by[j] >= 0) {
+            continue;
+        }
+        
+        if (config->type == IO_POINT_TYPE_GPIO_BO && config->pin >= 0) {
+            ESP_LOGI(TAG, "  Releasing GPIO binary output on pin %d (%s)", config->pin, config->id);
+            gpio_handler_write_digital(&manager->gpio_handler, config->pin, false);
+        } else if (config->type == IO_POINT_TYPE_GPIO_BI && config->input_mode != IO_INPUT_MODE_POLLED) {
+            gpio_handler_release_edge_input(&manager->gpio_handler, config->pin);
+        } else if (config->type == IO_POINT_TYPE_SHIFT_REG_BO) {
+            ESP_LOGI(TAG, "  Releasing shift register binary output (chip: %d, bit: %d) (%s)", 
+                     config->chip_index, config->bit_index, config->id);
+            if (shift_register_set_output_bit(&manager->shift_register_handler, config->chip_index, 
+                                              config->bit_index, false) == ESP_OK) {
+                shift_register_changed = true;
+            }
+        }
+    }
+    
+    if (shift_register_changed) {
+        shift_register_write_outputs(&manager->shift_register_handler);
+    }
+}
+
+/**
+ * @brief Configure IO points from manager->current_config
+ * 
+ * Compiles the hot-path point table used by the polling task. With a
+ * previous point table (reload), points matched by ID whose hardware
+ * mapping is unchanged keep their runtime state, filter state and output
+ * level and are not touched in hardware; only new and remapped points are
+ * configured, outputs no longer driven by any point are switched off, and edge
+ * capture is stopped on inputs no longer used.
+ * Handles stay valid unless a previous index now holds a different point.
+ */
+static esp_err_t configure_io_points(io_manager_t* manager, io_previous_points_t* previous) {
+    ESP_LOGI(TAG, "Starting IO point configuration...");
+    
+    const io_config_t* current = &manager->current_config;
+    int config_count = current->io_point_count;
+    int16_t* previous_index = NULL;
+    bool layout_changed = (previous == NULL);
+    
+    esp_err_t ret = reserve_point_tables(manager, config_count);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    // Match new points to previous ones by ID; only an unchanged hardware mapping is reused
+    if (previous && config_count > 0) {
+        previous_index = psram_smart_malloc(config_count * sizeof(int16_t), ALLOC_NORMAL);
+        if (!previous_index) {
+            return ESP_ERR_NO_MEM;
+        }
+        for (int i = 0; i < config_count; i++) {
+            previous_index[i] = -1;
+        }
+    }
+    if (previous) {
+        for (int j = 0; j < previous->count; j++) {
+            previous->kept_by[j] = -1;
+            for (int i = 0; i < config_count; i++) {
+                if (previous_index[i] < 0 && strcmp(previous->configs[j].id, current->io_points[i].id) == 0) {
+                    if (same_hardware(&previous->configs[j], &current->io_points[i])) {
+                        previous->kept_by[j] = (int16_t)i;
+                        previous_index[i] = (int16_t)j;
+                    }
+                    break;
+                }
+            }
+            
+            if (j < config_count && (strcmp(previous->configs[j].id, current->io_points[j].id) != 0 || 
+                                     previous->configs[j].type != current->io_points[j].type)) {
+                layout_changed = true;
+            }
+        }
+        
+        release_previous_points(manager, previous);
+    }
+    
+    if (layout_changed) {
+        manager->point_generation++; // Invalidate handles issued for the previous table
+    }
+    manager->active_point_count = 0;
+    point_id_index_clear(&manager->id_index);
     
     if (config_count == 0) {
         ESP_LOGW(TAG, "No IO points found in configuration!");
+        allocate_filter_states(manager, previous);
+        build_scan_lists(manager);
         return ESP_OK; // Not an error, just no points configured
     }
     
-    // Configure each IO point
-    for (int i = 0; i < config_count && i < IO_MANAGER_MAX_POINTS; i++) {
-        const io_point_config_t* config = &configs[i];
-        
-        ESP_LOGI(TAG, "Configuring IO point [%d]: %s (type: %d, pin: %d)", 
-                 i, config->id, config->type, config->pin);
+    int kept_count = 0;
+    for (int i = 0; i < config_count; i++) {
+        const io_point_config_t* config = &current->io_points[i];
         
         // Store point ID mapping
         strncpy(manager->point_ids[i], config->id, CONFIG_MAX_ID_LENGTH - 1);
         manager->point_ids[i][CONFIG_MAX_ID_LENGTH - 1] = '\0';
         
-        // Initialize runtime state
+        // Compile hot-path descriptor
+        if (io_manager_compile_point(config, &manager->point_table[i]) != ESP_OK) {
+            ESP_LOGW(TAG, "  Unknown IO point type: %d", config->type);
+        }
+        if (config->pin < 0 && (config->type == IO_POINT_TYPE_GPIO_AI || config->type == IO_POINT_TYPE_GPIO_BI)) {
+            manager->point_table[i].read = NULL;
+        }
+        if ((config->type == IO_POINT_TYPE_SHIFT_REG_BI || config->type == IO_POINT_TYPE_SHIFT_REG_BO) &&
+            !shift_register_point_mapped(manager, &manager->point_table[i])) {
+            ESP_LOGE(TAG, "  Shift register point %s (chip: %d, bit: %d) is outside the chain, not driven", 
+                     config->id, config->chip_index, config->bit_index);
+            manager->point_table[i].chip_index = IO_CHIP_INDEX_UNMAPPED;
+            manager->point_table[i].read = NULL;
+        }
+        
+        if (previous_index && previous_index[i] >= 0) {
+            // Same hardware: keep values, counters, alarm and output state (filter state follows below)
+            manager->runtime_states[i] = previous->states[previous_index[i]];
+            manager->runtime_states[i].filter_state = NULL;
+            kept_count++;
+#ifdef DEBUG_IO_MANAGER
+            ESP_LOGI(TAG, "Keeping IO point [%d]: %s (type: %d, pin: %d)", i, config->id, config->type, config->pin);
+#endif
+        } else {
+            ESP_LOGI(TAG, "Configuring IO point [%d]: %s (type: %d, pin: %d)", 
+                     i, config->id, config->type, config->pin);
+            configure_point_hardware(manager, i);
+        }
+        
+        manager->active_point_count++;
+    }
+    
+    psram_smart_free(previous_index);
+    allocate_filter_states(manager, previous);
+    build_scan_lists(manager);
+    
+    ret = point_id_index_build(&manager->id_index, manager->point_ids[0], CONFIG_MAX_ID_LENGTH, 
+                                         manager->active_point_count);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Point ID index incomplete (duplicate IDs?): %s", esp_err_to_name(ret));
+    }
+    if (manager->alarm_manager) {
+        resolve_alarm_handles(manager);
+    }
+    if (manager->trending_manager) {
+        resolve_trend_handles(manager);
+    }
+    
+    ESP_LOGI(TAG, "IO point configuration complete: %d points configured, %d kept", 
+             manager->active_point_count, kept_count);
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Read analog input point (ADC counts)
+ */
+static esp_err_t read_analog_input(io_manager_t* manager, int point_index, int32_t* raw) {
+    int adc_raw = 0;
+    esp_err_t ret = gpio_handler_read_analog(&manager->gpio_handler, manager->point_table[point_index].pin, &adc_raw);
+    *raw = adc_raw;
+    return ret;
+}
+
+/**
+ * @brief Read binary input point (0 or 1, before inversion)
+ */
+static esp_err_t read_binary_input(io_manager_t* manager, int point_index, int32_t* raw) {
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    bool digital_state = false;
+    esp_err_t ret;
+    
+    if (point->type == IO_POINT_TYPE_GPIO_BI) {
+        // Read GPIO
+        ret = gpio_handler_read_digital(&manager->gpio_handler, point->pin, &digital_state);
+    } else {
+        // Read shift register
+        ret = shift_register_get_input_bit(&manager->shift_register_handler, 
+                                          point->chip_index, point->bit_index, 
+                                          &digital_state);
+    }
+    
+    *raw = digital_state ? 1 : 0;
+    return ret;
+}
+
+/**
+ * @brief Read edge-mode binary input: (accepted edge count << 1) | debounced level
+ */
+static esp_err_t read_edge_input(io_manager_t* manager, int point_index, int32_t* raw) {
+    gpio_edge_status_t status;
+    esp_err_t ret = gpio_handler_read_edge_input(&manager->gpio_handler, manager->point_table[point_index].pin, &status);
+    *raw = (int32_t)((status.edge_count << 1) | (status.level ? 1U : 0U));
+    return ret;
+}
+
+/**
+ * @brief Read counter-mode binary input: running pulse count
+ */
+static esp_err_t read_counter_input(io_manager_t* manager, int point_index, int32_t* raw) {
+    gpio_edge_status_t status;
+    esp_err_t ret = gpio_handler_read_edge_input(&manager->gpio_handler, manager->point_table[point_index].pin, &status);
+    *raw = (int32_t)status.pulse_count;
+    return ret;
+}
+
+/**
+ * @brief Apply a raw sample to an input point's runtime state
+ * 
+ * Caller must hold state_mutex.
+ */
+static void apply_input_sample(io_manager_t* manager, int point_index, esp_err_t result, 
+                               int32_t raw, uint64_t timestamp) {
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    io_point_runtime_state_t* state = &manager->runtime_states[point_index];
+    
+    if (result != ESP_OK) {
+        state->error_state = true;
+        state->error_count++;
+        manager->total_error_count++;
+        record_change(manager, point_index, timestamp);
+        return;
+    }
+    
+    if (point->type == IO_POINT_TYPE_GPIO_AI) {
+        // Scale raw ADC value to engineering units based on range
+        float raw_value = point->range_min + ((float)raw * point->range_scale);
+        state->raw_value = raw_value;
+        state->conditioned_value = signal_conditioner_process(&point->pipeline, state->filter_state, raw_value);
+    } else if (point->input_mode == IO_INPUT_MODE_COUNTER) {
+        // Raw value is the total in units; the rate since the last sample is conditioned
+        uint32_t count = (uint32_t)raw;
+        if (state->update_count > 0 && timestamp > state->last_update_time) {
+            float pulses = (float)(count - state->pulse_count);
+            float seconds = (float)(timestamp - state->last_update_time) * 1e-6f;
+            float rate = pulses * point->units_per_pulse * point->rate_time_base_s / seconds;
+            state->conditioned_value = signal_conditioner_process(&point->pipeline, state->filter_state, rate);
+        }
+        state->pulse_count = count;
+        state->edge_count = count;
+        state->raw_value = (float)count * point->units_per_pulse;
+    } else {
+        // Apply inversion if configured
+        bool digital_state = (raw & 0x01) != 0;
+        if (point->input_mode == IO_INPUT_MODE_EDGE) {
+            state->edge_count = (uint32_t)raw >> 1;
+        }
+        if (point->is_inverted) {
+            digital_state = !digital_state;
+        }
+        state->digital_state = digital_state;
+        state->raw_value = digital_state ? 1.0f : 0.0f;
+        state->conditioned_value = state->raw_value;
+    }
+    
+    state->error_state = false;
+    state->last_update_time = timestamp;
+    state->update_count++;
+    
+    record_change(manager, point_index, timestamp);
+}
+
+/**
+ * @brief Force the outputs of tripped interlocks and release the rest
+ * 
+ * Shift register outputs are written with one latch of the chain, GPIO
+ * outputs right after it. Caller must hold state_mutex, so the hold check
+ * of concurrent output writes cannot interleave with the forcing.
+ * 
+ * @param tripped Tripped interlocks, bit k = interlock k
+ * @param scan_start Start of the scan pass that read the tripping samples
+ */
+static void apply_interlocks(io_manager_t* manager, uint32_t tripped, int64_t scan_start) {
+    uint32_t held[IO_OUTPUT_BATCH_WORDS] = {0};
+    uint32_t states[IO_OUTPUT_BATCH_WORDS] = {0};
+    uint32_t written[IO_OUTPUT_BATCH_WORDS] = {0};
+    uint8_t chip_masks[SHIFT_REGISTER_MAX_CHIPS] = {0};
+    uint8_t chip_values[SHIFT_REGISTER_MAX_CHIPS] = {0};
+    int chip_count = 0;
+    bool tripped_now = false;
+    
+    // Forced state per output: the lowest tripped interlock naming it wins
+    for (int k = 0; k < manager->interlock_count; k++) {
+        int i = manager->interlocks[k].output_index;
+        if (!(tripped & (1U << k)) || i < 0 || (held[i >> 5] & (1U << (i & 31)))) {
+            continue;
+        }
+        held[i >> 5] |= 1U << (i & 31);
+        if (manager->interlocks[k].forced_state) {
+            states[i >> 5] |= 1U << (i & 31);
+        }
+    }
+    
+    // Stage the outputs not yet held in their forced state; release the rest
+    uint32_t forced_outputs = 0;
+    for (int k = 0; k < manager->interlock_count; k++) {
+        int i = manager->interlocks[k].output_index;
+        if (i < 0) {
+            continue;
+        }
         io_point_runtime_state_t* state = &manager->runtime_states[i];
-        memset(state, 0, sizeof(io_point_runtime_state_t));
-        
-        // Configure hardware based on type
-        switch (config->type) {
-            case IO_POINT_TYPE_GPIO_AI:
-                if (config->pin >= 0) {
-                    ESP_LOGI(TAG, "  Configuring GPIO analog input on pin %d", config->pin);
-                    gpio_handler_configure_analog(&manager->gpio_handler, config->pin);
-                } else {
-                    ESP_LOGW(TAG, "  Invalid pin %d for GPIO AI point %s", config->pin, config->id);
-                }
-                break;
-                
-            case IO_POINT_TYPE_GPIO_BI:
-                if (config->pin >= 0) {
-                    ESP_LOGI(TAG, "  Configuring GPIO binary input on pin %d", config->pin);
-                    gpio_handler_configure_input(&manager->gpio_handler, config->pin, true);
-                } else {
-                    ESP_LOGW(TAG, "  Invalid pin %d for GPIO BI point %s", config->pin, config->id);
-                }
-                break;
-                
-            case IO_POINT_TYPE_GPIO_BO:
-                if (config->pin >= 0) {
-                    // SAFETY: Always start with safe state (OFF), gpio_handler now enforces this
-                    ESP_LOGI(TAG, "  Configuring GPIO binary output on pin %d (SAFE INIT)", config->pin);
-                    gpio_handler_configure_output(&manager->gpio_handler, config->pin, false);  // Always start OFF
-                    
-                    // Initialize runtime state to match safe hardware state
-                    state->digital_state = false;  // OFF state
-                    state->raw_value = 0.0f;
-                    state->conditioned_value = 0.0f;
-                } else {
-                    ESP_LOGW(TAG, "  Invalid pin %d for GPIO BO point %s", config->pin, config->id);
+        uint32_t bit = 1U << (i & 31);
+        
+        if (!(held[i >> 5] & bit)) {
+            state->interlocked = false;
+            continue;
+        }
+        if (written[i >> 5] & bit) {
+            continue; // Named by an earlier interlock
+        }
+        const io_point_descriptor_t* point = &manager->point_table[i];
+        if (point->type == IO_POINT_TYPE_SHIFT_REG_BO && !shift_register_point_mapped(manager, point)) {
+            continue; // Outside the chain: skipped so the rest of the chain still latches
+        }
+        written[i >> 5] |= bit;
+        forced_outputs++;
+        
+        bool forced_state = (states[i >> 5] & bit) != 0;
+        if (state->interlocked && state->digital_state == forced_state) {
+            written[i >> 5] &= ~bit; // Already held
+            continue;
+        }
+        if (!state->interlocked) {
+            state->interlocked = true;
+            manager->interlock_stats.trip_count++;
+            tripped_now = true;
+        }
+        
+        if (point->type == IO_POINT_TYPE_SHIFT_REG_BO) {
+            uint8_t chip_bit = (uint8_t)(1 << point->bit_index);
+            chip_masks[point->chip_index] |= chip_bit;
+            if (point->is_inverted ? !forced_state : forced_state) {
+                chip_values[point->chip_index] |= chip_bit;
+            }
+            if (point->chip_index + 1 > chip_count) {
+                chip_count = point->chip_index + 1;
+            }
+        }
+    }
+    manager->interlock_stats.forced_outputs = forced_outputs;
+    
+    // One latch for the chain, then the direct GPIO outputs
+    esp_err_t latch_ret = ESP_OK;
+    if (chip_count > 0) {
+        latch_ret = shift_register_update_outputs(&manager->shift_register_handler, chip_masks, chip_values, chip_count);
+        if (latch_ret != ESP_OK) {
+            ESP_LOGE(TAG, "Interlock latch failed: %s", esp_err_to_name(latch_ret));
+        }
+    }
+    
+    uint64_t now = esp_timer_get_time();
+    for (int w = 0; w < IO_OUTPUT_BATCH_WORDS; w++) {
+        uint32_t pending = written[w];
+        while (pending) {
+            int i = (w << 5) + __builtin_ctz(pending);
+            pending &= pending - 1;
+            
+            const io_point_descriptor_t* point = &manager->point_table[i];
+            bool forced_state = (states[w] >> (i & 31)) & 0x01;
+            esp_err_t ret = latch_ret;
+            if (point->type == IO_POINT_TYPE_GPIO_BO) {
+                ret = gpio_handler_write_digital(&manager->gpio_handler, point->pin, 
+                                                 point->is_inverted ? !forced_state : forced_state);
+                now = esp_timer_get_time();
+            }
+            if (ret != ESP_OK) {
+                continue; // Still held; the next pass retries the write
+            }
+            
+            io_point_runtime_state_t* state = &manager->runtime_states[i];
+            state->digital_state = forced_state;
+            state->raw_value = forced_state ? 1.0f : 0.0f;
+            state->conditioned_value = state->raw_value;
+            state->last_update_time = now;
+            state->update_count++;
+            record_change(manager, i, now);
+        }
+    }
+    
+    if (tripped_now) {
+        uint32_t latency_us = (uint32_t)(now - (uint64_t)scan_start);
+        manager->interlock_stats.last_latency_us = latency_us;
+        if (latency_us > manager->interlock_stats.worst_latency_us) {
+            manager->interlock_stats.worst_latency_us = latency_us;
+        }
+        record_timing(manager, IO_TIMING_INTERLOCK_LATENCY, latency_us);
+    }
+    
+#ifdef DEBUG_IO_MANAGER
+    if (tripped_now) {
+        ESP_LOGI(TAG, "Interlocks 0x%08lx: %lu outputs held, %lu us from scan start", 
+                 (unsigned long)tripped, (unsigned long)forced_outputs, 
+                 (unsigned long)manager->interlock_stats.last_latency_us);
+    }
+#endif
+}
+
+/**
+ * @brief Alarm stage: evaluate the monitored samples of a scan pass as one batch
+ * 
+ * Runs after the pass's samples are applied, so every new conditioned value
+ * is evaluated in the scan that read it, and the interlocks it trips or
+ * releases are applied in the same pass. Caller must hold state_mutex.
+ */
+static void evaluate_alarm_stage(io_manager_t* manager, const io_scan_sample_t* samples, int sample_count, 
+                                 uint64_t timestamp, int64_t scan_start) {
+    alarm_sample_t* batch = manager->alarm_samples;
+    int batch_count = 0;
+    
+    for (int j = 0; j < sample_count; j++) {
+        const io_point_descriptor_t* point = &manager->point_table[samples[j].point_index];
+        if (samples[j].result == ESP_OK && point->alarm_handle >= 0) {
+            batch[batch_count].handle = point->alarm_handle;
+            batch[batch_count].value = manager->runtime_states[samples[j].point_index].conditioned_value;
+            batch[batch_count].source_index = samples[j].point_index;
+            batch[batch_count].active = false;
+            batch_count++;
+        }
+    }
+    
+    uint32_t tripped = 0;
+    if (batch_count == 0 || 
+        alarm_manager_process_samples(manager->alarm_manager, batch, batch_count, timestamp, &tripped) != ESP_OK) {
+        return;
+    }
+    
+    for (int j = 0; j < batch_count; j++) {
+        io_point_runtime_state_t* state = &manager->runtime_states[batch[j].source_index];
+        if (batch[j].active && !state->alarm_active) {
+            state->alarm_count++;
+            state->alarm_start_time = timestamp;
+        }
+        state->alarm_active = batch[j].active;
+    }
+    
+    if (tripped || manager->interlock_tripped) {
+        apply_interlocks(manager, tripped, scan_start);
+        manager->interlock_tripped = tripped;
+    }
+}
+
+/**
+ * @brief Trend stage of a scan pass
+ * 
+ * Records the pass's trended input samples and the state of every trended
+ * binary output as one batch, stamped with the wall-clock time of the
+ * pass; the trending manager keeps only due analog samples and state
+ * changes. Caller must hold state_mutex.
+ */
+static void record_trend_stage(io_manager_t* manager, const io_scan_sample_t* samples, int sample_count) {
+    trending_sample_t* batch = manager->trend_samples;
+    int batch_count = 0;
+    
+    for (int j = 0; j < sample_count; j++) {
+        const io_point_descriptor_t* point = &manager->point_table[samples[j].point_index];
+        if (samples[j].result == ESP_OK && point->trend_handle >= 0) {
+            const io_point_runtime_state_t* state = &manager->runtime_states[samples[j].point_index];
+            batch[batch_count].handle = point->trend_handle;
+            batch[batch_count].value = state->conditioned_value;
+            batch[batch_count].state = state->digital_state;
+            batch_count++;
+        }
+    }
+    for (int k = 0; k < manager->trend_output_count; k++) {
+        uint16_t index = manager->trend_outputs[k];
+        batch[batch_count].handle = manager->point_table[index].trend_handle;
+        batch[batch_count].value = manager->runtime_states[index].digital_state ? 1.0f : 0.0f;
+        batch[batch_count].state = manager->runtime_states[index].digital_state;
+        batch_count++;
+    }
+    if (batch_count == 0) {
+        return;
+    }
+    
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    int64_t time_ms = (int64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+    trending_manager_record_samples(manager->trending_manager, batch, batch_count, time_ms);
+}
+
+/**
+ * @brief Publish runtime states to the reader snapshot
+ * 
+ * Fills the back buffer and flips it to the front. Caller must hold
+ * state_mutex (or be the only writer, as during init).
+ */
+static void publish_snapshot(io_manager_t* manager) {
+    uint32_t back = __atomic_load_n(&manager->snapshot_front, __ATOMIC_RELAXED) ^ 1;
+    io_snapshot_buffer_t* buffer = &manager->snapshot_buffers[back];
+    
+    // Odd sequence marks the buffer as being written
+    __atomic_store_n(&buffer->sequence, buffer->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    
+    int count = manager->active_point_count;
+    for (int i = 0; i < count; i++) {
+        const io_point_runtime_state_t* state = &manager->runtime_states[i];
+        io_point_snapshot_t* point = &buffer->points[i];
+        point->raw_value = state->raw_value;
+        point->conditioned_value = state->conditioned_value;
+        point->last_update_time = state->last_update_time;
+        point->update_count = state->update_count;
+        point->error_count = state->error_count;
+        point->change_sequence = state->change_sequence;
+        point->edge_count = state->edge_count;
+        point->digital_state = state->digital_state;
+        point->error_state = state->error_state;
+        point->alarm_active = state->alarm_active;
+    }
+    buffer->point_count = count;
+    buffer->publish_count = ++manager->snapshot_publish_count;
+    buffer->change_sequence = manager->change_sequence;
+    buffer->generation = manager->point_generation;
+    
+    __atomic_store_n(&buffer->sequence, buffer->sequence + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&manager->snapshot_front, back, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy one or all points out of the published snapshot
+ * 
+ * Lock-free: retries when the writer rewrote the buffer during the copy.
+ */
+static esp_err_t read_snapshot(io_manager_t* manager, int first_index, io_point_snapshot_t* points, 
+                               int max_points, int* actual_count, uint32_t* sequence) {
+    for (int attempt = 0; attempt < IO_MANAGER_SNAPSHOT_MAX_RETRIES; attempt++) {
+        uint32_t front = __atomic_load_n(&manager->snapshot_front, __ATOMIC_ACQUIRE);
+        const io_snapshot_buffer_t* buffer = &manager->snapshot_buffers[front];
+        
+        uint32_t begin = __atomic_load_n(&buffer->sequence, __ATOMIC_ACQUIRE);
+        if (begin & 1) {
+            continue;
+        }
+        
+        // A resize swaps the points array; the replaced one stays valid until the next resize
+        const io_point_snapshot_t* source = __atomic_load_n(&buffer->points, __ATOMIC_ACQUIRE);
+        int count = buffer->point_count - first_index;
+        if (count > max_points) count = max_points;
+        if (count < 0) count = 0;
+        if (count > 0) {
+            memcpy(points, &source[first_index], count * sizeof(io_point_snapshot_t));
+        }
+        uint32_t publish_count = buffer->publish_count;
+        
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&buffer->sequence, __ATOMIC_RELAXED) == begin) {
+            *actual_count = count;
+            if (sequence) *sequence = publish_count;
+            return ESP_OK;
+        }
+    }
+    
+    return ESP_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Read a single point from the published snapshot
+ */
+static esp_err_t read_snapshot_point(io_manager_t* manager, int point_index, io_point_snapshot_t* point) {
+    int count = 0;
+    esp_err_t ret = read_snapshot(manager, point_index, point, 1, &count, NULL);
+    if (ret == ESP_OK && count != 1) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ret;
+}
+
+/**
+ * @brief Scan the input points of the selected scan classes
+ * 
+ * Caller must hold scan_mutex. Hardware is read without state_mutex; the
+ * mutex is held only to apply the samples and publish the snapshot.
+ */
+static esp_err_t scan_due_classes(io_manager_t* manager, uint32_t class_mask, int64_t scan_lock_wait_us) {
+    io_scan_sample_t* samples = manager->scan_samples;
+    int sample_count = 0;
+    int64_t cycle_start = esp_timer_get_time();
+    
+    // Read shift register inputs only when a due class needs them
+    bool read_shift_register = false;
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        if ((class_mask & (1U << c)) && manager->scan_class_reads_shift_register[c]) {
+            read_shift_register = true;
+            break;
+        }
+    }
+    if (read_shift_register) {
+        shift_register_read_inputs(&manager->shift_register_handler);
+    }
+    int64_t acquire_start = esp_timer_get_time();
+    if (read_shift_register) {
+        record_timing(manager, IO_TIMING_SHIFT_REGISTER, acquire_start - cycle_start);
+    }
+    
+    // Acquire samples of each due class
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        if (!(class_mask & (1U << c))) {
+            continue;
+        }
+        
+        const uint16_t* list = manager->scan_lists[c];
+        int count = manager->scan_list_counts[c];
+        for (int k = 0; k < count; k++) {
+            io_scan_sample_t* sample = &samples[sample_count++];
+            sample->point_index = list[k];
+            sample->result = manager->point_table[list[k]].read(manager, list[k], &sample->raw);
+        }
+    }
+    uint64_t timestamp = esp_timer_get_time();
+    record_timing(manager, IO_TIMING_INPUT_READS, (int64_t)timestamp - acquire_start);
+    
+    // Apply and publish
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    int64_t apply_start = esp_timer_get_time();
+    record_timing(manager, IO_TIMING_MUTEX_WAIT, scan_lock_wait_us + (apply_start - (int64_t)timestamp));
+    
+    for (int j = 0; j < sample_count; j++) {
+        apply_input_sample(manager, samples[j].point_index, samples[j].result, samples[j].raw, timestamp);
+    }
+    if (manager->alarm_manager) {
+        evaluate_alarm_stage(manager, samples, sample_count, timestamp, cycle_start);
+    }
+    if (manager->trending_manager) {
+        record_trend_stage(manager, samples, sample_count);
+    }
+    record_timing(manager, IO_TIMING_CONDITIONING, esp_timer_get_time() - apply_start);
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        if (class_mask & (1U << c)) {
+            manager->scan_class_cycle_counts[c]++;
+        }
+    }
+    manager->update_cycle_count++;
+    manager->last_update_time = timestamp;
+    publish_snapshot(manager);
+    
+    xSemaphoreGive(manager->state_mutex);
+    record_timing(manager, IO_TIMING_SCAN_CYCLE, esp_timer_get_time() - cycle_start);
+    return ESP_OK;
+}
+
+/**
+ * @brief IO polling task
+ * 
+ * Deadline-ordered scheduler: each pass scans the classes whose deadline has
+ * passed, then sleeps until the earliest next deadline. Classes without input
+ * points are not scheduled, except the normal class which keeps the cycle
+ * statistics ticking. An overrunning class skips its missed slots instead of
+ * bursting to catch up.
+ */
+static void io_polling_task(void* parameter) {
+    io_manager_t* manager = (io_manager_t*)parameter;
+    TickType_t period[IO_SCAN_CLASS_COUNT];
+    TickType_t next_due[IO_SCAN_CLASS_COUNT];
+    bool scheduled[IO_SCAN_CLASS_COUNT];
+    int64_t last_start_us[IO_SCAN_CLASS_COUNT] = {0};
+    uint32_t skipped_mask = 0;
+    TickType_t now = xTaskGetTickCount();
+    
+    for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+        period[c] = pdMS_TO_TICKS(manager->scan_interval_ms[c]);
+        if (period[c] == 0) {
+            period[c] = 1;
+        }
+        next_due[c] = now;
+        scheduled[c] = (c == IO_SCAN_CLASS_NORMAL) || manager->scan_list_counts[c] > 0;
+    }
+    
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "IO polling task started (fast %lu ms, normal %lu ms, slow %lu ms)",
+             manager->scan_interval_ms[IO_SCAN_CLASS_FAST],
+             manager->scan_interval_ms[IO_SCAN_CLASS_NORMAL],
+             manager->scan_interval_ms[IO_SCAN_CLASS_SLOW]);
+#endif
+    
+    while (manager->polling_task_running) {
+        now = xTaskGetTickCount();
+        
+        // Collect due classes and advance their deadlines
+        uint32_t due_mask = 0;
+        for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+            if (!scheduled[c] || (int32_t)(now - next_due[c]) < 0) {
+                continue;
+            }
+            due_mask |= (1U << c);
+            next_due[c] += period[c];
+            if ((int32_t)(now - next_due[c]) >= 0) {
+                next_due[c] = now + period[c]; // Overrun, skip missed slots
+                skipped_mask |= (1U << c);
+            }
+        }
+        
+        if (due_mask) {
+            int64_t wait_start = esp_timer_get_time();
+            if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+                // Jitter: deviation of each due class's start from one period after its last start
+                for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+                    if (!(due_mask & (1U << c))) {
+                        continue;
+                    }
+                    if (last_start_us[c] != 0) {
+                        int64_t expected_us = (int64_t)period[c] * portTICK_PERIOD_MS * 1000;
+                        int64_t deviation_us = (wait_start - last_start_us[c]) - expected_us;
+                        record_timing(manager, IO_TIMING_WAKE_JITTER, deviation_us < 0 ? -deviation_us : deviation_us);
+                    }
+                    last_start_us[c] = wait_start;
+                    if (skipped_mask & (1U << c)) {
+                        manager->timing.deadline_misses++;
+                    }
                 }
-                break;
-                
-            case IO_POINT_TYPE_SHIFT_REG_BI:
-                ESP_LOGI(TAG, "  Configuring shift register binary input (chip: %d, bit: %d)", 
-                         config->chip_index, config->bit_index);
-                break;
-                
-            case IO_POINT_TYPE_SHIFT_REG_BO:
-                ESP_LOGI(TAG, "  Configuring shift register binary output (chip: %d, bit: %d) (SAFE INIT)", 
-                         config->chip_index, config->bit_index);
-                
-                // SAFETY: Initialize shift register output to safe state (OFF)
-                // The shift register handler already initializes all outputs to 0 during init
-                // Just ensure runtime state matches the safe hardware state
-                state->digital_state = false;  // OFF state
-                state->raw_value = 0.0f;
-                state->conditioned_value = 0.0f;
-                break;
+                skipped_mask &= ~due_mask;
                 
-            default:
-                ESP_LOGW(TAG, "  Unknown IO point type: %d", config->type);
-                break;
+                scan_due_classes(manager, due_mask, esp_timer_get_time() - wait_start);
+                xSemaphoreGive(manager->scan_mutex);
+            }
         }
         
-        manager->active_point_count++;
+        // Sleep until the earliest deadline (stop_polling notifies to wake early)
+        TickType_t next_wake = next_due[IO_SCAN_CLASS_NORMAL];
+        for (int c = 0; c < IO_SCAN_CLASS_COUNT; c++) {
+            if (scheduled[c] && (int32_t)(next_due[c] - next_wake) < 0) {
+                next_wake = next_due[c];
+            }
+        }
+        now = xTaskGetTickCount();
+        if ((int32_t)(next_wake - now) > 0) {
+            ulTaskNotifyTake(pdTRUE, next_wake - now);
+        }
+    }
+    
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "IO polling task stopped");
+#endif
+    
+    xSemaphoreGive(manager->polling_task_exited);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Write a binary output and record its new state
+ * 
+ * Caller must hold state_mutex, so an interlock cannot trip between the
+ * hold check and the write.
+ * 
+ * @param applied_at Pointer to store the time the hardware write completed (may be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if an interlock holds the output
+ */
+static esp_err_t write_binary_output(io_manager_t* manager, int point_index, bool state, uint64_t* applied_at) {
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    
+    // Apply inversion if configured
+    bool hardware_state = point->is_inverted ? !state : state;
+    esp_err_t ret;
+    
+    io_point_runtime_state_t* runtime_state = &manager->runtime_states[point_index];
+    if (runtime_state->interlocked) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // Set hardware state
+    if (point->type == IO_POINT_TYPE_GPIO_BO) {
+        ret = gpio_handler_write_digital(&manager->gpio_handler, point->pin, hardware_state);
+    } else {
+        ret = shift_register_set_output_bit(&manager->shift_register_handler, 
+                                           point->chip_index, point->bit_index, 
+                                           hardware_state);
+        if (ret == ESP_OK) {
+            // Write to hardware
+            ret = shift_register_write_outputs(&manager->shift_register_handler);
+        }
+    }
+    
+    uint64_t now = esp_timer_get_time();
+    if (applied_at) {
+        *applied_at = now;
+    }
+    
+    if (ret == ESP_OK) {
+        // Update runtime state
+        runtime_state->digital_state = state;
+        runtime_state->raw_value = state ? 1.0f : 0.0f;
+        runtime_state->conditioned_value = runtime_state->raw_value;
+        runtime_state->last_update_time = now;
+        runtime_state->update_count++;
+        record_change(manager, point_index, now);
+        publish_snapshot(manager);
+    }
+    
+    return ret;
+}
+
+/**
+ * @brief Drive a binary output and record its new state
+ * 
+ * Holds state_mutex across the hardware write.
+ * 
+ * @param applied_at Pointer to store the time the hardware write completed (may be NULL)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if an interlock holds the output
+ */
+static esp_err_t drive_binary_output(io_manager_t* manager, int point_index, bool state, uint64_t* applied_at) {
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    esp_err_t ret = write_binary_output(manager, point_index, state, applied_at);
+    xSemaphoreGive(manager->state_mutex);
+    return ret;
+}
+
+/**
+ * @brief Restore the pulse heap order upwards from position
+ */
+static void pulse_heap_sift_up(io_pulse_deadline_t* heap, int position) {
+    io_pulse_deadline_t entry = heap[position];
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (heap[parent].deadline <= entry.deadline) {
+            break;
+        }
+        heap[position] = heap[parent];
+        position = parent;
+    }
+    heap[position] = entry;
+}
+
+/**
+ * @brief Restore the pulse heap order downwards from position
+ */
+static void pulse_heap_sift_down(io_pulse_deadline_t* heap, int count, int position) {
+    io_pulse_deadline_t entry = heap[position];
+    for (;;) {
+        int child = 2 * position + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap[child + 1].deadline < heap[child].deadline) {
+            child++;
+        }
+        if (entry.deadline <= heap[child].deadline) {
+            break;
+        }
+        heap[position] = heap[child];
+        position = child;
+    }
+    heap[position] = entry;
+}
+
+/**
+ * @brief Remove the entry at position from the pulse heap
+ * 
+ * Caller must hold pulse_mutex.
+ */
+static io_pulse_deadline_t pulse_heap_remove(io_manager_t* manager, int position) {
+    io_pulse_deadline_t* heap = manager->pulse_heap;
+    io_pulse_deadline_t removed = heap[position];
+    int last = --manager->pulse_heap_count;
+    
+    if (position < last) {
+        heap[position] = heap[last];
+        pulse_heap_sift_down(heap, last, position);
+        pulse_heap_sift_up(heap, position);
     }
-    
-    ESP_LOGI(TAG, "IO point configuration complete: %d points configured", manager->active_point_count);
-    
-    // Free PSRAM allocation
-    psram_smart_free(configs);
-    ESP_LOGI(TAG, "PSRAM configuration array freed");
-    
-    return ESP_OK;
+    return removed;
 }
 
 /**
- * @brief Update analog input point
+ * @brief Arm the pulse timer for the earliest pending deadline
+ * 
+ * Caller must hold pulse_mutex.
  */
-static esp_err_t update_analog_input(io_manager_t* manager, int point_index) {
-    io_point_config_t config;
-    esp_err_t ret = config_manager_get_io_point_config(manager->config_manager, 
-                                                      manager->point_ids[point_index], 
-                                                      &config);
-    if (ret != ESP_OK) {
-        return ret;
+static void arm_pulse_timer(io_manager_t* manager) {
+    esp_timer_stop(manager->pulse_timer); // Not running is fine
+    if (manager->pulse_heap_count == 0) {
+        return;
     }
     
-    io_point_runtime_state_t* state = &manager->runtime_states[point_index];
+    int64_t delay_us = (int64_t)manager->pulse_heap[0].deadline - esp_timer_get_time();
+    esp_timer_start_once(manager->pulse_timer, delay_us > 0 ? (uint64_t)delay_us : 0);
+}
+
+/**
+ * @brief Record the end of a pulse in the point's runtime state
+ * 
+ * Caller must hold state_mutex.
+ * 
+ * @param completed True if the timer switched the output off, false if a write cancelled it
+ *                  or an interlock held the output
+ */
+static void finish_pulse(io_manager_t* manager, const io_pulse_deadline_t* pulse, uint64_t ended_at, bool completed) {
+    uint64_t achieved_us = ended_at - pulse->start_time;
     
-    // Read ADC value using GPIO handler
-    int adc_raw = 0;
-    ret = gpio_handler_read_analog(&manager->gpio_handler, config.pin, &adc_raw);
-    if (ret != ESP_OK) {
-        state->error_state = true;
-        state->error_count++;
-        return ret;
+    if (completed) {
+        int64_t error_us = (int64_t)achieved_us - (int64_t)(pulse->deadline - pulse->start_time);
+        if (error_us < 0) {
+            error_us = -error_us;
+        }
+        if (error_us > manager->pulse_worst_error_us) {
+            manager->pulse_worst_error_us = error_us;
+        }
+        manager->pulse_completed_count++;
     }
     
-    // Convert raw ADC value to engineering units
-    float raw_value = (float)adc_raw;
-    
-    // Scale to engineering units based on range
-    float range_span = config.range_max - config.range_min;
-    float normalized = raw_value / 4095.0f; // Normalize to 0-1
-    raw_value = config.range_min + (normalized * range_span);
-    
-    // Apply signal conditioning
-    float conditioned_value = apply_signal_conditioning(&config, state, raw_value);
+    io_point_runtime_state_t* state = &manager->runtime_states[pulse->point_index];
+    state->timed_pulse_active = false;
+    state->timed_pulse_achieved_us = achieved_us;
     
-    // Update state
-    state->raw_value = raw_value;
-    state->conditioned_value = conditioned_value;
-    state->error_state = false;
-    state->last_update_time = esp_timer_get_time();
-    state->update_count++;
-    
-    return ESP_OK;
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "Pulse on %s %s: %llu us requested, %llu us achieved", 
+             manager->point_ids[pulse->point_index], completed ? "completed" : "cancelled",
+             pulse->deadline - pulse->start_time, achieved_us);
+#endif
 }
 
 /**
- * @brief Update binary input point
+ * @brief Cancel a point's pending switch-off, if any
+ * 
+ * Caller must hold pulse_mutex.
  */
-static esp_err_t update_binary_input(io_manager_t* manager, int point_index) {
-    io_point_config_t config;
-    esp_err_t ret = config_manager_get_io_point_config(manager->config_manager, 
-                                                      manager->point_ids[point_index], 
-                                                      &config);
-    if (ret != ESP_OK) {
-        return ret;
+static void cancel_pulse(io_manager_t* manager, int point_index) {
+    for (int i = 0; i < manager->pulse_heap_count; i++) {
+        if (manager->pulse_heap[i].point_index == point_index) {
+            bool earliest = (i == 0);
+            io_pulse_deadline_t pulse = pulse_heap_remove(manager, i);
+            if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+                finish_pulse(manager, &pulse, esp_timer_get_time(), false);
+                xSemaphoreGive(manager->state_mutex);
+            }
+            if (earliest) {
+                arm_pulse_timer(manager);
+            }
+            return;
+        }
     }
+}
+
+/**
+ * @brief Pulse timer callback (esp_timer task)
+ * 
+ * Switches off every output whose deadline has passed and re-arms for the
+ * next one. Never blocks on the pulse or state mutex: if a caller holds
+ * either, the callback retries shortly instead of stalling other esp_timer
+ * callbacks. A failed switch-off stays at the head of the heap and is
+ * retried; only a successful OFF write counts as a completed pulse.
+ */
+static void pulse_timer_callback(void* arg) {
+    io_manager_t* manager = (io_manager_t*)arg;
     
-    io_point_runtime_state_t* state = &manager->runtime_states[point_index];
-    bool digital_state = false;
-    
-    if (config.type == IO_POINT_TYPE_GPIO_BI) {
-        // Read GPIO
-        ret = gpio_handler_read_digital(&manager->gpio_handler, config.pin, &digital_state);
-    } else if (config.type == IO_POINT_TYPE_SHIFT_REG_BI) {
-        // Read shift register
-        ret = shift_register_get_input_bit(&manager->shift_register_handler, 
-                                          config.chip_index, config.bit_index, 
-                                          &digital_state);
+    if (xSemaphoreTake(manager->pulse_mutex, 0) != pdTRUE) {
+        esp_timer_start_once(manager->pulse_timer, IO_MANAGER_PULSE_RETRY_US);
+        return;
     }
-    
-    if (ret != ESP_OK) {
-        state->error_state = true;
-        state->error_count++;
-        return ret;
+    if (xSemaphoreTake(manager->state_mutex, 0) != pdTRUE) {
+        xSemaphoreGive(manager->pulse_mutex);
+        esp_timer_start_once(manager->pulse_timer, IO_MANAGER_PULSE_RETRY_US);
+        return;
     }
     
-    // Apply inversion if configured
-    if (config.is_inverted) {
-        digital_state = !digital_state;
+    bool retry = false;
+    while (manager->pulse_heap_count > 0 && manager->pulse_heap[0].deadline <= (uint64_t)esp_timer_get_time()) {
+        io_pulse_deadline_t* pulse = &manager->pulse_heap[0];
+        uint64_t applied_at = 0;
+        esp_err_t ret = write_binary_output(manager, pulse->point_index, false, &applied_at);
+        if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) { // An interlock holding it already decided the state
+            if (pulse->retries++ == 0) {
+                ESP_LOGE(TAG, "Pulse switch-off failed on %s: %s, retrying", 
+                         manager->point_ids[pulse->point_index], esp_err_to_name(ret));
+            }
+            retry = true;
+            break;
+        }
+        
+        io_pulse_deadline_t finished = pulse_heap_remove(manager, 0);
+        finish_pulse(manager, &finished, applied_at, ret == ESP_OK);
     }
+    xSemaphoreGive(manager->state_mutex);
     
-    // Update state
-    state->digital_state = digital_state;
-    state->raw_value = digital_state ? 1.0f : 0.0f;
-    state->conditioned_value = state->raw_value;
-    state->error_state = false;
-    state->last_update_time = esp_timer_get_time();
-    state->update_count++;
-    
-    return ESP_OK;
+    if (retry) {
+        esp_timer_stop(manager->pulse_timer); // Not running is fine
+        esp_timer_start_once(manager->pulse_timer, IO_MANAGER_PULSE_RETRY_US);
+    } else {
+        arm_pulse_timer(manager);
+    }
+    xSemaphoreGive(manager->pulse_mutex);
 }
 
 /**
- * @brief IO polling task
+ * @brief Move pending pulses to the reloaded point table
+ * 
+ * Pulses of outputs no point keeps are dropped; release_previous_points
+ * already switched those outputs off. Caller must hold pulse_mutex.
  */
-static void io_polling_task(void* parameter) {
-    io_manager_t* manager = (io_manager_t*)parameter;
-    TickType_t last_wake_time = xTaskGetTickCount();
-    
-#ifdef DEBUG_IO_MANAGER
-    ESP_LOGI(TAG, "IO polling task started");
-#endif
+static void remap_pulses(io_manager_t* manager, const io_previous_points_t* previous) {
+    int kept = 0;
+    
+    for (int i = 0; i < manager->pulse_heap_count; i++) {
+        io_pulse_deadline_t pulse = manager->pulse_heap[i];
+        int new_index = pulse.point_index < previous->count ? previous->kept_by[pulse.point_index] : -1;
+        if (new_index >= 0) {
+            pulse.point_index = (uint16_t)new_index;
+            manager->pulse_heap[kept++] = pulse;
+        }
+    }
     
-    while (manager->polling_task_running) {
-        // Take mutex for state access
+    manager->pulse_heap_count = kept;
+    for (int i = kept / 2 - 1; i >= 0; i--) {
+        pulse_heap_sift_down(manager->pulse_heap, kept, i);
+    }
+    arm_pulse_timer(manager);
+}
+
+/**
+ * @brief Switch off every pending pulse now (shutdown)
+ */
+static void stop_pulses(io_manager_t* manager) {
+    xSemaphoreTake(manager->pulse_mutex, portMAX_DELAY);
+    esp_timer_stop(manager->pulse_timer);
+    while (manager->pulse_heap_count > 0) {
+        io_pulse_deadline_t pulse = pulse_heap_remove(manager, 0);
+        uint64_t applied_at = 0;
+        drive_binary_output(manager, pulse.point_index, false, &applied_at);
         if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            
-            // Read shift register inputs first
-            shift_register_read_inputs(&manager->shift_register_handler);
-            
-            // Update all input points
-            for (int i = 0; i < manager->active_point_count; i++) {
-                io_point_config_t config;
-                if (config_manager_get_io_point_config(manager->config_manager, 
-                                                      manager->point_ids[i], 
-                                                      &config) == ESP_OK) {
-                    
-                    switch (config.type) {
-                        case IO_POINT_TYPE_GPIO_AI:
-                            update_analog_input(manager, i);
-                            break;
-                            
-                        case IO_POINT_TYPE_GPIO_BI:
-                        case IO_POINT_TYPE_SHIFT_REG_BI:
-                            update_binary_input(manager, i);
-                            break;
-                            
-                        default:
-                            // Output points don't need updating
-                            break;
-                    }
-                }
-            }
-            
-            manager->update_cycle_count++;
-            manager->last_update_time = esp_timer_get_time();
-            
+            finish_pulse(manager, &pulse, applied_at, false);
             xSemaphoreGive(manager->state_mutex);
         }
-        
-        // Wait for next polling interval
-        vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(1000)); // 1 second default
     }
-    
-#ifdef DEBUG_IO_MANAGER
-    ESP_LOGI(TAG, "IO polling task stopped");
-#endif
-    
-    vTaskDelete(NULL);
+    xSemaphoreGive(manager->pulse_mutex);
 }
 
 esp_err_t io_manager_init(io_manager_t* manager, config_manager_t* config_manager) {
@@ -374,12 +1724,44 @@ esp_err_t io_manager_init(io_manager_t* manager, config_manager_t* config_manage
         return ESP_ERR_NO_MEM;
     }
     
+    manager->scan_mutex = xSemaphoreCreateMutex();
+    if (!manager->scan_mutex) {
+#ifdef DEBUG_IO_MANAGER
+        ESP_LOGE(TAG, "Failed to create scan mutex");
+#endif
+        vSemaphoreDelete(manager->state_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Output switch-offs run from an esp_timer task callback, independent of the polling task
+    manager->pulse_mutex = xSemaphoreCreateMutex();
+    const esp_timer_create_args_t pulse_timer_args = {
+        .callback = pulse_timer_callback,
+        .arg = manager,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "io_pulse"
+    };
+    if (!manager->pulse_mutex || esp_timer_create(&pulse_timer_args, &manager->pulse_timer) != ESP_OK) {
+#ifdef DEBUG_IO_MANAGER
+        ESP_LOGE(TAG, "Failed to create pulse timer");
+#endif
+        if (manager->pulse_mutex) {
+            vSemaphoreDelete(manager->pulse_mutex);
+        }
+        vSemaphoreDelete(manager->scan_mutex);
+        vSemaphoreDelete(manager->state_mutex);
+        return ESP_ERR_NO_MEM;
+    }
+    
     // Initialize GPIO handler
     esp_err_t ret = gpio_handler_init(&manager->gpio_handler);
     if (ret != ESP_OK) {
 #ifdef DEBUG_IO_MANAGER
         ESP_LOGE(TAG, "Failed to initialize GPIO handler: %s", esp_err_to_name(ret));
 #endif
+        esp_timer_delete(manager->pulse_timer);
+        vSemaphoreDelete(manager->pulse_mutex);
+        vSemaphoreDelete(manager->scan_mutex);
         vSemaphoreDelete(manager->state_mutex);
         return ret;
     }
@@ -394,6 +1776,9 @@ esp_err_t io_manager_init(io_manager_t* manager, config_manager_t* config_manage
             ESP_LOGE(TAG, "Failed to initialize shift register handler: %s", esp_err_to_name(ret));
 #endif
             gpio_handler_destroy(&manager->gpio_handler);
+            esp_timer_delete(manager->pulse_timer);
+            vSemaphoreDelete(manager->pulse_mutex);
+            vSemaphoreDelete(manager->scan_mutex);
             vSemaphoreDelete(manager->state_mutex);
             return ret;
         }
@@ -401,17 +1786,29 @@ esp_err_t io_manager_init(io_manager_t* manager, config_manager_t* config_manage
     
     
     // Configure IO points
-    ret = configure_io_points(manager);
+    ret = fetch_point_configs(manager);
+    if (ret == ESP_OK) {
+        ret = configure_io_points(manager, NULL);
+    }
     if (ret != ESP_OK) {
 #ifdef DEBUG_IO_MANAGER
         ESP_LOGE(TAG, "Failed to configure IO points: %s", esp_err_to_name(ret));
 #endif
+        release_point_tables(manager);
+        signal_conditioner_pool_release(&manager->filter_pool);
         shift_register_handler_destroy(&manager->shift_register_handler);
         gpio_handler_destroy(&manager->gpio_handler);
+        esp_timer_delete(manager->pulse_timer);
+        vSemaphoreDelete(manager->pulse_mutex);
+        vSemaphoreDelete(manager->scan_mutex);
         vSemaphoreDelete(manager->state_mutex);
         return ret;
     }
     
+    start_adc_acquisition(manager);
+    
+    // Publish initial (safe) states before any reader can see the manager
+    publish_snapshot(manager);
     manager->initialized = true;
     
 #ifdef DEBUG_IO_MANAGER
@@ -431,6 +1828,26 @@ esp_err_t io_manager_start_polling(io_manager_t* manager, uint32_t polling_inter
         return ESP_ERR_INVALID_STATE; // Already running
     }
     
+    if (!manager->polling_task_exited) {
+        manager->polling_task_exited = xSemaphoreCreateBinary();
+        if (!manager->polling_task_exited) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if (manager->polling_task_handle) {
+        // A stop timed out; the previous task must be gone before another starts
+        if (xSemaphoreTake(manager->polling_task_exited, 0) != pdTRUE) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        manager->polling_task_handle = NULL;
+    }
+    
+    manager->polling_interval_ms = polling_interval_ms > 0 ? 
+                                   polling_interval_ms : IO_MANAGER_DEFAULT_POLLING_INTERVAL_MS;
+    manager->polling_task_priority = task_priority;
+    manager->polling_task_stack_size = task_stack_size;
+    update_scan_intervals(manager);
+    
     manager->polling_task_running = true;
     
     BaseType_t result = xTaskCreate(io_polling_task, "io_polling", 
@@ -445,129 +1862,467 @@ esp_err_t io_manager_start_polling(io_manager_t* manager, uint32_t polling_inter
         return ESP_ERR_NO_MEM;
     }
     
-#ifdef DEBUG_IO_MANAGER
-    ESP_LOGI(TAG, "IO polling task started (interval: %lu ms)", polling_interval_ms);
-#endif
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "IO polling task started (interval: %lu ms)", manager->polling_interval_ms);
+#endif
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_stop_polling(io_manager_t* manager) {
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!manager->polling_task_running) {
+        return ESP_OK; // Already stopped
+    }
+    
+    manager->polling_task_running = false;
+    
+    // Wake the task from its deadline sleep and wait until it has left its loop
+    if (manager->polling_task_handle) {
+        xTaskNotifyGive(manager->polling_task_handle);
+        if (xSemaphoreTake(manager->polling_task_exited, 
+                           pdMS_TO_TICKS(IO_MANAGER_POLLING_STOP_TIMEOUT_MS)) != pdTRUE) {
+            ESP_LOGE(TAG, "Polling task did not stop within %d ms", IO_MANAGER_POLLING_STOP_TIMEOUT_MS);
+            return ESP_ERR_TIMEOUT;
+        }
+        manager->polling_task_handle = NULL;
+    }
+    
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "IO polling task stopped");
+#endif
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_resolve_handle(io_manager_t* manager, const char* point_id, io_point_handle_t* handle) {
+    if (!manager || !manager->initialized || !point_id || !handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = find_point_index(manager, point_id);
+    if (point_index < 0) {
+        *handle = IO_POINT_HANDLE_INVALID;
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    *handle = ((io_point_handle_t)manager->point_generation << 16) | (io_point_handle_t)point_index;
+    return ESP_OK;
+}
+
+esp_err_t io_manager_set_binary_output(io_manager_t* manager, const char* point_id, bool state) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_set_binary_output_by_handle(manager, handle, state);
+}
+
+esp_err_t io_manager_set_binary_output_by_handle(io_manager_t* manager, io_point_handle_t handle, bool state) {
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    
+    // Verify it's a binary output
+    if (point->type != IO_POINT_TYPE_GPIO_BO && point->type != IO_POINT_TYPE_SHIFT_REG_BO) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // An explicit write overrides a pending pulse switch-off; the timer callback changes the heap
+    if (xSemaphoreTake(manager->pulse_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    cancel_pulse(manager, point_index);
+    xSemaphoreGive(manager->pulse_mutex);
+    
+    return drive_binary_output(manager, point_index, state, NULL);
+}
+
+esp_err_t io_manager_get_binary_output_by_handle(io_manager_t* manager, io_point_handle_t handle, bool* state) {
+    if (!manager || !manager->initialized || !state) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    io_point_snapshot_t snapshot;
+    esp_err_t ret = read_snapshot_point(manager, point_index, &snapshot);
+    if (ret == ESP_OK) {
+        *state = snapshot.digital_state;
+    }
+    
+    return ret;
+}
+
+esp_err_t io_manager_get_binary_output(io_manager_t* manager, const char* point_id, bool* state) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_get_binary_output_by_handle(manager, handle, state);
+}
+
+esp_err_t io_manager_pulse_output_by_handle(io_manager_t* manager, io_point_handle_t handle, uint64_t duration_us) {
+    if (!manager || !manager->initialized || duration_us == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    uint8_t type = manager->point_table[point_index].type;
+    if (type != IO_POINT_TYPE_GPIO_BO && type != IO_POINT_TYPE_SHIFT_REG_BO) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (xSemaphoreTake(manager->pulse_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    // Re-pulsing restarts the on-time
+    cancel_pulse(manager, point_index);
+    
+    uint64_t applied_at = 0;
+    esp_err_t ret = drive_binary_output(manager, point_index, true, &applied_at);
+    if (ret == ESP_OK) {
+        // One pending pulse per point at most, so the heap never outgrows the point table
+        io_pulse_deadline_t* pulse = &manager->pulse_heap[manager->pulse_heap_count];
+        pulse->deadline = applied_at + duration_us;
+        pulse->start_time = applied_at;
+        pulse->point_index = (uint16_t)point_index;
+        pulse->retries = 0;
+        pulse_heap_sift_up(manager->pulse_heap, manager->pulse_heap_count++);
+        
+        if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            io_point_runtime_state_t* state = &manager->runtime_states[point_index];
+            state->timed_pulse_active = true;
+            state->timed_pulse_start_time = applied_at;
+            state->timed_pulse_requested_us = duration_us;
+            state->timed_pulse_achieved_us = 0;
+            xSemaphoreGive(manager->state_mutex);
+        }
+        
+        arm_pulse_timer(manager);
+    }
+    
+    xSemaphoreGive(manager->pulse_mutex);
+    return ret;
+}
+
+esp_err_t io_manager_pulse_output(io_manager_t* manager, const char* point_id, uint64_t duration_us) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_pulse_output_by_handle(manager, handle, duration_us);
+}
+
+esp_err_t io_manager_dose_volume_by_handle(io_manager_t* manager, io_point_handle_t handle, float volume_ml) {
+    if (!manager || !manager->initialized || !(volume_ml > 0.0f)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // A reload replaces the point configurations under state_mutex
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    int point_index = handle_to_index(manager, handle);
+    float flow_rate = point_index >= 0 ? manager->current_config.io_points[point_index].flow_rate_ml_per_second : 0.0f;
+    xSemaphoreGive(manager->state_mutex);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (!(flow_rate > 0.0f)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    uint64_t duration_us = (uint64_t)((double)volume_ml / flow_rate * 1000000.0 + 0.5);
+    return io_manager_pulse_output_by_handle(manager, handle, duration_us > 0 ? duration_us : 1);
+}
+
+esp_err_t io_manager_dose_volume(io_manager_t* manager, const char* point_id, float volume_ml) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_dose_volume_by_handle(manager, handle, volume_ml);
+}
+
+esp_err_t io_manager_get_pulse_result_by_handle(io_manager_t* manager, io_point_handle_t handle, 
+                                                io_pulse_result_t* result) {
+    if (!manager || !manager->initialized || !result) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    const io_point_runtime_state_t* state = &manager->runtime_states[point_index];
+    result->active = state->timed_pulse_active;
+    result->start_time = state->timed_pulse_start_time;
+    result->requested_us = state->timed_pulse_requested_us;
+    result->achieved_us = state->timed_pulse_achieved_us;
+    xSemaphoreGive(manager->state_mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_begin_outputs(io_manager_t* manager, io_output_batch_t* batch) {
+    if (!manager || !manager->initialized || !batch) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memset(batch, 0, sizeof(io_output_batch_t));
+    batch->generation = manager->point_generation;
     
     return ESP_OK;
 }
 
-esp_err_t io_manager_stop_polling(io_manager_t* manager) {
-    if (!manager || !manager->initialized) {
-        return ESP_ERR_INVALID_STATE;
+esp_err_t io_manager_set_output(io_manager_t* manager, io_output_batch_t* batch, io_point_handle_t handle, bool state) {
+    if (!manager || !manager->initialized || !batch) {
+        return ESP_ERR_INVALID_ARG;
     }
     
-    if (!manager->polling_task_running) {
-        return ESP_OK; // Already stopped
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0 || (handle >> 16) != batch->generation) {
+        return ESP_ERR_NOT_FOUND;
     }
     
-    manager->polling_task_running = false;
+    uint8_t type = manager->point_table[point_index].type;
+    if (type != IO_POINT_TYPE_GPIO_BO && type != IO_POINT_TYPE_SHIFT_REG_BO) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Wait for task to finish
-    if (manager->polling_task_handle) {
-        vTaskDelay(pdMS_TO_TICKS(100)); // Give task time to exit
-        manager->polling_task_handle = NULL;
+    // Early refusal; the commit checks again under state_mutex
+    if (manager->runtime_states[point_index].interlocked) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-#ifdef DEBUG_IO_MANAGER
-    ESP_LOGI(TAG, "IO polling task stopped");
-#endif
+    uint32_t bit = 1U << (point_index & 31);
+    int word = point_index >> 5;
+    
+    if (!(batch->staged[word] & bit)) {
+        batch->staged[word] |= bit;
+        batch->staged_count++;
+    }
+    
+    if (state) {
+        batch->states[word] |= bit;
+    } else {
+        batch->states[word] &= ~bit;
+    }
     
     return ESP_OK;
 }
 
-esp_err_t io_manager_set_binary_output(io_manager_t* manager, const char* point_id, bool state) {
-    if (!manager || !manager->initialized || !point_id) {
+bool io_manager_output_staged(const io_output_batch_t* batch, io_point_handle_t handle) {
+    if (!batch || (handle >> 16) != batch->generation) {
+        return false;
+    }
+    
+    int point_index = (int)(handle & 0xFFFF);
+    if (point_index >= IO_MANAGER_MAX_POINTS) {
+        return false;
+    }
+    return (batch->staged[point_index >> 5] >> (point_index & 31)) & 0x01;
+}
+
+esp_err_t io_manager_commit_outputs(io_manager_t* manager, io_output_batch_t* batch) {
+    if (!manager || !manager->initialized || !batch) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Get point configuration
-    io_point_config_t config;
-    esp_err_t ret = config_manager_get_io_point_config(manager->config_manager, point_id, &config);
-    if (ret != ESP_OK) {
-        return ret;
+    if (batch->generation != manager->point_generation) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // Verify it's a binary output
-    if (config.type != IO_POINT_TYPE_GPIO_BO && config.type != IO_POINT_TYPE_SHIFT_REG_BO) {
-        return ESP_ERR_INVALID_ARG;
+    if (batch->staged_count == 0) {
+        return ESP_OK;
     }
     
-    // Apply inversion if configured
-    bool hardware_state = config.is_inverted ? !state : state;
+    // Staged writes override pending pulse switch-offs; the timer callback changes the heap
+    if (xSemaphoreTake(manager->pulse_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    for (int i = manager->pulse_heap_count - 1; i >= 0; i--) {
+        int point_index = manager->pulse_heap[i].point_index;
+        if (batch->staged[point_index >> 5] & (1U << (point_index & 31))) {
+            cancel_pulse(manager, point_index);
+            i = manager->pulse_heap_count; // Heap reordered, rescan
+        }
+    }
+    xSemaphoreGive(manager->pulse_mutex);
     
-    // Set hardware state
-    if (config.type == IO_POINT_TYPE_GPIO_BO) {
-        ret = gpio_handler_write_digital(&manager->gpio_handler, config.pin, hardware_state);
-    } else if (config.type == IO_POINT_TYPE_SHIFT_REG_BO) {
-        ret = shift_register_set_output_bit(&manager->shift_register_handler, 
-                                           config.chip_index, config.bit_index, 
-                                           hardware_state);
-        if (ret == ESP_OK) {
-            // Write to hardware
-            ret = shift_register_write_outputs(&manager->shift_register_handler);
+    // Held until the changes are recorded, so no interlock trips between the hold check and the write
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    // Merge shift register changes into per-chip masks
+    uint8_t chip_masks[SHIFT_REGISTER_MAX_CHIPS] = {0};
+    uint8_t chip_values[SHIFT_REGISTER_MAX_CHIPS] = {0};
+    int chip_count = 0;
+    esp_err_t ret = ESP_OK;
+    
+    for (int i = 0; i < manager->active_point_count; i++) {
+        if (!(batch->staged[i >> 5] & (1U << (i & 31)))) {
+            continue;
+        }
+        if (manager->runtime_states[i].interlocked) {
+            batch->staged[i >> 5] &= ~(1U << (i & 31)); // Refused, the rest of the batch still applies
+            batch->staged_count--;
+            ret = ESP_ERR_INVALID_STATE;
+            continue;
+        }
+        
+        const io_point_descriptor_t* point = &manager->point_table[i];
+        if (point->type != IO_POINT_TYPE_SHIFT_REG_BO) {
+            continue;
+        }
+        if (!shift_register_point_mapped(manager, point)) {
+            batch->staged[i >> 5] &= ~(1U << (i & 31)); // Outside the chain, the rest of the batch still applies
+            batch->staged_count--;
+            ret = ESP_ERR_INVALID_ARG;
+            continue;
+        }
+        
+        bool state = (batch->states[i >> 5] >> (i & 31)) & 0x01;
+        bool hardware_state = point->is_inverted ? !state : state;
+        uint8_t bit = (uint8_t)(1 << point->bit_index);
+        
+        chip_masks[point->chip_index] |= bit;
+        if (hardware_state) {
+            chip_values[point->chip_index] |= bit;
+        }
+        if (point->chip_index + 1 > chip_count) {
+            chip_count = point->chip_index + 1;
         }
     }
     
-    if (ret == ESP_OK) {
-        // Update runtime state
-        int point_index = find_point_index(manager, point_id);
-        if (point_index >= 0) {
-            if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-                io_point_runtime_state_t* runtime_state = &manager->runtime_states[point_index];
-                runtime_state->digital_state = state;
-                runtime_state->raw_value = state ? 1.0f : 0.0f;
-                runtime_state->conditioned_value = runtime_state->raw_value;
-                runtime_state->last_update_time = esp_timer_get_time();
-                runtime_state->update_count++;
-                xSemaphoreGive(manager->state_mutex);
-            }
+    // One write for the whole chain: every changed relay switches on the same latch edge
+    if (chip_count > 0) {
+        esp_err_t latch_ret = shift_register_update_outputs(&manager->shift_register_handler, 
+                                                            chip_masks, chip_values, chip_count);
+        if (latch_ret != ESP_OK) {
+            ESP_LOGE(TAG, "Output batch latch failed: %s", esp_err_to_name(latch_ret));
+            xSemaphoreGive(manager->state_mutex);
+            return latch_ret;
         }
     }
     
-    return ret;
-}
-
-esp_err_t io_manager_get_binary_output(io_manager_t* manager, const char* point_id, bool* state) {
-    if (!manager || !manager->initialized || !point_id || !state) {
-        return ESP_ERR_INVALID_ARG;
+    // Direct GPIO outputs follow the latch back to back
+    for (int i = 0; i < manager->active_point_count; i++) {
+        if (!(batch->staged[i >> 5] & (1U << (i & 31)))) {
+            continue;
+        }
+        
+        const io_point_descriptor_t* point = &manager->point_table[i];
+        if (point->type != IO_POINT_TYPE_GPIO_BO) {
+            continue;
+        }
+        
+        bool state = (batch->states[i >> 5] >> (i & 31)) & 0x01;
+        esp_err_t gpio_ret = gpio_handler_write_digital(&manager->gpio_handler, point->pin, 
+                                                        point->is_inverted ? !state : state);
+        if (gpio_ret != ESP_OK) {
+            ESP_LOGE(TAG, "Output batch GPIO write failed on pin %d: %s", point->pin, esp_err_to_name(gpio_ret));
+            batch->staged[i >> 5] &= ~(1U << (i & 31)); // Leave runtime state untouched
+            ret = gpio_ret;
+        }
     }
     
-    int point_index = find_point_index(manager, point_id);
-    if (point_index < 0) {
-        return ESP_ERR_NOT_FOUND;
+    // Record every applied change and publish once
+    uint64_t now = esp_timer_get_time();
+    for (int i = 0; i < manager->active_point_count; i++) {
+        if (!(batch->staged[i >> 5] & (1U << (i & 31)))) {
+            continue;
+        }
+        
+        bool state = (batch->states[i >> 5] >> (i & 31)) & 0x01;
+        io_point_runtime_state_t* runtime_state = &manager->runtime_states[i];
+        runtime_state->digital_state = state;
+        runtime_state->raw_value = state ? 1.0f : 0.0f;
+        runtime_state->conditioned_value = runtime_state->raw_value;
+        runtime_state->last_update_time = now;
+        runtime_state->update_count++;
+        record_change(manager, i, now);
     }
     
-    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        *state = manager->runtime_states[point_index].digital_state;
-        xSemaphoreGive(manager->state_mutex);
-        return ESP_OK;
+    publish_snapshot(manager);
+    xSemaphoreGive(manager->state_mutex);
+    
+#ifdef DEBUG_IO_MANAGER
+    ESP_LOGI(TAG, "Committed output batch: %d points, %d shift register chips in one latch", 
+             batch->staged_count, chip_count);
+#endif
+    
+    if (ret == ESP_OK) {
+        memset(batch->staged, 0, sizeof(batch->staged));
+        batch->staged_count = 0;
     }
     
-    return ESP_ERR_TIMEOUT;
+    return ret;
 }
 
-esp_err_t io_manager_get_analog_conditioned(io_manager_t* manager, const char* point_id, float* value) {
-    if (!manager || !manager->initialized || !point_id || !value) {
+esp_err_t io_manager_get_analog_conditioned_by_handle(io_manager_t* manager, io_point_handle_t handle, float* value) {
+    if (!manager || !manager->initialized || !value) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    int point_index = find_point_index(manager, point_id);
+    int point_index = handle_to_index(manager, handle);
     if (point_index < 0) {
         return ESP_ERR_NOT_FOUND;
     }
     
-    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        *value = manager->runtime_states[point_index].conditioned_value;
-        xSemaphoreGive(manager->state_mutex);
-        return ESP_OK;
+    io_point_snapshot_t snapshot;
+    esp_err_t ret = read_snapshot_point(manager, point_index, &snapshot);
+    if (ret == ESP_OK) {
+        *value = snapshot.conditioned_value;
     }
     
-    return ESP_ERR_TIMEOUT;
+    return ret;
+}
+
+esp_err_t io_manager_get_analog_conditioned(io_manager_t* manager, const char* point_id, float* value) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_get_analog_conditioned_by_handle(manager, handle, value);
 }
 
 esp_err_t io_manager_get_statistics(io_manager_t* manager, uint32_t* update_cycles, 
-                                   uint32_t* total_errors, uint64_t* last_update_time) {
+                                   uint32_t* total_errors, uint64_t* last_update_time,
+                                   io_scan_timing_t* timing) {
     if (!manager || !manager->initialized) {
         return ESP_ERR_INVALID_STATE;
     }
@@ -576,24 +2331,101 @@ esp_err_t io_manager_get_statistics(io_manager_t* manager, uint32_t* update_cycl
     if (total_errors) *total_errors = manager->total_error_count;
     if (last_update_time) *last_update_time = manager->last_update_time;
     
+    if (timing) {
+        // Copy between scans so each histogram is internally consistent
+        if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+        *timing = manager->timing;
+        xSemaphoreGive(manager->scan_mutex);
+    }
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_get_interlock_stats(io_manager_t* manager, io_interlock_stats_t* stats) {
+    if (!manager || !manager->initialized || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    *stats = manager->interlock_stats;
+    xSemaphoreGive(manager->state_mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_reset_timing(io_manager_t* manager) {
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    memset(&manager->timing, 0, sizeof(io_scan_timing_t));
+    xSemaphoreGive(manager->scan_mutex);
+    
     return ESP_OK;
 }
 
+uint32_t io_manager_timing_percentile(const io_timing_histogram_t* histogram, float percentile) {
+    if (!histogram || histogram->count == 0) {
+        return 0;
+    }
+    
+    uint64_t target = (uint64_t)((percentile / 100.0f) * (float)histogram->count + 0.5f);
+    if (target < 1) {
+        target = 1;
+    }
+    
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < IO_TIMING_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+        if (seen >= target) {
+            uint32_t upper_us = (bucket == 0) ? 0 : (1U << bucket) - 1;
+            return (bucket == IO_TIMING_BUCKETS - 1 || upper_us > histogram->max_us) ? histogram->max_us : upper_us;
+        }
+    }
+    return histogram->max_us;
+}
+
 void io_manager_destroy(io_manager_t* manager) {
     if (manager && manager->initialized) {
         // Stop polling task
         io_manager_stop_polling(manager);
         
+        // No dose outlives the manager
+        stop_pulses(manager);
+        esp_timer_stop(manager->pulse_timer);
+        esp_timer_delete(manager->pulse_timer);
+        manager->pulse_timer = NULL;
+        
         // Cleanup handlers
         shift_register_handler_destroy(&manager->shift_register_handler);
         gpio_handler_destroy(&manager->gpio_handler);
+        signal_conditioner_pool_release(&manager->filter_pool);
+        release_point_tables(manager);
         
-        
-        // Cleanup mutex
+        // Cleanup mutexes
         if (manager->state_mutex) {
             vSemaphoreDelete(manager->state_mutex);
             manager->state_mutex = NULL;
         }
+        if (manager->scan_mutex) {
+            vSemaphoreDelete(manager->scan_mutex);
+            manager->scan_mutex = NULL;
+        }
+        if (manager->pulse_mutex) {
+            vSemaphoreDelete(manager->pulse_mutex);
+            manager->pulse_mutex = NULL;
+        }
+        if (manager->polling_task_exited && !manager->polling_task_handle) {
+            vSemaphoreDelete(manager->polling_task_exited);
+            manager->polling_task_exited = NULL;
+        }
         
         manager->initialized = false;
         
@@ -603,41 +2435,105 @@ void io_manager_destroy(io_manager_t* manager) {
     }
 }
 
-// Simplified implementations for remaining functions
 esp_err_t io_manager_update_inputs(io_manager_t* manager) {
-    // This would be called by the polling task
-    return ESP_OK;
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    int64_t wait_start = esp_timer_get_time();
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    esp_err_t ret = scan_due_classes(manager, IO_MANAGER_ALL_SCAN_CLASSES, esp_timer_get_time() - wait_start);
+    xSemaphoreGive(manager->scan_mutex);
+    
+    return ret;
+}
+
+esp_err_t io_manager_scan_classes(io_manager_t* manager, uint32_t class_mask) {
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    int64_t wait_start = esp_timer_get_time();
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    esp_err_t ret = scan_due_classes(manager, class_mask & IO_MANAGER_ALL_SCAN_CLASSES, 
+                                     esp_timer_get_time() - wait_start);
+    xSemaphoreGive(manager->scan_mutex);
+    
+    return ret;
+}
+
+// Simplified implementations for remaining functions
+esp_err_t io_manager_get_binary_input_by_handle(io_manager_t* manager, io_point_handle_t handle, bool* state) {
+    return io_manager_get_binary_output_by_handle(manager, handle, state); // Same logic
 }
 
 esp_err_t io_manager_get_binary_input(io_manager_t* manager, const char* point_id, bool* state) {
     return io_manager_get_binary_output(manager, point_id, state); // Same logic
 }
 
+esp_err_t io_manager_get_analog_raw_by_handle(io_manager_t* manager, io_point_handle_t handle, float* value) {
+    if (!manager || !manager->initialized || !value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    int point_index = handle_to_index(manager, handle);
+    if (point_index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    io_point_snapshot_t snapshot;
+    esp_err_t ret = read_snapshot_point(manager, point_index, &snapshot);
+    if (ret == ESP_OK) {
+        *value = snapshot.raw_value;
+    }
+    
+    return ret;
+}
+
 esp_err_t io_manager_get_analog_raw(io_manager_t* manager, const char* point_id, float* value) {
-    if (!manager || !manager->initialized || !point_id || !value) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_get_analog_raw_by_handle(manager, handle, value);
+}
+
+esp_err_t io_manager_get_input_edges(io_manager_t* manager, io_point_handle_t handle, uint32_t since_sequence,
+                                     gpio_edge_event_t* events, int max_events, int* event_count) {
+    if (!manager || !manager->initialized || !events || max_events < 0 || !event_count) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    int point_index = find_point_index(manager, point_id);
+    int point_index = handle_to_index(manager, handle);
     if (point_index < 0) {
         return ESP_ERR_NOT_FOUND;
     }
     
-    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        *value = manager->runtime_states[point_index].raw_value;
-        xSemaphoreGive(manager->state_mutex);
-        return ESP_OK;
+    const io_point_descriptor_t* point = &manager->point_table[point_index];
+    if (point->type != IO_POINT_TYPE_GPIO_BI || point->input_mode == IO_INPUT_MODE_POLLED) {
+        return ESP_ERR_NOT_FOUND;
     }
     
-    return ESP_ERR_TIMEOUT;
+    // The edge history has its own lock; no manager mutex is needed
+    return gpio_handler_get_edges(&manager->gpio_handler, point->pin, since_sequence, 
+                                  events, max_events, event_count);
 }
 
-esp_err_t io_manager_get_runtime_state(io_manager_t* manager, const char* point_id, io_point_runtime_state_t* state) {
-    if (!manager || !manager->initialized || !point_id || !state) {
+esp_err_t io_manager_get_runtime_state_by_handle(io_manager_t* manager, io_point_handle_t handle, 
+                                              io_point_runtime_state_t* state) {
+    if (!manager || !manager->initialized || !state) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    int point_index = find_point_index(manager, point_id);
+    int point_index = handle_to_index(manager, handle);
     if (point_index < 0) {
         return ESP_ERR_NOT_FOUND;
     }
@@ -651,6 +2547,69 @@ esp_err_t io_manager_get_runtime_state(io_manager_t* manager, const char* point_
     return ESP_ERR_TIMEOUT;
 }
 
+esp_err_t io_manager_get_runtime_state(io_manager_t* manager, const char* point_id, io_point_runtime_state_t* state) {
+    io_point_handle_t handle;
+    esp_err_t ret = io_manager_resolve_handle(manager, point_id, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return io_manager_get_runtime_state_by_handle(manager, handle, state);
+}
+
+esp_err_t io_manager_get_snapshot(io_manager_t* manager, io_point_snapshot_t* points, 
+                                 int max_points, int* actual_count, uint32_t* sequence) {
+    if (!manager || !manager->initialized || !points || max_points < 0 || !actual_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    return read_snapshot(manager, 0, points, max_points, actual_count, sequence);
+}
+
+esp_err_t io_manager_get_changes_since(io_manager_t* manager, uint32_t since, io_point_change_t* changes,
+                                      int max_changes, int* change_count, uint32_t* latest) {
+    if (!manager || !manager->initialized || !changes || max_changes < 0 || !change_count || !latest) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    for (int attempt = 0; attempt < IO_MANAGER_SNAPSHOT_MAX_RETRIES; attempt++) {
+        uint32_t front = __atomic_load_n(&manager->snapshot_front, __ATOMIC_ACQUIRE);
+        const io_snapshot_buffer_t* buffer = &manager->snapshot_buffers[front];
+        
+        uint32_t begin = __atomic_load_n(&buffer->sequence, __ATOMIC_ACQUIRE);
+        if (begin & 1) {
+            continue;
+        }
+        
+        int count = 0;
+        uint32_t first_skipped = 0;
+        for (int i = 0; i < buffer->point_count; i++) {
+            const io_point_snapshot_t* point = &buffer->points[i];
+            if (point->change_sequence <= since) {
+                continue;
+            }
+            
+            if (count < max_changes) {
+                changes[count].handle = ((io_point_handle_t)buffer->generation << 16) | (io_point_handle_t)i;
+                changes[count].point = *point;
+                count++;
+            } else if (first_skipped == 0 || point->change_sequence < first_skipped) {
+                first_skipped = point->change_sequence;
+            }
+        }
+        uint32_t buffer_latest = buffer->change_sequence;
+        
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&buffer->sequence, __ATOMIC_RELAXED) == begin) {
+            *change_count = count;
+            *latest = first_skipped ? first_skipped - 1 : buffer_latest;
+            return ESP_OK;
+        }
+    }
+    
+    return ESP_ERR_TIMEOUT;
+}
+
 esp_err_t io_manager_get_all_point_ids(io_manager_t* manager, char point_ids[][CONFIG_MAX_ID_LENGTH], 
                                       int max_points, int* actual_count) {
     if (!manager || !manager->initialized || !point_ids || !actual_count) {
@@ -673,19 +2632,151 @@ esp_err_t io_manager_reload_config(io_manager_t* manager) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    // Stop polling during reconfiguration
+    // Previous table, one PSRAM block sized to the current point count
+    io_previous_points_t previous_points;
+    io_previous_points_t* previous = &previous_points;
+    memset(previous, 0, sizeof(io_previous_points_t));
+    previous->count = manager->active_point_count;
+    
+    size_t point_bytes = sizeof(io_point_config_t) + sizeof(io_point_descriptor_t) + 
+                         sizeof(io_point_runtime_state_t) + sizeof(int16_t);
+    uint8_t* previous_storage = NULL;
+    if (previous->count > 0) {
+        previous_storage = psram_smart_malloc(previous->count * point_bytes, ALLOC_LARGE_BUFFER);
+        if (!previous_storage) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    previous->states = (io_point_runtime_state_t*)previous_storage;
+    previous->configs = (io_point_config_t*)(previous->states + previous->count);
+    previous->descriptors = (io_point_descriptor_t*)(previous->configs + previous->count);
+    previous->kept_by = (int16_t*)(previous->descriptors + previous->count);
+    for (int j = 0; j < previous->count; j++) {
+        previous->kept_by[j] = (int16_t)j; // Unchanged table if configuration stops early
+    }
+    
+    // Stop polling during reconfiguration; the task must have exited before the tables change
     bool was_polling = manager->polling_task_running;
     if (was_polling) {
-        io_manager_stop_polling(manager);
+        esp_err_t stop_ret = io_manager_stop_polling(manager);
+        if (stop_ret != ESP_OK) {
+            psram_smart_free(previous_storage);
+            return stop_ret;
+        }
+    }
+    
+    // No scan (io_manager_update_inputs, attach) runs for the whole reload
+    xSemaphoreTake(manager->scan_mutex, portMAX_DELAY);
+    
+    // Hold pending switch-offs while the point table is rebuilt
+    xSemaphoreTake(manager->pulse_mutex, portMAX_DELAY);
+    
+    // Readers and output writes wait while the point table is swapped
+    xSemaphoreTake(manager->state_mutex, portMAX_DELAY);
+    
+    // Keep the previous table (and a copy of its filter state) to diff against
+    previous->adc_config = manager->current_config.adc_config;
+    memcpy(previous->configs, manager->current_config.io_points, previous->count * sizeof(io_point_config_t));
+    memcpy(previous->descriptors, manager->point_table, previous->count * sizeof(io_point_descriptor_t));
+    memcpy(previous->states, manager->runtime_states, previous->count * sizeof(io_point_runtime_state_t));
+    if (manager->filter_pool.used > 0) {
+        previous->filter_states = psram_smart_malloc(manager->filter_pool.used, ALLOC_NORMAL);
+        if (previous->filter_states) {
+            memcpy(previous->filter_states, manager->filter_pool.storage, manager->filter_pool.used);
+            previous->filter_pool_base = manager->filter_pool.storage;
+        } else {
+            ESP_LOGW(TAG, "No memory to preserve filter state across reload");
+        }
+    }
+    
+    esp_err_t ret = fetch_point_configs(manager);
+    bool fetched = (ret == ESP_OK);
+    if (ret == ESP_OK && manager->alarm_manager) {
+        esp_err_t alarm_ret = alarm_manager_reload_config(manager->alarm_manager);
+        if (alarm_ret != ESP_OK) {
+            ESP_LOGW(TAG, "Alarm configuration reload failed: %s", esp_err_to_name(alarm_ret));
+        }
+    }
+    if (ret == ESP_OK && manager->trending_manager) {
+        esp_err_t trend_ret = trending_manager_reload_config(manager->trending_manager);
+        if (trend_ret != ESP_OK) {
+            ESP_LOGW(TAG, "Trend configuration reload failed: %s", esp_err_to_name(trend_ret));
+        }
+    }
+    if (ret == ESP_OK) {
+        // Continuous ADC restarts only when its channel set or settings change
+        const adc_acquisition_config_t* adc_config = &manager->current_config.adc_config;
+        bool restart_adc = memcmp(adc_config, &previous->adc_config, sizeof(adc_acquisition_config_t)) != 0 ||
+                           analog_pin_mask(manager->current_config.io_points, manager->current_config.io_point_count) !=
+                           analog_pin_mask(previous->configs, previous->count);
+        
+        if (restart_adc) {
+            gpio_handler_stop_adc_continuous(&manager->gpio_handler);
+        }
+        ret = configure_io_points(manager, previous);
+        if (restart_adc) {
+            start_adc_acquisition(manager);
+        }
     }
     
-    // Reconfigure IO points
-    esp_err_t ret = configure_io_points(manager);
+    remap_pulses(manager, previous);
+    publish_snapshot(manager);
+    if (fetched) {
+        // Pipelines are compiled against the new copies now
+        release_lookup_tables(previous->configs, previous->count);
+    }
+    xSemaphoreGive(manager->state_mutex);
+    xSemaphoreGive(manager->pulse_mutex);
+    xSemaphoreGive(manager->scan_mutex);
+    
+    psram_smart_free(previous->filter_states);
+    psram_smart_free(previous_storage);
     
     // Restart polling if it was running
     if (was_polling && ret == ESP_OK) {
-        io_manager_start_polling(manager, 1000, 2, 4096);
+        io_manager_start_polling(manager, manager->polling_interval_ms, 
+                                 manager->polling_task_priority, manager->polling_task_stack_size);
     }
     
     return ret;
 }
+
+esp_err_t io_manager_attach_alarm_manager(io_manager_t* manager, alarm_manager_t* alarm_manager) {
+    if (!manager || !manager->initialized || (alarm_manager && !alarm_manager->initialized)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        xSemaphoreGive(manager->scan_mutex);
+        return ESP_ERR_TIMEOUT;
+    }
+    manager->alarm_manager = alarm_manager;
+    resolve_alarm_handles(manager); // Releases interlocks, so output writes must not race it
+    xSemaphoreGive(manager->state_mutex);
+    xSemaphoreGive(manager->scan_mutex);
+    
+    return ESP_OK;
+}
+
+esp_err_t io_manager_attach_trending_manager(io_manager_t* manager, trending_manager_t* trending_manager) {
+    if (!manager || !manager->initialized || (trending_manager && !trending_manager->initialized)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+    if (xSemaphoreTake(manager->state_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        xSemaphoreGive(manager->scan_mutex);
+        return ESP_ERR_TIMEOUT;
+    }
+    manager->trending_manager = trending_manager;
+    resolve_trend_handles(manager);
+    xSemaphoreGive(manager->state_mutex);
+    xSemaphoreGive(manager->scan_mutex);
+    
+    return ESP_OK;
+}
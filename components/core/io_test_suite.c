@@ -0,0 +1,2618 @@
+/**
+ * @file io_test_suite.c
+ * @brief IO system benchmark and self-test suite for SNRv9 Irrigation Control System
+ * 
+ * Benchmarks run on target against synthetic configurations built from the
+ * live IO configuration. Nothing in this file changes an output; the shift
+ * register benchmark and the output batch test re-latch the live output
+ * image unchanged.
+ */
+
+#include "io_test_suite.h"
+#include "psram_manager.h"
+#include "storage_manager.h"
+#include "debug_config.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+static const char *TAG = DEBUG_IO_TEST_MANAGER_TAG;
+
+#define IO_BENCH_POINT_COUNT    32      ///< Points in synthetic benchmark configuration
+#define IO_BENCH_ITERATIONS     200     ///< Scan cycles per timed run
+#define IO_BENCH_LIVE_CYCLES    20      ///< Live scan cycles to average
+#define IO_SNAPSHOT_READS       500     ///< Snapshot reads in the snapshot test
+#define IO_LOOKUP_ITERATIONS    200     ///< Full ID sweeps per timed lookup run
+#define IO_ADC_TEST_OVERSAMPLE  16      ///< Oversampling used by the ADC averaging test
+#define IO_SR_BENCH_CYCLES      20      ///< Shift register cycles per timed run
+#define IO_COV_SCAN_CYCLES      50      ///< Manual scans in the change reporting test
+#define IO_COND_SAMPLES         10000   ///< Samples per timed conditioning run
+#define IO_COND_CHECK_SAMPLES   200     ///< Samples compared against the reference evaluation
+#define IO_LOOKUP_CHECK_INPUTS  1000    ///< Inputs compared against a linear segment scan
+#define IO_FILTER_STATE_BYTES   256     ///< Scratch filter state, enough for any single filter
+#define IO_FILTER_SETTLE_SAMPLES 200    ///< Samples fed before checking a filter's settled output
+#define IO_EDGE_TEST_PIN        4       ///< Edge-mode pin on the synthetic handler
+#define IO_COUNTER_TEST_PIN     5       ///< Counter-mode pin on the synthetic handler
+#define IO_EDGE_TEST_DEBOUNCE_US 1000   ///< Debounce window of the edge-mode test input
+#define IO_COUNTER_TEST_PULSES  50      ///< Pulses in the injected counter train
+#define IO_PULSE_TOLERANCE_US   1000    ///< Largest allowed |achieved - requested| pulse on-time
+#define IO_PULSE_SETTLE_MS      20      ///< Wait after a pulse deadline before checking its result
+#define IO_BATCH_TEST_OUTPUTS   4       ///< Shift register outputs staged in the output batch test
+#define IO_ALARM_TEST_POINTS    8       ///< Monitored points in the alarm stage test
+#define IO_ALARM_TEST_SAMPLES   2000    ///< Samples per point in the timed alarm stage run
+#define IO_ALARM_WINDOW_LARGE   1024    ///< Analysis window of the large-window point
+#define IO_ALARM_WINDOW_SMALL   16      ///< Analysis window of the small-window point
+#define IO_ALARM_STUCK_WINDOW   64      ///< Stuck signal window of the large-window point
+#define IO_ALARM_WINDOW_SAMPLES 3000    ///< Samples fed in the window statistics test
+#define IO_ALARM_WINDOW_MAX_RATIO 1.5f  ///< Largest allowed per-sample cost growth from small to large window
+#define IO_ALARM_RULE_PASSES    500     ///< Scan passes timed in the alarm rule benchmark
+#define IO_ALARM_RULE_HISTORY   20      ///< Analysis window of the alarm rule benchmark points
+#define IO_ALARM_FLAP_SAMPLES   40      ///< Samples of the flapping point in the suppression test
+#define IO_ALARM_SHELVE_MS      200     ///< Shelve duration in the suppression test
+#define IO_INTERLOCK_PASSES     1000    ///< Scan passes timed in the interlock test
+#define IO_JOURNAL_TEST_PATH    "/alarm_journal_test"  ///< Segment file base path of the test journal
+#define IO_JOURNAL_TEST_RECORDS (ALARM_JOURNAL_SEGMENT_RECORDS + 100)  ///< Records appended (rolls into a second segment)
+#define IO_JOURNAL_FLUSH_EVERY  256     ///< Appends between forced flushes (within the journal ring)
+#define IO_TREND_TEST_SAMPLES   3600    ///< Scan passes fed to the trend test (one hour at 1 s)
+#define IO_TREND_TOGGLE_EVERY   37      ///< Passes between state changes of the trended input
+#define IO_TREND_RAW_BYTES      12      ///< Uncompressed record: 64-bit time and float value
+#define IO_TREND_DAY_SAMPLES    8640    ///< Samples per day at the default 10 s interval
+#define IO_ROLLUP_TEST_DAYS     31      ///< Days fed to the rollup test
+#define IO_ROLLUP_CHART_DAYS    30      ///< Range of the charted rollup query
+#define IO_ROLLUP_CHART_POINTS  500     ///< Chart width the rollup query resolution is derived from
+#define IO_ROLLUP_MEAN_TOLERANCE 0.001f ///< Largest allowed |rollup - recomputed| hourly mean
+#define IO_SCALE_ITERATIONS     100     ///< Scan cycles per timed scaling run
+#define IO_SCALE_MAX_RATIO      1.5f    ///< Largest allowed per-point cost growth from 32 to 256 points
+
+static const int io_sr_bench_chains[] = {1, 8, 32};  ///< Shift register chain lengths to time
+static const int io_scale_bench_counts[] = {32, 64, 128, 256};  ///< Point counts to time
+static const uint32_t io_pulse_test_ms[] = {20, 50, 100};       ///< Pulse lengths to time
+
+/* =============================================================================
+ * HELPER FUNCTIONS
+ * =============================================================================
+ */
+
+/**
+ * @brief Build a synthetic configuration manager with count points
+ * 
+ * Points are cloned round-robin from the live configuration and renamed so
+ * that ID lookups have realistic lengths.
+ */
+static config_manager_t* create_bench_config(config_manager_t* source, int count)
+{
+    config_manager_t* bench = psram_smart_malloc(sizeof(config_manager_t), ALLOC_LARGE_BUFFER);
+    if (!bench) {
+        return NULL;
+    }
+    
+    config_manager_init(bench, "/io_bench.json");
+    if (config_manager_reserve_io_points(&bench->config, count) != ESP_OK) {
+        config_manager_destroy(bench);
+        psram_smart_free(bench);
+        return NULL;
+    }
+    
+    int source_count = source ? source->config.io_point_count : 0;
+    for (int i = 0; i < count; i++) {
+        io_point_config_t* point = &bench->config.io_points[i];
+        
+        if (source_count > 0) {
+            *point = source->config.io_points[i % source_count];
+        } else {
+            memset(point, 0, sizeof(io_point_config_t));
+            point->type = IO_POINT_TYPE_GPIO_AI;
+            point->pin = 34;
+            point->range_max = 100.0f;
+        }
+        snprintf(point->id, CONFIG_MAX_ID_LENGTH, "BENCH_POINT_%03d", i);
+        
+        // Lookup tables stay owned by the source manager
+        point->signal_config.lookup_table = NULL;
+        point->signal_config.lookup_table_count = 0;
+    }
+    bench->config.io_point_count = count;
+    config_manager_rebuild_index(bench);
+    
+    return bench;
+}
+
+/**
+ * @brief Run the per-point scan work over a compiled table and runtime states
+ * 
+ * Mirrors the hot path of a scan without hardware: scale a synthetic raw
+ * value, condition it, apply the deadband and update the state counters.
+ * 
+ * @return int64_t Elapsed microseconds for IO_SCALE_ITERATIONS cycles
+ */
+static int64_t time_scan_work(const io_point_descriptor_t* table, io_point_runtime_state_t* states, int count)
+{
+    int64_t start = esp_timer_get_time();
+    for (int iter = 0; iter < IO_SCALE_ITERATIONS; iter++) {
+        for (int i = 0; i < count; i++) {
+            const io_point_descriptor_t* point = &table[i];
+            io_point_runtime_state_t* state = &states[i];
+            float raw = (float)((iter * 37 + i * 11) & 0xFFF);
+            float value = point->range_min + raw * point->range_scale;
+            
+            state->raw_value = raw;
+            state->conditioned_value = signal_conditioner_process(&point->pipeline, NULL, value);
+            if (fabsf(state->conditioned_value - state->reported_value) > point->deadband) {
+                state->reported_value = state->conditioned_value;
+                state->change_sequence++;
+            }
+            state->update_count++;
+        }
+    }
+    return esp_timer_get_time() - start;
+}
+
+/**
+ * @brief Fill a synthetic conversion frame (TYPE1 layout)
+ * 
+ * Alternates between channel_a and channel_b; channel_a carries +/- noise
+ * around value_a on alternate samples.
+ */
+static void fill_adc_frame(uint8_t* frame, int results, int channel_a, int value_a, int noise_a,
+                           int channel_b, int value_b)
+{
+    for (int i = 0; i < results; i++) {
+        adc_digi_output_data_t* out = (adc_digi_output_data_t*)&frame[i * SOC_ADC_DIGI_RESULT_BYTES];
+        out->val = 0;
+        if ((i & 1) == 0) {
+            out->type1.channel = channel_a;
+            out->type1.data = ((i >> 1) & 1) ? value_a + noise_a : value_a - noise_a;
+        } else {
+            out->type1.channel = channel_b;
+            out->type1.data = value_b;
+        }
+    }
+}
+
+/* =============================================================================
+ * PUBLIC FUNCTIONS
+ * =============================================================================
+ */
+
+bool io_test_suite_benchmark_point_table(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Point table benchmark: IO manager not initialized");
+        return false;
+    }
+    
+    ESP_LOGI(TAG, "=== Point Table Benchmark (%d points, %d cycles) ===", 
+             IO_BENCH_POINT_COUNT, IO_BENCH_ITERATIONS);
+    
+    config_manager_t* bench = create_bench_config(manager->config_manager, IO_BENCH_POINT_COUNT);
+    io_point_config_t* scratch = psram_smart_malloc(2 * sizeof(io_point_config_t), ALLOC_LARGE_BUFFER);
+    io_point_descriptor_t* table = psram_smart_malloc(IO_BENCH_POINT_COUNT * sizeof(io_point_descriptor_t), 
+                                                      ALLOC_CRITICAL);
+    if (!bench || !scratch || !table) {
+        ESP_LOGE(TAG, "Point table benchmark: allocation failed");
+        psram_smart_free(bench);
+        psram_smart_free(scratch);
+        psram_smart_free(table);
+        return false;
+    }
+    
+    volatile float checksum = 0.0f;
+    
+    // Legacy pattern: dispatch lookup + update lookup, both full struct copies
+    int64_t start = esp_timer_get_time();
+    for (int iter = 0; iter < IO_BENCH_ITERATIONS; iter++) {
+        for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+            const char* id = bench->config.io_points[i].id;
+            if (config_manager_get_io_point_config(bench, id, &scratch[0]) != ESP_OK) {
+                continue;
+            }
+            if (scratch[0].type == IO_POINT_TYPE_GPIO_AI || 
+                scratch[0].type == IO_POINT_TYPE_GPIO_BI || 
+                scratch[0].type == IO_POINT_TYPE_SHIFT_REG_BI) {
+                config_manager_get_io_point_config(bench, id, &scratch[1]);
+                checksum += scratch[1].range_min + (float)scratch[1].pin;
+            }
+        }
+    }
+    int64_t legacy_us = esp_timer_get_time() - start;
+    
+    // Compiled table
+    for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+        io_manager_compile_point(&bench->config.io_points[i], &table[i]);
+    }
+    
+    start = esp_timer_get_time();
+    for (int iter = 0; iter < IO_BENCH_ITERATIONS; iter++) {
+        for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+            const io_point_descriptor_t* point = &table[i];
+            if (point->read) {
+                checksum += point->range_min + (float)point->pin;
+            }
+        }
+    }
+    int64_t compiled_us = esp_timer_get_time() - start;
+    
+    // Live scan cycle including hardware reads
+    start = esp_timer_get_time();
+    for (int i = 0; i < IO_BENCH_LIVE_CYCLES; i++) {
+        io_manager_update_inputs(manager);
+    }
+    int64_t live_us = esp_timer_get_time() - start;
+    
+    ESP_LOGI(TAG, "Legacy config access:   %lld us/cycle", legacy_us / IO_BENCH_ITERATIONS);
+    ESP_LOGI(TAG, "Compiled point table:   %lld us/cycle", compiled_us / IO_BENCH_ITERATIONS);
+    ESP_LOGI(TAG, "Live scan (%d points):  %lld us/cycle", 
+             manager->active_point_count, live_us / IO_BENCH_LIVE_CYCLES);
+    ESP_LOGD(TAG, "Checksum: %.1f", (double)checksum);
+    
+    psram_smart_free(table);
+    psram_smart_free(scratch);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    bool passed = compiled_us < legacy_us;
+    ESP_LOGI(TAG, "Point table benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_benchmark_scaling(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Scaling benchmark: IO manager not initialized");
+        return false;
+    }
+    
+    int runs = sizeof(io_scale_bench_counts) / sizeof(io_scale_bench_counts[0]);
+    ESP_LOGI(TAG, "=== Scaling Benchmark (%d to %d points, %d cycles) ===", 
+             io_scale_bench_counts[0], io_scale_bench_counts[runs - 1], IO_SCALE_ITERATIONS);
+    
+    bool passed = true;
+    float base_ns_per_point = 0.0f;
+    
+    for (int run = 0; run < runs && passed; run++) {
+        int count = io_scale_bench_counts[run];
+        config_manager_t* bench = create_bench_config(manager->config_manager, count);
+        io_point_descriptor_t* table = psram_smart_malloc(count * sizeof(io_point_descriptor_t), ALLOC_CRITICAL);
+        io_point_runtime_state_t* hot = psram_smart_malloc(count * sizeof(io_point_runtime_state_t), ALLOC_CRITICAL);
+        io_point_runtime_state_t* cold = psram_smart_malloc(count * sizeof(io_point_runtime_state_t), 
+                                                            ALLOC_LARGE_BUFFER);
+        if (!bench || !table || !hot || !cold) {
+            ESP_LOGE(TAG, "Scaling benchmark: allocation failed at %d points", count);
+            passed = false;
+        } else {
+            for (int i = 0; i < count; i++) {
+                io_manager_compile_point(&bench->config.io_points[i], &table[i]);
+            }
+            memset(hot, 0, count * sizeof(io_point_runtime_state_t));
+            memset(cold, 0, count * sizeof(io_point_runtime_state_t));
+            
+            int64_t hot_us = time_scan_work(table, hot, count);
+            int64_t cold_us = time_scan_work(table, cold, count);
+            
+            float ns_per_point = (float)hot_us * 1000.0f / ((float)IO_SCALE_ITERATIONS * count);
+            ESP_LOGI(TAG, "%3d points: %lld us/cycle, %.0f ns/point (states in PSRAM: %lld us/cycle)", 
+                     count, hot_us / IO_SCALE_ITERATIONS, (double)ns_per_point, cold_us / IO_SCALE_ITERATIONS);
+            
+            if (run == 0) {
+                base_ns_per_point = ns_per_point;
+            } else if (ns_per_point > base_ns_per_point * IO_SCALE_MAX_RATIO) {
+                ESP_LOGE(TAG, "Scaling benchmark: per-point cost at %d points is %.1fx that at %d", 
+                         count, (double)(ns_per_point / base_ns_per_point), io_scale_bench_counts[0]);
+                passed = false;
+            }
+        }
+        
+        psram_smart_free(cold);
+        psram_smart_free(hot);
+        psram_smart_free(table);
+        if (bench) {
+            config_manager_destroy(bench);
+            psram_smart_free(bench);
+        }
+    }
+    
+    ESP_LOGI(TAG, "Scaling benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_benchmark_id_lookup(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "ID lookup benchmark: IO manager not initialized");
+        return false;
+    }
+    
+    ESP_LOGI(TAG, "=== ID Lookup Benchmark (%d points, %d sweeps) ===", 
+             IO_BENCH_POINT_COUNT, IO_LOOKUP_ITERATIONS);
+    
+    config_manager_t* bench = create_bench_config(manager->config_manager, IO_BENCH_POINT_COUNT);
+    if (!bench) {
+        ESP_LOGE(TAG, "ID lookup benchmark: allocation failed");
+        return false;
+    }
+    
+    bool passed = true;
+    volatile int checksum = 0;
+    
+    // Every ID must resolve to its own position, unknown IDs must miss
+    for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+        if (config_manager_find_io_point_index(bench, bench->config.io_points[i].id) != i) {
+            ESP_LOGE(TAG, "ID lookup benchmark: %s resolved incorrectly", bench->config.io_points[i].id);
+            passed = false;
+        }
+    }
+    if (config_manager_find_io_point_index(bench, "BENCH_POINT_XX") >= 0) {
+        ESP_LOGE(TAG, "ID lookup benchmark: unknown ID resolved");
+        passed = false;
+    }
+    
+    // Linear strcmp scan (previous lookup)
+    int64_t start = esp_timer_get_time();
+    for (int iter = 0; iter < IO_LOOKUP_ITERATIONS; iter++) {
+        for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+            const char* id = bench->config.io_points[i].id;
+            for (int j = 0; j < bench->config.io_point_count; j++) {
+                if (strcmp(bench->config.io_points[j].id, id) == 0) {
+                    checksum += j;
+                    break;
+                }
+            }
+        }
+    }
+    int64_t linear_us = esp_timer_get_time() - start;
+    
+    // Hashed index
+    start = esp_timer_get_time();
+    for (int iter = 0; iter < IO_LOOKUP_ITERATIONS; iter++) {
+        for (int i = 0; i < IO_BENCH_POINT_COUNT; i++) {
+            checksum += config_manager_find_io_point_index(bench, bench->config.io_points[i].id);
+        }
+    }
+    int64_t hashed_us = esp_timer_get_time() - start;
+    
+    // Live handle resolution
+    int live_resolved = 0;
+    for (int i = 0; i < manager->active_point_count; i++) {
+        io_point_handle_t handle;
+        if (io_manager_resolve_handle(manager, manager->point_ids[i], &handle) == ESP_OK &&
+            (int)(handle & 0xFFFF) == i) {
+            live_resolved++;
+        }
+    }
+    if (live_resolved != manager->active_point_count) {
+        ESP_LOGE(TAG, "ID lookup benchmark: %d/%d live handles resolved", 
+                 live_resolved, manager->active_point_count);
+        passed = false;
+    }
+    
+    ESP_LOGI(TAG, "Linear strcmp lookup:   %lld us/sweep", linear_us / IO_LOOKUP_ITERATIONS);
+    ESP_LOGI(TAG, "Hashed index lookup:    %lld us/sweep", hashed_us / IO_LOOKUP_ITERATIONS);
+    ESP_LOGD(TAG, "Checksum: %d", checksum);
+    
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    ESP_LOGI(TAG, "ID lookup benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_adc_oversampling(void)
+{
+    ESP_LOGI(TAG, "=== ADC Oversampling Test (%dx, synthetic frames) ===", IO_ADC_TEST_OVERSAMPLE);
+    
+    // GPIO34 = ADC1 channel 6, GPIO35 = ADC1 channel 7, GPIO36 = ADC1 channel 0
+    gpio_handler_t synth;
+    esp_err_t ret = gpio_handler_init_synthetic(&synth, (1ULL << 34) | (1ULL << 35) | (1ULL << 36), 
+                                               IO_ADC_TEST_OVERSAMPLE);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "ADC oversampling test: synthetic handler init failed: %s", esp_err_to_name(ret));
+        return false;
+    }
+    
+    uint8_t frame[GPIO_HANDLER_ADC_FRAME_SIZE];
+    int results = GPIO_HANDLER_ADC_FRAME_SIZE / SOC_ADC_DIGI_RESULT_BYTES;
+    bool passed = true;
+    int value = 0;
+    
+    // Noisy channel averages out, constant channel passes through
+    fill_adc_frame(frame, results, 6, 1000, 40, 7, 3000);
+    for (int i = 0; i < 4; i++) {
+        gpio_handler_adc_feed_frame(&synth, frame, sizeof(frame));
+    }
+    if (gpio_handler_read_analog(&synth, 34, &value) != ESP_OK || value != 1000) {
+        ESP_LOGE(TAG, "ADC oversampling test: noisy channel averaged to %d (expected 1000)", value);
+        passed = false;
+    }
+    if (gpio_handler_read_analog(&synth, 35, &value) != ESP_OK || value != 3000) {
+        ESP_LOGE(TAG, "ADC oversampling test: constant channel read %d (expected 3000)", value);
+        passed = false;
+    }
+    
+    // Step: half the window at the new level averages to the midpoint
+    int step_results = IO_ADC_TEST_OVERSAMPLE; // Half on channel 6, half on channel 7
+    fill_adc_frame(frame, step_results, 6, 2000, 0, 7, 3000);
+    gpio_handler_adc_feed_frame(&synth, frame, step_results * SOC_ADC_DIGI_RESULT_BYTES);
+    if (gpio_handler_read_analog(&synth, 34, &value) != ESP_OK || value != 1500) {
+        ESP_LOGE(TAG, "ADC oversampling test: step response %d (expected 1500)", value);
+        passed = false;
+    }
+    
+    // Channel without samples must not report a value
+    if (gpio_handler_read_analog(&synth, 36, &value) != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "ADC oversampling test: empty channel returned a value");
+        passed = false;
+    }
+    
+    // Read cost in continuous mode (no hardware access)
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < 1000; i++) {
+        gpio_handler_read_analog(&synth, 34, &value);
+    }
+    int64_t read_us = esp_timer_get_time() - start;
+    ESP_LOGI(TAG, "Averaged read: %lld ns/read", read_us);
+    
+    gpio_handler_destroy(&synth);
+    
+    ESP_LOGI(TAG, "ADC oversampling test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_benchmark_shift_register(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "=== Shift Register Benchmark (%d cycles per chain length) ===", IO_SR_BENCH_CYCLES);
+    
+    bool passed = true;
+    
+    // Live chain: active backend on the real pins
+    shift_register_handler_t* live = NULL;
+    int live_chain = 0;
+    if (manager && manager->initialized && manager->shift_register_handler.initialized) {
+        live = &manager->shift_register_handler;
+        live_chain = live->config.num_output_registers > live->config.num_input_registers ?
+                     live->config.num_output_registers : live->config.num_input_registers;
+    }
+    
+    // Detached chain: SPI master with no pins, on the peripheral the live chain does not use
+    shift_register_config_t detached_config = {
+        .output_clock_pin = -1, .output_latch_pin = -1, .output_data_pin = -1, .output_enable_pin = -1,
+        .input_clock_pin = -1, .input_load_pin = -1, .input_data_pin = -1,
+        .num_output_registers = SHIFT_REGISTER_MAX_CHIPS,
+        .num_input_registers = SHIFT_REGISTER_MAX_CHIPS,
+        .backend = SHIFT_REGISTER_BACKEND_SPI,
+        .spi_host = (live && live->config.spi_host == 3) ? 2 : 3,
+        .spi_clock_hz = live ? live->config.spi_clock_hz : 0
+    };
+    shift_register_handler_t detached;
+    bool detached_ready = (shift_register_handler_init(&detached, &detached_config) == ESP_OK);
+    if (!detached_ready) {
+        ESP_LOGW(TAG, "Shift register benchmark: detached SPI chain unavailable");
+    }
+    
+    if (!live) {
+        ESP_LOGW(TAG, "Shift register benchmark: no live chain configured");
+    }
+    
+    for (size_t i = 0; i < sizeof(io_sr_bench_chains) / sizeof(io_sr_bench_chains[0]); i++) {
+        int chips = io_sr_bench_chains[i];
+        uint32_t cycle_ns = 0;
+        
+        if (live && chips >= live_chain) {
+            esp_err_t ret = shift_register_benchmark_cycle(live, chips, IO_SR_BENCH_CYCLES, &cycle_ns);
+            if (ret == ESP_OK) {
+                ESP_LOGI(TAG, "%s (live)     %2d chips: %lu ns/cycle", 
+                         live->backend == SHIFT_REGISTER_BACKEND_SPI ? "SPI " : "GPIO", chips, cycle_ns);
+            } else {
+                ESP_LOGE(TAG, "Live chain benchmark failed at %d chips: %s", chips, esp_err_to_name(ret));
+                passed = false;
+            }
+        }
+        
+        if (detached_ready) {
+            esp_err_t ret = shift_register_benchmark_cycle(&detached, chips, IO_SR_BENCH_CYCLES, &cycle_ns);
+            if (ret == ESP_OK) {
+                ESP_LOGI(TAG, "SPI  (detached) %2d chips: %lu ns/cycle", chips, cycle_ns);
+            } else {
+                ESP_LOGE(TAG, "Detached chain benchmark failed at %d chips: %s", chips, esp_err_to_name(ret));
+                passed = false;
+            }
+        }
+        
+        // Let the polling task catch up between runs
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
+    if (detached_ready) {
+        shift_register_handler_destroy(&detached);
+    }
+    
+    ESP_LOGI(TAG, "Shift register benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Deterministic pseudo-random ADC-like sample (0-100 engineering units)
+ */
+static float cond_test_sample(uint32_t* seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return (float)(*seed >> 20) * (100.0f / 4096.0f);
+}
+
+/**
+ * @brief Reference conditioning: stage by stage, powf per sample, O(window) SMA
+ */
+static float cond_reference(const signal_config_t* config, const float* history, int history_count, float value)
+{
+    float scaled = (value + config->offset) * config->gain * config->scaling_factor;
+    
+    if (config->filter_type == SIGNAL_FILTER_SMA && config->sma_window_size > 1) {
+        int window = history_count < config->sma_window_size ? history_count : config->sma_window_size;
+        float sum = 0.0f;
+        for (int i = history_count - window; i < history_count; i++) {
+            sum += (history[i] + config->offset) * config->gain * config->scaling_factor;
+        }
+        scaled = sum / window;
+    }
+    
+    float multiplier = powf(10.0f, (float)config->precision_digits);
+    return roundf(scaled * multiplier) / multiplier;
+}
+
+/**
+ * @brief Time IO_COND_SAMPLES samples through a compiled pipeline
+ * 
+ * @return uint32_t Nanoseconds per sample
+ */
+static uint32_t cond_time_pipeline(const signal_pipeline_t* pipeline, void* state)
+{
+    volatile float sink = 0.0f;
+    uint32_t seed = 12345;
+    
+    signal_conditioner_reset_state(pipeline, state);
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < IO_COND_SAMPLES; i++) {
+        sink = signal_conditioner_process(pipeline, state, cond_test_sample(&seed));
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    (void)sink;
+    
+    return (uint32_t)((elapsed_us * 1000) / IO_COND_SAMPLES);
+}
+
+bool io_test_suite_benchmark_conditioning(void)
+{
+    ESP_LOGI(TAG, "=== Signal Conditioning Benchmark (%d samples per run) ===", IO_COND_SAMPLES);
+    
+    signal_config_t* config = psram_smart_malloc(sizeof(signal_config_t), ALLOC_NORMAL);
+    void* state = psram_smart_malloc(IO_FILTER_STATE_BYTES, ALLOC_CRITICAL);
+    float* history = psram_smart_malloc(IO_COND_CHECK_SAMPLES * sizeof(float), ALLOC_NORMAL);
+    if (!config || !state || !history) {
+        ESP_LOGE(TAG, "Conditioning benchmark: allocation failed");
+        psram_smart_free(config);
+        psram_smart_free(state);
+        psram_smart_free(history);
+        return false;
+    }
+    
+    memset(config, 0, sizeof(signal_config_t));
+    config->enabled = true;
+    config->offset = -0.5f;
+    config->gain = 2.0f;
+    config->scaling_factor = 0.75f;
+    config->precision_digits = 2;
+    config->filter_type = SIGNAL_FILTER_SMA;
+    config->sma_window_size = 8;
+    
+    bool passed = true;
+    signal_pipeline_t pipeline;
+    signal_conditioner_compile(config, &pipeline);
+    signal_conditioner_reset_state(&pipeline, state);
+    
+    // Compiled pipeline must match the stage-by-stage evaluation to within one rounding step
+    uint32_t seed = 1;
+    float tolerance = 1.0f / pipeline.precision_multiplier + 1e-4f;
+    for (int i = 0; i < IO_COND_CHECK_SAMPLES; i++) {
+        history[i] = cond_test_sample(&seed);
+        float compiled = signal_conditioner_process(&pipeline, state, history[i]);
+        float reference = cond_reference(config, history, i + 1, history[i]);
+        if (fabsf(compiled - reference) > tolerance) {
+            ESP_LOGE(TAG, "Conditioning mismatch at sample %d: %.4f vs reference %.4f", i, compiled, reference);
+            passed = false;
+            break;
+        }
+    }
+    
+    // Per-sample cost of the pipeline shapes used in the field
+    uint32_t sma_ns = cond_time_pipeline(&pipeline, state);
+    
+    config->filter_type = SIGNAL_FILTER_EMA;
+    config->ema_alpha = CONFIG_DEFAULT_EMA_ALPHA;
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t ema_ns = cond_time_pipeline(&pipeline, state);
+    
+    config->filter_type = SIGNAL_FILTER_MEDIAN;
+    config->median_window_size = CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE;
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t median_ns = cond_time_pipeline(&pipeline, state);
+    
+    config->filter_type = SIGNAL_FILTER_HAMPEL;
+    config->hampel_threshold = CONFIG_DEFAULT_HAMPEL_THRESHOLD;
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t hampel_ns = cond_time_pipeline(&pipeline, state);
+    
+    // Butterworth low-pass, cutoff at 1/10 of the sample rate
+    const float lowpass[5] = {0.0674553f, 0.1349106f, 0.0674553f, -1.1429805f, 0.4128016f};
+    config->filter_type = SIGNAL_FILTER_BIQUAD;
+    memcpy(config->biquad_coefficients, lowpass, sizeof(lowpass));
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t biquad_ns = cond_time_pipeline(&pipeline, state);
+    
+    config->filter_type = SIGNAL_FILTER_NONE;
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t scale_ns = cond_time_pipeline(&pipeline, state);
+    
+    config->enabled = false;
+    signal_conditioner_compile(config, &pipeline);
+    uint32_t pass_ns = cond_time_pipeline(&pipeline, state);
+    
+    // Reference evaluation of the scale + round shape for comparison
+    config->enabled = true;
+    volatile float sink = 0.0f;
+    seed = 12345;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < IO_COND_SAMPLES; i++) {
+        float value = cond_test_sample(&seed);
+        sink = cond_reference(config, &value, 1, value);
+    }
+    uint32_t reference_ns = (uint32_t)(((esp_timer_get_time() - start) * 1000) / IO_COND_SAMPLES);
+    (void)sink;
+    
+    ESP_LOGI(TAG, "Pass-through:          %lu ns/sample", pass_ns);
+    ESP_LOGI(TAG, "Scale + round:         %lu ns/sample (reference %lu ns/sample)", scale_ns, reference_ns);
+    ESP_LOGI(TAG, "Scale + SMA(8) + round: %lu ns/sample", sma_ns);
+    ESP_LOGI(TAG, "Scale + EMA + round:    %lu ns/sample", ema_ns);
+    ESP_LOGI(TAG, "Scale + median(%d) + round: %lu ns/sample", CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE, median_ns);
+    ESP_LOGI(TAG, "Scale + Hampel(%d) + round: %lu ns/sample", CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE, hampel_ns);
+    ESP_LOGI(TAG, "Scale + biquad + round: %lu ns/sample", biquad_ns);
+    
+    psram_smart_free(config);
+    psram_smart_free(state);
+    psram_smart_free(history);
+    
+    ESP_LOGI(TAG, "Conditioning benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Feed a step with one spike through a filter
+ * 
+ * Feeds `low` for half of IO_FILTER_SETTLE_SAMPLES, then `high`, with a
+ * single spike of `spike` a few samples before the step.
+ * 
+ * @param peak Largest output seen (spike leakage)
+ * @return float Final output
+ */
+static float filter_step_response(const signal_config_t* config, void* state, float low, float high, 
+                                  float spike, float* peak)
+{
+    signal_pipeline_t pipeline;
+    signal_conditioner_compile(config, &pipeline);
+    signal_conditioner_reset_state(&pipeline, state);
+    
+    float output = 0.0f;
+    *peak = -1e30f;
+    for (int i = 0; i < IO_FILTER_SETTLE_SAMPLES; i++) {
+        float sample = i < IO_FILTER_SETTLE_SAMPLES / 2 ? low : high;
+        if (i == IO_FILTER_SETTLE_SAMPLES / 2 - 10) {
+            sample = spike;
+        }
+        output = signal_conditioner_process(&pipeline, state, sample);
+        if (i < IO_FILTER_SETTLE_SAMPLES / 2 && output > *peak) {
+            *peak = output;
+        }
+    }
+    return output;
+}
+
+bool io_test_suite_filters(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "=== Signal Filter Test ===");
+    
+    signal_config_t* config = psram_smart_malloc(sizeof(signal_config_t), ALLOC_NORMAL);
+    void* state = psram_smart_malloc(IO_FILTER_STATE_BYTES, ALLOC_CRITICAL);
+    if (!config || !state) {
+        ESP_LOGE(TAG, "Filter test: allocation failed");
+        psram_smart_free(config);
+        psram_smart_free(state);
+        return false;
+    }
+    
+    memset(config, 0, sizeof(signal_config_t));
+    config->enabled = true;
+    config->gain = 1.0f;
+    config->scaling_factor = 1.0f;
+    config->precision_digits = 3;
+    config->ema_alpha = CONFIG_DEFAULT_EMA_ALPHA;
+    config->median_window_size = CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE;
+    config->hampel_threshold = CONFIG_DEFAULT_HAMPEL_THRESHOLD;
+    const float lowpass[5] = {0.0674553f, 0.1349106f, 0.0674553f, -1.1429805f, 0.4128016f};
+    memcpy(config->biquad_coefficients, lowpass, sizeof(lowpass));
+    
+    struct {
+        signal_filter_type_t type;
+        const char* name;
+        bool rejects_spike;
+    } cases[] = {
+        {SIGNAL_FILTER_EMA, "EMA", false},
+        {SIGNAL_FILTER_MEDIAN, "MEDIAN", true},
+        {SIGNAL_FILTER_HAMPEL, "HAMPEL", true},
+        {SIGNAL_FILTER_BIQUAD, "BIQUAD", false},
+    };
+    
+    bool passed = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        config->filter_type = cases[i].type;
+        float peak = 0.0f;
+        float settled = filter_step_response(config, state, 10.0f, 20.0f, 500.0f, &peak);
+        
+        // Every filter settles on a step; median and Hampel must not pass the spike at all
+        bool ok = fabsf(settled - 20.0f) < 0.01f && (!cases[i].rejects_spike || peak <= 10.0f + 0.01f);
+        ESP_LOGI(TAG, "%-6s settled %.3f, peak before step %.3f: %s", cases[i].name, settled, peak, ok ? "ok" : "FAIL");
+        passed &= ok;
+    }
+    
+    // Unstable biquad coefficients must compile to no filter stage
+    signal_pipeline_t pipeline;
+    config->filter_type = SIGNAL_FILTER_BIQUAD;
+    config->biquad_coefficients[4] = 1.5f;
+    signal_conditioner_compile(config, &pipeline);
+    if (pipeline.filter || signal_conditioner_validate_config(config)) {
+        ESP_LOGE(TAG, "Unstable biquad was accepted");
+        passed = false;
+    }
+    
+    // The live pool holds only what the configured filters need
+    if (manager) {
+        size_t fixed_bytes = (size_t)manager->active_point_count * SIGNAL_CONDITIONER_MAX_SMA_WINDOW * sizeof(float);
+        ESP_LOGI(TAG, "Filter state pool: %u bytes for %d points (fixed %d-sample windows: %u bytes)",
+                 (unsigned)manager->filter_pool.used, manager->active_point_count,
+                 SIGNAL_CONDITIONER_MAX_SMA_WINDOW, (unsigned)fixed_bytes);
+    }
+    
+    psram_smart_free(config);
+    psram_smart_free(state);
+    
+    ESP_LOGI(TAG, "Filter test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Reference interpolation: linear segment scan with per-segment division
+ */
+static float lookup_reference(const lookup_table_entry_t* table, int count, float input)
+{
+    if (input <= table[0].input) return table[0].output;
+    if (input >= table[count - 1].input) return table[count - 1].output;
+    
+    for (int i = 0; i < count - 1; i++) {
+        if (input >= table[i].input && input < table[i + 1].input) {
+            return table[i].output + (table[i + 1].output - table[i].output) * 
+                   (input - table[i].input) / (table[i + 1].input - table[i].input);
+        }
+    }
+    return input;
+}
+
+bool io_test_suite_lookup_table(void)
+{
+    ESP_LOGI(TAG, "=== Lookup Table Interpolation Test (%d entries) ===", CONFIG_MAX_LOOKUP_ENTRIES);
+    
+    signal_config_t* config = psram_smart_malloc(sizeof(signal_config_t), ALLOC_NORMAL);
+    lookup_table_entry_t* table = psram_smart_malloc(CONFIG_MAX_LOOKUP_ENTRIES * sizeof(lookup_table_entry_t), 
+                                                     ALLOC_LARGE_BUFFER);
+    if (!config || !table) {
+        ESP_LOGE(TAG, "Lookup table test: allocation failed");
+        psram_smart_free(config);
+        psram_smart_free(table);
+        return false;
+    }
+    
+    // Non-uniform, non-linear curve shaped like a capacitive moisture probe
+    int count = CONFIG_MAX_LOOKUP_ENTRIES;
+    for (int i = 0; i < count; i++) {
+        float x = (float)i * (float)i * (4095.0f / (float)((count - 1) * (count - 1)));
+        table[i].input = x;
+        table[i].output = 100.0f * sqrtf(x / 4095.0f);
+    }
+    for (int i = 0; i < count - 1; i++) {
+        table[i].slope = (table[i + 1].output - table[i].output) / (table[i + 1].input - table[i].input);
+    }
+    table[count - 1].slope = 0.0f;
+    
+    memset(config, 0, sizeof(signal_config_t));
+    config->lookup_table_enabled = true;
+    config->lookup_table = table;
+    config->lookup_table_count = count;
+    
+    bool passed = true;
+    uint32_t seed = 7;
+    for (int i = 0; i < IO_LOOKUP_CHECK_INPUTS && passed; i++) {
+        // Cover both clamped ends as well as the table range
+        float input = cond_test_sample(&seed) * 45.0f - 150.0f;
+        float result = signal_conditioner_lookup_table(input, config);
+        float reference = lookup_reference(table, count, input);
+        if (fabsf(result - reference) > 1e-2f) {
+            ESP_LOGE(TAG, "Lookup mismatch at input %.3f: %.4f vs reference %.4f", input, result, reference);
+            passed = false;
+        }
+    }
+    
+    volatile float sink = 0.0f;
+    seed = 12345;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < IO_COND_SAMPLES; i++) {
+        sink = signal_conditioner_lookup_table(cond_test_sample(&seed) * 40.95f, config);
+    }
+    uint32_t search_ns = (uint32_t)(((esp_timer_get_time() - start) * 1000) / IO_COND_SAMPLES);
+    
+    seed = 12345;
+    start = esp_timer_get_time();
+    for (int i = 0; i < IO_COND_SAMPLES; i++) {
+        sink = lookup_reference(table, count, cond_test_sample(&seed) * 40.95f);
+    }
+    uint32_t scan_ns = (uint32_t)(((esp_timer_get_time() - start) * 1000) / IO_COND_SAMPLES);
+    (void)sink;
+    
+    ESP_LOGI(TAG, "Binary search: %lu ns/lookup, linear scan: %lu ns/lookup", search_ns, scan_ns);
+    
+    psram_smart_free(config);
+    psram_smart_free(table);
+    
+    ESP_LOGI(TAG, "Lookup table test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_snapshot(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Snapshot test: IO manager not initialized");
+        return false;
+    }
+    
+    ESP_LOGI(TAG, "=== Snapshot Test (%d reads) ===", IO_SNAPSHOT_READS);
+    
+    int capacity = manager->active_point_count > 0 ? manager->active_point_count : 1;
+    io_point_snapshot_t* points = psram_smart_malloc(capacity * sizeof(io_point_snapshot_t), ALLOC_CRITICAL);
+    if (!points) {
+        ESP_LOGE(TAG, "Snapshot test: allocation failed");
+        return false;
+    }
+    
+    bool passed = true;
+    uint32_t last_sequence = 0;
+    int failures = 0;
+    int64_t worst_us = 0;
+    
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < IO_SNAPSHOT_READS; i++) {
+        int count = 0;
+        uint32_t sequence = 0;
+        
+        int64_t read_start = esp_timer_get_time();
+        esp_err_t ret = io_manager_get_snapshot(manager, points, capacity, &count, &sequence);
+        int64_t read_us = esp_timer_get_time() - read_start;
+        if (read_us > worst_us) {
+            worst_us = read_us;
+        }
+        
+        if (ret != ESP_OK) {
+            failures++;
+            continue;
+        }
+        if (count != manager->active_point_count || sequence < last_sequence) {
+            ESP_LOGE(TAG, "Snapshot test: inconsistent snapshot (count %d/%d, sequence %lu after %lu)",
+                     count, manager->active_point_count, sequence, last_sequence);
+            passed = false;
+            break;
+        }
+        last_sequence = sequence;
+        
+        // Interleave manual scans so the writer publishes during the reads
+        if ((i % 50) == 0) {
+            io_manager_update_inputs(manager);
+        }
+    }
+    int64_t total_us = esp_timer_get_time() - start;
+    
+    ESP_LOGI(TAG, "Snapshot reads: %lld us total, worst %lld us, %d retries exhausted", 
+             total_us, worst_us, failures);
+    
+    psram_smart_free(points);
+    
+    if (failures > 0) {
+        passed = false;
+    }
+    ESP_LOGI(TAG, "Snapshot test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_change_reporting(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Change reporting test: IO manager not initialized");
+        return false;
+    }
+    
+    ESP_LOGI(TAG, "=== Change Reporting Test (%d scans) ===", IO_COV_SCAN_CYCLES);
+    
+    int capacity = manager->active_point_count > 0 ? manager->active_point_count : 1;
+    io_point_change_t* changes = psram_smart_malloc(capacity * sizeof(io_point_change_t), ALLOC_CRITICAL);
+    if (!changes) {
+        ESP_LOGE(TAG, "Change reporting test: allocation failed");
+        return false;
+    }
+    
+    bool passed = true;
+    uint32_t since = 0;
+    int count = 0;
+    
+    // Catch up on everything reported so far
+    if (io_manager_get_changes_since(manager, 0, changes, capacity, &count, &since) != ESP_OK) {
+        ESP_LOGE(TAG, "Change reporting test: initial read failed");
+        psram_smart_free(changes);
+        return false;
+    }
+    
+    int reported = 0;
+    int scanned = 0;
+    for (int i = 0; i < IO_COV_SCAN_CYCLES && passed; i++) {
+        io_manager_update_inputs(manager);
+        scanned += manager->active_point_count;
+        
+        uint32_t latest = 0;
+        if (io_manager_get_changes_since(manager, since, changes, capacity, &count, &latest) != ESP_OK) {
+            ESP_LOGE(TAG, "Change reporting test: read failed at scan %d", i);
+            passed = false;
+            break;
+        }
+        
+        if (latest < since) {
+            ESP_LOGE(TAG, "Change reporting test: sequence went backwards (%lu after %lu)", latest, since);
+            passed = false;
+        }
+        for (int j = 0; j < count; j++) {
+            if (changes[j].point.change_sequence <= since || changes[j].point.change_sequence > latest) {
+                ESP_LOGE(TAG, "Change reporting test: change %lu outside (%lu, %lu]", 
+                         changes[j].point.change_sequence, since, latest);
+                passed = false;
+            }
+        }
+        
+        reported += count;
+        since = latest;
+    }
+    
+    ESP_LOGI(TAG, "Point updates: %d scanned, %d reported (%.1f%%)", 
+             scanned, reported, scanned > 0 ? 100.0f * reported / scanned : 0.0f);
+    
+    psram_smart_free(changes);
+    
+    ESP_LOGI(TAG, "Change reporting test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Compare two loaded configurations, lookup tables by content
+ */
+static bool config_load_matches(const io_config_t* a, const io_config_t* b, io_point_config_t* scratch)
+{
+    if (memcmp(a, b, offsetof(io_config_t, io_points)) != 0) {
+        return false;
+    }
+    
+    for (int i = 0; i < a->io_point_count; i++) {
+        const signal_config_t* sa = &a->io_points[i].signal_config;
+        const signal_config_t* sb = &b->io_points[i].signal_config;
+        
+        *scratch = b->io_points[i];
+        scratch->signal_config.lookup_table = sa->lookup_table;
+        if (memcmp(&a->io_points[i], scratch, sizeof(io_point_config_t)) != 0) {
+            ESP_LOGE(TAG, "Config load mismatch at point %d (%s)", i, a->io_points[i].id);
+            return false;
+        }
+        
+        if (sa->lookup_table_count > 0 && 
+            (!sa->lookup_table || !sb->lookup_table || 
+             memcmp(sa->lookup_table, sb->lookup_table, sa->lookup_table_count * sizeof(lookup_table_entry_t)) != 0)) {
+            ESP_LOGE(TAG, "Config load lookup table mismatch at point %d (%s)", i, a->io_points[i].id);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool io_test_suite_benchmark_config_load(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "=== Config Load Benchmark ===");
+    
+    static const config_load_source_t sources[] = {
+        CONFIG_LOAD_JSON_DOM, CONFIG_LOAD_JSON_STREAM, CONFIG_LOAD_BINARY_CACHE
+    };
+    static const char* const source_names[] = { "JSON DOM", "JSON stream", "binary cache" };
+    
+    config_manager_t* live = manager->config_manager;
+    config_manager_t* bench = psram_smart_malloc(sizeof(config_manager_t), ALLOC_LARGE_BUFFER);
+    io_point_config_t* scratch = psram_smart_malloc(sizeof(io_point_config_t), ALLOC_NORMAL);
+    if (!bench || !scratch || config_manager_init(bench, live->config_file_path) != ESP_OK) {
+        ESP_LOGE(TAG, "Config load benchmark: allocation failed");
+        psram_smart_free(bench);
+        psram_smart_free(scratch);
+        return false;
+    }
+    
+    bool passed = true;
+    for (size_t s = 0; s < sizeof(sources) / sizeof(sources[0]); s++) {
+        size_t internal_before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+        size_t total_before = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+        heap_caps_monitor_local_minimum_free_size_start();
+        
+        int64_t start = esp_timer_get_time();
+        esp_err_t ret = config_manager_load_from(bench, sources[s]);
+        uint32_t load_us = (uint32_t)(esp_timer_get_time() - start);
+        
+        size_t internal_peak = internal_before - heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+        size_t total_peak = total_before - heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+        heap_caps_monitor_local_minimum_free_size_stop();
+        
+        if (ret == ESP_ERR_NOT_FOUND && sources[s] == CONFIG_LOAD_BINARY_CACHE) {
+            ESP_LOGW(TAG, "%-12s: no cache file, skipped", source_names[s]);
+            continue;
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "%-12s: load failed: %s", source_names[s], esp_err_to_name(ret));
+            passed = false;
+            continue;
+        }
+        
+        bool matches = config_load_matches(&live->config, &bench->config, scratch);
+        passed = passed && matches;
+        
+        ESP_LOGI(TAG, "%-12s: %lu us, peak heap %zu bytes (internal %zu), %d points%s", 
+                 source_names[s], load_us, total_peak, internal_peak, bench->config.io_point_count,
+                 matches ? "" : " (MISMATCH)");
+    }
+    
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    psram_smart_free(scratch);
+    
+    ESP_LOGI(TAG, "Config load benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_reload(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Reload test: IO manager not initialized");
+        return false;
+    }
+    
+    ESP_LOGI(TAG, "=== Incremental Reload Test ===");
+    
+    io_manager_update_inputs(manager);
+    
+    int count = manager->active_point_count;
+    io_point_runtime_state_t* before = psram_smart_malloc((count > 0 ? count : 1) * sizeof(io_point_runtime_state_t), 
+                                                          ALLOC_NORMAL);
+    if (!before) {
+        ESP_LOGE(TAG, "Reload test: allocation failed");
+        return false;
+    }
+
+    uint16_t generation = manager->point_generation;
+    memcpy(before, manager->runtime_states, count * sizeof(io_point_runtime_state_t));
+    
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = io_manager_reload_config(manager);
+    int64_t reload_us = esp_timer_get_time() - start;
+    
+    // An unchanged configuration must keep every handle, value, counter and output level
+    bool passed = (ret == ESP_OK && manager->active_point_count == count && 
+                   manager->point_generation == generation);
+    for (int i = 0; passed && i < count; i++) {
+        const io_point_runtime_state_t* after = &manager->runtime_states[i];
+        if (after->update_count < before[i].update_count || after->digital_state != before[i].digital_state ||
+            after->alarm_count != before[i].alarm_count || after->change_sequence != before[i].change_sequence) {
+            ESP_LOGE(TAG, "Reload test: state of %s was reset", manager->point_ids[i]);
+            passed = false;
+        }
+    }
+    
+    ESP_LOGI(TAG, "Reload of %d unchanged points: %lld us (%s)", count, reload_us, esp_err_to_name(ret));
+    
+    psram_smart_free(before);
+    
+    ESP_LOGI(TAG, "Reload test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Commit a batch and count the shift register latches it took
+ * 
+ * Caller holds scan_mutex so no scan pass latches the chain meanwhile.
+ */
+static esp_err_t batch_commit_counted(io_manager_t* manager, io_output_batch_t* batch, uint32_t* latches)
+{
+    uint32_t before = 0;
+    uint32_t after = 0;
+    shift_register_get_statistics(&manager->shift_register_handler, NULL, &before, NULL);
+    esp_err_t ret = io_manager_commit_outputs(manager, batch);
+    shift_register_get_statistics(&manager->shift_register_handler, NULL, &after, NULL);
+    *latches = after - before;
+    return ret;
+}
+
+/**
+ * @brief Stage every test output at its current level
+ */
+static bool batch_stage_current(io_manager_t* manager, io_output_batch_t* batch, 
+                                const io_point_handle_t* handles, int count)
+{
+    if (io_manager_begin_outputs(manager, batch) != ESP_OK) {
+        return false;
+    }
+    for (int n = 0; n < count; n++) {
+        bool state = false;
+        if (io_manager_get_binary_output_by_handle(manager, handles[n], &state) != ESP_OK ||
+            io_manager_set_output(manager, batch, handles[n], state) != ESP_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool io_test_suite_output_batch(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Output batch test: IO manager not initialized");
+        return false;
+    }
+    
+    // Mapped shift register outputs that no interlock names and no pulse holds
+    io_point_handle_t handles[IO_BATCH_TEST_OUTPUTS];
+    int indices[IO_BATCH_TEST_OUTPUTS];
+    int count = 0;
+    for (int i = 0; i < manager->active_point_count && count < IO_BATCH_TEST_OUTPUTS; i++) {
+        const io_point_descriptor_t* point = &manager->point_table[i];
+        if (point->type != IO_POINT_TYPE_SHIFT_REG_BO || 
+            point->chip_index >= manager->shift_register_handler.config.num_output_registers) {
+            continue;
+        }
+        bool named = false;
+        for (int k = 0; k < manager->interlock_count; k++) {
+            if (manager->interlocks[k].output_index == i) {
+                named = true;
+            }
+        }
+        io_pulse_result_t pulse;
+        if (named || io_manager_resolve_handle(manager, manager->point_ids[i], &handles[count]) != ESP_OK ||
+            io_manager_get_pulse_result_by_handle(manager, handles[count], &pulse) != ESP_OK || pulse.active) {
+            continue;
+        }
+        indices[count++] = i;
+    }
+    if (count < 2) {
+        ESP_LOGW(TAG, "Output batch test: fewer than 2 free shift register outputs, skipped");
+        return true;
+    }
+    
+    ESP_LOGI(TAG, "=== Output Batch Test (%d outputs) ===", count);
+    
+    // Every output is rewritten at its current level, so the relays never move
+    io_output_batch_t batch;
+    uint32_t latches = 0;
+    bool passed = true;
+    if (xSemaphoreTake(manager->scan_mutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        ESP_LOGE(TAG, "Output batch test: scan mutex busy");
+        return false;
+    }
+    
+    // A multi-point batch reaches the chain in one latch and is emptied
+    esp_err_t ret = ESP_FAIL;
+    if (batch_stage_current(manager, &batch, handles, count)) {
+        ret = batch_commit_counted(manager, &batch, &latches);
+    }
+    ESP_LOGI(TAG, "%d outputs committed: %lu latch(es) (%s)", count, latches, esp_err_to_name(ret));
+    if (ret != ESP_OK || latches != 1 || batch.staged_count != 0) {
+        ESP_LOGE(TAG, "Output batch test: batch did not land in one latch");
+        passed = false;
+    }
+    
+    // A held target is refused and reported; the rest still lands in one latch
+    if (passed && batch_stage_current(manager, &batch, handles, count)) {
+        xSemaphoreTake(manager->state_mutex, portMAX_DELAY);
+        manager->runtime_states[indices[0]].interlocked = true;
+        xSemaphoreGive(manager->state_mutex);
+        
+        ret = batch_commit_counted(manager, &batch, &latches);
+        
+        xSemaphoreTake(manager->state_mutex, portMAX_DELAY);
+        manager->runtime_states[indices[0]].interlocked = false;
+        xSemaphoreGive(manager->state_mutex);
+        
+        bool rest_staged = true;
+        for (int n = 1; n < count; n++) {
+            rest_staged = rest_staged && io_manager_output_staged(&batch, handles[n]);
+        }
+        if (ret != ESP_ERR_INVALID_STATE || latches != 1 || io_manager_output_staged(&batch, handles[0]) || 
+            !rest_staged || batch.staged_count != count - 1) {
+            ESP_LOGE(TAG, "Output batch test: held output %s not refused alone (%s, %lu latches)", 
+                     manager->point_ids[indices[0]], esp_err_to_name(ret), latches);
+            passed = false;
+        }
+    } else if (passed) {
+        ESP_LOGE(TAG, "Output batch test: staging failed");
+        passed = false;
+    }
+    
+    // A batch opened before a reload is rejected whole, before anything is written
+    if (passed && batch_stage_current(manager, &batch, handles, count)) {
+        batch.generation--;
+        ret = batch_commit_counted(manager, &batch, &latches);
+        if (ret != ESP_ERR_INVALID_STATE || latches != 0 || batch.staged_count != count) {
+            ESP_LOGE(TAG, "Output batch test: stale batch applied (%s, %lu latches)", esp_err_to_name(ret), latches);
+            passed = false;
+        }
+    } else if (passed) {
+        ESP_LOGE(TAG, "Output batch test: staging failed");
+        passed = false;
+    }
+    
+    xSemaphoreGive(manager->scan_mutex);
+    
+    ESP_LOGI(TAG, "Output batch test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_edge_inputs(void)
+{
+    ESP_LOGI(TAG, "=== Edge Input Test (synthetic edge trains) ===");
+    
+    gpio_handler_t synth;
+    esp_err_t ret = gpio_handler_init_synthetic(&synth, 0, 4);
+    if (ret == ESP_OK) {
+        ret = gpio_handler_configure_edge_input(&synth, IO_EDGE_TEST_PIN, true, IO_EDGE_TEST_DEBOUNCE_US, false);
+    }
+    if (ret == ESP_OK) {
+        ret = gpio_handler_configure_edge_input(&synth, IO_COUNTER_TEST_PIN, true, 
+                                                CONFIG_DEFAULT_COUNTER_DEBOUNCE_US, true);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Edge input test: setup failed: %s", esp_err_to_name(ret));
+        gpio_handler_destroy(&synth);
+        return false;
+    }
+    
+    // Edges are injected in the past so a later read can settle a level held since
+    int64_t t0 = esp_timer_get_time() - 1000000;
+    bool passed = true;
+    gpio_edge_status_t status;
+    
+    // Contact bounce on press: the first edge is taken, the chatter inside the window is rejected
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, true, t0);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, false, t0 + 100);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, true, t0 + 200);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, false, t0 + 300);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, true, t0 + 400);
+    gpio_handler_read_edge_input(&synth, IO_EDGE_TEST_PIN, &status);
+    if (!status.level || status.edge_count != 1 || status.rejected_count != 2) {
+        ESP_LOGE(TAG, "Edge input test: bounce gave level %d, %lu edges, %lu rejected (expected 1, 1, 2)", 
+                 status.level, (unsigned long)status.edge_count, (unsigned long)status.rejected_count);
+        passed = false;
+    }
+    
+    // Clean release, then a short pulse whose trailing edge falls inside the window
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, false, t0 + 10000);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, true, t0 + 20000);
+    gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN, false, t0 + 20500);
+    
+    // The line has stayed low since, so the read must settle it at its original timestamp
+    gpio_handler_read_edge_input(&synth, IO_EDGE_TEST_PIN, &status);
+    if (status.level || status.edge_count != 4 || status.last_edge_us != t0 + 20500) {
+        ESP_LOGE(TAG, "Edge input test: settle gave level %d, %lu edges at %lld us (expected 0, 4, %lld us)", 
+                 status.level, (unsigned long)status.edge_count, status.last_edge_us - t0, 20500LL);
+        passed = false;
+    }
+    
+    static const int64_t expected_offsets[] = {0, 10000, 20000, 20500};
+    gpio_edge_event_t events[GPIO_HANDLER_EDGE_HISTORY];
+    int event_count = 0;
+    gpio_handler_get_edges(&synth, IO_EDGE_TEST_PIN, 0, events, GPIO_HANDLER_EDGE_HISTORY, &event_count);
+    if (event_count != 4) {
+        ESP_LOGE(TAG, "Edge input test: %d edges in history (expected 4)", event_count);
+        passed = false;
+    }
+    for (int i = 0; i < event_count && i < 4; i++) {
+        if (events[i].sequence != (uint32_t)(i + 1) || events[i].timestamp_us != t0 + expected_offsets[i] ||
+            events[i].level != ((i & 1) == 0)) {
+            ESP_LOGE(TAG, "Edge input test: edge %d is #%lu at %lld us level %d", i, 
+                     (unsigned long)events[i].sequence, events[i].timestamp_us - t0, events[i].level);
+            passed = false;
+        }
+    }
+    gpio_handler_get_edges(&synth, IO_EDGE_TEST_PIN, 2, events, GPIO_HANDLER_EDGE_HISTORY, &event_count);
+    if (event_count != 2 || events[0].sequence != 3) {
+        ESP_LOGE(TAG, "Edge input test: %d edges since #2 (expected 2 starting at #3)", event_count);
+        passed = false;
+    }
+    
+    // Pulse train with a bounce on every rising edge, timed as the ISR path
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < IO_COUNTER_TEST_PULSES; i++) {
+        int64_t t = t0 + (int64_t)i * 1000;
+        gpio_handler_inject_edge(&synth, IO_COUNTER_TEST_PIN, true, t);
+        gpio_handler_inject_edge(&synth, IO_COUNTER_TEST_PIN, false, t + 20);
+        gpio_handler_inject_edge(&synth, IO_COUNTER_TEST_PIN, true, t + 40);
+        gpio_handler_inject_edge(&synth, IO_COUNTER_TEST_PIN, false, t + 500);
+    }
+    int64_t inject_us = esp_timer_get_time() - start;
+    
+    gpio_handler_read_edge_input(&synth, IO_COUNTER_TEST_PIN, &status);
+    if (status.pulse_count != IO_COUNTER_TEST_PULSES || status.edge_count != 2 * IO_COUNTER_TEST_PULSES || 
+        status.rejected_count != IO_COUNTER_TEST_PULSES) {
+        ESP_LOGE(TAG, "Edge input test: counter gave %lu pulses, %lu edges, %lu rejected (expected %d, %d, %d)", 
+                 (unsigned long)status.pulse_count, (unsigned long)status.edge_count, 
+                 (unsigned long)status.rejected_count, IO_COUNTER_TEST_PULSES, 2 * IO_COUNTER_TEST_PULSES, 
+                 IO_COUNTER_TEST_PULSES);
+        passed = false;
+    }
+    
+    // History keeps only the newest edges
+    gpio_handler_get_edges(&synth, IO_COUNTER_TEST_PIN, 0, events, GPIO_HANDLER_EDGE_HISTORY, &event_count);
+    if (event_count != GPIO_HANDLER_EDGE_HISTORY || 
+        events[0].sequence != 2 * IO_COUNTER_TEST_PULSES - GPIO_HANDLER_EDGE_HISTORY + 1) {
+        ESP_LOGE(TAG, "Edge input test: history wrap returned %d edges from #%lu", event_count, 
+                 (unsigned long)(event_count > 0 ? events[0].sequence : 0));
+        passed = false;
+    }
+    
+    // Released and unconfigured pins take no edges
+    gpio_handler_release_edge_input(&synth, IO_EDGE_TEST_PIN);
+    if (gpio_handler_read_edge_input(&synth, IO_EDGE_TEST_PIN, &status) != ESP_ERR_NOT_FOUND ||
+        gpio_handler_inject_edge(&synth, IO_EDGE_TEST_PIN + 10, true, t0) != ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(TAG, "Edge input test: released or unconfigured pin accepted an edge");
+        passed = false;
+    }
+    
+    ESP_LOGI(TAG, "Edge processing: %lld ns/edge", inject_us * 1000 / (4 * IO_COUNTER_TEST_PULSES));
+    
+    gpio_handler_destroy(&synth);
+    
+    ESP_LOGI(TAG, "Edge input test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_pulse_outputs(io_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        ESP_LOGE(TAG, "Pulse output test: IO manager not initialized");
+        return false;
+    }
+    
+    int point_index = -1;
+    for (int i = 0; i < manager->active_point_count && point_index < 0; i++) {
+        uint8_t type = manager->point_table[i].type;
+        if (type == IO_POINT_TYPE_GPIO_BO || type == IO_POINT_TYPE_SHIFT_REG_BO) {
+            point_index = i;
+        }
+    }
+    if (point_index < 0) {
+        ESP_LOGW(TAG, "Pulse output test: no binary output configured, skipped");
+        return true;
+    }
+    
+    const char* point_id = manager->point_ids[point_index];
+    ESP_LOGI(TAG, "=== Pulse Output Test (%s) ===", point_id);
+    
+    io_point_handle_t handle;
+    bool initial_state = false;
+    if (io_manager_resolve_handle(manager, point_id, &handle) != ESP_OK ||
+        io_manager_get_binary_output_by_handle(manager, handle, &initial_state) != ESP_OK) {
+        ESP_LOGE(TAG, "Pulse output test: cannot resolve %s", point_id);
+        return false;
+    }
+    
+    bool passed = true;
+    io_pulse_result_t result;
+    
+    // Timed pulses; the test task spins through them without yielding to load its core
+    for (size_t i = 0; i < sizeof(io_pulse_test_ms) / sizeof(io_pulse_test_ms[0]) && passed; i++) {
+        uint64_t requested_us = (uint64_t)io_pulse_test_ms[i] * 1000;
+        if (io_manager_pulse_output_by_handle(manager, handle, requested_us) != ESP_OK) {
+            ESP_LOGE(TAG, "Pulse output test: pulse of %lu ms rejected", io_pulse_test_ms[i]);
+            passed = false;
+            break;
+        }
+        
+        int64_t until = esp_timer_get_time() + (int64_t)requested_us;
+        while (esp_timer_get_time() < until) {
+        }
+        vTaskDelay(pdMS_TO_TICKS(IO_PULSE_SETTLE_MS));
+        
+        if (io_manager_get_pulse_result_by_handle(manager, handle, &result) != ESP_OK || result.active) {
+            ESP_LOGE(TAG, "Pulse output test: %lu ms pulse still active", io_pulse_test_ms[i]);
+            passed = false;
+            break;
+        }
+        
+        int64_t error_us = (int64_t)result.achieved_us - (int64_t)result.requested_us;
+        ESP_LOGI(TAG, "%3lu ms pulse: %llu us achieved (%+lld us)", io_pulse_test_ms[i], result.achieved_us, error_us);
+        if (error_us > IO_PULSE_TOLERANCE_US || error_us < -IO_PULSE_TOLERANCE_US) {
+            passed = false;
+        }
+    }
+    
+    // An explicit write cancels the pending switch-off
+    if (passed && io_manager_pulse_output_by_handle(manager, handle, 10 * 1000000ULL) == ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(IO_PULSE_SETTLE_MS));
+        io_manager_set_binary_output_by_handle(manager, handle, false);
+        if (io_manager_get_pulse_result_by_handle(manager, handle, &result) != ESP_OK || result.active || 
+            manager->pulse_heap_count != 0 || result.achieved_us >= result.requested_us) {
+            ESP_LOGE(TAG, "Pulse output test: explicit write did not cancel the pulse");
+            passed = false;
+        }
+    }
+    
+    io_manager_set_binary_output_by_handle(manager, handle, initial_state);
+    
+    ESP_LOGI(TAG, "Pulses completed: %lu, worst on-time error %lld us", 
+             manager->pulse_completed_count, manager->pulse_worst_error_us);
+    ESP_LOGI(TAG, "Pulse output test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_alarm_stage(void)
+{
+    ESP_LOGI(TAG, "=== Alarm Stage Test (%d points) ===", IO_ALARM_TEST_POINTS);
+    
+    config_manager_t* bench = create_bench_config(NULL, IO_ALARM_TEST_POINTS);
+    alarm_manager_t* alarms = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+    if (!bench || !alarms) {
+        ESP_LOGE(TAG, "Alarm stage test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(alarms);
+        return false;
+    }
+    
+    // Max value alarm: 3 samples to activate, 2 to clear; rate of change on every point
+    for (int i = 0; i < IO_ALARM_TEST_POINTS; i++) {
+        alarm_config_t* config = &bench->config.io_points[i].alarm_config;
+        memset(config, 0, sizeof(alarm_config_t));
+        config->enabled = true;
+        config->rules.check_max_value = true;
+        config->rules.max_value_threshold = 90.0f;
+        config->rules.check_rate_of_change = true;
+        config->rules.rate_of_change_threshold = 1000.0f;
+        config->rules.alarm_persistence_samples = 3;
+        config->rules.samples_to_clear_alarm_condition = 2;
+    }
+    
+    bool passed = (alarm_manager_init(alarms, bench) == ESP_OK && alarms->active_point_count == IO_ALARM_TEST_POINTS);
+    
+    // Expected alarm state after each sample of point 0
+    static const float values[] = {50.0f, 50.0f, 95.0f, 95.0f, 95.0f, 50.0f, 50.0f, 50.0f};
+    static const bool expected[] = {false, false, false, false, true, true, false, false};
+    alarm_point_handle_t handle = -1;
+    if (passed && alarm_manager_resolve_point(alarms, bench->config.io_points[0].id, &handle) != ESP_OK) {
+        passed = false;
+    }
+    for (size_t i = 0; passed && i < sizeof(values) / sizeof(values[0]); i++) {
+        bool active = false;
+        if (alarm_manager_process_sample(alarms, handle, values[i], esp_timer_get_time(), &active) != ESP_OK ||
+            active != expected[i]) {
+            ESP_LOGE(TAG, "Alarm stage test: sample %u (%.0f) gave %s", (unsigned)i, (double)values[i], 
+                     active ? "active" : "inactive");
+            passed = false;
+        }
+    }
+    
+    // Per-sample cost of the stage as the scan sees it
+    if (passed) {
+        int64_t start = esp_timer_get_time();
+        for (int n = 0; n < IO_ALARM_TEST_SAMPLES; n++) {
+            for (int i = 0; i < IO_ALARM_TEST_POINTS; i++) {
+                alarm_manager_process_sample(alarms, i, (float)((n + i) % 100), (uint64_t)n, NULL);
+            }
+        }
+        int64_t elapsed_us = esp_timer_get_time() - start;
+        ESP_LOGI(TAG, "Alarm stage: %.2f us/sample", 
+                 (double)elapsed_us / ((double)IO_ALARM_TEST_SAMPLES * IO_ALARM_TEST_POINTS));
+    }
+    
+    if (alarms->initialized) {
+        alarm_manager_destroy(alarms);
+    }
+    psram_smart_free(alarms);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    ESP_LOGI(TAG, "Alarm stage test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Per-sample cost of the alarm stage for one point (microseconds)
+ */
+static double alarm_window_time(alarm_manager_t* alarms, alarm_point_handle_t handle)
+{
+    uint32_t seed = 7;
+    int64_t start = esp_timer_get_time();
+    for (int n = 0; n < IO_ALARM_TEST_SAMPLES; n++) {
+        alarm_manager_process_sample(alarms, handle, cond_test_sample(&seed), (uint64_t)n, NULL);
+    }
+    return (double)(esp_timer_get_time() - start) / IO_ALARM_TEST_SAMPLES;
+}
+
+bool io_test_suite_alarm_window(void)
+{
+    ESP_LOGI(TAG, "=== Alarm Window Test (%d / %d samples) ===", IO_ALARM_WINDOW_SMALL, IO_ALARM_WINDOW_LARGE);
+    
+    config_manager_t* bench = create_bench_config(NULL, 2);
+    alarm_manager_t* alarms = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+    float* history = psram_smart_malloc(IO_ALARM_WINDOW_SAMPLES * sizeof(float), ALLOC_NORMAL);
+    if (!bench || !alarms || !history) {
+        ESP_LOGE(TAG, "Alarm window test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(alarms);
+        psram_smart_free(history);
+        return false;
+    }
+    
+    // Point 0: large window with every window-based rule; point 1: small window, same rules
+    for (int i = 0; i < 2; i++) {
+        alarm_config_t* config = &bench->config.io_points[i].alarm_config;
+        memset(config, 0, sizeof(alarm_config_t));
+        config->enabled = true;
+        config->history_samples_for_analysis = (i == 0) ? IO_ALARM_WINDOW_LARGE : IO_ALARM_WINDOW_SMALL;
+        config->rules.check_rate_of_change = true;
+        config->rules.rate_of_change_threshold = 1000.0f;
+        config->rules.check_stuck_signal = true;
+        config->rules.stuck_signal_window_samples = (i == 0) ? IO_ALARM_STUCK_WINDOW : IO_ALARM_WINDOW_SMALL / 2;
+        config->rules.stuck_signal_delta_threshold = 1.0f;
+        config->rules.check_noise_band = true;
+        config->rules.noise_band_threshold = 20.0f;
+        config->rules.alarm_persistence_samples = 1;
+        config->rules.samples_to_clear_alarm_condition = 1;
+    }
+    
+    bool passed = (alarm_manager_init(alarms, bench) == ESP_OK && alarms->active_point_count == 2);
+    
+    // Random samples with a constant stretch every 500 so the stuck window sees both
+    uint32_t seed = 12345;
+    for (int n = 0; passed && n < IO_ALARM_WINDOW_SAMPLES; n++) {
+        history[n] = (n % 500 >= 300) ? 42.0f : cond_test_sample(&seed);
+        if (alarm_manager_process_sample(alarms, 0, history[n], (uint64_t)n, NULL) != ESP_OK) {
+            passed = false;
+            break;
+        }
+        
+        // Brute-force reference over the same windows
+        int stuck_count = (n + 1 < IO_ALARM_STUCK_WINDOW) ? n + 1 : IO_ALARM_STUCK_WINDOW;
+        float window_min = history[n];
+        float window_max = history[n];
+        for (int k = n - stuck_count + 1; k <= n; k++) {
+            window_min = fminf(window_min, history[k]);
+            window_max = fmaxf(window_max, history[k]);
+        }
+        int count = (n + 1 < IO_ALARM_WINDOW_LARGE) ? n + 1 : IO_ALARM_WINDOW_LARGE;
+        double sum = 0.0;
+        for (int k = n - count + 1; k <= n; k++) {
+            sum += history[k];
+        }
+        double mean = sum / count;
+        double squares = 0.0;
+        for (int k = n - count + 1; k <= n; k++) {
+            squares += (history[k] - mean) * (history[k] - mean);
+        }
+        
+        const alarm_window_t* window = &alarms->points.windows[0];
+        float got_min = window->samples[window->min_deque[window->min_front]];
+        float got_max = window->samples[window->max_deque[window->max_front]];
+        if (got_min != window_min || got_max != window_max || window->count != count ||
+            fabs(window->mean - mean) > 0.01 || fabs(window->m2 - squares) > 0.001 * squares + 0.01) {
+            ESP_LOGE(TAG, "Alarm window test: sample %d min %.3f/%.3f max %.3f/%.3f mean %.4f/%.4f m2 %.1f/%.1f",
+                     n, (double)got_min, (double)window_min, (double)got_max, (double)window_max,
+                     (double)window->mean, mean, (double)window->m2, squares);
+            passed = false;
+        }
+        
+        // The stuck alarm follows the constant stretches
+        bool stuck = false;
+        alarm_manager_get_alarm_status(alarms, bench->config.io_points[0].id, ALARM_TYPE_STUCK_SIGNAL, &stuck);
+        if (stuck != (window_max - history[n] <= 1.0f && history[n] - window_min <= 1.0f &&
+                      stuck_count == IO_ALARM_STUCK_WINDOW)) {
+            ESP_LOGE(TAG, "Alarm window test: sample %d stuck alarm %s", n, stuck ? "active" : "inactive");
+            passed = false;
+        }
+    }
+    
+    // Per-sample cost must not grow with the window
+    if (passed) {
+        double small_us = alarm_window_time(alarms, 1);
+        double large_us = alarm_window_time(alarms, 0);
+        ESP_LOGI(TAG, "Alarm window: %.2f us/sample (%d), %.2f us/sample (%d)", 
+                 small_us, IO_ALARM_WINDOW_SMALL, large_us, IO_ALARM_WINDOW_LARGE);
+        if (large_us > small_us * IO_ALARM_WINDOW_MAX_RATIO) {
+            ESP_LOGE(TAG, "Alarm window test: cost grows with window length");
+            passed = false;
+        }
+    }
+    
+    if (alarms->initialized) {
+        alarm_manager_destroy(alarms);
+    }
+    psram_smart_free(alarms);
+    psram_smart_free(history);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    ESP_LOGI(TAG, "Alarm window test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_alarm_suppression(void)
+{
+    ESP_LOGI(TAG, "=== Alarm Suppression Test ===");
+    
+    config_manager_t* bench = create_bench_config(NULL, 3);
+    alarm_manager_t* alarms = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+    if (!bench || !alarms) {
+        ESP_LOGE(TAG, "Alarm suppression test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(alarms);
+        return false;
+    }
+    
+    // Point 0 flaps, point 1 sees a root cause and a consequence, point 2 is shelved
+    for (int i = 0; i < 3; i++) {
+        alarm_config_t* config = &bench->config.io_points[i].alarm_config;
+        memset(config, 0, sizeof(alarm_config_t));
+        config->enabled = true;
+        config->rules.check_disconnected = true;
+        config->rules.disconnected_threshold = 2.0f;
+        config->rules.check_rate_of_change = (i == 1);
+        config->rules.rate_of_change_threshold = 10.0f;
+        config->rules.alarm_persistence_samples = 1;
+        config->rules.samples_to_clear_alarm_condition = 1;
+    }
+    
+    bool passed = (alarm_manager_init(alarms, bench) == ESP_OK && alarms->active_point_count == 3);
+    const uint32_t disconnected = ALARM_RULE_BIT(ALARM_TYPE_DISCONNECTED);
+    const uint32_t rate = ALARM_RULE_BIT(ALARM_TYPE_RATE_OF_CHANGE);
+    
+    // Flapping: only the first activations of the rate window are notified
+    for (int n = 0; passed && n < IO_ALARM_FLAP_SAMPLES; n++) {
+        passed = alarm_manager_process_sample(alarms, 0, (n % 2 == 0) ? 0.0f : 50.0f, (uint64_t)n, NULL) == ESP_OK;
+    }
+    uint32_t flap_notified = alarms->notified_count;
+    uint32_t flap_limited = alarms->rate_limited_count;
+    if (passed && (flap_notified != 2 * ALARM_RATE_MAX_PER_TYPE || 
+                   flap_limited != IO_ALARM_FLAP_SAMPLES / 2 - ALARM_RATE_MAX_PER_TYPE)) {
+        ESP_LOGE(TAG, "Alarm suppression test: flapping notified %lu, rate limited %lu", flap_notified, flap_limited);
+        passed = false;
+    }
+    
+    // First-out: the drop trips the rate alarm first, disconnected is grouped under it
+    bool active = false;
+    if (passed) {
+        alarm_manager_process_sample(alarms, 1, 50.0f, 0, NULL);
+        alarm_manager_process_sample(alarms, 1, 0.0f, 0, &active);
+        if (!active || alarms->points.first_out_type[1] != ALARM_TYPE_RATE_OF_CHANGE ||
+            alarms->points.notified_mask[1] != rate || alarms->points.active_mask[1] != (rate | disconnected) ||
+            alarms->grouped_count != 1) {
+            ESP_LOGE(TAG, "Alarm suppression test: first-out grouping failed");
+            passed = false;
+        }
+    }
+    // The root cause clears; the consequence outlasts it and is notified on its own
+    if (passed) {
+        alarm_manager_process_sample(alarms, 1, 0.0f, 0, &active);
+        if (!active || alarms->points.notified_mask[1] != disconnected || 
+            alarms->points.first_out_type[1] != ALARM_FIRST_OUT_NONE) {
+            ESP_LOGE(TAG, "Alarm suppression test: grouped alarm not released");
+            passed = false;
+        }
+    }
+    
+    // Shelved: held back until the shelve expires
+    if (passed) {
+        passed = alarm_manager_shelve(alarms, bench->config.io_points[2].id, ALARM_TYPE_DISCONNECTED, 
+                                      IO_ALARM_SHELVE_MS) == ESP_OK;
+        alarm_manager_process_sample(alarms, 2, 0.0f, 0, &active);
+        if (!passed || active || alarms->points.active_mask[2] != disconnected) {
+            ESP_LOGE(TAG, "Alarm suppression test: shelved alarm notified");
+            passed = false;
+        }
+    }
+    if (passed) {
+        vTaskDelay(pdMS_TO_TICKS(IO_ALARM_SHELVE_MS + 100));
+        alarm_manager_process_sample(alarms, 2, 0.0f, 0, &active);
+        if (!active || alarms->points.shelved_mask[2] != 0) {
+            ESP_LOGE(TAG, "Alarm suppression test: shelve did not expire");
+            passed = false;
+        }
+    }
+    
+    // A persistent alarm during the flood stays pending until the rate window allows it
+    alarm_summary_t summary;
+    alarm_point_summary_t points[3];
+    int point_count = 0;
+    if (passed) {
+        alarm_manager_process_sample(alarms, 0, 0.0f, 0, &active);
+        passed = !active && alarm_manager_get_summary(alarms, &summary, points, 3, &point_count) == ESP_OK &&
+                 summary.active_alarms == 3 && summary.notified_alarms == 2 && summary.points_in_alarm == 2 &&
+                 point_count == 3 && summary.rate_limited == flap_limited && summary.grouped == 1;
+        if (!passed) {
+            ESP_LOGE(TAG, "Alarm suppression test: summary %u active, %u notified, %d points",
+                     summary.active_alarms, summary.notified_alarms, point_count);
+        } else {
+            ESP_LOGI(TAG, "Notified %lu transitions, rate limited %lu, grouped %lu", 
+                     summary.notified_transitions, summary.rate_limited, summary.grouped);
+        }
+    }
+    
+    if (alarms->initialized) {
+        alarm_manager_destroy(alarms);
+    }
+    psram_smart_free(alarms);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    ESP_LOGI(TAG, "Alarm suppression test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_interlocks(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "=== Interlock Test ===");
+    
+    config_manager_t* bench = create_bench_config(NULL, 2);
+    alarm_manager_t* alarms = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+    if (!bench || !alarms) {
+        ESP_LOGE(TAG, "Interlock test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(alarms);
+        return false;
+    }
+    
+    // Point 0: over range forces OUT_A off, any alarm forces OUT_B on; point 1: disconnected forces OUT_A on
+    for (int i = 0; i < 2; i++) {
+        alarm_config_t* config = &bench->config.io_points[i].alarm_config;
+        memset(config, 0, sizeof(alarm_config_t));
+        config->enabled = true;
+        config->rules.check_max_value = true;
+        config->rules.max_value_threshold = 90.0f;
+        config->rules.check_disconnected = true;
+        config->rules.disconnected_threshold = 2.0f;
+        config->rules.alarm_persistence_samples = 1;
+        config->rules.samples_to_clear_alarm_condition = 1;
+    }
+    alarm_config_t* config = &bench->config.io_points[0].alarm_config;
+    config->interlock_count = 2;
+    strcpy(config->interlocks[0].output_point_id, "OUT_A");
+    config->interlocks[0].alarm_mask = CONFIG_INTERLOCK_MAX_VALUE;
+    config->interlocks[0].forced_state = false;
+    strcpy(config->interlocks[1].output_point_id, "OUT_B");
+    config->interlocks[1].alarm_mask = CONFIG_INTERLOCK_ANY;
+    config->interlocks[1].forced_state = true;
+    config = &bench->config.io_points[1].alarm_config;
+    config->interlock_count = 1;
+    strcpy(config->interlocks[0].output_point_id, "OUT_A");
+    config->interlocks[0].alarm_mask = CONFIG_INTERLOCK_DISCONNECTED;
+    config->interlocks[0].forced_state = true;
+    
+    alarm_interlock_info_t info;
+    bool passed = alarm_manager_init(alarms, bench) == ESP_OK && alarm_manager_get_interlock_count(alarms) == 3 &&
+                  alarm_manager_get_interlock(alarms, 2, &info) == ESP_OK && strcmp(info.output_point_id, "OUT_A") == 0 &&
+                  strcmp(info.point_id, bench->config.io_points[1].id) == 0 && info.forced_state &&
+                  info.alarm_mask == ALARM_RULE_BIT(ALARM_TYPE_DISCONNECTED);
+    if (!passed) {
+        ESP_LOGE(TAG, "Interlock test: interlocks not compiled");
+    }
+    
+    // Tripped mask follows the raw alarm state after each batch, shelved or not
+    alarm_sample_t samples[2];
+    static const float values[][2] = {{50.0f, 50.0f}, {95.0f, 50.0f}, {95.0f, 50.0f}, {50.0f, 0.0f}};
+    static const uint32_t expected[] = {0x0, 0x3, 0x3, 0x4};
+    for (size_t n = 0; passed && n < sizeof(expected) / sizeof(expected[0]); n++) {
+        if (n == 2) {
+            alarm_manager_shelve(alarms, bench->config.io_points[0].id, ALARM_TYPE_COUNT, IO_ALARM_SHELVE_MS);
+        }
+        for (int i = 0; i < 2; i++) {
+            samples[i].handle = i;
+            samples[i].value = values[n][i];
+            samples[i].source_index = 0;
+            samples[i].active = false;
+        }
+        uint32_t tripped = 0xFFFFFFFF;
+        if (alarm_manager_process_samples(alarms, samples, 2, (uint64_t)n, &tripped) != ESP_OK || 
+            tripped != expected[n]) {
+            ESP_LOGE(TAG, "Interlock test: pass %u tripped 0x%lx, expected 0x%lx", 
+                     (unsigned)n, (unsigned long)tripped, (unsigned long)expected[n]);
+            passed = false;
+        }
+    }
+    
+    // Cost of evaluating a pass with the tripped mask
+    if (passed) {
+        uint32_t tripped = 0;
+        int64_t start = esp_timer_get_time();
+        for (int n = 0; n < IO_INTERLOCK_PASSES; n++) {
+            samples[0].value = (n & 1) ? 95.0f : 50.0f;
+            samples[1].value = 50.0f;
+            alarm_manager_process_samples(alarms, samples, 2, (uint64_t)n, &tripped);
+        }
+        ESP_LOGI(TAG, "Alarm stage with interlocks: %.2f us/pass", 
+                 (double)(esp_timer_get_time() - start) / IO_INTERLOCK_PASSES);
+    }
+    
+    if (alarms->initialized) {
+        alarm_manager_destroy(alarms);
+    }
+    psram_smart_free(alarms);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    // Live interlocks: a held output refuses writes; report the measured latency
+    if (passed && manager && manager->initialized && manager->alarm_manager) {
+        io_interlock_stats_t stats;
+        io_scan_timing_t* timing = psram_smart_malloc(sizeof(io_scan_timing_t), ALLOC_NORMAL);
+        if (timing && io_manager_get_interlock_stats(manager, &stats) == ESP_OK &&
+            io_manager_get_statistics(manager, NULL, NULL, NULL, timing) == ESP_OK) {
+            // A sample is at most one scan interval old when its pass starts
+            uint32_t interval_ms = 0;
+            for (int i = 0; i < manager->active_point_count; i++) {
+                uint32_t class_ms = manager->scan_interval_ms[manager->point_table[i].scan_class];
+                if (manager->point_table[i].alarm_handle >= 0 && class_ms > interval_ms) {
+                    interval_ms = class_ms;
+                }
+            }
+            
+            const io_timing_histogram_t* latency = &timing->histograms[IO_TIMING_INTERLOCK_LATENCY];
+            ESP_LOGI(TAG, "Live interlocks: %d, %lu trips, %lu outputs held", 
+                     manager->interlock_count, stats.trip_count, stats.forced_outputs);
+            if (latency->count > 0) {
+                ESP_LOGI(TAG, "Scan start to relay: mean %llu us, worst %lu us (%lu trips timed)", 
+                         latency->total_us / latency->count, latency->max_us, latency->count);
+                ESP_LOGI(TAG, "Worst case sensor to relay: %lu us (scan interval %lu ms + worst pass)", 
+                         interval_ms * 1000 + stats.worst_latency_us, interval_ms);
+            }
+            
+            for (int k = 0; k < manager->interlock_count; k++) {
+                int output_index = manager->interlocks[k].output_index;
+                if (output_index < 0 || !manager->runtime_states[output_index].interlocked) {
+                    continue;
+                }
+                // Rewriting the held state changes nothing even if it were accepted
+                io_point_handle_t handle;
+                bool state = false;
+                if (io_manager_resolve_handle(manager, manager->point_ids[output_index], &handle) == ESP_OK &&
+                    io_manager_get_binary_output_by_handle(manager, handle, &state) == ESP_OK &&
+                    io_manager_set_binary_output_by_handle(manager, handle, state) != ESP_ERR_INVALID_STATE) {
+                    ESP_LOGE(TAG, "Interlock test: held output %s accepted a write", manager->point_ids[output_index]);
+                    passed = false;
+                }
+                break;
+            }
+        }
+        psram_smart_free(timing);
+    } else if (passed) {
+        ESP_LOGW(TAG, "Interlock test: no alarm manager attached, live latency not measured");
+    }
+    
+    ESP_LOGI(TAG, "Interlock test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Journal test query state: checks records arrive in append order
+ */
+typedef struct {
+    uint32_t point_key;                 ///< Only this point's records were queried (0 = all)
+    uint32_t count;                     ///< Records visited
+    uint32_t last_sequence;             ///< Sequence of the previous record
+    float last_value;                   ///< Value (append index) of the previous record
+    int out_of_order;                   ///< Records not following the previous one
+} io_journal_check_t;
+
+/**
+ * @brief Journal visitor: count records out of append order or of the wrong point
+ */
+static bool journal_check_visit(const alarm_journal_record_t* record, void* context)
+{
+    io_journal_check_t* check = (io_journal_check_t*)context;
+    uint32_t step = check->point_key ? 2 : 1;
+    if ((check->point_key && record->point_key != check->point_key) ||
+        (check->count > 0 && (record->sequence != check->last_sequence + step || 
+                              record->value != check->last_value + (float)step))) {
+        check->out_of_order++;
+    }
+    check->last_sequence = record->sequence;
+    check->last_value = record->value;
+    check->count++;
+    return true;
+}
+
+/**
+ * @brief Query the whole journal and check the records follow each other
+ */
+static bool journal_check_query(alarm_journal_t* journal, uint32_t point_key, uint32_t expected)
+{
+    io_journal_check_t check = {.point_key = point_key};
+    esp_err_t ret = alarm_journal_query(journal, INT64_MIN, INT64_MAX, point_key, journal_check_visit, &check);
+    if (ret != ESP_OK || check.count != expected || check.out_of_order != 0) {
+        ESP_LOGE(TAG, "Journal test: query returned %lu/%lu records, %d out of order (%s)", 
+                 check.count, expected, check.out_of_order, esp_err_to_name(ret));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Remove the test journal's segment files
+ */
+static void journal_remove_test_files(void)
+{
+    char path[40];
+    for (int slot = 0; slot < ALARM_JOURNAL_SEGMENT_COUNT; slot++) {
+        snprintf(path, sizeof(path), "%s_%d.bin", IO_JOURNAL_TEST_PATH, slot);
+        storage_manager_delete_file(path);
+    }
+}
+
+bool io_test_suite_alarm_journal(void)
+{
+    ESP_LOGI(TAG, "=== Alarm Journal Test (%d records) ===", IO_JOURNAL_TEST_RECORDS);
+    
+    alarm_journal_t* journal = psram_smart_malloc(sizeof(alarm_journal_t), ALLOC_NORMAL);
+    if (!journal) {
+        ESP_LOGE(TAG, "Journal test: allocation failed");
+        return false;
+    }
+    
+    // Own segment files, started empty; no flush task, so flushes happen only where forced
+    journal_remove_test_files();
+    bool passed = (alarm_journal_init(journal, IO_JOURNAL_TEST_PATH) == ESP_OK && journal->current_slot < 0);
+    if (!passed) {
+        ESP_LOGE(TAG, "Journal test: init failed");
+    }
+    
+    // Two points alternate; the value is the append index so order can be checked
+    static const uint32_t keys[2] = {0x1234ABCD, 0x5678EF01};
+    int64_t start = esp_timer_get_time();
+    for (int n = 0; passed && n < IO_JOURNAL_TEST_RECORDS; n++) {
+        alarm_journal_append(journal, keys[n & 1], 0, (n & 2) ? ALARM_JOURNAL_CLEARED : ALARM_JOURNAL_ACTIVATED, (float)n);
+        if ((n + 1) % IO_JOURNAL_FLUSH_EVERY == 0 && alarm_journal_flush(journal) != ESP_OK) {
+            ESP_LOGE(TAG, "Journal test: flush failed after %d records", n + 1);
+            passed = false;
+        }
+    }
+    
+    // Flushed segments followed by the records still in the ring
+    alarm_journal_stats_t stats;
+    if (passed) {
+        alarm_journal_get_stats(journal, &stats);
+        ESP_LOGI(TAG, "Appended %lu records in %lld us: %lu flushed in %lu writes, %lu pending", 
+                 stats.appended, esp_timer_get_time() - start, stats.flushed, stats.flush_count, stats.pending);
+        passed = stats.dropped == 0 && stats.pending == IO_JOURNAL_TEST_RECORDS % IO_JOURNAL_FLUSH_EVERY &&
+                 journal_check_query(journal, 0, IO_JOURNAL_TEST_RECORDS);
+    }
+    
+    // Forced flush: everything from flash, across the rollover into the second segment
+    if (passed) {
+        passed = alarm_journal_flush(journal) == ESP_OK && alarm_journal_get_stats(journal, &stats) == ESP_OK && 
+                 stats.pending == 0 && stats.write_errors == 0;
+        if (passed && (journal->current_slot != 1 || 
+                       journal->segments[0].record_count != ALARM_JOURNAL_SEGMENT_RECORDS ||
+                       journal->segments[1].record_count != IO_JOURNAL_TEST_RECORDS - ALARM_JOURNAL_SEGMENT_RECORDS)) {
+            ESP_LOGE(TAG, "Journal test: no rollover (slot %d, %lu + %lu records)", journal->current_slot, 
+                     journal->segments[0].record_count, journal->segments[1].record_count);
+            passed = false;
+        }
+        passed = passed && journal_check_query(journal, 0, IO_JOURNAL_TEST_RECORDS) &&
+                 journal_check_query(journal, keys[1], IO_JOURNAL_TEST_RECORDS / 2);
+    }
+    
+    if (journal->initialized) {
+        alarm_journal_destroy(journal);
+    }
+    psram_smart_free(journal);
+    journal_remove_test_files();
+    
+    ESP_LOGI(TAG, "Alarm journal test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Trend test query state: compares decoded samples against what was fed
+ */
+typedef struct {
+    const int64_t* times;               ///< Expected times
+    const float* values;                ///< Expected values
+    int expected;                       ///< Expected samples
+    int count;                          ///< Samples visited
+    int mismatches;                     ///< Samples differing from the expected ones
+} io_trend_check_t;
+
+/**
+ * @brief Trend visitor: count samples that differ from the expected ones
+ */
+static bool trend_check_visit(int64_t time_ms, float value, void* context)
+{
+    io_trend_check_t* check = (io_trend_check_t*)context;
+    if (check->count >= check->expected || time_ms != check->times[check->count] ||
+        memcmp(&value, &check->values[check->count], sizeof(float)) != 0) {
+        check->mismatches++;
+    }
+    check->count++;
+    return true;
+}
+
+/**
+ * @brief Rollup test query state: compares hourly buckets against statistics recomputed from the samples
+ */
+typedef struct {
+    int64_t start_ms;                   ///< Start of the first fed hour
+    const float* minimum;               ///< Expected minimum per hour
+    const float* maximum;               ///< Expected maximum per hour
+    const double* sum;                  ///< Expected sum per hour
+    const uint32_t* count;              ///< Expected sample count per hour
+    int hours;                          ///< Hours fed
+    int buckets;                        ///< Buckets visited
+    int mismatches;                     ///< Buckets differing from the expected statistics
+} io_rollup_check_t;
+
+/**
+ * @brief Rollup visitor: count hourly buckets that differ from the recomputed statistics
+ */
+static bool rollup_check_visit(const trending_bucket_t* bucket, void* context)
+{
+    io_rollup_check_t* check = (io_rollup_check_t*)context;
+    int64_t hour = (bucket->start_ms - check->start_ms) / TRENDING_TIER_1H_MS;
+    check->buckets++;
+    if (bucket->duration_ms != TRENDING_TIER_1H_MS || hour < 0 || hour >= check->hours ||
+        bucket->count != check->count[hour] || bucket->min != check->minimum[hour] ||
+        bucket->max != check->maximum[hour] ||
+        fabsf(bucket->mean - (float)(check->sum[hour] / check->count[hour])) > IO_ROLLUP_MEAN_TOLERANCE) {
+        check->mismatches++;
+    }
+    return true;
+}
+
+/**
+ * @brief Bucket visitor: count buckets only
+ */
+static bool rollup_count_visit(const trending_bucket_t* bucket, void* context)
+{
+    (*(int*)context)++;
+    return true;
+}
+
+bool io_test_suite_trending(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "=== Trending Test ===");
+    
+    config_manager_t* bench = create_bench_config(NULL, 2);
+    trending_manager_t* trends = psram_smart_malloc(sizeof(trending_manager_t), ALLOC_NORMAL);
+    // Expected analog times and values, then binary change times and states
+    int64_t* times = psram_smart_malloc(2 * IO_TREND_TEST_SAMPLES * sizeof(int64_t), ALLOC_LARGE_BUFFER);
+    float* values = psram_smart_malloc(2 * IO_TREND_TEST_SAMPLES * sizeof(float), ALLOC_LARGE_BUFFER);
+    if (!bench || !trends || !times || !values) {
+        ESP_LOGE(TAG, "Trending test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(trends);
+        psram_smart_free(times);
+        psram_smart_free(values);
+        return false;
+    }
+    
+    // Point 0 is an analog input sampled every second, point 1 a binary input
+    for (int i = 0; i < 2; i++) {
+        io_point_config_t* point = &bench->config.io_points[i];
+        point->trend_config.enabled = true;
+        point->trend_config.sample_interval_s = 1;
+    }
+    bench->config.io_points[1].type = IO_POINT_TYPE_GPIO_BI;
+    
+    bool passed = true;
+    esp_err_t ret = trending_manager_init(trends, bench);
+    if (ret == ESP_ERR_NO_MEM) {
+        // The live trending manager already holds its pool
+        ESP_LOGW(TAG, "Trending test: no PSRAM for a second trend pool, skipped");
+    } else if (ret != ESP_OK || trending_manager_get_series_count(trends) != 2) {
+        ESP_LOGE(TAG, "Trending test: init failed (%s)", esp_err_to_name(ret));
+        passed = false;
+    } else {
+        // Passes land anywhere within their 1 s slot; the sensor resolves 0.1 units
+        int64_t* change_times = times + IO_TREND_TEST_SAMPLES;
+        float* change_states = values + IO_TREND_TEST_SAMPLES;
+        int changes = 0;
+        int64_t start_ms = 1700000000000LL;
+        uint32_t seed = 12345;
+        bool state = false;
+        int64_t record_us = 0;
+        for (int n = 0; passed && n < IO_TREND_TEST_SAMPLES; n++) {
+            seed = seed * 1103515245u + 12345u;
+            int64_t time_ms = start_ms + n * 1000LL + (seed >> 16) % 900;
+            float value = roundf((20.0f + 5.0f * sinf(n * 0.005f) + ((seed >> 8) % 5) * 0.1f) * 10.0f) / 10.0f;
+            if (n % IO_TREND_TOGGLE_EVERY == 0) {
+                state = !state;
+                change_times[changes] = time_ms;
+                change_states[changes] = state ? 1.0f : 0.0f;
+                changes++;
+            }
+            times[n] = start_ms + n * 1000LL;
+            values[n] = value;
+            
+            trending_sample_t batch[2] = {
+                { .handle = 0, .value = value, .state = false },
+                { .handle = 1, .value = 0.0f, .state = state }
+            };
+            int64_t begin = esp_timer_get_time();
+            passed = trending_manager_record_samples(trends, batch, 2, time_ms) == ESP_OK;
+            record_us += esp_timer_get_time() - begin;
+        }
+        
+        // Exact round trip of every sample and state change
+        io_trend_check_t analog = { times, values, IO_TREND_TEST_SAMPLES, 0, 0 };
+        io_trend_check_t binary = { change_times, change_states, changes, 0, 0 };
+        if (passed) {
+            passed = trending_manager_query(trends, bench->config.io_points[0].id, 0, INT64_MAX,
+                                            trend_check_visit, &analog) == ESP_OK &&
+                     trending_manager_query(trends, bench->config.io_points[1].id, 0, INT64_MAX,
+                                            trend_check_visit, &binary) == ESP_OK &&
+                     analog.count == analog.expected && analog.mismatches == 0 &&
+                     binary.count == binary.expected && binary.mismatches == 0;
+            if (!passed) {
+                ESP_LOGE(TAG, "Trending test: analog %d/%d samples (%d wrong), binary %d/%d changes (%d wrong)",
+                         analog.count, analog.expected, analog.mismatches,
+                         binary.count, binary.expected, binary.mismatches);
+            }
+        }
+        
+        trending_series_info_t analog_info;
+        trending_series_info_t binary_info;
+        if (passed && trending_manager_get_series_info(trends, 0, &analog_info) == ESP_OK &&
+            trending_manager_get_series_info(trends, 1, &binary_info) == ESP_OK) {
+            float analog_bytes = (float)analog_info.bytes_used / analog_info.samples;
+            float binary_bytes = (float)binary_info.bytes_used / binary_info.samples;
+            ESP_LOGI(TAG, "Recorded %d passes in %lld us (%.2f us per pass of 2 points)",
+                     IO_TREND_TEST_SAMPLES, record_us, (float)record_us / IO_TREND_TEST_SAMPLES);
+            ESP_LOGI(TAG, "Analog: %lu samples in %lu bytes, %.2f bytes/sample (%.1fx smaller than %d-byte records)",
+                     analog_info.samples, analog_info.bytes_used, analog_bytes,
+                     IO_TREND_RAW_BYTES / analog_bytes, IO_TREND_RAW_BYTES);
+            ESP_LOGI(TAG, "Binary: %lu changes in %lu bytes, %.2f bytes/change",
+                     binary_info.samples, binary_info.bytes_used, binary_bytes);
+            // One day at the default interval per analog point
+            ESP_LOGI(TAG, "%d KB pool holds a day of %d s samples for %lu analog points (%lu uncompressed)",
+                     TRENDING_POOL_BYTES / 1024, CONFIG_DEFAULT_TREND_INTERVAL_S,
+                     (unsigned long)(TRENDING_POOL_BYTES / (analog_bytes * IO_TREND_DAY_SAMPLES)),
+                     (unsigned long)(TRENDING_POOL_BYTES / (IO_TREND_RAW_BYTES * IO_TREND_DAY_SAMPLES)));
+        }
+        
+        // An unchanged reload keeps the history
+        if (passed) {
+            passed = trending_manager_reload_config(trends) == ESP_OK &&
+                     trending_manager_get_series_info(trends, 0, &analog_info) == ESP_OK &&
+                     analog_info.samples == IO_TREND_TEST_SAMPLES;
+            if (!passed) {
+                ESP_LOGE(TAG, "Trending test: unchanged reload lost history");
+            }
+        }
+    }
+    
+    if (trends->initialized) {
+        trending_manager_destroy(trends);
+    }
+    psram_smart_free(trends);
+    psram_smart_free(times);
+    psram_smart_free(values);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    if (manager && manager->trending_manager) {
+        trending_stats_t stats;
+        if (trending_manager_get_stats(manager->trending_manager, &stats) == ESP_OK) {
+            ESP_LOGI(TAG, "Live trends: %u analog, %u binary points, %lu samples in %lu bytes",
+                     stats.analog_points, stats.binary_points, stats.samples_held, stats.bytes_held);
+        }
+    }
+    
+    ESP_LOGI(TAG, "Trending test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_trend_rollups(void)
+{
+    ESP_LOGI(TAG, "=== Trend Rollup Test ===");
+    
+    const int hours = IO_ROLLUP_TEST_DAYS * 24;
+    const int passes = IO_ROLLUP_TEST_DAYS * IO_TREND_DAY_SAMPLES;
+    config_manager_t* bench = create_bench_config(NULL, 1);
+    trending_manager_t* trends = psram_smart_malloc(sizeof(trending_manager_t), ALLOC_NORMAL);
+    float* minimum = psram_smart_malloc(2 * hours * sizeof(float), ALLOC_LARGE_BUFFER);
+    double* sum = psram_smart_malloc(hours * sizeof(double), ALLOC_LARGE_BUFFER);
+    uint32_t* count = psram_smart_malloc(hours * sizeof(uint32_t), ALLOC_LARGE_BUFFER);
+    if (!bench || !trends || !minimum || !sum || !count) {
+        ESP_LOGE(TAG, "Rollup test: allocation failed");
+        if (bench) {
+            config_manager_destroy(bench);
+        }
+        psram_smart_free(bench);
+        psram_smart_free(trends);
+        psram_smart_free(minimum);
+        psram_smart_free(sum);
+        psram_smart_free(count);
+        return false;
+    }
+    float* maximum = minimum + hours;
+    memset(count, 0, hours * sizeof(uint32_t));
+    
+    io_point_config_t* point = &bench->config.io_points[0];
+    point->trend_config.enabled = true;
+    point->trend_config.sample_interval_s = CONFIG_DEFAULT_TREND_INTERVAL_S;
+    
+    bool passed = true;
+    esp_err_t ret = trending_manager_init(trends, bench);
+    if (ret == ESP_ERR_NO_MEM) {
+        ESP_LOGW(TAG, "Rollup test: no PSRAM for a second trend pool, skipped");
+    } else if (ret != ESP_OK || trending_manager_get_series_count(trends) != 1) {
+        ESP_LOGE(TAG, "Rollup test: init failed (%s)", esp_err_to_name(ret));
+        passed = false;
+    } else {
+        // A month of passes at the default interval, starting on an hour
+        int64_t start_ms = 1700002800000LL;
+        uint32_t seed = 54321;
+        int64_t record_us = 0;
+        for (int n = 0; passed && n < passes; n++) {
+            seed = seed * 1103515245u + 12345u;
+            float value = 20.0f + 5.0f * sinf(n * 0.0007f) + ((seed >> 8) % 100) * 0.01f;
+            int hour = n / (IO_TREND_DAY_SAMPLES / 24);
+            if (count[hour] == 0 || value < minimum[hour]) {
+                minimum[hour] = value;
+            }
+            if (count[hour] == 0 || value > maximum[hour]) {
+                maximum[hour] = value;
+            }
+            sum[hour] = (count[hour] == 0) ? value : sum[hour] + value;
+            count[hour]++;
+            
+            trending_sample_t sample = { .handle = 0, .value = value, .state = false };
+            int64_t begin = esp_timer_get_time();
+            passed = trending_manager_record_samples(trends, &sample, 1,
+                                                     start_ms + n * (CONFIG_DEFAULT_TREND_INTERVAL_S * 1000LL)) == ESP_OK;
+            record_us += esp_timer_get_time() - begin;
+            if (n % IO_TREND_DAY_SAMPLES == 0) {
+                vTaskDelay(1);
+            }
+        }
+        
+        // A 30-day chart picks the hourly tier and reads one bucket per hour
+        int64_t end_ms = start_ms + (int64_t)passes * CONFIG_DEFAULT_TREND_INTERVAL_S * 1000LL;
+        int64_t from_ms = end_ms - IO_ROLLUP_CHART_DAYS * 86400000LL;
+        uint32_t resolution_ms = (uint32_t)((end_ms - from_ms) / IO_ROLLUP_CHART_POINTS);
+        io_rollup_check_t check = { start_ms, minimum, maximum, sum, count, hours, 0, 0 };
+        trending_tier_t tier = TRENDING_TIER_RAW;
+        int64_t query_us = 0;
+        if (passed) {
+            int64_t begin = esp_timer_get_time();
+            passed = trending_manager_query_resolution(trends, point->id, from_ms, end_ms, resolution_ms,
+                                                       rollup_check_visit, &check, &tier) == ESP_OK;
+            query_us = esp_timer_get_time() - begin;
+            passed = passed && tier == TRENDING_TIER_1H && check.mismatches == 0 &&
+                     check.buckets == IO_ROLLUP_CHART_DAYS * 24;
+            if (!passed) {
+                ESP_LOGE(TAG, "Rollup test: tier %d, %d hourly buckets (%d wrong), expected %d",
+                         tier, check.buckets, check.mismatches, IO_ROLLUP_CHART_DAYS * 24);
+            }
+        }
+        
+        // The same month from the raw samples still held
+        if (passed) {
+            int raw_samples = 0;
+            int day_buckets = 0;
+            int64_t begin = esp_timer_get_time();
+            trending_manager_query_resolution(trends, point->id, from_ms, end_ms, 0,
+                                              rollup_count_visit, &raw_samples, NULL);
+            int64_t raw_us = esp_timer_get_time() - begin;
+            trending_manager_query_resolution(trends, point->id, end_ms - 86400000LL, end_ms, TRENDING_TIER_1MIN_MS,
+                                              rollup_count_visit, &day_buckets, &tier);
+            passed = tier == TRENDING_TIER_1MIN && day_buckets == 24 * 60;
+            
+            ESP_LOGI(TAG, "Recorded %d passes in %lld us (%.2f us per sample, rollups included)",
+                     passes, record_us, (float)record_us / passes);
+            ESP_LOGI(TAG, "%d-day chart at %lu ms resolution: %d hourly buckets in %lld us",
+                     IO_ROLLUP_CHART_DAYS, resolution_ms, check.buckets, query_us);
+            ESP_LOGI(TAG, "Raw samples for the same range: %d held (of %d fed) in %lld us",
+                     raw_samples, IO_ROLLUP_CHART_DAYS * IO_TREND_DAY_SAMPLES, raw_us);
+            if (!passed) {
+                ESP_LOGE(TAG, "Rollup test: one day at 1 min gave tier %d, %d buckets", tier, day_buckets);
+            }
+        }
+    }
+    
+    if (trends->initialized) {
+        trending_manager_destroy(trends);
+    }
+    psram_smart_free(trends);
+    psram_smart_free(minimum);
+    psram_smart_free(sum);
+    psram_smart_free(count);
+    config_manager_destroy(bench);
+    psram_smart_free(bench);
+    
+    ESP_LOGI(TAG, "Trend rollup test: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+/**
+ * @brief Alarm state of one point before the structure-of-arrays layout
+ * 
+ * Kept for every one of CONFIG_MAX_IO_POINTS, monitored or not.
+ */
+typedef struct {
+    bool active[4];
+    uint32_t activation_count[4];
+    uint64_t activation_time[4];
+    uint32_t persistence_count[4];
+    uint32_t clear_count[4];
+    uint32_t good_samples_count;
+    bool trust_restored;
+    float last_values[IO_ALARM_RULE_HISTORY];
+    int history_index;
+    int history_count;
+} io_legacy_alarm_state_t;
+
+bool io_test_suite_benchmark_alarm_rules(void)
+{
+    static const int point_counts[] = {32, 128};
+    
+    ESP_LOGI(TAG, "=== Alarm Rule Benchmark ===");
+    
+    size_t legacy_bytes = CONFIG_MAX_IO_POINTS * (sizeof(io_legacy_alarm_state_t) + CONFIG_MAX_ID_LENGTH);
+    bool passed = true;
+    
+    for (size_t c = 0; passed && c < sizeof(point_counts) / sizeof(point_counts[0]); c++) {
+        int count = point_counts[c];
+        config_manager_t* bench = create_bench_config(NULL, count);
+        alarm_manager_t* batched = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+        alarm_manager_t* single = psram_smart_malloc(sizeof(alarm_manager_t), ALLOC_NORMAL);
+        alarm_sample_t* samples = psram_smart_malloc(count * sizeof(alarm_sample_t), ALLOC_CRITICAL);
+        if (!bench || !batched || !single || !samples) {
+            ESP_LOGE(TAG, "Alarm rule benchmark: allocation failed");
+            if (bench) {
+                config_manager_destroy(bench);
+            }
+            psram_smart_free(bench);
+            psram_smart_free(batched);
+            psram_smart_free(single);
+            psram_smart_free(samples);
+            return false;
+        }
+        memset(batched, 0, sizeof(alarm_manager_t));
+        memset(single, 0, sizeof(alarm_manager_t));
+        
+        // Every rule on every point, thresholds the random signal crosses now and then
+        for (int i = 0; i < count; i++) {
+            alarm_config_t* config = &bench->config.io_points[i].alarm_config;
+            memset(config, 0, sizeof(alarm_config_t));
+            config->enabled = true;
+            config->history_samples_for_analysis = IO_ALARM_RULE_HISTORY;
+            config->rules.check_rate_of_change = true;
+            config->rules.rate_of_change_threshold = 4.0f;
+            config->rules.check_disconnected = true;
+            config->rules.disconnected_threshold = 2.0f;
+            config->rules.check_max_value = true;
+            config->rules.max_value_threshold = 98.0f;
+            config->rules.check_stuck_signal = true;
+            config->rules.stuck_signal_window_samples = IO_ALARM_RULE_HISTORY / 2;
+            config->rules.stuck_signal_delta_threshold = 0.5f;
+            config->rules.check_noise_band = true;
+            config->rules.noise_band_threshold = 29.0f;
+            config->rules.alarm_persistence_samples = 2;
+            config->rules.samples_to_clear_alarm_condition = 2;
+        }
+        
+        passed = alarm_manager_init(batched, bench) == ESP_OK && alarm_manager_init(single, bench) == ESP_OK &&
+                 batched->active_point_count == count;
+        
+        // Same samples through one batch per pass and through one call per point
+        uint32_t seed = 99;
+        int64_t batched_us = 0;
+        int64_t single_us = 0;
+        for (int n = 0; passed && n < IO_ALARM_RULE_PASSES; n++) {
+            for (int i = 0; i < count; i++) {
+                samples[i].handle = i;
+                samples[i].value = (n % 50 >= 40 && i % 2 == 0) ? 42.0f : cond_test_sample(&seed);
+                samples[i].source_index = (uint16_t)i;
+                samples[i].active = false;
+            }
+            
+            int64_t start = esp_timer_get_time();
+            for (int i = 0; i < count; i++) {
+                alarm_manager_process_sample(single, i, samples[i].value, (uint64_t)n, NULL);
+            }
+            int64_t middle = esp_timer_get_time();
+            esp_err_t ret = alarm_manager_process_samples(batched, samples, count, (uint64_t)n, NULL);
+            batched_us += esp_timer_get_time() - middle;
+            single_us += middle - start;
+            
+            if (ret != ESP_OK || 
+                memcmp(batched->points.active_mask, single->points.active_mask, count * sizeof(uint32_t)) != 0) {
+                ESP_LOGE(TAG, "Alarm rule benchmark: batch and per-point results differ at pass %d", n);
+                passed = false;
+            }
+        }
+        
+        if (passed) {
+            size_t table_bytes = batched->points.hot_bytes + batched->points.cold_bytes + 
+                                 batched->points.window_bytes + count * CONFIG_MAX_ID_LENGTH;
+            uint32_t total_alarms = 0;
+            alarm_manager_get_statistics(batched, &total_alarms, NULL, NULL);
+            ESP_LOGI(TAG, "%3d points: batch %.0f ns/point, per-point %.0f ns/point (%lu activations)", count,
+                     (double)batched_us * 1000.0 / ((double)IO_ALARM_RULE_PASSES * count),
+                     (double)single_us * 1000.0 / ((double)IO_ALARM_RULE_PASSES * count), total_alarms);
+            ESP_LOGI(TAG, "%3d points: %u bytes (%u internal RAM) vs %u bytes fixed array-of-structs, %u saved",
+                     count, (unsigned)table_bytes, (unsigned)batched->points.hot_bytes, (unsigned)legacy_bytes,
+                     table_bytes < legacy_bytes ? (unsigned)(legacy_bytes - table_bytes) : 0U);
+            if (total_alarms == 0) {
+                ESP_LOGE(TAG, "Alarm rule benchmark: no alarm activated");
+                passed = false;
+            }
+        }
+        
+        if (batched->initialized) {
+            alarm_manager_destroy(batched);
+        }
+        if (single->initialized) {
+            alarm_manager_destroy(single);
+        }
+        psram_smart_free(batched);
+        psram_smart_free(single);
+        psram_smart_free(samples);
+        config_manager_destroy(bench);
+        psram_smart_free(bench);
+    }
+    
+    ESP_LOGI(TAG, "Alarm rule benchmark: %s", passed ? "PASS" : "FAIL");
+    return passed;
+}
+
+bool io_test_suite_run(io_manager_t* manager)
+{
+    ESP_LOGI(TAG, "Starting IO test suite...");
+    
+    int passed = 0;
+    int total = 0;
+    
+    total++;
+    if (io_test_suite_benchmark_point_table(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_scaling(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_id_lookup(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_conditioning()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_lookup_table()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_filters(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_config_load(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_adc_oversampling()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_edge_inputs()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_shift_register(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_snapshot(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_change_reporting(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_reload(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_output_batch(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+#if DEBUG_IO_TEST_DRIVE_OUTPUTS
+    total++;
+    if (io_test_suite_pulse_outputs(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+#else
+    ESP_LOGI(TAG, "Pulse output test skipped (DEBUG_IO_TEST_DRIVE_OUTPUTS disabled)");
+#endif
+    
+    total++;
+    if (io_test_suite_alarm_stage()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_alarm_window()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_benchmark_alarm_rules()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_alarm_suppression()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_interlocks(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_alarm_journal()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_trending(manager)) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    total++;
+    if (io_test_suite_trend_rollups()) passed++;
+    vTaskDelay(pdMS_TO_TICKS(10));
+    
+    ESP_LOGI(TAG, "IO test suite complete: %d/%d passed", passed, total);
+    return passed == total;
+}
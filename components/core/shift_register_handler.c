@@ -7,19 +7,277 @@
 #include "debug_config.h"
 #include "esp_log.h"
 #include "driver/gpio.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_gpio.h"
+#include "esp_timer.h"
+#include "soc/spi_periph.h"
 #include "freertos/task.h"
 #include <string.h>
 
 static const char* TAG = DEBUG_SHIFT_REGISTER_TAG;
 
+/**
+ * @brief Number of bytes clocked per cycle (longer of the two chains)
+ */
+static int chain_length(const shift_register_config_t* config) {
+    return config->num_output_registers > config->num_input_registers ?
+           config->num_output_registers : config->num_input_registers;
+}
+
+/**
+ * @brief Drive a GPIO-controlled pin, skipping unconnected (-1) pins
+ */
+static inline void set_pin_level(int pin, uint32_t level) {
+    if (pin >= 0) {
+        gpio_set_level(pin, level);
+    }
+}
+
+/**
+ * @brief Check that every clock and data pin the GPIO backend would drive is connected
+ */
+static bool gpio_backend_pins_valid(const shift_register_config_t* config) {
+    if (config->num_output_registers > 0 &&
+        (config->output_clock_pin < 0 || config->output_latch_pin < 0 || config->output_data_pin < 0)) {
+        return false;
+    }
+    if (config->num_input_registers > 0 &&
+        (config->input_clock_pin < 0 || config->input_load_pin < 0 || config->input_data_pin < 0)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Release the SPI device, bus and DMA buffers
+ */
+static void spi_backend_deinit(shift_register_handler_t* handler) {
+    if (handler->spi_device) {
+        spi_bus_remove_device(handler->spi_device);
+        handler->spi_device = NULL;
+        spi_bus_free(handler->spi_host);
+    }
+    
+    heap_caps_free(handler->spi_tx_buffer);
+    heap_caps_free(handler->spi_rx_buffer);
+    handler->spi_tx_buffer = NULL;
+    handler->spi_rx_buffer = NULL;
+}
+
+/**
+ * @brief Set up the SPI master for combined input/output transfers
+ * 
+ * MOSI feeds the 74HC595 chain and MISO reads the 74HC165 chain. With both
+ * chains present SCLK runs in mode 0 on the output clock pin and is routed
+ * inverted to the input clock pin; with inputs only it runs in mode 2 on the
+ * input clock pin. Pins set to -1 are left unconnected.
+ */
+static esp_err_t spi_backend_init(shift_register_handler_t* handler) {
+    const shift_register_config_t* config = &handler->config;
+    bool has_outputs = config->num_output_registers > 0;
+    bool has_inputs = config->num_input_registers > 0;
+    
+    if (has_outputs && has_inputs && config->input_clock_pin >= 0 &&
+        config->input_clock_pin == config->output_clock_pin) {
+        ESP_LOGE(TAG, "SPI backend needs separate input and output clock pins");
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    handler->spi_host = (config->spi_host == 3) ? SPI3_HOST : SPI2_HOST;
+    
+    spi_bus_config_t bus_config = {
+        .mosi_io_num = has_outputs ? config->output_data_pin : -1,
+        .miso_io_num = has_inputs ? config->input_data_pin : -1,
+        .sclk_io_num = has_outputs ? config->output_clock_pin : config->input_clock_pin,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = SHIFT_REGISTER_MAX_CHIPS,
+        .flags = SPICOMMON_BUSFLAG_MASTER | SPICOMMON_BUSFLAG_GPIO_PINS
+    };
+    
+    esp_err_t ret = spi_bus_initialize(handler->spi_host, &bus_config, SPI_DMA_CH_AUTO);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize SPI bus: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    spi_device_interface_config_t device_config = {
+        .mode = has_outputs ? 0 : 2,
+        .clock_speed_hz = config->spi_clock_hz > 0 ? config->spi_clock_hz : CONFIG_DEFAULT_SHIFT_REGISTER_SPI_CLOCK_HZ,
+        .spics_io_num = -1,
+        .queue_size = 1
+    };
+    
+    ret = spi_bus_add_device(handler->spi_host, &device_config, &handler->spi_device);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to add SPI device: %s", esp_err_to_name(ret));
+        handler->spi_device = NULL;
+        spi_bus_free(handler->spi_host);
+        return ret;
+    }
+    
+    handler->spi_tx_buffer = heap_caps_calloc(1, SHIFT_REGISTER_MAX_CHIPS, MALLOC_CAP_DMA);
+    handler->spi_rx_buffer = heap_caps_calloc(1, SHIFT_REGISTER_MAX_CHIPS, MALLOC_CAP_DMA);
+    if (!handler->spi_tx_buffer || !handler->spi_rx_buffer) {
+        ESP_LOGE(TAG, "Failed to allocate SPI DMA buffers");
+        spi_backend_deinit(handler);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // 74HC165 shifts on its rising edge; the inverted clock makes that the
+    // SCLK falling edge, half a period before the master samples
+    if (has_outputs && has_inputs && config->input_clock_pin >= 0) {
+        esp_rom_gpio_pad_select_gpio(config->input_clock_pin);
+        gpio_set_direction(config->input_clock_pin, GPIO_MODE_OUTPUT);
+        esp_rom_gpio_connect_out_signal(config->input_clock_pin, spi_periph_signal[handler->spi_host].spiclk_out,
+                                        true, false);
+    }
+    
+    if (has_inputs && config->input_data_pin >= 0) {
+        gpio_set_pull_mode(config->input_data_pin, GPIO_PULLUP_ONLY);
+    }
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Clock one combined cycle of @p chips bytes through the SPI backend
+ * 
+ * Caller must hold the handler mutex.
+ */
+static esp_err_t spi_exchange(shift_register_handler_t* handler, int chips) {
+    const shift_register_config_t* config = &handler->config;
+    uint8_t* tx = handler->spi_tx_buffer;
+    
+    // Highest chip first; padding ahead of the image falls off the end of the chain
+    for (int i = 0; i < chips; i++) {
+        int chip = chips - 1 - i;
+        tx[i] = (chip < config->num_output_registers) ? handler->output_states[chip] : 0;
+    }
+    
+    if (config->num_output_registers > 0) {
+        set_pin_level(config->output_latch_pin, 0);
+    }
+    
+    // Parallel load; 74HC165 needs well under 1μs
+    if (config->num_input_registers > 0) {
+        set_pin_level(config->input_load_pin, 0);
+        esp_rom_delay_us(1);
+        set_pin_level(config->input_load_pin, 1);
+        esp_rom_delay_us(1);
+    }
+    
+    spi_transaction_t transaction = {
+        .length = (size_t)chips * 8,
+        .tx_buffer = tx,
+        .rx_buffer = handler->spi_rx_buffer
+    };
+    
+    // Polling avoids the interrupt round trip, which dominates short transfers
+    esp_err_t ret = spi_device_polling_transmit(handler->spi_device, &transaction);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    if (config->num_output_registers > 0) {
+        set_pin_level(config->output_latch_pin, 1);
+    }
+    
+    // Chip nearest the data pin arrives first
+    for (int i = 0; i < chips && i < config->num_input_registers; i++) {
+        handler->input_states[config->num_input_registers - 1 - i] = handler->spi_rx_buffer[i];
+    }
+    
+    return ESP_OK;
+}
+
+/**
+ * @brief Bit-bang @p chips bytes into the output chain and latch
+ * 
+ * Caller must hold the handler mutex.
+ */
+static void bitbang_write(shift_register_handler_t* handler, int chips) {
+    // Latch low to prepare for data
+    gpio_set_level(handler->config.output_latch_pin, 0);
+    
+    // Serial write to all registers (MSB first, highest chip first)
+    for (int chip = chips - 1; chip >= 0; chip--) {
+        uint8_t byte_value = (chip < handler->config.num_output_registers) ? handler->output_states[chip] : 0;
+        
+        for (int bit = 7; bit >= 0; bit--) {
+            // Set data bit
+            int bit_value = (byte_value >> bit) & 0x01;
+            gpio_set_level(handler->config.output_data_pin, bit_value);
+            esp_rom_delay_us(1); // 1μs setup time
+            
+            // Clock pulse
+            gpio_set_level(handler->config.output_clock_pin, 1);
+            esp_rom_delay_us(1); // 1μs high time
+            gpio_set_level(handler->config.output_clock_pin, 0);
+            esp_rom_delay_us(1); // 1μs low time
+        }
+    }
+    
+    // Latch high to update outputs
+    gpio_set_level(handler->config.output_latch_pin, 1);
+    esp_rom_delay_us(5); // 5μs delay for latch
+}
+
+/**
+ * @brief Parallel load and bit-bang @p chips bytes out of the input chain
+ * 
+ * Caller must hold the handler mutex.
+ */
+static void bitbang_read(shift_register_handler_t* handler, int chips) {
+    int last_chip = handler->config.num_input_registers - 1;
+    
+    // Parallel load - capture all inputs
+    gpio_set_level(handler->config.input_load_pin, 0);
+    esp_rom_delay_us(5); // 5μs delay for load
+    gpio_set_level(handler->config.input_load_pin, 1);
+    esp_rom_delay_us(5); // 5μs delay for stabilization
+    
+    // Serial read from all registers
+    for (int chip = last_chip; chip > last_chip - chips; chip--) {
+        uint8_t byte_value = 0;
+        
+        for (int bit = 7; bit >= 0; bit--) {
+            // Clock low
+            gpio_set_level(handler->config.input_clock_pin, 0);
+            esp_rom_delay_us(1); // 1μs delay
+            
+            // Read data bit
+            int bit_value = gpio_get_level(handler->config.input_data_pin);
+            if (bit_value) {
+                byte_value |= (1 << bit);
+            }
+            
+            // Clock high
+            gpio_set_level(handler->config.input_clock_pin, 1);
+            esp_rom_delay_us(1); // 1μs delay
+        }
+        
+        if (chip >= 0) {
+            handler->input_states[chip] = byte_value;
+        }
+    }
+}
+
 esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const shift_register_config_t* config) {
     if (!handler || !config) {
         return ESP_ERR_INVALID_ARG;
     }
     
+    if (config->num_output_registers < 0 || config->num_output_registers > SHIFT_REGISTER_MAX_CHIPS ||
+        config->num_input_registers < 0 || config->num_input_registers > SHIFT_REGISTER_MAX_CHIPS) {
+        ESP_LOGE(TAG, "Register count out of range (max %d)", SHIFT_REGISTER_MAX_CHIPS);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
     // Initialize structure
     memset(handler, 0, sizeof(shift_register_handler_t));
     handler->config = *config;
+    handler->backend = SHIFT_REGISTER_BACKEND_GPIO;
     
     // Create mutex
     handler->mutex = xSemaphoreCreateMutex();
@@ -28,21 +286,45 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
         return ESP_ERR_NO_MEM;
     }
     
+    // SPI backend takes over the clock and data pins; fall back to bit-banging if unavailable
+    if (config->backend == SHIFT_REGISTER_BACKEND_SPI &&
+        (config->num_output_registers > 0 || config->num_input_registers > 0)) {
+        esp_err_t ret = spi_backend_init(handler);
+        if (ret == ESP_OK) {
+            handler->backend = SHIFT_REGISTER_BACKEND_SPI;
+        } else if (gpio_backend_pins_valid(config)) {
+            ESP_LOGW(TAG, "SPI backend unavailable (%s), using GPIO bit-bang", esp_err_to_name(ret));
+        } else {
+            ESP_LOGE(TAG, "SPI backend unavailable (%s) and pins unusable for bit-bang", esp_err_to_name(ret));
+            vSemaphoreDelete(handler->mutex);
+            return ret;
+        }
+    }
+    bool use_spi = (handler->backend == SHIFT_REGISTER_BACKEND_SPI);
+    
     // Configure GPIO pins for output shift registers
     if (config->num_output_registers > 0) {
+        uint64_t output_mask = 0;
+        if (config->output_latch_pin >= 0) {
+            output_mask |= (1ULL << config->output_latch_pin);
+        }
+        if (!use_spi) {
+            output_mask |= (1ULL << config->output_clock_pin) | 
+                           (1ULL << config->output_data_pin);
+        }
+        
         gpio_config_t io_conf = {
-            .pin_bit_mask = (1ULL << config->output_clock_pin) | 
-                           (1ULL << config->output_latch_pin) | 
-                           (1ULL << config->output_data_pin),
+            .pin_bit_mask = output_mask,
             .mode = GPIO_MODE_OUTPUT,
             .pull_up_en = GPIO_PULLUP_DISABLE,
             .pull_down_en = GPIO_PULLDOWN_DISABLE,
             .intr_type = GPIO_INTR_DISABLE
         };
         
-        esp_err_t ret = gpio_config(&io_conf);
+        esp_err_t ret = output_mask ? gpio_config(&io_conf) : ESP_OK;
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to configure output GPIO pins: %s", esp_err_to_name(ret));
+            spi_backend_deinit(handler);
             vSemaphoreDelete(handler->mutex);
             return ret;
         }
@@ -60,6 +342,7 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
             ret = gpio_config(&enable_conf);
             if (ret != ESP_OK) {
                 ESP_LOGE(TAG, "Failed to configure output enable pin: %s", esp_err_to_name(ret));
+                spi_backend_deinit(handler);
                 vSemaphoreDelete(handler->mutex);
                 return ret;
             }
@@ -69,9 +352,11 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
         }
         
         // Initialize output pins
-        gpio_set_level(config->output_clock_pin, 0);
-        gpio_set_level(config->output_latch_pin, 0);
-        gpio_set_level(config->output_data_pin, 0);
+        set_pin_level(config->output_latch_pin, 0);
+        if (!use_spi) {
+            gpio_set_level(config->output_clock_pin, 0);
+            gpio_set_level(config->output_data_pin, 0);
+        }
         
         // CRITICAL SAFETY: Initialize all outputs to safe state (OFF) following reference example
         // This ensures hardware matches software state before enabling outputs
@@ -85,6 +370,7 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
         if (write_ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to write safe state to shift registers: %s", esp_err_to_name(write_ret));
             handler->initialized = false;  // Reset on failure
+            spi_backend_deinit(handler);
             vSemaphoreDelete(handler->mutex);
             return write_ret;
         }
@@ -101,42 +387,55 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
     
     // Configure GPIO pins for input shift registers
     if (config->num_input_registers > 0) {
-        // Clock and load pins as outputs
+        // Clock and load pins as outputs (clock belongs to the SPI bus with the SPI backend)
+        uint64_t clock_load_mask = 0;
+        if (config->input_load_pin >= 0) {
+            clock_load_mask |= (1ULL << config->input_load_pin);
+        }
+        if (!use_spi) {
+            clock_load_mask |= (1ULL << config->input_clock_pin);
+        }
+        
         gpio_config_t clock_load_conf = {
-            .pin_bit_mask = (1ULL << config->input_clock_pin) | 
-                           (1ULL << config->input_load_pin),
+            .pin_bit_mask = clock_load_mask,
             .mode = GPIO_MODE_OUTPUT,
             .pull_up_en = GPIO_PULLUP_DISABLE,
             .pull_down_en = GPIO_PULLDOWN_DISABLE,
             .intr_type = GPIO_INTR_DISABLE
         };
         
-        esp_err_t ret = gpio_config(&clock_load_conf);
+        esp_err_t ret = clock_load_mask ? gpio_config(&clock_load_conf) : ESP_OK;
         if (ret != ESP_OK) {
             ESP_LOGE(TAG, "Failed to configure input clock/load pins: %s", esp_err_to_name(ret));
+            handler->initialized = false;
+            spi_backend_deinit(handler);
             vSemaphoreDelete(handler->mutex);
             return ret;
         }
         
-        // Data pin as input
-        gpio_config_t data_conf = {
-            .pin_bit_mask = (1ULL << config->input_data_pin),
-            .mode = GPIO_MODE_INPUT,
-            .pull_up_en = GPIO_PULLUP_ENABLE,
-            .pull_down_en = GPIO_PULLDOWN_DISABLE,
-            .intr_type = GPIO_INTR_DISABLE
-        };
-        
-        ret = gpio_config(&data_conf);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "Failed to configure input data pin: %s", esp_err_to_name(ret));
-            vSemaphoreDelete(handler->mutex);
-            return ret;
+        // Data pin as input (already a pulled-up SPI input with the SPI backend)
+        if (!use_spi) {
+            gpio_config_t data_conf = {
+                .pin_bit_mask = (1ULL << config->input_data_pin),
+                .mode = GPIO_MODE_INPUT,
+                .pull_up_en = GPIO_PULLUP_ENABLE,
+                .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                .intr_type = GPIO_INTR_DISABLE
+            };
+            
+            ret = gpio_config(&data_conf);
+            if (ret != ESP_OK) {
+                ESP_LOGE(TAG, "Failed to configure input data pin: %s", esp_err_to_name(ret));
+                handler->initialized = false;
+                vSemaphoreDelete(handler->mutex);
+                return ret;
+            }
+            
+            gpio_set_level(config->input_clock_pin, 1);  // Clock idle high
         }
         
         // Initialize input pins
-        gpio_set_level(config->input_clock_pin, 1);  // Clock idle high
-        gpio_set_level(config->input_load_pin, 1);   // Load idle high
+        set_pin_level(config->input_load_pin, 1);   // Load idle high
         
         // Set initialized flag if not already set (for input-only configurations)
         if (!handler->initialized) {
@@ -150,8 +449,8 @@ esp_err_t shift_register_handler_init(shift_register_handler_t* handler, const s
     }
     
 #ifdef DEBUG_SHIFT_REGISTER
-    ESP_LOGI(TAG, "Shift register handler initialized (out: %d, in: %d)", 
-             config->num_output_registers, config->num_input_registers);
+    ESP_LOGI(TAG, "Shift register handler initialized (out: %d, in: %d, backend: %s)", 
+             config->num_output_registers, config->num_input_registers, use_spi ? "SPI" : "GPIO");
 #endif
     
     return ESP_OK;
@@ -171,39 +470,43 @@ esp_err_t shift_register_read_inputs(shift_register_handler_t* handler) {
         return ESP_ERR_TIMEOUT;
     }
     
-    // Parallel load - capture all inputs
-    gpio_set_level(handler->config.input_load_pin, 0);
-    esp_rom_delay_us(5); // 5μs delay for load
-    gpio_set_level(handler->config.input_load_pin, 1);
-    esp_rom_delay_us(5); // 5μs delay for stabilization
-    
-    // Serial read from all registers
-    for (int chip = handler->config.num_input_registers - 1; chip >= 0; chip--) {
-        uint8_t byte_value = 0;
-        
-        for (int bit = 7; bit >= 0; bit--) {
-            // Clock low
-            gpio_set_level(handler->config.input_clock_pin, 0);
-            esp_rom_delay_us(1); // 1μs delay
-            
-            // Read data bit
-            int bit_value = gpio_get_level(handler->config.input_data_pin);
-            if (bit_value) {
-                byte_value |= (1 << bit);
-            }
-            
-            // Clock high
-            gpio_set_level(handler->config.input_clock_pin, 1);
-            esp_rom_delay_us(1); // 1μs delay
-        }
-        
-        handler->input_states[chip] = byte_value;
+    esp_err_t ret = ESP_OK;
+    if (handler->backend == SHIFT_REGISTER_BACKEND_SPI) {
+        ret = spi_exchange(handler, chain_length(&handler->config));
+    } else {
+        bitbang_read(handler, handler->config.num_input_registers);
     }
     
-    handler->read_count++;
+    if (ret == ESP_OK) {
+        handler->read_count++;
+    } else {
+        handler->error_count++;
+    }
     xSemaphoreGive(handler->mutex);
     
-    return ESP_OK;
+    return ret;
+}
+
+/**
+ * @brief Write the output state buffer to the chain
+ * 
+ * Caller must hold the handler mutex.
+ */
+static esp_err_t write_outputs_locked(shift_register_handler_t* handler) {
+    esp_err_t ret = ESP_OK;
+    if (handler->backend == SHIFT_REGISTER_BACKEND_SPI) {
+        ret = spi_exchange(handler, chain_length(&handler->config));
+    } else {
+        bitbang_write(handler, handler->config.num_output_registers);
+    }
+    
+    if (ret == ESP_OK) {
+        handler->write_count++;
+    } else {
+        handler->error_count++;
+    }
+    
+    return ret;
 }
 
 esp_err_t shift_register_write_outputs(shift_register_handler_t* handler) {
@@ -220,35 +523,35 @@ esp_err_t shift_register_write_outputs(shift_register_handler_t* handler) {
         return ESP_ERR_TIMEOUT;
     }
     
-    // Latch low to prepare for data
-    gpio_set_level(handler->config.output_latch_pin, 0);
+    esp_err_t ret = write_outputs_locked(handler);
+    xSemaphoreGive(handler->mutex);
     
-    // Serial write to all registers (MSB first, highest chip first)
-    for (int chip = handler->config.num_output_registers - 1; chip >= 0; chip--) {
-        uint8_t byte_value = handler->output_states[chip];
-        
-        for (int bit = 7; bit >= 0; bit--) {
-            // Set data bit
-            int bit_value = (byte_value >> bit) & 0x01;
-            gpio_set_level(handler->config.output_data_pin, bit_value);
-            esp_rom_delay_us(1); // 1μs setup time
-            
-            // Clock pulse
-            gpio_set_level(handler->config.output_clock_pin, 1);
-            esp_rom_delay_us(1); // 1μs high time
-            gpio_set_level(handler->config.output_clock_pin, 0);
-            esp_rom_delay_us(1); // 1μs low time
-        }
+    return ret;
+}
+
+esp_err_t shift_register_update_outputs(shift_register_handler_t* handler, const uint8_t* masks, 
+                                        const uint8_t* values, int chip_count) {
+    if (!handler || !handler->initialized) {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // Latch high to update outputs
-    gpio_set_level(handler->config.output_latch_pin, 1);
-    esp_rom_delay_us(5); // 5μs delay for latch
+    if (!masks || !values || chip_count < 0 || chip_count > handler->config.num_output_registers) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    handler->write_count++;
+    if (xSemaphoreTake(handler->mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        handler->error_count++;
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    for (int chip = 0; chip < chip_count; chip++) {
+        handler->output_states[chip] = (handler->output_states[chip] & ~masks[chip]) | (values[chip] & masks[chip]);
+    }
+    
+    esp_err_t ret = write_outputs_locked(handler);
     xSemaphoreGive(handler->mutex);
     
-    return ESP_OK;
+    return ret;
 }
 
 esp_err_t shift_register_set_output_bit(shift_register_handler_t* handler, int chip_index, int bit_index, bool state) {
@@ -396,8 +699,49 @@ esp_err_t shift_register_get_statistics(shift_register_handler_t* handler, uint3
     return ESP_OK;
 }
 
+esp_err_t shift_register_benchmark_cycle(shift_register_handler_t* handler, int chips, int cycles, uint32_t* cycle_ns) {
+    if (!handler || !handler->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // Shorter runs would leave the real chain partially shifted when latched
+    if (chips < chain_length(&handler->config) || chips < 1 || chips > SHIFT_REGISTER_MAX_CHIPS ||
+        cycles <= 0 || !cycle_ns) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (xSemaphoreTake(handler->mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        handler->error_count++;
+        return ESP_ERR_TIMEOUT;
+    }
+    
+    esp_err_t ret = ESP_OK;
+    int64_t start = esp_timer_get_time();
+    
+    for (int i = 0; i < cycles && ret == ESP_OK; i++) {
+        if (handler->backend == SHIFT_REGISTER_BACKEND_SPI) {
+            ret = spi_exchange(handler, chips);
+        } else {
+            if (handler->config.num_output_registers > 0) {
+                bitbang_write(handler, chips);
+            }
+            if (handler->config.num_input_registers > 0) {
+                bitbang_read(handler, chips);
+            }
+        }
+    }
+    
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    xSemaphoreGive(handler->mutex);
+    
+    *cycle_ns = (uint32_t)((elapsed_us * 1000) / cycles);
+    return ret;
+}
+
 void shift_register_handler_destroy(shift_register_handler_t* handler) {
     if (handler && handler->initialized) {
+        spi_backend_deinit(handler);
+        
         if (handler->mutex) {
             vSemaphoreDelete(handler->mutex);
             handler->mutex = NULL;
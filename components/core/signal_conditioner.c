@@ -4,160 +4,439 @@
  */
 
 #include "signal_conditioner.h"
+#include "psram_manager.h"
 #include "debug_config.h"
 #include <math.h>
+#include <stdio.h>
 #include <string.h>
 
 #ifdef DEBUG_SIGNAL_CONDITIONER
 static const char* TAG = DEBUG_SIGNAL_CONDITIONER_TAG;
 #endif
 
-float signal_conditioner_apply(float raw_value, 
-                              const signal_config_t* config,
-                              float* sma_buffer,
-                              int* sma_index,
-                              int* sma_count,
-                              float* sma_sum)
+/**
+ * @brief Pool allocation alignment in bytes
+ */
+#define SIGNAL_POOL_ALIGN 4
+
+/**
+ * @brief Ring buffer state shared by the SMA, median and Hampel filters
+ */
+typedef struct {
+    uint16_t index;                     ///< Next window slot
+    uint16_t count;                     ///< Samples in the window
+    float sum;                          ///< Running window sum (SMA only)
+    float window[];                     ///< window_size samples
+} ring_filter_state_t;
+
+/**
+ * @brief EMA filter state
+ */
+typedef struct {
+    float value;                        ///< Current average
+    bool primed;                        ///< First sample seen
+} ema_filter_state_t;
+
+/**
+ * @brief Biquad filter state (transposed direct form II)
+ */
+typedef struct {
+    float z1;                           ///< First delay element
+    float z2;                           ///< Second delay element
+    bool primed;                        ///< Delay line settled on the first sample
+} biquad_filter_state_t;
+
+/**
+ * @brief Push a sample into a ring window
+ * 
+ * @return float Sample that was overwritten (valid only when the window was full)
+ */
+static inline float ring_push(ring_filter_state_t* ring, uint16_t window_size, float sample)
 {
-    if (!config || !config->enabled) {
-        return raw_value;
+    float evicted = ring->window[ring->index];
+    ring->window[ring->index] = sample;
+    ring->index = (ring->index + 1 == window_size) ? 0 : ring->index + 1;
+    if (ring->count < window_size) {
+        ring->count++;
     }
+    return evicted;
+}
 
-    float conditioned_value = raw_value;
+/**
+ * @brief Median of values (reorders values)
+ */
+static float median_of(float* values, int count)
+{
+    // Insertion sort: windows are at most SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW long
+    for (int i = 1; i < count; i++) {
+        float value = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > value) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = value;
+    }
+    
+    return (count & 1) ? values[count / 2] : 0.5f * (values[count / 2 - 1] + values[count / 2]);
+}
 
-#ifdef DEBUG_SIGNAL_CONDITIONER
-    printf("[%s] Starting signal conditioning: raw=%.3f\n", TAG, raw_value);
+/**
+ * @brief SMA filter stage
+ */
+static float filter_sma(const signal_pipeline_t* pipeline, void* state, float sample)
+{
+    ring_filter_state_t* ring = (ring_filter_state_t*)state;
+    bool full = ring->count == pipeline->window_size;
+    
+    float evicted = ring_push(ring, pipeline->window_size, sample);
+    ring->sum += full ? sample - evicted : sample;
+    
+#if DEBUG_SIGNAL_CONDITIONER_VERBOSE
+    printf("[%s] SMA filter: new_sample=%.3f, count=%d, sum=%.3f\n", TAG, sample, ring->count, ring->sum);
 #endif
+    
+    return ring->sum / ring->count;
+}
 
-    // Step 1: Apply offset
-    conditioned_value += config->offset;
+/**
+ * @brief EMA filter stage
+ */
+static float filter_ema(const signal_pipeline_t* pipeline, void* state, float sample)
+{
+    ema_filter_state_t* ema = (ema_filter_state_t*)state;
+    
+    if (!ema->primed) {
+        ema->value = sample;
+        ema->primed = true;
+    } else {
+        ema->value += pipeline->coefficients[0] * (sample - ema->value);
+    }
+    
+    return ema->value;
+}
 
-    // Step 2: Apply gain
-    conditioned_value *= config->gain;
+/**
+ * @brief Windowed median filter stage
+ */
+static float filter_median(const signal_pipeline_t* pipeline, void* state, float sample)
+{
+    ring_filter_state_t* ring = (ring_filter_state_t*)state;
+    float sorted[SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW];
+    
+    ring_push(ring, pipeline->window_size, sample);
+    memcpy(sorted, ring->window, ring->count * sizeof(float));
+    
+    return median_of(sorted, ring->count);
+}
 
-    // Step 3: Apply scaling factor
-    conditioned_value *= config->scaling_factor;
+/**
+ * @brief Hampel filter stage
+ * 
+ * Replaces the sample with the window median when it lies more than
+ * threshold * 1.4826 * MAD from it (1.4826 scales MAD to a standard
+ * deviation for Gaussian noise).
+ */
+static float filter_hampel(const signal_pipeline_t* pipeline, void* state, float sample)
+{
+    ring_filter_state_t* ring = (ring_filter_state_t*)state;
+    float scratch[SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW];
+    
+    ring_push(ring, pipeline->window_size, sample);
+    int count = ring->count;
+    if (count < 3) {
+        return sample;
+    }
+    
+    memcpy(scratch, ring->window, count * sizeof(float));
+    float median = median_of(scratch, count);
+    
+    for (int i = 0; i < count; i++) {
+        scratch[i] = fabsf(ring->window[i] - median);
+    }
+    float mad = median_of(scratch, count);
+    
+    float deviation = fabsf(sample - median);
+    if (deviation > pipeline->coefficients[0] * 1.4826f * mad) {
+#if DEBUG_SIGNAL_CONDITIONER_VERBOSE
+        printf("[%s] Hampel rejected %.3f (median=%.3f, mad=%.3f)\n", TAG, sample, median, mad);
+#endif
+        return median;
+    }
+    
+    return sample;
+}
 
+/**
+ * @brief Biquad IIR filter stage (transposed direct form II)
+ */
+static float filter_biquad(const signal_pipeline_t* pipeline, void* state, float sample)
+{
+    biquad_filter_state_t* biquad = (biquad_filter_state_t*)state;
+    const float* c = pipeline->coefficients; // b0 b1 b2 a1 a2
+    
+    if (!biquad->primed) {
+        // Start at the DC steady state for the first sample to avoid a startup transient
+        float dc_gain = (c[0] + c[1] + c[2]) / (1.0f + c[3] + c[4]);
+        float y = dc_gain * sample;
+        biquad->z2 = c[2] * sample - c[4] * y;
+        biquad->z1 = c[1] * sample - c[3] * y + biquad->z2;
+        biquad->primed = true;
+    }
+    
+    float y = c[0] * sample + biquad->z1;
+    biquad->z1 = c[1] * sample - c[3] * y + biquad->z2;
+    biquad->z2 = c[2] * sample - c[4] * y;
+    
+    return y;
+}
+
+/**
+ * @brief Check a biquad's poles lie inside the unit circle
+ */
+static bool biquad_is_stable(const float* coefficients)
+{
+    float a1 = coefficients[3];
+    float a2 = coefficients[4];
+    return fabsf(a2) < 1.0f && fabsf(a1) < 1.0f + a2;
+}
+
+/**
+ * @brief Clamp a window size to [2, max]
+ */
+static uint16_t clamp_window(int window_size, int max)
+{
+    if (window_size < 2) return 2;
+    return (uint16_t)(window_size > max ? max : window_size);
+}
+
+/**
+ * @brief Compile the filter stage
+ */
+static void compile_filter(const signal_config_t* config, signal_pipeline_t* pipeline)
+{
+    switch (config->filter_type) {
+        case SIGNAL_FILTER_SMA:
+            if (config->sma_window_size > 1) {
+                pipeline->filter = filter_sma;
+                pipeline->window_size = clamp_window(config->sma_window_size, SIGNAL_CONDITIONER_MAX_SMA_WINDOW);
+                pipeline->state_size = sizeof(ring_filter_state_t) + pipeline->window_size * sizeof(float);
+            }
+            break;
+            
+        case SIGNAL_FILTER_EMA:
+            if (config->ema_alpha > 0.0f && config->ema_alpha < 1.0f) {
+                pipeline->filter = filter_ema;
+                pipeline->coefficients[0] = config->ema_alpha;
+                pipeline->state_size = sizeof(ema_filter_state_t);
+            }
+            break;
+            
+        case SIGNAL_FILTER_MEDIAN:
+        case SIGNAL_FILTER_HAMPEL:
+            if (config->median_window_size > 1) {
+                pipeline->filter = config->filter_type == SIGNAL_FILTER_MEDIAN ? filter_median : filter_hampel;
+                pipeline->window_size = clamp_window(config->median_window_size, SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW);
+                pipeline->coefficients[0] = config->hampel_threshold > 0.0f ? 
+                                            config->hampel_threshold : CONFIG_DEFAULT_HAMPEL_THRESHOLD;
+                pipeline->state_size = sizeof(ring_filter_state_t) + pipeline->window_size * sizeof(float);
+            }
+            break;
+            
+        case SIGNAL_FILTER_BIQUAD:
+            if (biquad_is_stable(config->biquad_coefficients)) {
+                pipeline->filter = filter_biquad;
+                memcpy(pipeline->coefficients, config->biquad_coefficients, sizeof(pipeline->coefficients));
+                pipeline->state_size = sizeof(biquad_filter_state_t);
+            } else {
 #ifdef DEBUG_SIGNAL_CONDITIONER
-    printf("[%s] After offset/gain/scaling: %.3f\n", TAG, conditioned_value);
+                printf("[%s] Unstable biquad coefficients, filter disabled\n", TAG);
 #endif
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
 
-    // Step 4: Apply lookup table interpolation (if enabled)
-    if (config->lookup_table_enabled && config->lookup_table_count > 0) {
-        conditioned_value = signal_conditioner_lookup_table(conditioned_value, config);
 #ifdef DEBUG_SIGNAL_CONDITIONER
-        printf("[%s] After lookup table: %.3f\n", TAG, conditioned_value);
+/**
+ * @brief Filter type name for logging
+ */
+static const char* filter_name(signal_filter_fn_t filter)
+{
+    if (filter == filter_sma) return "SMA";
+    if (filter == filter_ema) return "EMA";
+    if (filter == filter_median) return "MEDIAN";
+    if (filter == filter_hampel) return "HAMPEL";
+    if (filter == filter_biquad) return "BIQUAD";
+    return "none";
+}
 #endif
+
+esp_err_t signal_conditioner_compile(const signal_config_t* config, signal_pipeline_t* pipeline)
+{
+    if (!config || !pipeline) {
+        return ESP_ERR_INVALID_ARG;
     }
 
-    // Step 5: Apply precision rounding
-    conditioned_value = signal_conditioner_round_precision(conditioned_value, config->precision_digits);
+    memset(pipeline, 0, sizeof(signal_pipeline_t));
+    pipeline->enabled = config->enabled;
 
-    // Step 6: Apply SMA filtering (if enabled)
-    if (config->filter_type == SIGNAL_FILTER_SMA && config->sma_window_size > 1) {
-        conditioned_value = signal_conditioner_sma_filter(conditioned_value,
-                                                         sma_buffer,
-                                                         sma_index,
-                                                         sma_count,
-                                                         sma_sum,
-                                                         config->sma_window_size);
-#ifdef DEBUG_SIGNAL_CONDITIONER
-        printf("[%s] After SMA filter: %.3f\n", TAG, conditioned_value);
-#endif
+    // (x + offset) * gain * scaling_factor == x * scale + bias
+    pipeline->scale = config->gain * config->scaling_factor;
+    pipeline->bias = config->offset * pipeline->scale;
+
+    if (config->lookup_table_enabled && config->lookup_table && config->lookup_table_count >= 2) {
+        pipeline->lookup = config;
     }
 
+    compile_filter(config, pipeline);
+
+    int digits = config->precision_digits;
+    if (digits < 0) digits = 0;
+    if (digits > SIGNAL_CONDITIONER_MAX_PRECISION) digits = SIGNAL_CONDITIONER_MAX_PRECISION;
+    pipeline->precision_multiplier = powf(10.0f, (float)digits);
+    pipeline->precision_inverse = 1.0f / pipeline->precision_multiplier;
+
 #ifdef DEBUG_SIGNAL_CONDITIONER
-    printf("[%s] Final conditioned value: %.3f\n", TAG, conditioned_value);
+    printf("[%s] Compiled pipeline: %s, scale=%.4f, bias=%.4f, lookup=%s, filter=%s(%d, %d bytes), digits=%d\n",
+           TAG, pipeline->enabled ? "enabled" : "pass-through", pipeline->scale, pipeline->bias,
+           pipeline->lookup ? "yes" : "no", filter_name(pipeline->filter), pipeline->window_size,
+           pipeline->state_size, digits);
 #endif
 
-    return conditioned_value;
+    return ESP_OK;
 }
 
-float signal_conditioner_lookup_table(float input, const signal_config_t* config)
+float signal_conditioner_process(const signal_pipeline_t* pipeline, void* state, float value)
 {
-    if (!config || !config->lookup_table_enabled || config->lookup_table_count < 2) {
-        return input;
+    if (!pipeline->enabled) {
+        return value;
     }
 
-    // Handle edge cases
-    if (input <= config->lookup_table[0].input) {
-        return config->lookup_table[0].output;
+    // Step 1: Offset, gain and scaling factor in one multiply-add
+    float conditioned_value = value * pipeline->scale + pipeline->bias;
+
+    // Step 2: Lookup table interpolation
+    if (pipeline->lookup) {
+        conditioned_value = signal_conditioner_lookup_table(conditioned_value, pipeline->lookup);
     }
-    
-    if (input >= config->lookup_table[config->lookup_table_count - 1].input) {
-        return config->lookup_table[config->lookup_table_count - 1].output;
+
+    // Step 3: Filter on full-precision values
+    if (pipeline->filter && state) {
+        conditioned_value = pipeline->filter(pipeline, state, conditioned_value);
     }
 
-    // Find the interpolation segment
-    for (int i = 0; i < config->lookup_table_count - 1; i++) {
-        float x1 = config->lookup_table[i].input;
-        float y1 = config->lookup_table[i].output;
-        float x2 = config->lookup_table[i + 1].input;
-        float y2 = config->lookup_table[i + 1].output;
+    // Step 4: Precision rounding
+    conditioned_value = roundf(conditioned_value * pipeline->precision_multiplier) * pipeline->precision_inverse;
 
-        if (input >= x1 && input <= x2) {
-            // Linear interpolation: y = y1 + (y2-y1) * (x-x1) / (x2-x1)
-            if (x2 == x1) {
-                return y1; // Avoid division by zero
-            }
-            
-            float interpolated = y1 + (y2 - y1) * (input - x1) / (x2 - x1);
-            
-#ifdef DEBUG_SIGNAL_CONDITIONER
-            printf("[%s] Lookup interpolation: input=%.3f, x1=%.3f, y1=%.3f, x2=%.3f, y2=%.3f, result=%.3f\n",
-                   TAG, input, x1, y1, x2, y2, interpolated);
+#if DEBUG_SIGNAL_CONDITIONER_VERBOSE
+    printf("[%s] Conditioned %.3f -> %.3f\n", TAG, value, conditioned_value);
 #endif
-            
-            return interpolated;
-        }
+
+    return conditioned_value;
+}
+
+void signal_conditioner_reset_state(const signal_pipeline_t* pipeline, void* state)
+{
+    if (pipeline && state) {
+        memset(state, 0, pipeline->state_size);
+    }
+}
+
+esp_err_t signal_conditioner_pool_reserve(signal_filter_pool_t* pool, size_t capacity)
+{
+    if (!pool) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pool->used = 0;
+    if (capacity <= pool->capacity) {
+        return ESP_OK;
+    }
+
+    signal_conditioner_pool_release(pool);
+    // Filter state is touched on every scan, so keep it in internal RAM
+    pool->storage = psram_smart_malloc(capacity, ALLOC_CRITICAL);
+    if (!pool->storage) {
+        return ESP_ERR_NO_MEM;
     }
+    pool->capacity = capacity;
 
-    // Should not reach here, but return input as fallback
-    return input;
+    return ESP_OK;
 }
 
-float signal_conditioner_sma_filter(float new_sample,
-                                   float* sma_buffer,
-                                   int* sma_index,
-                                   int* sma_count,
-                                   float* sma_sum,
-                                   int window_size)
+size_t signal_conditioner_pool_size(const signal_pipeline_t* pipeline)
 {
-    if (!sma_buffer || !sma_index || !sma_count || !sma_sum || window_size <= 1) {
-        return new_sample;
+    if (!pipeline || !pipeline->filter) {
+        return 0;
     }
+    return (pipeline->state_size + SIGNAL_POOL_ALIGN - 1) & ~(size_t)(SIGNAL_POOL_ALIGN - 1);
+}
 
-    // Ensure window size doesn't exceed buffer size
-    if (window_size > 16) { // Based on our reduced buffer size
-        window_size = 16;
+void* signal_conditioner_pool_alloc(signal_filter_pool_t* pool, const signal_pipeline_t* pipeline)
+{
+    size_t size = signal_conditioner_pool_size(pipeline);
+    if (!pool || size == 0 || pool->used + size > pool->capacity) {
+        return NULL;
     }
 
-    // Remove old sample from sum if buffer is full
-    if (*sma_count >= window_size) {
-        *sma_sum -= sma_buffer[*sma_index];
+    void* state = pool->storage + pool->used;
+    pool->used += size;
+    memset(state, 0, size);
+    return state;
+}
+
+void signal_conditioner_pool_release(signal_filter_pool_t* pool)
+{
+    if (pool && pool->storage) {
+        psram_smart_free(pool->storage);
+        pool->storage = NULL;
+        pool->capacity = 0;
+        pool->used = 0;
     }
+}
 
-    // Add new sample
-    sma_buffer[*sma_index] = new_sample;
-    *sma_sum += new_sample;
+float signal_conditioner_lookup_table(float input, const signal_config_t* config)
+{
+    if (!config || !config->lookup_table_enabled || !config->lookup_table || config->lookup_table_count < 2) {
+        return input;
+    }
 
-    // Update count (up to window size)
-    if (*sma_count < window_size) {
-        (*sma_count)++;
+    const lookup_table_entry_t* table = config->lookup_table;
+    int last = config->lookup_table_count - 1;
+
+    // Handle edge cases
+    if (input <= table[0].input) {
+        return table[0].output;
+    }
+    
+    if (input >= table[last].input) {
+        return table[last].output;
     }
 
-    // Calculate average
-    float average = *sma_sum / (*sma_count);
+    // Binary search for the segment start: table[low].input <= input < table[low + 1].input
+    int low = 0;
+    int high = last;
+    while (high - low > 1) {
+        int mid = (low + high) >> 1;
+        if (table[mid].input <= input) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
 
-    // Update index (circular buffer)
-    *sma_index = (*sma_index + 1) % window_size;
+    float interpolated = table[low].output + (input - table[low].input) * table[low].slope;
 
-#ifdef DEBUG_SIGNAL_CONDITIONER
-    printf("[%s] SMA filter: new_sample=%.3f, count=%d, sum=%.3f, average=%.3f\n",
-           TAG, new_sample, *sma_count, *sma_sum, average);
+#if DEBUG_SIGNAL_CONDITIONER_VERBOSE
+    printf("[%s] Lookup interpolation: input=%.3f, segment=%d, x1=%.3f, y1=%.3f, result=%.3f\n",
+           TAG, input, low, table[low].input, table[low].output, interpolated);
 #endif
 
-    return average;
+    return interpolated;
 }
 
 float signal_conditioner_round_precision(float value, int precision_digits)
@@ -165,64 +444,72 @@ float signal_conditioner_round_precision(float value, int precision_digits)
     if (precision_digits < 0) {
         precision_digits = 0;
     }
-    if (precision_digits > 6) {
-        precision_digits = 6; // Reasonable limit for float precision
+    if (precision_digits > SIGNAL_CONDITIONER_MAX_PRECISION) {
+        precision_digits = SIGNAL_CONDITIONER_MAX_PRECISION; // Reasonable limit for float precision
     }
 
     float multiplier = powf(10.0f, (float)precision_digits);
     return roundf(value * multiplier) / multiplier;
 }
 
-void signal_conditioner_init_sma(float* sma_buffer,
-                                int* sma_index,
-                                int* sma_count,
-                                float* sma_sum,
-                                int buffer_size)
+bool signal_conditioner_validate_config(const signal_config_t* config)
 {
-    if (!sma_buffer || !sma_index || !sma_count || !sma_sum) {
-        return;
+    if (!config) {
+        return false;
     }
 
-    // Clear buffer
-    memset(sma_buffer, 0, buffer_size * sizeof(float));
-    
-    // Reset state
-    *sma_index = 0;
-    *sma_count = 0;
-    *sma_sum = 0.0f;
-
+    // Validate SMA window size
+    if (config->filter_type == SIGNAL_FILTER_SMA) {
+        if (config->sma_window_size < 1 || config->sma_window_size > SIGNAL_CONDITIONER_MAX_SMA_WINDOW) {
 #ifdef DEBUG_SIGNAL_CONDITIONER
-    printf("[%s] SMA filter initialized with buffer size %d\n", TAG, buffer_size);
+            printf("[%s] Invalid SMA window size: %d (must be 1-%d)\n", TAG, config->sma_window_size,
+                   SIGNAL_CONDITIONER_MAX_SMA_WINDOW);
 #endif
-}
+            return false;
+        }
+    }
 
-bool signal_conditioner_validate_config(const signal_config_t* config)
-{
-    if (!config) {
+    // Validate EMA smoothing factor
+    if (config->filter_type == SIGNAL_FILTER_EMA && (config->ema_alpha <= 0.0f || config->ema_alpha > 1.0f)) {
+#ifdef DEBUG_SIGNAL_CONDITIONER
+        printf("[%s] Invalid EMA alpha: %.3f (must be 0-1)\n", TAG, config->ema_alpha);
+#endif
         return false;
     }
 
-    // Validate SMA window size
-    if (config->filter_type == SIGNAL_FILTER_SMA) {
-        if (config->sma_window_size < 1 || config->sma_window_size > 16) {
+    // Validate median/Hampel window size
+    if (config->filter_type == SIGNAL_FILTER_MEDIAN || config->filter_type == SIGNAL_FILTER_HAMPEL) {
+        if (config->median_window_size < 1 || config->median_window_size > SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW) {
 #ifdef DEBUG_SIGNAL_CONDITIONER
-            printf("[%s] Invalid SMA window size: %d (must be 1-16)\n", TAG, config->sma_window_size);
+            printf("[%s] Invalid median window size: %d (must be 1-%d)\n", TAG, config->median_window_size,
+                   SIGNAL_CONDITIONER_MAX_MEDIAN_WINDOW);
 #endif
             return false;
         }
     }
 
+    // Validate biquad stability
+    if (config->filter_type == SIGNAL_FILTER_BIQUAD && !biquad_is_stable(config->biquad_coefficients)) {
+#ifdef DEBUG_SIGNAL_CONDITIONER
+        printf("[%s] Unstable biquad coefficients: a1=%.4f, a2=%.4f\n", TAG,
+               config->biquad_coefficients[3], config->biquad_coefficients[4]);
+#endif
+        return false;
+    }
+
     // Validate precision digits
-    if (config->precision_digits < 0 || config->precision_digits > 6) {
+    if (config->precision_digits < 0 || config->precision_digits > SIGNAL_CONDITIONER_MAX_PRECISION) {
 #ifdef DEBUG_SIGNAL_CONDITIONER
-        printf("[%s] Invalid precision digits: %d (must be 0-6)\n", TAG, config->precision_digits);
+        printf("[%s] Invalid precision digits: %d (must be 0-%d)\n", TAG, config->precision_digits,
+               SIGNAL_CONDITIONER_MAX_PRECISION);
 #endif
         return false;
     }
 
     // Validate lookup table
     if (config->lookup_table_enabled) {
-        if (config->lookup_table_count < 2 || config->lookup_table_count > CONFIG_MAX_LOOKUP_ENTRIES) {
+        if (!config->lookup_table || config->lookup_table_count < 2 || 
+            config->lookup_table_count > CONFIG_MAX_LOOKUP_ENTRIES) {
 #ifdef DEBUG_SIGNAL_CONDITIONER
             printf("[%s] Invalid lookup table count: %d (must be 2-%d)\n", 
                    TAG, config->lookup_table_count, CONFIG_MAX_LOOKUP_ENTRIES);
@@ -0,0 +1,1106 @@
+/**
+ * @file trending_manager.c
+ * @brief Trend History Manager Implementation for SNRv9 Irrigation Control System
+ */
+
+#include "trending_manager.h"
+#include "psram_manager.h"
+#include "debug_config.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef DEBUG_TRENDING_SYSTEM
+static const char* TAG = DEBUG_TRENDING_SYSTEM_TAG;
+#endif
+
+/**
+ * @brief Payload bits of a block
+ */
+#define TRENDING_PAYLOAD_BITS (TRENDING_BLOCK_PAYLOAD * 8)
+
+/**
+ * @brief Longest encoded sample (analog: 36 timestamp + 44 value bits, binary: 10 varint bytes)
+ */
+#define TRENDING_MAX_SAMPLE_BITS 80
+
+/**
+ * @brief Rollup records copied per lock hold while querying
+ */
+#define TRENDING_QUERY_CHUNK 16
+
+/**
+ * @brief Bucket length by tier
+ */
+static const uint32_t trending_tier_ms[TRENDING_TIER_COUNT] = {
+    0, TRENDING_TIER_1MIN_MS, TRENDING_TIER_15MIN_MS, TRENDING_TIER_1H_MS
+};
+
+/**
+ * @brief Rollup ring proportions by rollup tier
+ */
+static const uint32_t trending_rollup_target[TRENDING_ROLLUP_TIERS] = {
+    TRENDING_ROLLUP_TARGET_1MIN, TRENDING_ROLLUP_TARGET_15MIN, TRENDING_ROLLUP_TARGET_1H
+};
+
+/**
+ * @brief Bit reader over a copied block payload
+ */
+typedef struct {
+    const uint8_t* payload;
+    uint32_t position;
+    uint32_t end;
+} trending_bit_reader_t;
+
+/**
+ * @brief Raw query adapter for resolution queries
+ */
+typedef struct {
+    trending_bucket_fn_t visit;
+    void* context;
+} trending_raw_adapter_t;
+
+// Forward declarations
+static esp_err_t trending_build_series(trending_manager_t* manager);
+static inline uint8_t* trending_block(const trending_manager_t* manager, const trending_series_t* series,
+                                      uint32_t sequence);
+static int trending_find_series(trending_manager_t* manager, const char* point_id);
+static void trending_record_analog(trending_manager_t* manager, trending_series_t* series,
+                                   int64_t time_ms, float value);
+static void trending_record_binary(trending_manager_t* manager, trending_series_t* series,
+                                   int64_t time_ms, bool state);
+static void trending_rollup_merge(trending_manager_t* manager, trending_series_t* series, int tier,
+                                  const trending_open_bucket_t* source);
+
+esp_err_t trending_manager_init(trending_manager_t* manager, config_manager_t* config_manager)
+{
+    if (!manager || !config_manager) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#ifdef DEBUG_TRENDING_SYSTEM
+    printf("[%s] Initializing trending manager...\n", TAG);
+#endif
+
+    memset(manager, 0, sizeof(trending_manager_t));
+    portMUX_INITIALIZE(&manager->lock);
+    manager->config_manager = config_manager;
+
+    esp_err_t ret = psram_manager_allocate_for_category(PSRAM_ALLOC_TRENDING, TRENDING_POOL_BYTES,
+                                                        (void**)&manager->pool);
+    if (ret != ESP_OK || !manager->pool) {
+#ifdef DEBUG_TRENDING_SYSTEM
+        printf("[%s] No memory for the %d byte trend pool\n", TAG, TRENDING_POOL_BYTES);
+#endif
+        memset(manager, 0, sizeof(trending_manager_t));
+        return ESP_ERR_NO_MEM;
+    }
+    manager->pool_blocks = TRENDING_POOL_BYTES / TRENDING_BLOCK_BYTES * (100 - TRENDING_ROLLUP_PERCENT) / 100;
+    manager->rollups = (trending_rollup_t*)(manager->pool + (size_t)manager->pool_blocks * TRENDING_BLOCK_BYTES);
+    manager->rollup_records = (TRENDING_POOL_BYTES - manager->pool_blocks * TRENDING_BLOCK_BYTES) /
+                              sizeof(trending_rollup_t);
+
+    ret = trending_build_series(manager);
+    if (ret != ESP_OK) {
+        free(manager->pool);
+        memset(manager, 0, sizeof(trending_manager_t));
+        return ret;
+    }
+
+    manager->initialized = true;
+
+#ifdef DEBUG_TRENDING_SYSTEM
+    printf("[%s] Trending manager initialized with %d trended points\n", TAG, manager->series_count);
+#endif
+
+    return ESP_OK;
+}
+
+esp_err_t trending_manager_reload_config(trending_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = trending_build_series(manager);
+
+#ifdef DEBUG_TRENDING_SYSTEM
+    printf("[%s] Trend configuration reloaded: %d trended points (%s)\n",
+           TAG, manager->series_count, esp_err_to_name(ret));
+#endif
+
+    return ret;
+}
+
+esp_err_t trending_manager_resolve_point(trending_manager_t* manager, const char* point_id,
+                                         trending_handle_t* handle)
+{
+    if (!manager || !manager->initialized || !point_id || !handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *handle = trending_find_series(manager, point_id);
+    return (*handle < 0) ? ESP_ERR_NOT_FOUND : ESP_OK;
+}
+
+esp_err_t trending_manager_record_samples(trending_manager_t* manager, const trending_sample_t* samples,
+                                          int count, int64_t time_ms)
+{
+    if (!manager || !manager->initialized || (!samples && count > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const trending_sample_t* sample = &samples[i];
+
+        portENTER_CRITICAL(&manager->lock);
+        if (sample->handle < 0 || sample->handle >= manager->series_count) {
+            portEXIT_CRITICAL(&manager->lock);
+            return ESP_ERR_INVALID_ARG;
+        }
+        trending_series_t* series = &manager->series[sample->handle];
+        float value = (series->kind == TRENDING_KIND_ANALOG) ? sample->value : (sample->state ? 1.0f : 0.0f);
+        if (value == value) {
+            trending_open_bucket_t single = { time_ms, value, value, value, 1 };
+            trending_rollup_merge(manager, series, 0, &single);
+        }
+        if (series->kind == TRENDING_KIND_ANALOG) {
+            trending_record_analog(manager, series, time_ms, sample->value);
+        } else {
+            trending_record_binary(manager, series, time_ms, sample->state);
+        }
+        portEXIT_CRITICAL(&manager->lock);
+    }
+
+    return ESP_OK;
+}
+
+int trending_manager_get_series_count(trending_manager_t* manager)
+{
+    if (!manager || !manager->initialized) {
+        return 0;
+    }
+    return manager->series_count;
+}
+
+esp_err_t trending_manager_get_series_info(trending_manager_t* manager, trending_handle_t handle,
+                                           trending_series_info_t* info)
+{
+    if (!manager || !manager->initialized || !info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(info, 0, sizeof(trending_series_info_t));
+
+    portENTER_CRITICAL(&manager->lock);
+    if (handle < 0 || handle >= manager->series_count) {
+        portEXIT_CRITICAL(&manager->lock);
+        return ESP_ERR_NOT_FOUND;
+    }
+    const trending_series_t* series = &manager->series[handle];
+    memcpy(info->point_id, manager->point_ids[handle], CONFIG_MAX_ID_LENGTH);
+    info->kind = (trending_kind_t)series->kind;
+    info->interval_ms = (series->kind == TRENDING_KIND_ANALOG) ? series->interval_ms : 0;
+    info->samples = series->held_samples;
+    info->bytes_used = series->held_bytes;
+    info->bytes_allocated = (uint32_t)series->block_count * TRENDING_BLOCK_BYTES;
+    if (series->next_sequence != series->first_sequence) {
+        const trending_block_header_t* oldest =
+            (const trending_block_header_t*)trending_block(manager, series, series->first_sequence);
+        info->first_ms = oldest->first_ms;
+        info->last_ms = series->previous_ms;
+    }
+    for (int tier = 0; tier < TRENDING_ROLLUP_TIERS; tier++) {
+        uint32_t capacity = series->rollup_capacity[tier];
+        info->rollup_held[tier] = (series->rollup_next[tier] < capacity) ? series->rollup_next[tier] : capacity;
+        info->rollup_capacity[tier] = capacity;
+    }
+    portEXIT_CRITICAL(&manager->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t trending_manager_get_stats(trending_manager_t* manager, trending_stats_t* stats)
+{
+    if (!manager || !manager->initialized || !stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stats, 0, sizeof(trending_stats_t));
+    stats->pool_bytes = manager->pool_blocks * TRENDING_BLOCK_BYTES;
+    stats->rollup_bytes = manager->rollup_records * sizeof(trending_rollup_t);
+
+    portENTER_CRITICAL(&manager->lock);
+    for (int i = 0; i < manager->series_count; i++) {
+        const trending_series_t* series = &manager->series[i];
+        if (series->kind == TRENDING_KIND_ANALOG) {
+            stats->analog_points++;
+        } else {
+            stats->binary_points++;
+        }
+        stats->samples_held += series->held_samples;
+        stats->bytes_held += series->held_bytes;
+        for (int tier = 0; tier < TRENDING_ROLLUP_TIERS; tier++) {
+            uint32_t capacity = series->rollup_capacity[tier];
+            stats->rollups_held += (series->rollup_next[tier] < capacity) ? series->rollup_next[tier] : capacity;
+        }
+    }
+    stats->samples_recorded = manager->samples_recorded;
+    stats->blocks_recycled = manager->blocks_recycled;
+    portEXIT_CRITICAL(&manager->lock);
+
+    return ESP_OK;
+}
+
+void trending_manager_destroy(trending_manager_t* manager)
+{
+    if (!manager) {
+        return;
+    }
+
+    psram_smart_free(manager->series);
+    psram_smart_free(manager->point_ids);
+    point_id_index_release(&manager->id_index);
+    // Category allocations come straight from the heap
+    free(manager->pool);
+
+    memset(manager, 0, sizeof(trending_manager_t));
+
+#ifdef DEBUG_TRENDING_SYSTEM
+    printf("[%s] Trending manager destroyed\n", TAG);
+#endif
+}
+
+// Private functions
+
+/**
+ * @brief Block of a series by sequence number
+ */
+static inline uint8_t* trending_block(const trending_manager_t* manager, const trending_series_t* series,
+                                      uint32_t sequence)
+{
+    return manager->pool + (size_t)(series->first_block + sequence % series->block_count) * TRENDING_BLOCK_BYTES;
+}
+
+/**
+ * @brief Bytes of a block holding samples
+ */
+static inline uint32_t trending_block_used_bytes(const trending_block_header_t* header)
+{
+    return sizeof(trending_block_header_t) + (header->used_bits + 7) / 8;
+}
+
+/**
+ * @brief Append bits (MSB first) to a zeroed payload
+ */
+static void trending_put_bits(uint8_t* payload, trending_block_header_t* header, uint64_t value, int bits)
+{
+    uint32_t position = header->used_bits;
+    while (bits > 0) {
+        int room = 8 - (position & 7);
+        int take = (bits < room) ? bits : room;
+        uint8_t chunk = (uint8_t)((value >> (bits - take)) & ((1u << take) - 1));
+        payload[position >> 3] |= (uint8_t)(chunk << (room - take));
+        position += take;
+        bits -= take;
+    }
+    header->used_bits = (uint16_t)position;
+}
+
+/**
+ * @brief Read bits (MSB first); reads past the end return zeros
+ */
+static uint64_t trending_get_bits(trending_bit_reader_t* reader, int bits)
+{
+    uint64_t value = 0;
+    while (bits > 0) {
+        if (reader->position >= reader->end) {
+            value <<= bits;
+            break;
+        }
+        int room = 8 - (reader->position & 7);
+        int take = (bits < room) ? bits : room;
+        uint8_t chunk = (uint8_t)((reader->payload[reader->position >> 3] >> (room - take)) & ((1u << take) - 1));
+        value = (value << take) | chunk;
+        reader->position += take;
+        bits -= take;
+    }
+    return value;
+}
+
+/**
+ * @brief Sign-extend an n-bit two's complement field
+ */
+static inline int64_t trending_sign_extend(uint64_t value, int bits)
+{
+    uint64_t sign = 1ull << (bits - 1);
+    return (int64_t)((value ^ sign) - sign);
+}
+
+/**
+ * @brief Start a new block with its first sample, dropping the oldest block when the ring is full
+ */
+static void trending_start_block(trending_manager_t* manager, trending_series_t* series,
+                                 int64_t time_ms, float first_value)
+{
+    if (series->next_sequence - series->first_sequence >= series->block_count) {
+        const trending_block_header_t* oldest =
+            (const trending_block_header_t*)trending_block(manager, series, series->first_sequence);
+        series->held_samples -= oldest->count;
+        series->held_bytes -= trending_block_used_bytes(oldest);
+        series->first_sequence++;
+        manager->blocks_recycled++;
+    }
+
+    uint8_t* block = trending_block(manager, series, series->next_sequence);
+    trending_block_header_t* header = (trending_block_header_t*)block;
+    memset(block, 0, TRENDING_BLOCK_BYTES);
+    header->first_ms = time_ms;
+    header->last_ms = time_ms;
+    header->first_value = first_value;
+    header->count = 1;
+    series->next_sequence++;
+
+    series->previous_ms = time_ms;
+    series->held_samples++;
+    series->held_bytes += sizeof(trending_block_header_t);
+    manager->samples_recorded++;
+}
+
+/**
+ * @brief Block being written, or NULL when the ring is empty
+ */
+static trending_block_header_t* trending_current_block(trending_manager_t* manager, trending_series_t* series)
+{
+    if (series->next_sequence == series->first_sequence) {
+        return NULL;
+    }
+    return (trending_block_header_t*)trending_block(manager, series, series->next_sequence - 1);
+}
+
+/**
+ * @brief Account a sample appended to the current block
+ */
+static void trending_finish_append(trending_manager_t* manager, trending_series_t* series,
+                                   trending_block_header_t* header, uint16_t bits_before, int64_t time_ms)
+{
+    header->count++;
+    header->last_ms = time_ms;
+    series->previous_ms = time_ms;
+    series->held_samples++;
+    series->held_bytes += (header->used_bits + 7) / 8 - (bits_before + 7) / 8;
+    manager->samples_recorded++;
+}
+
+/**
+ * @brief Encode an analog sample on the first sample of each interval slot
+ */
+static void trending_record_analog(trending_manager_t* manager, trending_series_t* series,
+                                   int64_t time_ms, float value)
+{
+    int64_t slot_ms = time_ms - time_ms % series->interval_ms;
+    trending_block_header_t* header = trending_current_block(manager, series);
+    if (header && slot_ms == series->previous_ms) {
+        return;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    int64_t delta = slot_ms - series->previous_ms;
+    if (!header || delta < 0 || delta > INT32_MAX ||
+        header->used_bits + TRENDING_MAX_SAMPLE_BITS > TRENDING_PAYLOAD_BITS) {
+        trending_start_block(manager, series, slot_ms, value);
+        series->previous_delta = 0;
+        series->previous_bits = bits;
+        series->previous_leading = 0xFF;
+        series->previous_trailing = 0;
+        return;
+    }
+
+    uint8_t* payload = (uint8_t*)(header + 1);
+    uint16_t bits_before = header->used_bits;
+
+    // Timestamp: delta-of-delta, 0 while no slot is missed
+    int64_t dod = delta - series->previous_delta;
+    if (dod == 0) {
+        trending_put_bits(payload, header, 0x0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+        trending_put_bits(payload, header, 0x2, 2);
+        trending_put_bits(payload, header, (uint64_t)dod & 0x7F, 7);
+    } else if (dod >= -256 && dod <= 255) {
+        trending_put_bits(payload, header, 0x6, 3);
+        trending_put_bits(payload, header, (uint64_t)dod & 0x1FF, 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+        trending_put_bits(payload, header, 0xE, 4);
+        trending_put_bits(payload, header, (uint64_t)dod & 0xFFF, 12);
+    } else {
+        // |dod| <= 2 * INT32_MAX only fits 33 bits in theory; the delta itself always fits 32
+        trending_put_bits(payload, header, 0xF, 4);
+        trending_put_bits(payload, header, (uint64_t)delta & 0xFFFFFFFF, 32);
+    }
+    series->previous_delta = (int32_t)delta;
+
+    // Value: XOR with the previous value, meaningful bits only
+    uint32_t xor_bits = bits ^ series->previous_bits;
+    if (xor_bits == 0) {
+        trending_put_bits(payload, header, 0x0, 1);
+    } else {
+        uint8_t leading = (uint8_t)__builtin_clz(xor_bits);
+        uint8_t trailing = (uint8_t)__builtin_ctz(xor_bits);
+        if (series->previous_leading != 0xFF && leading >= series->previous_leading &&
+            trailing >= series->previous_trailing) {
+            int length = 32 - series->previous_leading - series->previous_trailing;
+            trending_put_bits(payload, header, 0x2, 2);
+            trending_put_bits(payload, header, xor_bits >> series->previous_trailing, length);
+        } else {
+            int length = 32 - leading - trailing;
+            trending_put_bits(payload, header, 0x3, 2);
+            trending_put_bits(payload, header, leading, 5);
+            trending_put_bits(payload, header, (uint64_t)(length - 1), 5);
+            trending_put_bits(payload, header, xor_bits >> trailing, length);
+            series->previous_leading = leading;
+            series->previous_trailing = trailing;
+        }
+    }
+    series->previous_bits = bits;
+
+    trending_finish_append(manager, series, header, bits_before, slot_ms);
+}
+
+/**
+ * @brief Encode a binary point's state change as the length of the run that ended
+ */
+static void trending_record_binary(trending_manager_t* manager, trending_series_t* series,
+                                   int64_t time_ms, bool state)
+{
+    trending_block_header_t* header = trending_current_block(manager, series);
+    if (header && state == series->state) {
+        return;
+    }
+    series->state = state;
+
+    int64_t run_ms = time_ms - series->previous_ms;
+    if (!header || run_ms < 0 || header->used_bits + TRENDING_MAX_SAMPLE_BITS > TRENDING_PAYLOAD_BITS) {
+        trending_start_block(manager, series, time_ms, state ? 1.0f : 0.0f);
+        return;
+    }
+
+    uint8_t* payload = (uint8_t*)(header + 1);
+    uint16_t bits_before = header->used_bits;
+
+    // LEB128: 7 bits per byte, low group first, high bit set on all but the last byte
+    uint64_t remaining = (uint64_t)run_ms;
+    do {
+        uint8_t byte = remaining & 0x7F;
+        remaining >>= 7;
+        if (remaining) {
+            byte |= 0x80;
+        }
+        trending_put_bits(payload, header, byte, 8);
+    } while (remaining);
+
+    trending_finish_append(manager, series, header, bits_before, time_ms);
+}
+
+/**
+ * @brief Close the open bucket of a rollup tier into its ring and the next tier
+ */
+static void trending_rollup_close(trending_manager_t* manager, trending_series_t* series, int tier)
+{
+    trending_open_bucket_t* open = &series->rollup_open[tier];
+    uint32_t capacity = series->rollup_capacity[tier];
+    if (capacity > 0) {
+        trending_rollup_t* record =
+            &manager->rollups[series->rollup_first[tier] + series->rollup_next[tier] % capacity];
+        record->start_s = (uint32_t)(open->start_ms / 1000);
+        record->count = open->count;
+        record->min = open->min;
+        record->max = open->max;
+        record->mean = open->sum / open->count;
+        series->rollup_next[tier]++;
+    }
+    if (tier + 1 < TRENDING_ROLLUP_TIERS) {
+        trending_rollup_merge(manager, series, tier + 1, open);
+    }
+    open->count = 0;
+}
+
+/**
+ * @brief Fold a sample or a closed finer bucket into the open bucket of a rollup tier
+ */
+static void trending_rollup_merge(trending_manager_t* manager, trending_series_t* series, int tier,
+                                  const trending_open_bucket_t* source)
+{
+    trending_open_bucket_t* open = &series->rollup_open[tier];
+    int64_t start_ms = source->start_ms - source->start_ms % trending_tier_ms[tier + 1];
+    if (open->count > 0 && open->start_ms != start_ms) {
+        trending_rollup_close(manager, series, tier);
+    }
+    if (open->count == 0) {
+        open->start_ms = start_ms;
+        open->min = source->min;
+        open->max = source->max;
+        open->sum = 0.0f;
+    } else {
+        if (source->min < open->min) {
+            open->min = source->min;
+        }
+        if (source->max > open->max) {
+            open->max = source->max;
+        }
+    }
+    open->sum += source->sum;
+    open->count += source->count;
+}
+
+/**
+ * @brief Buckets of a rollup tier not closed yet: its open bucket and the finer open buckets
+ *
+ * A finer bucket is only merged up when it closes, so the newest samples
+ * can already belong to a later bucket of this tier than its open one.
+ *
+ * @return int Number of buckets stored in time order (at most TRENDING_ROLLUP_TIERS)
+ */
+static int trending_rollup_partial(const trending_series_t* series, int tier,
+                                   trending_open_bucket_t buckets[TRENDING_ROLLUP_TIERS])
+{
+    int count = 0;
+    for (int finer = tier; finer >= 0; finer--) {
+        const trending_open_bucket_t* open = &series->rollup_open[finer];
+        if (open->count == 0) {
+            continue;
+        }
+        int64_t start_ms = open->start_ms - open->start_ms % trending_tier_ms[tier + 1];
+        trending_open_bucket_t* bucket = &buckets[count - 1];
+        if (count == 0 || start_ms != bucket->start_ms) {
+            bucket = &buckets[count++];
+            *bucket = *open;
+            bucket->start_ms = start_ms;
+            continue;
+        }
+        if (open->min < bucket->min) {
+            bucket->min = open->min;
+        }
+        if (open->max > bucket->max) {
+            bucket->max = open->max;
+        }
+        bucket->sum += open->sum;
+        bucket->count += open->count;
+    }
+    return count;
+}
+
+/**
+ * @brief Decode a copied analog block, visiting samples in [from_ms, to_ms]
+ *
+ * @return bool False if the visitor stopped the query
+ */
+static bool trending_decode_analog(const uint8_t* block, int64_t from_ms, int64_t to_ms,
+                                   trending_visit_fn_t visit, void* context)
+{
+    const trending_block_header_t* header = (const trending_block_header_t*)block;
+    trending_bit_reader_t reader = { block + sizeof(trending_block_header_t), 0, header->used_bits };
+
+    int64_t time_ms = header->first_ms;
+    int64_t delta = 0;
+    uint32_t bits;
+    memcpy(&bits, &header->first_value, sizeof(bits));
+    int leading = 0;
+    int trailing = 0;
+
+    for (int i = 0; i < header->count; i++) {
+        if (i > 0) {
+            if (trending_get_bits(&reader, 1) == 0) {
+                // Same delta
+            } else if (trending_get_bits(&reader, 1) == 0) {
+                delta += trending_sign_extend(trending_get_bits(&reader, 7), 7);
+            } else if (trending_get_bits(&reader, 1) == 0) {
+                delta += trending_sign_extend(trending_get_bits(&reader, 9), 9);
+            } else if (trending_get_bits(&reader, 1) == 0) {
+                delta += trending_sign_extend(trending_get_bits(&reader, 12), 12);
+            } else {
+                delta = (int64_t)trending_get_bits(&reader, 32);
+            }
+            time_ms += delta;
+
+            if (trending_get_bits(&reader, 1) != 0) {
+                if (trending_get_bits(&reader, 1) != 0) {
+                    leading = (int)trending_get_bits(&reader, 5);
+                    int length = (int)trending_get_bits(&reader, 5) + 1;
+                    trailing = 32 - leading - length;
+                }
+                bits ^= (uint32_t)trending_get_bits(&reader, 32 - leading - trailing) << trailing;
+            }
+        }
+
+        if (time_ms > to_ms) {
+            return true;
+        }
+        if (time_ms >= from_ms) {
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            if (!visit(time_ms, value, context)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode a copied binary block, visiting state records in [from_ms, to_ms]
+ *
+ * The state in effect at from_ms is carried in *state / *state_known and
+ * visited at from_ms before the first record inside the range.
+ *
+ * @return bool False if the visitor stopped the query
+ */
+static bool trending_decode_binary(const uint8_t* block, int64_t from_ms, int64_t to_ms,
+                                   bool* state, bool* state_known, trending_visit_fn_t visit, void* context)
+{
+    const trending_block_header_t* header = (const trending_block_header_t*)block;
+    trending_bit_reader_t reader = { block + sizeof(trending_block_header_t), 0, header->used_bits };
+
+    int64_t time_ms = header->first_ms;
+    bool current = header->first_value != 0.0f;
+
+    for (int i = 0; i < header->count; i++) {
+        if (i > 0) {
+            uint64_t run_ms = 0;
+            int shift = 0;
+            uint8_t byte;
+            do {
+                byte = (uint8_t)trending_get_bits(&reader, 8);
+                if (shift < 64) {
+                    run_ms |= (uint64_t)(byte & 0x7F) << shift;
+                }
+                shift += 7;
+            } while ((byte & 0x80) && reader.position < reader.end);
+            time_ms += (int64_t)run_ms;
+            current = !current;
+        }
+
+        if (time_ms > to_ms) {
+            return true;
+        }
+        if (time_ms <= from_ms) {
+            *state = current;
+            *state_known = true;
+            if (time_ms < from_ms) {
+                continue;
+            }
+        } else if (*state_known) {
+            // Range starts within a run
+            *state_known = false;
+            if (!visit(from_ms, *state ? 1.0f : 0.0f, context)) {
+                return false;
+            }
+        }
+        *state_known = false;
+        if (!visit(time_ms, current ? 1.0f : 0.0f, context)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t trending_manager_query(trending_manager_t* manager, const char* point_id, int64_t from_ms,
+                                 int64_t to_ms, trending_visit_fn_t visit, void* context)
+{
+    if (!manager || !manager->initialized || !point_id || !visit) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Block copy, aligned for its header
+    uint64_t block_storage[TRENDING_BLOCK_BYTES / sizeof(uint64_t)];
+    uint8_t* block = (uint8_t*)block_storage;
+
+    portENTER_CRITICAL(&manager->lock);
+    int index = trending_find_series(manager, point_id);
+    uint32_t generation = manager->generation;
+    trending_series_t series = {0};
+    if (index >= 0) {
+        series = manager->series[index];
+    }
+    portEXIT_CRITICAL(&manager->lock);
+
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    bool state = false;
+    bool state_known = false;
+    for (uint32_t sequence = series.first_sequence; sequence != series.next_sequence; sequence++) {
+        // Copy the block out if it is still held and may overlap the range
+        bool copied = false;
+        bool past_range = false;
+        portENTER_CRITICAL(&manager->lock);
+        if (manager->generation == generation) {
+            const trending_series_t* current = &manager->series[index];
+            if (sequence - current->first_sequence < current->next_sequence - current->first_sequence) {
+                const trending_block_header_t* header =
+                    (const trending_block_header_t*)trending_block(manager, current, sequence);
+                if (header->first_ms > to_ms) {
+                    past_range = true;
+                } else if (header->last_ms >= from_ms || series.kind == TRENDING_KIND_BINARY) {
+                    memcpy(block, header, trending_block_used_bytes(header));
+                    copied = true;
+                }
+            }
+        }
+        portEXIT_CRITICAL(&manager->lock);
+
+        if (past_range) {
+            break;
+        }
+        if (!copied) {
+            continue;
+        }
+
+        const trending_block_header_t* header = (const trending_block_header_t*)block;
+        bool more;
+        if (series.kind == TRENDING_KIND_ANALOG) {
+            more = trending_decode_analog(block, from_ms, to_ms, visit, context);
+        } else if (header->last_ms < from_ms) {
+            // Only the state at the end of the block matters: it toggles per record
+            state = (header->first_value != 0.0f) != ((header->count - 1) & 1);
+            state_known = true;
+            more = true;
+        } else {
+            more = trending_decode_binary(block, from_ms, to_ms, &state, &state_known, visit, context);
+        }
+        if (!more) {
+            break;
+        }
+    }
+
+    // Range entirely within the last run
+    if (state_known && from_ms <= to_ms) {
+        visit(from_ms, state ? 1.0f : 0.0f, context);
+    }
+
+    return ESP_OK;
+}
+
+trending_tier_t trending_manager_select_tier(uint32_t resolution_ms)
+{
+    for (int tier = TRENDING_TIER_COUNT - 1; tier > TRENDING_TIER_RAW; tier--) {
+        if (trending_tier_ms[tier] <= resolution_ms) {
+            return (trending_tier_t)tier;
+        }
+    }
+    return TRENDING_TIER_RAW;
+}
+
+uint32_t trending_manager_tier_duration_ms(trending_tier_t tier)
+{
+    if (tier < TRENDING_TIER_RAW || tier >= TRENDING_TIER_COUNT) {
+        return 0;
+    }
+    return trending_tier_ms[tier];
+}
+
+/**
+ * @brief Raw query visitor: pass a sample on as a bucket of one
+ */
+static bool trending_raw_bucket_visit(int64_t time_ms, float value, void* context)
+{
+    const trending_raw_adapter_t* adapter = (const trending_raw_adapter_t*)context;
+    trending_bucket_t bucket = { time_ms, 0, 1, value, value, value };
+    return adapter->visit(&bucket, adapter->context);
+}
+
+esp_err_t trending_manager_query_resolution(trending_manager_t* manager, const char* point_id,
+                                            int64_t from_ms, int64_t to_ms, uint32_t resolution_ms,
+                                            trending_bucket_fn_t visit, void* context, trending_tier_t* tier)
+{
+    if (!manager || !manager->initialized || !point_id || !visit) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    trending_tier_t selected = trending_manager_select_tier(resolution_ms);
+    if (tier) {
+        *tier = selected;
+    }
+    if (selected == TRENDING_TIER_RAW) {
+        trending_raw_adapter_t adapter = { visit, context };
+        return trending_manager_query(manager, point_id, from_ms, to_ms, trending_raw_bucket_visit, &adapter);
+    }
+
+    int rollup = selected - 1;
+    uint32_t duration_ms = trending_tier_ms[selected];
+
+    // Find the first bucket ending after from_ms
+    portENTER_CRITICAL(&manager->lock);
+    int index = trending_find_series(manager, point_id);
+    uint32_t generation = manager->generation;
+    uint32_t sequence = 0;
+    if (index >= 0) {
+        const trending_series_t* series = &manager->series[index];
+        uint32_t capacity = series->rollup_capacity[rollup];
+        uint32_t next = series->rollup_next[rollup];
+        uint32_t low = (next > capacity) ? next - capacity : 0;
+        uint32_t high = next;
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            const trending_rollup_t* record = &manager->rollups[series->rollup_first[rollup] + middle % capacity];
+            if ((int64_t)record->start_s * 1000 + duration_ms <= from_ms) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        sequence = low;
+    }
+    portEXIT_CRITICAL(&manager->lock);
+
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    for (;;) {
+        // Copy a chunk of closed buckets; once caught up, the open bucket too
+        trending_rollup_t chunk[TRENDING_QUERY_CHUNK];
+        int chunk_count = 0;
+        bool caught_up = false;
+        trending_open_bucket_t partial[TRENDING_ROLLUP_TIERS];
+        int partial_count = 0;
+        portENTER_CRITICAL(&manager->lock);
+        bool stale = manager->generation != generation;
+        if (!stale) {
+            const trending_series_t* series = &manager->series[index];
+            uint32_t capacity = series->rollup_capacity[rollup];
+            uint32_t next = series->rollup_next[rollup];
+            uint32_t oldest = (next > capacity) ? next - capacity : 0;
+            if (sequence < oldest) {
+                sequence = oldest;
+            }
+            while (chunk_count < TRENDING_QUERY_CHUNK && sequence != next) {
+                chunk[chunk_count++] = manager->rollups[series->rollup_first[rollup] + sequence % capacity];
+                sequence++;
+            }
+            if (sequence == next) {
+                caught_up = true;
+                partial_count = trending_rollup_partial(series, rollup, partial);
+            }
+        }
+        portEXIT_CRITICAL(&manager->lock);
+
+        if (stale) {
+            break;
+        }
+        for (int i = 0; i < chunk_count; i++) {
+            trending_bucket_t bucket = { (int64_t)chunk[i].start_s * 1000, duration_ms, chunk[i].count,
+                                         chunk[i].min, chunk[i].max, chunk[i].mean };
+            if (bucket.start_ms > to_ms || !visit(&bucket, context)) {
+                return ESP_OK;
+            }
+        }
+        if (caught_up) {
+            for (int i = 0; i < partial_count; i++) {
+                if (partial[i].start_ms > to_ms) {
+                    break;
+                }
+                if (partial[i].start_ms + duration_ms <= from_ms) {
+                    continue;
+                }
+                trending_bucket_t bucket = { partial[i].start_ms, duration_ms, partial[i].count,
+                                             partial[i].min, partial[i].max, partial[i].sum / partial[i].count };
+                if (!visit(&bucket, context)) {
+                    break;
+                }
+            }
+            break;
+        }
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Find the series of a point (caller holds the lock or owns the table)
+ */
+static int trending_find_series(trending_manager_t* manager, const char* point_id)
+{
+    if (manager->series_count == 0) {
+        return -1;
+    }
+    return point_id_index_find(&manager->id_index, manager->point_ids[0], CONFIG_MAX_ID_LENGTH, point_id);
+}
+
+/**
+ * @brief Kind of a trended point: counter-mode inputs carry a rate, not a state
+ */
+static trending_kind_t trending_point_kind(const io_point_config_t* point)
+{
+    if (point->type == IO_POINT_TYPE_GPIO_AI ||
+        (point->type == IO_POINT_TYPE_GPIO_BI && point->input_mode == IO_INPUT_MODE_COUNTER)) {
+        return TRENDING_KIND_ANALOG;
+    }
+    return TRENDING_KIND_BINARY;
+}
+
+/**
+ * @brief Share the pool out as rings: TRENDING_ANALOG_WEIGHT blocks per analog point for each binary one,
+ *        and an equal share of rollup records per point
+ */
+static void trending_layout(trending_series_t* series, int count, uint32_t pool_blocks, uint32_t rollup_records)
+{
+    uint32_t target = 0;
+    for (int tier = 0; tier < TRENDING_ROLLUP_TIERS; tier++) {
+        target += trending_rollup_target[tier];
+    }
+    uint32_t rollup_share = (count > 0) ? rollup_records / count : 0;
+
+    uint32_t weight = 0;
+    for (int i = 0; i < count; i++) {
+        weight += (series[i].kind == TRENDING_KIND_ANALOG) ? TRENDING_ANALOG_WEIGHT : 1;
+    }
+    uint32_t unit = (weight > 0) ? pool_blocks / weight : 0;
+    if (unit > UINT16_MAX / TRENDING_ANALOG_WEIGHT) {
+        unit = UINT16_MAX / TRENDING_ANALOG_WEIGHT;
+    }
+
+    uint32_t first_block = 0;
+    uint32_t first_record = 0;
+    for (int i = 0; i < count; i++) {
+        trending_kind_t kind = (trending_kind_t)series[i].kind;
+        uint32_t interval_ms = series[i].interval_ms;
+        memset(&series[i], 0, sizeof(trending_series_t));
+        series[i].kind = kind;
+        series[i].interval_ms = interval_ms;
+        series[i].first_block = first_block;
+        series[i].block_count = (uint16_t)(unit * ((kind == TRENDING_KIND_ANALOG) ? TRENDING_ANALOG_WEIGHT : 1));
+        series[i].previous_leading = 0xFF;
+        first_block += series[i].block_count;
+        for (int tier = 0; tier < TRENDING_ROLLUP_TIERS; tier++) {
+            series[i].rollup_first[tier] = first_record;
+            series[i].rollup_capacity[tier] = (uint32_t)((uint64_t)rollup_share * trending_rollup_target[tier] / target);
+            first_record += series[i].rollup_capacity[tier];
+        }
+    }
+}
+
+/**
+ * @brief Build the series table from the configuration, keeping history if the trended set is unchanged
+ */
+static esp_err_t trending_build_series(trending_manager_t* manager)
+{
+    io_point_config_t* point = psram_smart_malloc(sizeof(io_point_config_t), ALLOC_LARGE_BUFFER);
+    if (!point) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Every ring needs TRENDING_MIN_BLOCKS blocks per unit of weight
+    uint32_t weight_budget = manager->pool_blocks / TRENDING_MIN_BLOCKS;
+    int config_count = config_manager_get_io_point_count(manager->config_manager);
+    int trended_count = 0;
+    uint32_t weight = 0;
+    for (int i = 0; i < config_count; i++) {
+        if (config_manager_get_io_point_config_by_index(manager->config_manager, i, point) != ESP_OK ||
+            !point->trend_config.enabled) {
+            continue;
+        }
+        uint32_t point_weight = (trending_point_kind(point) == TRENDING_KIND_ANALOG) ? TRENDING_ANALOG_WEIGHT : 1;
+        if (weight + point_weight > weight_budget) {
+#ifdef DEBUG_TRENDING_SYSTEM
+            printf("[%s] Trend pool full, point '%s' is not trended\n", TAG, point->id);
+#endif
+            continue;
+        }
+        weight += point_weight;
+        trended_count++;
+    }
+
+    trending_series_t* series = NULL;
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH] = NULL;
+    point_id_index_t id_index = {0};
+    if (trended_count > 0) {
+        // Encoder state is touched on every scan pass; IDs only on lookups
+        series = psram_smart_malloc(trended_count * sizeof(trending_series_t), ALLOC_CRITICAL);
+        point_ids = psram_smart_malloc(trended_count * CONFIG_MAX_ID_LENGTH, ALLOC_LARGE_BUFFER);
+        if (!series || !point_ids) {
+#ifdef DEBUG_TRENDING_SYSTEM
+            printf("[%s] No memory for %d trended points\n", TAG, trended_count);
+#endif
+            psram_smart_free(point);
+            psram_smart_free(series);
+            psram_smart_free(point_ids);
+            return ESP_ERR_NO_MEM;
+        }
+        memset(series, 0, trended_count * sizeof(trending_series_t));
+    }
+
+    int count = 0;
+    weight = 0;
+    for (int i = 0; i < config_count && count < trended_count; i++) {
+        if (config_manager_get_io_point_config_by_index(manager->config_manager, i, point) != ESP_OK ||
+            !point->trend_config.enabled) {
+            continue;
+        }
+        trending_kind_t kind = trending_point_kind(point);
+        uint32_t point_weight = (kind == TRENDING_KIND_ANALOG) ? TRENDING_ANALOG_WEIGHT : 1;
+        if (weight + point_weight > weight_budget) {
+            continue;
+        }
+        weight += point_weight;
+
+        uint32_t interval_s = point->trend_config.sample_interval_s;
+        if (interval_s < TRENDING_MIN_INTERVAL_S) {
+            interval_s = TRENDING_MIN_INTERVAL_S;
+        } else if (interval_s > TRENDING_MAX_INTERVAL_S) {
+            interval_s = TRENDING_MAX_INTERVAL_S;
+        }
+
+        strncpy(point_ids[count], point->id, CONFIG_MAX_ID_LENGTH - 1);
+        point_ids[count][CONFIG_MAX_ID_LENGTH - 1] = '\0';
+        series[count].kind = (uint8_t)kind;
+        series[count].interval_ms = interval_s * 1000;
+        count++;
+    }
+    psram_smart_free(point);
+
+    // Same points, kinds and intervals: the rings and their history stay as they are
+    bool unchanged = (count == manager->series_count);
+    for (int i = 0; unchanged && i < count; i++) {
+        unchanged = strcmp(point_ids[i], manager->point_ids[i]) == 0 &&
+                    series[i].kind == manager->series[i].kind &&
+                    series[i].interval_ms == manager->series[i].interval_ms;
+    }
+    if (unchanged && manager->series) {
+        psram_smart_free(series);
+        psram_smart_free(point_ids);
+        return ESP_OK;
+    }
+
+    trending_layout(series, count, manager->pool_blocks, manager->rollup_records);
+    if (count > 0) {
+        point_id_index_build(&id_index, point_ids[0], CONFIG_MAX_ID_LENGTH, count);
+    }
+
+    portENTER_CRITICAL(&manager->lock);
+    trending_series_t* old_series = manager->series;
+    char (*old_point_ids)[CONFIG_MAX_ID_LENGTH] = manager->point_ids;
+    point_id_index_t old_index = manager->id_index;
+    manager->series = series;
+    manager->point_ids = point_ids;
+    manager->id_index = id_index;
+    manager->series_count = count;
+    manager->generation++;
+    portEXIT_CRITICAL(&manager->lock);
+
+    psram_smart_free(old_series);
+    psram_smart_free(old_point_ids);
+    point_id_index_release(&old_index);
+
+#ifdef DEBUG_TRENDING_SYSTEM
+    if (count > 0) {
+        printf("[%s] Trend rings laid out: %d points, %lu of %lu blocks, history cleared\n",
+               TAG, count, (unsigned long)(series[count - 1].first_block + series[count - 1].block_count),
+               (unsigned long)manager->pool_blocks);
+    }
+#endif
+
+    return ESP_OK;
+}
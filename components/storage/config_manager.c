@@ -5,14 +5,22 @@
 
 #include "config_manager.h"
 #include "storage_manager.h"
+#include "psram_manager.h"
+#include "config_stream.h"
 #include "debug_config.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_crc.h"
 #include "cJSON.h"
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 static const char* TAG = DEBUG_CONFIG_MANAGER_TAG;
 
+#define CONFIG_IO_POINT_GROWTH 16   ///< First point table size when the count is not known up front
+
 /**
  * @brief Convert string to IO point type
  */
@@ -42,241 +50,1233 @@ static bo_type_t string_to_bo_type(const char* str) {
  */
 static signal_filter_type_t string_to_filter_type(const char* str) {
     if (strcmp(str, "SMA") == 0) return SIGNAL_FILTER_SMA;
+    if (strcmp(str, "EMA") == 0) return SIGNAL_FILTER_EMA;
+    if (strcmp(str, "MEDIAN") == 0) return SIGNAL_FILTER_MEDIAN;
+    if (strcmp(str, "HAMPEL") == 0) return SIGNAL_FILTER_HAMPEL;
+    if (strcmp(str, "BIQUAD") == 0) return SIGNAL_FILTER_BIQUAD;
     return SIGNAL_FILTER_NONE; // Default
 }
 
 /**
- * @brief Parse shift register configuration from JSON
+ * @brief Convert string to scan class
  */
-static esp_err_t parse_shift_register_config(cJSON* json, shift_register_config_t* config) {
-    cJSON* sr_config = cJSON_GetObjectItem(json, "shiftRegisterConfig");
-    if (!sr_config) {
-        return ESP_ERR_NOT_FOUND;
+static io_scan_class_t string_to_scan_class(const char* str) {
+    if (strcmp(str, "FAST") == 0) return IO_SCAN_CLASS_FAST;
+    if (strcmp(str, "SLOW") == 0) return IO_SCAN_CLASS_SLOW;
+    return IO_SCAN_CLASS_NORMAL; // Default
+}
+
+/**
+ * @brief Convert string to binary input mode
+ */
+static io_input_mode_t string_to_input_mode(const char* str) {
+    if (strcmp(str, "EDGE") == 0) return IO_INPUT_MODE_EDGE;
+    if (strcmp(str, "COUNTER") == 0) return IO_INPUT_MODE_COUNTER;
+    return IO_INPUT_MODE_POLLED; // Default
+}
+
+/**
+ * @brief Read a number as int, or fallback if the value is not a number
+ */
+static int value_int(const config_value_t* value, int fallback) {
+    return value->type == CONFIG_VALUE_NUMBER ? (int)value->number : fallback;
+}
+
+/**
+ * @brief Read a number as float, or fallback if the value is not a number
+ */
+static float value_float(const config_value_t* value, float fallback) {
+    return value->type == CONFIG_VALUE_NUMBER ? (float)value->number : fallback;
+}
+
+/**
+ * @brief Read a boolean (anything but true is false)
+ */
+static bool value_bool(const config_value_t* value) {
+    return value->type == CONFIG_VALUE_BOOL && value->boolean;
+}
+
+/**
+ * @brief Read a string, or NULL if the value is not a string
+ */
+static const char* value_string(const config_value_t* value) {
+    return value->type == CONFIG_VALUE_STRING ? value->string : NULL;
+}
+
+/**
+ * @brief Copy a string value into a fixed-size field
+ */
+static void copy_string(char* dest, size_t dest_size, const config_value_t* value) {
+    const char* str = value_string(value);
+    if (str) {
+        strncpy(dest, str, dest_size - 1);
+        dest[dest_size - 1] = '\0';
+    }
+}
+
+/**
+ * @brief Convert a cJSON item to a scalar value
+ */
+static void cjson_to_value(const cJSON* item, config_value_t* value) {
+    memset(value, 0, sizeof(config_value_t));
+    
+    if (cJSON_IsBool(item)) {
+        value->type = CONFIG_VALUE_BOOL;
+        value->boolean = cJSON_IsTrue(item);
+    } else if (cJSON_IsNumber(item)) {
+        value->type = CONFIG_VALUE_NUMBER;
+        value->number = item->valuedouble;
+    } else if (cJSON_IsString(item)) {
+        value->type = CONFIG_VALUE_STRING;
+        value->string = item->valuestring;
+    } else if (cJSON_IsObject(item)) {
+        value->type = CONFIG_VALUE_OBJECT;
+    } else if (cJSON_IsArray(item)) {
+        value->type = CONFIG_VALUE_ARRAY;
+    }
+}
+
+/*
+ * Field setters
+ * 
+ * Each configuration section has a defaults function and a setter that
+ * applies one scalar JSON member. Both the DOM and the streaming loaders
+ * drive the same setters, so key names, defaults and clamping live in one
+ * place.
+ */
+
+static void scan_class_defaults(scan_class_config_t* config) {
+    config->fast_interval_ms = CONFIG_DEFAULT_FAST_SCAN_INTERVAL_MS;
+    config->slow_interval_ms = CONFIG_DEFAULT_SLOW_SCAN_INTERVAL_MS;
+}
+
+static void set_scan_class_field(scan_class_config_t* config, const char* key, const config_value_t* value) {
+    int interval_ms = value_int(value, 0);
+    if (interval_ms <= 0) {
+        return;
     }
     
-    cJSON* item;
+    if (strcmp(key, "fastIntervalMs") == 0) config->fast_interval_ms = (uint32_t)interval_ms;
+    else if (strcmp(key, "slowIntervalMs") == 0) config->slow_interval_ms = (uint32_t)interval_ms;
+}
+
+static void adc_defaults(adc_acquisition_config_t* config) {
+    config->mode = ADC_ACQUISITION_ONESHOT;
+    config->oversample = 16;
+    config->sample_freq_hz = 20000;
+}
+
+static void set_adc_field(adc_acquisition_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "mode") == 0) {
+        const char* mode = value_string(value);
+        if (mode && strcmp(mode, "CONTINUOUS") == 0) {
+            config->mode = ADC_ACQUISITION_CONTINUOUS;
+        }
+    } else if (strcmp(key, "oversample") == 0) {
+        config->oversample = value_int(value, config->oversample);
+    } else if (strcmp(key, "sampleFreqHz") == 0) {
+        int freq = value_int(value, 0);
+        if (freq > 0) {
+            config->sample_freq_hz = (uint32_t)freq;
+        }
+    }
+}
+
+static void shift_register_defaults(shift_register_config_t* config) {
+    config->output_clock_pin = -1;
+    config->output_latch_pin = -1;
+    config->output_data_pin = -1;
+    config->output_enable_pin = -1;
+    config->input_clock_pin = -1;
+    config->input_load_pin = -1;
+    config->input_data_pin = -1;
+    config->num_output_registers = 0;
+    config->num_input_registers = 0;
+    config->backend = SHIFT_REGISTER_BACKEND_GPIO;
+    config->spi_host = 2;
+    config->spi_clock_hz = CONFIG_DEFAULT_SHIFT_REGISTER_SPI_CLOCK_HZ;
+}
+
+static void set_shift_register_field(shift_register_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "outputClockPin") == 0) config->output_clock_pin = value_int(value, -1);
+    else if (strcmp(key, "outputLatchPin") == 0) config->output_latch_pin = value_int(value, -1);
+    else if (strcmp(key, "outputDataPin") == 0) config->output_data_pin = value_int(value, -1);
+    else if (strcmp(key, "outputEnablePin") == 0) config->output_enable_pin = value_int(value, -1);
+    else if (strcmp(key, "inputClockPin") == 0) config->input_clock_pin = value_int(value, -1);
+    else if (strcmp(key, "inputLoadPin") == 0) config->input_load_pin = value_int(value, -1);
+    else if (strcmp(key, "inputDataPin") == 0) config->input_data_pin = value_int(value, -1);
+    else if (strcmp(key, "numOutputRegisters") == 0) config->num_output_registers = value_int(value, 0);
+    else if (strcmp(key, "numInputRegisters") == 0) config->num_input_registers = value_int(value, 0);
+    else if (strcmp(key, "backend") == 0) {
+        const char* backend = value_string(value);
+        config->backend = (backend && strcmp(backend, "SPI") == 0) ? 
+                          SHIFT_REGISTER_BACKEND_SPI : SHIFT_REGISTER_BACKEND_GPIO;
+    }
+    else if (strcmp(key, "spiHost") == 0) config->spi_host = value_int(value, 2);
+    else if (strcmp(key, "spiClockHz") == 0) {
+        int clock_hz = value_int(value, 0);
+        config->spi_clock_hz = clock_hz > 0 ? clock_hz : CONFIG_DEFAULT_SHIFT_REGISTER_SPI_CLOCK_HZ;
+    }
+}
+
+static void signal_defaults(signal_config_t* config) {
+    config->enabled = false;
+    config->filter_type = SIGNAL_FILTER_NONE;
+    config->gain = 1.0f;
+    config->offset = 0.0f;
+    config->scaling_factor = 1.0f;
+    config->sma_window_size = 5;
+    config->ema_alpha = CONFIG_DEFAULT_EMA_ALPHA;
+    config->median_window_size = CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE;
+    config->hampel_threshold = CONFIG_DEFAULT_HAMPEL_THRESHOLD;
+    // Biquad defaults to pass-through unless all five coefficients are given
+    memset(config->biquad_coefficients, 0, sizeof(config->biquad_coefficients));
+    config->biquad_coefficients[0] = 1.0f;
+    config->precision_digits = 2;
+    config->units[0] = '\0';
+    config->history_buffer_size = 100;
+    config->lookup_table_enabled = false;
+    config->lookup_table = NULL;
+    config->lookup_table_count = 0;
+    config->deadband = 0.0f;
+    config->cov_heartbeat_ms = 0;
+}
+
+static void set_signal_field(signal_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "enabled") == 0) config->enabled = value_bool(value);
+    else if (strcmp(key, "filterType") == 0) {
+        const char* filter = value_string(value);
+        config->filter_type = filter ? string_to_filter_type(filter) : SIGNAL_FILTER_NONE;
+    }
+    else if (strcmp(key, "gain") == 0) config->gain = value_float(value, 1.0f);
+    else if (strcmp(key, "offset") == 0) config->offset = value_float(value, 0.0f);
+    else if (strcmp(key, "scalingFactor") == 0) config->scaling_factor = value_float(value, 1.0f);
+    else if (strcmp(key, "smaWindowSize") == 0) config->sma_window_size = value_int(value, 5);
+    else if (strcmp(key, "emaAlpha") == 0) config->ema_alpha = value_float(value, CONFIG_DEFAULT_EMA_ALPHA);
+    else if (strcmp(key, "medianWindowSize") == 0) config->median_window_size = value_int(value, CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE);
+    else if (strcmp(key, "hampelThreshold") == 0) config->hampel_threshold = value_float(value, CONFIG_DEFAULT_HAMPEL_THRESHOLD);
+    else if (strcmp(key, "precisionDigits") == 0) config->precision_digits = value_int(value, 2);
+    else if (strcmp(key, "units") == 0) copy_string(config->units, CONFIG_MAX_UNITS_LENGTH, value);
+    else if (strcmp(key, "historyBufferSize") == 0) config->history_buffer_size = value_int(value, 100);
+    else if (strcmp(key, "lookupTableEnabled") == 0) config->lookup_table_enabled = value_bool(value);
+    else if (strcmp(key, "deadband") == 0) {
+        float deadband = value_float(value, 0.0f);
+        config->deadband = deadband > 0 ? deadband : 0.0f;
+    }
+    else if (strcmp(key, "covHeartbeatMs") == 0) {
+        int heartbeat_ms = value_int(value, 0);
+        config->cov_heartbeat_ms = heartbeat_ms > 0 ? (uint32_t)heartbeat_ms : 0;
+    }
+}
+
+/**
+ * @brief Apply biquad coefficients collected from a JSON array
+ */
+static void set_biquad_coefficients(signal_config_t* config, const float* coefficients, int count) {
+    if (count != 5) {
+        ESP_LOGW(TAG, "biquadCoefficients ignored: expected [b0, b1, b2, a1, a2]");
+        return;
+    }
+    memcpy(config->biquad_coefficients, coefficients, sizeof(config->biquad_coefficients));
+}
+
+static void alarm_defaults(alarm_config_t* config) {
+    config->enabled = false;
+    config->history_samples_for_analysis = 20;
+    config->interlock_count = 0;
+}
+
+static void set_alarm_field(alarm_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "enabled") == 0) config->enabled = value_bool(value);
+    else if (strcmp(key, "historySamplesForAnalysis") == 0) config->history_samples_for_analysis = value_int(value, 20);
+}
+
+/**
+ * @brief Convert string to interlock alarm type bits
+ */
+static uint32_t string_to_interlock_mask(const char* str) {
+    if (strcmp(str, "RATE_OF_CHANGE") == 0) return CONFIG_INTERLOCK_RATE_OF_CHANGE;
+    if (strcmp(str, "DISCONNECTED") == 0) return CONFIG_INTERLOCK_DISCONNECTED;
+    if (strcmp(str, "MAX_VALUE") == 0) return CONFIG_INTERLOCK_MAX_VALUE;
+    if (strcmp(str, "STUCK_SIGNAL") == 0) return CONFIG_INTERLOCK_STUCK_SIGNAL;
+    if (strcmp(str, "NOISE_BAND") == 0) return CONFIG_INTERLOCK_NOISE_BAND;
+    return CONFIG_INTERLOCK_ANY; // Default
+}
+
+static void interlock_defaults(interlock_config_t* config) {
+    memset(config, 0, sizeof(interlock_config_t));
+    config->alarm_mask = CONFIG_INTERLOCK_ANY;
+}
+
+static void set_interlock_field(interlock_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "outputPointId") == 0) copy_string(config->output_point_id, CONFIG_MAX_ID_LENGTH, value);
+    else if (strcmp(key, "alarmType") == 0) {
+        const char* type = value_string(value);
+        config->alarm_mask = type ? string_to_interlock_mask(type) : CONFIG_INTERLOCK_ANY;
+    }
+    else if (strcmp(key, "forcedState") == 0) config->forced_state = value_bool(value);
+}
+
+/**
+ * @brief Keep a parsed interlock if it names an output and there is room
+ */
+static void add_interlock(alarm_config_t* config, const interlock_config_t* interlock) {
+    if (interlock->output_point_id[0] == '\0') {
+        ESP_LOGW(TAG, "Interlock ignored: missing outputPointId");
+    } else if (config->interlock_count >= CONFIG_MAX_POINT_INTERLOCKS) {
+        ESP_LOGW(TAG, "Interlock on '%s' ignored: more than %d per point", 
+                 interlock->output_point_id, CONFIG_MAX_POINT_INTERLOCKS);
+    } else {
+        config->interlocks[config->interlock_count++] = *interlock;
+    }
+}
+
+static void trend_defaults(trend_config_t* config) {
+    config->enabled = false;
+    config->sample_interval_s = CONFIG_DEFAULT_TREND_INTERVAL_S;
+}
+
+static void set_trend_field(trend_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "enabled") == 0) config->enabled = value_bool(value);
+    else if (strcmp(key, "sampleIntervalSeconds") == 0) {
+        int interval = value_int(value, CONFIG_DEFAULT_TREND_INTERVAL_S);
+        config->sample_interval_s = interval > 0 ? (uint32_t)interval : CONFIG_DEFAULT_TREND_INTERVAL_S;
+    }
+}
+
+static void alarm_rule_defaults(alarm_rules_t* rules) {
+    memset(rules, 0, sizeof(alarm_rules_t));
+    rules->rate_of_change_threshold = 50.0f;
+    rules->disconnected_threshold = 0.5f;
+    rules->max_value_threshold = 4090.0f;
+    rules->stuck_signal_window_samples = 10;
+    rules->stuck_signal_delta_threshold = 1.0f;
+    rules->noise_band_threshold = 10.0f;
+    rules->alarm_persistence_samples = 1;
+    rules->alarm_clear_hysteresis_value = 5.0f;
+    rules->samples_to_clear_alarm_condition = 3;
+    rules->consecutive_good_samples_to_restore_trust = 5;
+}
+
+static void set_alarm_rule_field(alarm_rules_t* r, const char* key, const config_value_t* value) {
+    if (strcmp(key, "checkRateOfChange") == 0) r->check_rate_of_change = value_bool(value);
+    else if (strcmp(key, "rateOfChangeThreshold") == 0) r->rate_of_change_threshold = value_float(value, 50.0f);
+    else if (strcmp(key, "checkDisconnected") == 0) r->check_disconnected = value_bool(value);
+    else if (strcmp(key, "disconnectedThreshold") == 0) r->disconnected_threshold = value_float(value, 0.5f);
+    else if (strcmp(key, "checkMaxValue") == 0) r->check_max_value = value_bool(value);
+    else if (strcmp(key, "maxValueThreshold") == 0) r->max_value_threshold = value_float(value, 4090.0f);
+    else if (strcmp(key, "checkStuckSignal") == 0) r->check_stuck_signal = value_bool(value);
+    else if (strcmp(key, "stuckSignalWindowSamples") == 0) r->stuck_signal_window_samples = value_int(value, 10);
+    else if (strcmp(key, "stuckSignalDeltaThreshold") == 0) r->stuck_signal_delta_threshold = value_float(value, 1.0f);
+    else if (strcmp(key, "checkNoiseBand") == 0) r->check_noise_band = value_bool(value);
+    else if (strcmp(key, "noiseBandThreshold") == 0) r->noise_band_threshold = value_float(value, 10.0f);
+    else if (strcmp(key, "alarmPersistenceSamples") == 0) r->alarm_persistence_samples = value_int(value, 1);
+    else if (strcmp(key, "alarmClearHysteresisValue") == 0) r->alarm_clear_hysteresis_value = value_float(value, 5.0f);
+    else if (strcmp(key, "requiresManualReset") == 0) r->requires_manual_reset = value_bool(value);
+    else if (strcmp(key, "samplesToClearAlarmCondition") == 0) r->samples_to_clear_alarm_condition = value_int(value, 3);
+    else if (strcmp(key, "consecutiveGoodSamplesToRestoreTrust") == 0) r->consecutive_good_samples_to_restore_trust = value_int(value, 5);
+}
+
+static void io_point_defaults(io_point_config_t* config) {
+    memset(config, 0, sizeof(io_point_config_t));
+    config->pin = -1;
+    config->scan_class = IO_SCAN_CLASS_NORMAL;
+    config->range_max = 100.0f;
+    config->pulses_per_unit = 1.0f;
+    config->rate_time_base_s = CONFIG_DEFAULT_RATE_TIME_BASE_S;
+    config->bo_type = BO_TYPE_GENERIC;
+    config->enable_schedule_execution = true;
+    config->allow_manual_override = true;
+    config->manual_override_timeout = 3600;
+    trend_defaults(&config->trend_config);
+}
+
+/**
+ * @brief Apply one scalar IO point member
+ * 
+ * @return bool True if the member was the required "type" field
+ */
+static bool set_io_point_field(io_point_config_t* config, const char* key, const config_value_t* value) {
+    if (strcmp(key, "id") == 0) copy_string(config->id, CONFIG_MAX_ID_LENGTH, value);
+    else if (strcmp(key, "type") == 0) {
+        const char* type = value_string(value);
+        if (type) {
+            config->type = string_to_io_point_type(type);
+            return true;
+        }
+    }
+    else if (strcmp(key, "name") == 0) copy_string(config->name, CONFIG_MAX_NAME_LENGTH, value);
+    else if (strcmp(key, "description") == 0) copy_string(config->description, CONFIG_MAX_DESCRIPTION_LENGTH, value);
+    else if (strcmp(key, "pin") == 0) config->pin = value_int(value, -1);
+    else if (strcmp(key, "chipIndex") == 0) config->chip_index = value_int(value, 0);
+    else if (strcmp(key, "bitIndex") == 0) config->bit_index = value_int(value, 0);
+    else if (strcmp(key, "isInverted") == 0) config->is_inverted = value_bool(value);
+    else if (strcmp(key, "scanClass") == 0) {
+        const char* scan_class = value_string(value);
+        config->scan_class = scan_class ? string_to_scan_class(scan_class) : IO_SCAN_CLASS_NORMAL;
+    }
+    else if (strcmp(key, "rangeMin") == 0) config->range_min = value_float(value, 0.0f);
+    else if (strcmp(key, "rangeMax") == 0) config->range_max = value_float(value, 100.0f);
+    else if (strcmp(key, "inputMode") == 0) {
+        const char* input_mode = value_string(value);
+        config->input_mode = input_mode ? string_to_input_mode(input_mode) : IO_INPUT_MODE_POLLED;
+    }
+    else if (strcmp(key, "debounceUs") == 0) config->debounce_us = (uint32_t)value_int(value, 0);
+    else if (strcmp(key, "pulsesPerUnit") == 0) config->pulses_per_unit = value_float(value, 1.0f);
+    else if (strcmp(key, "rateTimeBase") == 0) config->rate_time_base_s = value_float(value, CONFIG_DEFAULT_RATE_TIME_BASE_S);
+    else if (strcmp(key, "boType") == 0) {
+        const char* bo_type = value_string(value);
+        config->bo_type = bo_type ? string_to_bo_type(bo_type) : BO_TYPE_GENERIC;
+    }
+    else if (strcmp(key, "lphPerEmitterFlow") == 0) config->lph_per_emitter_flow = value_float(value, 0.0f);
+    else if (strcmp(key, "numEmittersPerPlant") == 0) config->num_emitters_per_plant = value_int(value, 0);
+    else if (strcmp(key, "flowRateMLPerSecond") == 0) config->flow_rate_ml_per_second = value_float(value, 0.0f);
+    else if (strcmp(key, "isCalibrated") == 0) config->is_calibrated = value_bool(value);
+    else if (strcmp(key, "enableScheduleExecution") == 0) config->enable_schedule_execution = value_bool(value);
+    else if (strcmp(key, "allowManualOverride") == 0) config->allow_manual_override = value_bool(value);
+    else if (strcmp(key, "manualOverrideTimeout") == 0) config->manual_override_timeout = value_int(value, 3600);
+    
+    return false;
+}
+
+/**
+ * @brief Order lookup table entries by input
+ */
+static int compare_lookup_entries(const void* a, const void* b) {
+    float lhs = ((const lookup_table_entry_t*)a)->input;
+    float rhs = ((const lookup_table_entry_t*)b)->input;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief Store a lookup table read from JSON as a sorted PSRAM table
+ * 
+ * Entries are sorted by input (in place in entries), repeated inputs keep
+ * the first entry, and segment slopes are precomputed so interpolation is
+ * one multiply-add. The table is left empty if there are fewer than 2
+ * distinct inputs or no memory.
+ */
+static void store_lookup_table(signal_config_t* config, lookup_table_entry_t* entries, int entry_count) {
+    config->lookup_table = NULL;
+    config->lookup_table_count = 0;
     
-    item = cJSON_GetObjectItem(sr_config, "outputClockPin");
-    config->output_clock_pin = item ? item->valueint : -1;
+    if (entry_count == 0) {
+        return;
+    }
     
-    item = cJSON_GetObjectItem(sr_config, "outputLatchPin");
-    config->output_latch_pin = item ? item->valueint : -1;
+    qsort(entries, entry_count, sizeof(lookup_table_entry_t), compare_lookup_entries);
     
-    item = cJSON_GetObjectItem(sr_config, "outputDataPin");
-    config->output_data_pin = item ? item->valueint : -1;
+    int count = 1;
+    for (int i = 1; i < entry_count; i++) {
+        if (entries[i].input > entries[count - 1].input) {
+            entries[count++] = entries[i];
+        }
+    }
+    if (count < entry_count) {
+        ESP_LOGW(TAG, "Lookup table: dropped %d entries with repeated inputs", entry_count - count);
+    }
+    if (count < 2) {
+        ESP_LOGW(TAG, "Lookup table ignored: fewer than 2 distinct inputs");
+        return;
+    }
     
-    item = cJSON_GetObjectItem(sr_config, "outputEnablePin");
-    config->output_enable_pin = item ? item->valueint : -1;
+    for (int i = 0; i < count - 1; i++) {
+        entries[i].slope = (entries[i + 1].output - entries[i].output) / (entries[i + 1].input - entries[i].input);
+    }
+    entries[count - 1].slope = 0.0f;
     
-    item = cJSON_GetObjectItem(sr_config, "inputClockPin");
-    config->input_clock_pin = item ? item->valueint : -1;
+    lookup_table_entry_t* table = psram_smart_malloc(count * sizeof(lookup_table_entry_t), ALLOC_LARGE_BUFFER);
+    if (!table) {
+        ESP_LOGW(TAG, "Lookup table ignored: no memory for %d entries", count);
+        return;
+    }
+    memcpy(table, entries, count * sizeof(lookup_table_entry_t));
     
-    item = cJSON_GetObjectItem(sr_config, "inputLoadPin");
-    config->input_load_pin = item ? item->valueint : -1;
+    config->lookup_table = table;
+    config->lookup_table_count = count;
+}
+
+/**
+ * @brief Free the lookup tables owned by the manager
+ */
+static void free_lookup_tables(config_manager_t* manager) {
+    for (int i = 0; i < manager->config.io_point_count; i++) {
+        signal_config_t* signal = &manager->config.io_points[i].signal_config;
+        if (signal->lookup_table) {
+            psram_smart_free(signal->lookup_table);
+            signal->lookup_table = NULL;
+            signal->lookup_table_count = 0;
+        }
+    }
+}
+
+/*
+ * DOM loader (cJSON)
+ */
+
+/**
+ * @brief Parse a lookup table from a cJSON array
+ * 
+ * Entries may be objects ({"input": x, "output": y}) or pairs ([x, y]).
+ */
+static void parse_lookup_table(cJSON* json, signal_config_t* config, lookup_table_entry_t* scratch) {
+    int entry_count = cJSON_IsArray(json) ? cJSON_GetArraySize(json) : 0;
+    if (entry_count == 0) {
+        return;
+    }
+    if (entry_count < 2 || entry_count > CONFIG_MAX_LOOKUP_ENTRIES) {
+        ESP_LOGW(TAG, "Lookup table ignored: %d entries (must be 2-%d)", entry_count, CONFIG_MAX_LOOKUP_ENTRIES);
+        return;
+    }
     
-    item = cJSON_GetObjectItem(sr_config, "inputDataPin");
-    config->input_data_pin = item ? item->valueint : -1;
+    int i = 0;
+    cJSON* entry;
+    cJSON_ArrayForEach(entry, json) {
+        cJSON* input = NULL;
+        cJSON* output = NULL;
+        
+        if (cJSON_IsArray(entry) && cJSON_GetArraySize(entry) == 2) {
+            input = cJSON_GetArrayItem(entry, 0);
+            output = cJSON_GetArrayItem(entry, 1);
+        } else if (cJSON_IsObject(entry)) {
+            input = cJSON_GetObjectItem(entry, "input");
+            output = cJSON_GetObjectItem(entry, "output");
+        }
+        
+        if (!cJSON_IsNumber(input) || !cJSON_IsNumber(output)) {
+            ESP_LOGW(TAG, "Lookup table ignored: malformed entry %d", i);
+            return;
+        }
+        
+        scratch[i].input = (float)input->valuedouble;
+        scratch[i].output = (float)output->valuedouble;
+        i++;
+    }
     
-    item = cJSON_GetObjectItem(sr_config, "numOutputRegisters");
-    config->num_output_registers = item ? item->valueint : 0;
+    store_lookup_table(config, scratch, entry_count);
+}
+
+/**
+ * @brief Parse signal configuration from JSON
+ */
+static void parse_signal_config(cJSON* json, signal_config_t* config, lookup_table_entry_t* scratch) {
+    signal_defaults(config);
     
-    item = cJSON_GetObjectItem(sr_config, "numInputRegisters");
-    config->num_input_registers = item ? item->valueint : 0;
+    cJSON* item;
+    cJSON_ArrayForEach(item, json) {
+        if (strcmp(item->string, "lookupTable") == 0) {
+            parse_lookup_table(item, config, scratch);
+        } else if (strcmp(item->string, "biquadCoefficients") == 0) {
+            float coefficients[5];
+            int count = 0;
+            cJSON* coefficient;
+            cJSON_ArrayForEach(coefficient, item) {
+                if (count < 5) {
+                    coefficients[count] = cJSON_IsNumber(coefficient) ? (float)coefficient->valuedouble : 0.0f;
+                }
+                count++;
+            }
+            set_biquad_coefficients(config, coefficients, cJSON_IsArray(item) ? count : 0);
+        } else {
+            config_value_t value;
+            cjson_to_value(item, &value);
+            set_signal_field(config, item->string, &value);
+        }
+    }
+}
+
+/**
+ * @brief Parse alarm configuration from JSON
+ */
+static void parse_alarm_config(cJSON* json, alarm_config_t* config) {
+    alarm_defaults(config);
     
-    return ESP_OK;
+    cJSON* item;
+    cJSON_ArrayForEach(item, json) {
+        config_value_t value;
+        
+        if (strcmp(item->string, "rules") == 0) {
+            alarm_rule_defaults(&config->rules);
+            cJSON* rule;
+            cJSON_ArrayForEach(rule, item) {
+                cjson_to_value(rule, &value);
+                set_alarm_rule_field(&config->rules, rule->string, &value);
+            }
+        } else if (strcmp(item->string, "interlocks") == 0) {
+            cJSON* entry;
+            cJSON_ArrayForEach(entry, item) {
+                interlock_config_t interlock;
+                interlock_defaults(&interlock);
+                cJSON* field;
+                cJSON_ArrayForEach(field, entry) {
+                    cjson_to_value(field, &value);
+                    set_interlock_field(&interlock, field->string, &value);
+                }
+                add_interlock(config, &interlock);
+            }
+        } else {
+            cjson_to_value(item, &value);
+            set_alarm_field(config, item->string, &value);
+        }
+    }
 }
 
 /**
- * @brief Parse signal configuration from JSON
+ * @brief Parse IO point configuration from JSON
  */
-static void parse_signal_config(cJSON* json, signal_config_t* config) {
+static esp_err_t parse_io_point(cJSON* json, io_point_config_t* config, lookup_table_entry_t* scratch) {
+    io_point_defaults(config);
+    bool has_type = false;
+    
     cJSON* item;
+    cJSON_ArrayForEach(item, json) {
+        if (strcmp(item->string, "signalConfig") == 0) {
+            parse_signal_config(item, &config->signal_config, scratch);
+        } else if (strcmp(item->string, "alarmConfig") == 0) {
+            parse_alarm_config(item, &config->alarm_config);
+        } else if (strcmp(item->string, "trendConfig") == 0) {
+            cJSON* field;
+            cJSON_ArrayForEach(field, item) {
+                config_value_t value;
+                cjson_to_value(field, &value);
+                set_trend_field(&config->trend_config, field->string, &value);
+            }
+        } else {
+            config_value_t value;
+            cjson_to_value(item, &value);
+            has_type |= set_io_point_field(config, item->string, &value);
+        }
+    }
     
-    item = cJSON_GetObjectItem(json, "enabled");
-    config->enabled = item ? cJSON_IsTrue(item) : false;
+    // Required fields
+    if (config->id[0] == '\0' || !has_type) {
+        if (config->signal_config.lookup_table) {
+            psram_smart_free(config->signal_config.lookup_table);
+            config->signal_config.lookup_table = NULL;
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    item = cJSON_GetObjectItem(json, "filterType");
-    config->filter_type = item ? string_to_filter_type(item->valuestring) : SIGNAL_FILTER_NONE;
+    return ESP_OK;
+}
+
+/**
+ * @brief Apply the members of a cJSON object through a section setter
+ */
+#define CJSON_APPLY_SECTION(json, key, config, setter) do { \
+        cJSON* _section = cJSON_GetObjectItem(json, key); \
+        cJSON* _item; \
+        cJSON_ArrayForEach(_item, _section) { \
+            config_value_t _value; \
+            cjson_to_value(_item, &_value); \
+            setter(config, _item->string, &_value); \
+        } \
+    } while (0)
+
+/**
+ * @brief Load configuration by parsing the whole file into a cJSON DOM
+ */
+static esp_err_t load_json_dom(config_manager_t* manager, lookup_table_entry_t* scratch, 
+                               int* parsed_count, int* failed_count, int* total_count) {
+    char* file_content = NULL;
+    size_t file_size = 0;
     
-    item = cJSON_GetObjectItem(json, "gain");
-    config->gain = item ? (float)item->valuedouble : 1.0f;
+    esp_err_t ret = storage_manager_read_file(manager->config_file_path, &file_content, &file_size);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read config file '%s': %s", manager->config_file_path, esp_err_to_name(ret));
+        return ret;
+    }
     
-    item = cJSON_GetObjectItem(json, "offset");
-    config->offset = item ? (float)item->valuedouble : 0.0f;
+    ESP_LOGI(TAG, "Successfully read config file: %zu bytes", file_size);
     
-    item = cJSON_GetObjectItem(json, "scalingFactor");
-    config->scaling_factor = item ? (float)item->valuedouble : 1.0f;
+    cJSON* json = cJSON_Parse(file_content);
+    if (!json) {
+        ESP_LOGE(TAG, "Failed to parse JSON config - invalid JSON format");
+        ESP_LOGE(TAG, "JSON content preview (first 200 chars): %.200s", file_content);
+        free(file_content);
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    item = cJSON_GetObjectItem(json, "smaWindowSize");
-    config->sma_window_size = item ? item->valueint : 5;
+    free(file_content);
+    ESP_LOGI(TAG, "Successfully parsed JSON configuration");
     
-    item = cJSON_GetObjectItem(json, "precisionDigits");
-    config->precision_digits = item ? item->valueint : 2;
+    io_config_t* config = &manager->config;
     
-    item = cJSON_GetObjectItem(json, "units");
-    if (item && item->valuestring) {
-        strncpy(config->units, item->valuestring, CONFIG_MAX_UNITS_LENGTH - 1);
-        config->units[CONFIG_MAX_UNITS_LENGTH - 1] = '\0';
+    if (cJSON_GetObjectItem(json, "shiftRegisterConfig")) {
+        shift_register_defaults(&config->shift_register_config);
+        CJSON_APPLY_SECTION(json, "shiftRegisterConfig", &config->shift_register_config, set_shift_register_field);
     } else {
-        config->units[0] = '\0';
+        ESP_LOGW(TAG, "No shift register config found in JSON");
     }
+    CJSON_APPLY_SECTION(json, "scanClasses", &config->scan_class_config, set_scan_class_field);
+    CJSON_APPLY_SECTION(json, "adcConfig", &config->adc_config, set_adc_field);
     
-    item = cJSON_GetObjectItem(json, "historyBufferSize");
-    config->history_buffer_size = item ? item->valueint : 100;
+    cJSON* io_points = cJSON_GetObjectItem(json, "ioPoints");
+    if (!io_points) {
+        ESP_LOGE(TAG, "No 'ioPoints' array found in JSON");
+        cJSON_Delete(json);
+        return ESP_ERR_NOT_FOUND;
+    }
     
-    item = cJSON_GetObjectItem(json, "lookupTableEnabled");
-    config->lookup_table_enabled = item ? cJSON_IsTrue(item) : false;
+    if (!cJSON_IsArray(io_points)) {
+        ESP_LOGE(TAG, "'ioPoints' is not an array in JSON");
+        cJSON_Delete(json);
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Initialize lookup table count to 0
-    config->lookup_table_count = 0;
+    *total_count = cJSON_GetArraySize(io_points);
+    ESP_LOGI(TAG, "Found ioPoints array with %d items", *total_count);
+    
+    ret = config_manager_reserve_io_points(config, *total_count < CONFIG_MAX_IO_POINTS ? 
+                                                   *total_count : CONFIG_MAX_IO_POINTS);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "No memory for %d IO points", *total_count);
+        cJSON_Delete(json);
+        return ret;
+    }
+    
+    cJSON* point_json;
+    cJSON_ArrayForEach(point_json, io_points) {
+        if (config->io_point_count >= config->io_point_capacity) {
+            ESP_LOGW(TAG, "IO points beyond %d ignored", CONFIG_MAX_IO_POINTS);
+            break;
+        }
+        
+        io_point_config_t* point_config = &config->io_points[config->io_point_count];
+        esp_err_t parse_ret = parse_io_point(point_json, point_config, scratch);
+        if (parse_ret == ESP_OK) {
+            ESP_LOGI(TAG, "  [%d] Parsed IO point: %s (type: %d)", 
+                     config->io_point_count, point_config->id, point_config->type);
+            config->io_point_count++;
+            (*parsed_count)++;
+        } else {
+            ESP_LOGW(TAG, "  [%d] Failed to parse IO point: %s", *failed_count, esp_err_to_name(parse_ret));
+            (*failed_count)++;
+        }
+    }
+    
+    cJSON_Delete(json);
+    return ESP_OK;
 }
 
+/*
+ * Streaming loader
+ */
+
 /**
- * @brief Parse alarm configuration from JSON
+ * @brief Stream a lookup table array into scratch, then store it
  */
-static void parse_alarm_config(cJSON* json, alarm_config_t* config) {
-    cJSON* item;
-    
-    item = cJSON_GetObjectItem(json, "enabled");
-    config->enabled = item ? cJSON_IsTrue(item) : false;
+static void stream_lookup_table(config_stream_t* stream, signal_config_t* config, lookup_table_entry_t* scratch) {
+    if (!config_stream_enter_array(stream)) {
+        return;
+    }
     
-    item = cJSON_GetObjectItem(json, "historySamplesForAnalysis");
-    config->history_samples_for_analysis = item ? item->valueint : 20;
+    int count = 0;
+    bool valid = true;
     
-    // Parse alarm rules
-    cJSON* rules = cJSON_GetObjectItem(json, "rules");
-    if (rules) {
-        alarm_rules_t* r = &config->rules;
-        
-        item = cJSON_GetObjectItem(rules, "checkRateOfChange");
-        r->check_rate_of_change = item ? cJSON_IsTrue(item) : false;
-        
-        item = cJSON_GetObjectItem(rules, "rateOfChangeThreshold");
-        r->rate_of_change_threshold = item ? (float)item->valuedouble : 50.0f;
-        
-        item = cJSON_GetObjectItem(rules, "checkDisconnected");
-        r->check_disconnected = item ? cJSON_IsTrue(item) : false;
-        
-        item = cJSON_GetObjectItem(rules, "disconnectedThreshold");
-        r->disconnected_threshold = item ? (float)item->valuedouble : 0.5f;
-        
-        item = cJSON_GetObjectItem(rules, "checkMaxValue");
-        r->check_max_value = item ? cJSON_IsTrue(item) : false;
-        
-        item = cJSON_GetObjectItem(rules, "maxValueThreshold");
-        r->max_value_threshold = item ? (float)item->valuedouble : 4090.0f;
-        
-        item = cJSON_GetObjectItem(rules, "checkStuckSignal");
-        r->check_stuck_signal = item ? cJSON_IsTrue(item) : false;
+    while (config_stream_next_element(stream)) {
+        float pair[2] = {0.0f, 0.0f};
+        int found = 0;
+        config_value_t value;
         
-        item = cJSON_GetObjectItem(rules, "stuckSignalWindowSamples");
-        r->stuck_signal_window_samples = item ? item->valueint : 10;
-        
-        item = cJSON_GetObjectItem(rules, "stuckSignalDeltaThreshold");
-        r->stuck_signal_delta_threshold = item ? (float)item->valuedouble : 1.0f;
-        
-        item = cJSON_GetObjectItem(rules, "alarmPersistenceSamples");
-        r->alarm_persistence_samples = item ? item->valueint : 1;
-        
-        item = cJSON_GetObjectItem(rules, "alarmClearHysteresisValue");
-        r->alarm_clear_hysteresis_value = item ? (float)item->valuedouble : 5.0f;
-        
-        item = cJSON_GetObjectItem(rules, "requiresManualReset");
-        r->requires_manual_reset = item ? cJSON_IsTrue(item) : false;
+        if (config_stream_peek_type(stream) == CONFIG_VALUE_ARRAY) {
+            int elements = 0;
+            int numbers = 0;
+            config_stream_enter_array(stream);
+            while (config_stream_next_element(stream)) {
+                config_stream_read_value(stream, &value);
+                if (elements < 2 && value.type == CONFIG_VALUE_NUMBER) {
+                    pair[elements] = (float)value.number;
+                    numbers++;
+                }
+                elements++;
+            }
+            found = (elements == 2 && numbers == 2) ? 3 : 0;
+        } else if (config_stream_enter_object(stream)) {
+            while (config_stream_next_member(stream)) {
+                bool is_input = strcmp(stream->key, "input") == 0;
+                bool is_output = strcmp(stream->key, "output") == 0;
+                config_stream_read_value(stream, &value);
+                if (value.type == CONFIG_VALUE_NUMBER && (is_input || is_output)) {
+                    pair[is_input ? 0 : 1] = (float)value.number;
+                    found |= is_input ? 1 : 2;
+                }
+            }
+        }
         
-        item = cJSON_GetObjectItem(rules, "samplesToClearAlarmCondition");
-        r->samples_to_clear_alarm_condition = item ? item->valueint : 3;
+        if (found != 3) {
+            valid = false;
+        } else if (count < CONFIG_MAX_LOOKUP_ENTRIES) {
+            scratch[count].input = pair[0];
+            scratch[count].output = pair[1];
+        }
+        count++;
+    }
+    
+    if (!valid) {
+        ESP_LOGW(TAG, "Lookup table ignored: malformed entry");
+    } else if (count == 1 || count > CONFIG_MAX_LOOKUP_ENTRIES) {
+        ESP_LOGW(TAG, "Lookup table ignored: %d entries (must be 2-%d)", count, CONFIG_MAX_LOOKUP_ENTRIES);
+    } else {
+        store_lookup_table(config, scratch, count);
+    }
+}
+
+/**
+ * @brief Stream an array of numbers into values (count is the array length)
+ */
+static int stream_number_array(config_stream_t* stream, float* values, int max_values) {
+    int count = 0;
+    
+    if (!config_stream_enter_array(stream)) {
+        return 0;
+    }
+    while (config_stream_next_element(stream)) {
+        config_value_t value;
+        config_stream_read_value(stream, &value);
+        if (count < max_values) {
+            values[count] = value_float(&value, 0.0f);
+        }
+        count++;
+    }
+    
+    return count;
+}
+
+/**
+ * @brief Stream signal configuration
+ */
+static void stream_signal_config(config_stream_t* stream, signal_config_t* config, lookup_table_entry_t* scratch) {
+    signal_defaults(config);
+    if (!config_stream_enter_object(stream)) {
+        return;
+    }
+    
+    while (config_stream_next_member(stream)) {
+        if (strcmp(stream->key, "lookupTable") == 0) {
+            stream_lookup_table(stream, config, scratch);
+        } else if (strcmp(stream->key, "biquadCoefficients") == 0) {
+            float coefficients[5];
+            int count = stream_number_array(stream, coefficients, 5);
+            set_biquad_coefficients(config, coefficients, count);
+        } else {
+            config_value_t value;
+            config_stream_read_value(stream, &value);
+            set_signal_field(config, stream->key, &value);
+        }
+    }
+}
+
+/**
+ * @brief Stream alarm configuration
+ */
+static void stream_alarm_config(config_stream_t* stream, alarm_config_t* config) {
+    alarm_defaults(config);
+    if (!config_stream_enter_object(stream)) {
+        return;
+    }
+    
+    while (config_stream_next_member(stream)) {
+        config_value_t value;
         
-        item = cJSON_GetObjectItem(rules, "consecutiveGoodSamplesToRestoreTrust");
-        r->consecutive_good_samples_to_restore_trust = item ? item->valueint : 5;
+        if (strcmp(stream->key, "rules") == 0) {
+            alarm_rule_defaults(&config->rules);
+            if (config_stream_enter_object(stream)) {
+                while (config_stream_next_member(stream)) {
+                    config_stream_read_value(stream, &value);
+                    set_alarm_rule_field(&config->rules, stream->key, &value);
+                }
+            }
+        } else if (strcmp(stream->key, "interlocks") == 0) {
+            if (config_stream_enter_array(stream)) {
+                while (config_stream_next_element(stream)) {
+                    interlock_config_t interlock;
+                    interlock_defaults(&interlock);
+                    if (config_stream_enter_object(stream)) {
+                        while (config_stream_next_member(stream)) {
+                            config_stream_read_value(stream, &value);
+                            set_interlock_field(&interlock, stream->key, &value);
+                        }
+                    }
+                    add_interlock(config, &interlock);
+                }
+            }
+        } else {
+            config_stream_read_value(stream, &value);
+            set_alarm_field(config, stream->key, &value);
+        }
     }
 }
 
 /**
- * @brief Parse IO point configuration from JSON
+ * @brief Stream one IO point
  */
-static esp_err_t parse_io_point(cJSON* json, io_point_config_t* config) {
-    cJSON* item;
+static esp_err_t stream_io_point(config_stream_t* stream, io_point_config_t* config, lookup_table_entry_t* scratch) {
+    io_point_defaults(config);
+    if (!config_stream_enter_object(stream)) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Clear the configuration
-    memset(config, 0, sizeof(io_point_config_t));
+    bool has_type = false;
+    while (config_stream_next_member(stream)) {
+        if (strcmp(stream->key, "signalConfig") == 0) {
+            stream_signal_config(stream, &config->signal_config, scratch);
+        } else if (strcmp(stream->key, "alarmConfig") == 0) {
+            stream_alarm_config(stream, &config->alarm_config);
+        } else if (strcmp(stream->key, "trendConfig") == 0) {
+            if (config_stream_enter_object(stream)) {
+                while (config_stream_next_member(stream)) {
+                    config_value_t value;
+                    config_stream_read_value(stream, &value);
+                    set_trend_field(&config->trend_config, stream->key, &value);
+                }
+            }
+        } else {
+            config_value_t value;
+            config_stream_read_value(stream, &value);
+            has_type |= set_io_point_field(config, stream->key, &value);
+        }
+    }
     
     // Required fields
-    item = cJSON_GetObjectItem(json, "id");
-    if (!item || !item->valuestring) return ESP_ERR_INVALID_ARG;
-    strncpy(config->id, item->valuestring, CONFIG_MAX_ID_LENGTH - 1);
+    if (config->id[0] == '\0' || !has_type) {
+        if (config->signal_config.lookup_table) {
+            psram_smart_free(config->signal_config.lookup_table);
+            config->signal_config.lookup_table = NULL;
+        }
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    item = cJSON_GetObjectItem(json, "type");
-    if (!item || !item->valuestring) return ESP_ERR_INVALID_ARG;
-    config->type = string_to_io_point_type(item->valuestring);
+    return ESP_OK;
+}
+
+/**
+ * @brief Stream the members of an object through a section setter
+ */
+#define STREAM_APPLY_SECTION(stream, config, setter) do { \
+        if (config_stream_enter_object(stream)) { \
+            while (config_stream_next_member(stream)) { \
+                config_value_t _value; \
+                config_stream_read_value(stream, &_value); \
+                setter(config, (stream)->key, &_value); \
+            } \
+        } \
+    } while (0)
+
+/**
+ * @brief Load configuration by streaming the file straight into io_config_t
+ * 
+ * Holds one read chunk and one key/string at a time instead of the file
+ * and its DOM.
+ */
+static esp_err_t load_json_stream(config_manager_t* manager, lookup_table_entry_t* scratch, 
+                                  int* parsed_count, int* failed_count, int* total_count) {
+    config_stream_t* stream = psram_smart_malloc(sizeof(config_stream_t), ALLOC_NORMAL);
+    if (!stream) {
+        return ESP_ERR_NO_MEM;
+    }
     
-    // Optional fields
-    item = cJSON_GetObjectItem(json, "name");
-    if (item && item->valuestring) {
-        strncpy(config->name, item->valuestring, CONFIG_MAX_NAME_LENGTH - 1);
+    esp_err_t ret = config_stream_open(stream, manager->config_file_path);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to open config file '%s'", manager->config_file_path);
+        psram_smart_free(stream);
+        return ret;
     }
     
-    item = cJSON_GetObjectItem(json, "description");
-    if (item && item->valuestring) {
-        strncpy(config->description, item->valuestring, CONFIG_MAX_DESCRIPTION_LENGTH - 1);
+    io_config_t* config = &manager->config;
+    bool has_shift_registers = false;
+    bool has_io_points = false;
+    
+    if (!config_stream_enter_object(stream)) {
+        stream->error = true;
     }
     
-    item = cJSON_GetObjectItem(json, "pin");
-    config->pin = item ? item->valueint : -1;
+    while (!stream->error && config_stream_next_member(stream)) {
+        if (strcmp(stream->key, "shiftRegisterConfig") == 0) {
+            has_shift_registers = true;
+            shift_register_defaults(&config->shift_register_config);
+            STREAM_APPLY_SECTION(stream, &config->shift_register_config, set_shift_register_field);
+        } else if (strcmp(stream->key, "scanClasses") == 0) {
+            STREAM_APPLY_SECTION(stream, &config->scan_class_config, set_scan_class_field);
+        } else if (strcmp(stream->key, "adcConfig") == 0) {
+            STREAM_APPLY_SECTION(stream, &config->adc_config, set_adc_field);
+        } else if (strcmp(stream->key, "ioPoints") == 0) {
+            has_io_points = config_stream_enter_array(stream);
+            while (has_io_points && config_stream_next_element(stream)) {
+                (*total_count)++;
+                // Point count is unknown up front; grow the table by doubling
+                if (config->io_point_count >= config->io_point_capacity) {
+                    int capacity = config->io_point_capacity ? 2 * config->io_point_capacity : 
+                                                               CONFIG_IO_POINT_GROWTH;
+                    if (config_manager_reserve_io_points(config, capacity < CONFIG_MAX_IO_POINTS ? 
+                                                                 capacity : CONFIG_MAX_IO_POINTS) != ESP_OK ||
+                        config->io_point_count >= config->io_point_capacity) {
+                        config_stream_skip_value(stream);
+                        continue;
+                    }
+                }
+                
+                io_point_config_t* point_config = &config->io_points[config->io_point_count];
+                esp_err_t parse_ret = stream_io_point(stream, point_config, scratch);
+                if (parse_ret == ESP_OK) {
+                    ESP_LOGI(TAG, "  [%d] Parsed IO point: %s (type: %d)", 
+                             config->io_point_count, point_config->id, point_config->type);
+                    config->io_point_count++;
+                    (*parsed_count)++;
+                } else {
+                    ESP_LOGW(TAG, "  [%d] Failed to parse IO point: %s", *failed_count, esp_err_to_name(parse_ret));
+                    (*failed_count)++;
+                }
+            }
+        } else {
+            config_stream_skip_value(stream);
+        }
+    }
     
-    item = cJSON_GetObjectItem(json, "chipIndex");
-    config->chip_index = item ? item->valueint : 0;
+    bool syntax_error = stream->error;
+    size_t bytes_read = stream->bytes_read;
+    config_stream_close(stream);
+    psram_smart_free(stream);
     
-    item = cJSON_GetObjectItem(json, "bitIndex");
-    config->bit_index = item ? item->valueint : 0;
+    if (syntax_error) {
+        ESP_LOGE(TAG, "Failed to parse JSON config - invalid JSON format");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!has_io_points) {
+        ESP_LOGE(TAG, "No 'ioPoints' array found in JSON");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (!has_shift_registers) {
+        ESP_LOGW(TAG, "No shift register config found in JSON");
+    }
     
-    item = cJSON_GetObjectItem(json, "isInverted");
-    config->is_inverted = item ? cJSON_IsTrue(item) : false;
+    ESP_LOGI(TAG, "Streamed config file: %zu bytes, %d ioPoints items", bytes_read, *total_count);
+    return ESP_OK;
+}
+
+/*
+ * Binary configuration cache
+ * 
+ * Layout: config_cache_header_t, the io_config_t prefix (everything up to
+ * io_point_count), io_point_count io_point_config_t images with lookup table
+ * pointers cleared, then each point's lookup table entries in point order.
+ * The CRC covers everything after the header.
+ */
+
+#define CONFIG_CACHE_MAGIC      0x43524E53  ///< "SNRC"
+#define CONFIG_CACHE_VERSION    2           ///< Bump when the layout or meaning of cached structures changes
+#define CONFIG_CACHE_PREFIX_SIZE offsetof(io_config_t, io_point_capacity) ///< Cached part of io_config_t
+
+/**
+ * @brief Binary cache file header
+ */
+typedef struct {
+    uint32_t magic;                 ///< CONFIG_CACHE_MAGIC
+    uint16_t version;               ///< CONFIG_CACHE_VERSION
+    uint16_t header_size;           ///< sizeof(config_cache_header_t)
+    uint32_t prefix_size;           ///< CONFIG_CACHE_PREFIX_SIZE
+    uint32_t point_size;            ///< sizeof(io_point_config_t)
+    uint32_t lookup_entry_count;    ///< Lookup entries following the point images
+    uint32_t json_size;             ///< Size of the JSON the image was built from
+    int64_t json_mtime;             ///< Modification time of that JSON (0 if not recorded)
+    uint32_t crc;                   ///< CRC32 of the payload
+} config_cache_header_t;
+
+/**
+ * @brief Clear the configuration to the state every loader starts from
+ */
+static void reset_config(config_manager_t* manager) {
+    free_lookup_tables(manager);
+    
+    // The point table is kept for the next load
+    io_point_config_t* io_points = manager->config.io_points;
+    int io_point_capacity = manager->config.io_point_capacity;
+    memset(&manager->config, 0, sizeof(io_config_t));
+    manager->config.io_points = io_points;
+    manager->config.io_point_capacity = io_point_capacity;
+    scan_class_defaults(&manager->config.scan_class_config);
+    adc_defaults(&manager->config.adc_config);
+}
+
+/**
+ * @brief Load the binary cache image
+ * 
+ * @param check_json Reject the image if the JSON file cannot be stat'ed, is newer or is a different size
+ */
+static esp_err_t load_cache(config_manager_t* manager, bool check_json) {
+    FILE* file = storage_manager_open_file(manager->cache_file_path, "rb");
+    if (!file) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    config_cache_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    if (header.magic != CONFIG_CACHE_MAGIC || header.version != CONFIG_CACHE_VERSION || 
+        header.header_size != sizeof(config_cache_header_t) || 
+        header.prefix_size != CONFIG_CACHE_PREFIX_SIZE || 
+        header.point_size != sizeof(io_point_config_t)) {
+        fclose(file);
+        return ESP_ERR_INVALID_VERSION;
+    }
+    
+    if (check_json) {
+        size_t json_size = 0;
+        int64_t json_mtime = 0;
+        esp_err_t stat_ret = storage_manager_stat_file(manager->config_file_path, &json_size, &json_mtime);
+        if (stat_ret != ESP_OK) {
+            // Cannot tell whether the JSON changed, so parse it rather than trust the image
+            fclose(file);
+            return stat_ret;
+        }
+        if (json_mtime > header.json_mtime || json_size != header.json_size) {
+            fclose(file);
+            return ESP_ERR_INVALID_STATE;
+        }
+    }
     
-    item = cJSON_GetObjectItem(json, "rangeMin");
-    config->range_min = item ? (float)item->valuedouble : 0.0f;
+    reset_config(manager);
+    io_config_t* config = &manager->config;
+    esp_err_t ret = ESP_OK;
     
-    item = cJSON_GetObjectItem(json, "rangeMax");
-    config->range_max = item ? (float)item->valuedouble : 100.0f;
+    if (fread(config, header.prefix_size, 1, file) != 1 || 
+        config->io_point_count < 0 || config->io_point_count > CONFIG_MAX_IO_POINTS) {
+        ret = ESP_ERR_INVALID_SIZE;
+    } else {
+        ret = config_manager_reserve_io_points(config, config->io_point_count);
+    }
+    if (ret != ESP_OK) {
+        config->io_point_count = 0; // Nothing was read into the table
+    }
     
-    // Binary Output specific fields
-    item = cJSON_GetObjectItem(json, "boType");
-    config->bo_type = item ? string_to_bo_type(item->valuestring) : BO_TYPE_GENERIC;
+    size_t points_size = (size_t)config->io_point_count * sizeof(io_point_config_t);
+    if (ret == ESP_OK && points_size > 0 && fread(config->io_points, points_size, 1, file) != 1) {
+        ret = ESP_ERR_INVALID_SIZE;
+    }
     
-    item = cJSON_GetObjectItem(json, "lphPerEmitterFlow");
-    config->lph_per_emitter_flow = item ? (float)item->valuedouble : 0.0f;
+    uint32_t crc = 0;
+    uint32_t entries = 0;
+    if (ret == ESP_OK) {
+        crc = esp_rom_crc32_le(crc, (const uint8_t*)config, header.prefix_size);
+        crc = esp_rom_crc32_le(crc, (const uint8_t*)config->io_points, points_size);
+        
+        // Image pointers are meaningless; clear them all before allocating any table
+        for (int i = 0; i < config->io_point_count; i++) {
+            config->io_points[i].signal_config.lookup_table = NULL;
+        }
+    }
     
-    item = cJSON_GetObjectItem(json, "numEmittersPerPlant");
-    config->num_emitters_per_plant = item ? item->valueint : 0;
+    for (int i = 0; ret == ESP_OK && i < config->io_point_count; i++) {
+        signal_config_t* signal = &config->io_points[i].signal_config;
+        int count = signal->lookup_table_count;
+        if (count == 0) {
+            continue;
+        }
+        if (count < 0 || count > CONFIG_MAX_LOOKUP_ENTRIES || entries + count > header.lookup_entry_count) {
+            ret = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+        
+        size_t table_size = count * sizeof(lookup_table_entry_t);
+        signal->lookup_table = psram_smart_malloc(table_size, ALLOC_LARGE_BUFFER);
+        if (!signal->lookup_table) {
+            ret = ESP_ERR_NO_MEM;
+        } else if (fread(signal->lookup_table, table_size, 1, file) != 1) {
+            ret = ESP_ERR_INVALID_SIZE;
+        } else {
+            crc = esp_rom_crc32_le(crc, (const uint8_t*)signal->lookup_table, table_size);
+            entries += count;
+        }
+    }
+    fclose(file);
     
-    item = cJSON_GetObjectItem(json, "flowRateMLPerSecond");
-    config->flow_rate_ml_per_second = item ? (float)item->valuedouble : 0.0f;
+    if (ret == ESP_OK && (entries != header.lookup_entry_count || crc != header.crc)) {
+        ret = ESP_ERR_INVALID_CRC;
+    }
+    if (ret != ESP_OK) {
+        // Points whose table was never allocated still carry a count; clear before freeing
+        for (int i = 0; i < config->io_point_count; i++) {
+            if (!config->io_points[i].signal_config.lookup_table) {
+                config->io_points[i].signal_config.lookup_table_count = 0;
+            }
+        }
+        reset_config(manager);
+    }
     
-    item = cJSON_GetObjectItem(json, "isCalibrated");
-    config->is_calibrated = item ? cJSON_IsTrue(item) : false;
+    return ret;
+}
+
+/**
+ * @brief Write the loaded configuration as a binary cache image
+ * 
+ * Written to a temporary file and renamed, so a power loss leaves either
+ * the old image or the new one.
+ */
+static esp_err_t write_cache(config_manager_t* manager) {
+    const io_config_t* config = &manager->config;
     
-    item = cJSON_GetObjectItem(json, "enableScheduleExecution");
-    config->enable_schedule_execution = item ? cJSON_IsTrue(item) : true;
+    io_point_config_t* point = psram_smart_malloc(sizeof(io_point_config_t), ALLOC_NORMAL);
+    if (!point) {
+        return ESP_ERR_NO_MEM;
+    }
     
-    item = cJSON_GetObjectItem(json, "allowManualOverride");
-    config->allow_manual_override = item ? cJSON_IsTrue(item) : true;
+    char temp_path[sizeof(manager->cache_file_path) + 4];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", manager->cache_file_path);
     
-    item = cJSON_GetObjectItem(json, "manualOverrideTimeout");
-    config->manual_override_timeout = item ? item->valueint : 3600;
+    FILE* file = storage_manager_open_file(temp_path, "wb");
+    if (!file) {
+        psram_smart_free(point);
+        return ESP_FAIL;
+    }
     
-    // Parse signal configuration
-    cJSON* signal_config = cJSON_GetObjectItem(json, "signalConfig");
-    if (signal_config) {
-        parse_signal_config(signal_config, &config->signal_config);
+    config_cache_header_t header = {
+        .magic = CONFIG_CACHE_MAGIC,
+        .version = CONFIG_CACHE_VERSION,
+        .header_size = sizeof(config_cache_header_t),
+        .prefix_size = CONFIG_CACHE_PREFIX_SIZE,
+        .point_size = sizeof(io_point_config_t),
+    };
+    size_t json_size = 0;
+    storage_manager_stat_file(manager->config_file_path, &json_size, &header.json_mtime);
+    header.json_size = (uint32_t)json_size;
+    
+    // Header is rewritten with the CRC once the payload is out
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)config, header.prefix_size);
+    ok = ok && fwrite(config, header.prefix_size, 1, file) == 1;
+    
+    for (int i = 0; ok && i < config->io_point_count; i++) {
+        *point = config->io_points[i];
+        point->signal_config.lookup_table = NULL;
+        crc = esp_rom_crc32_le(crc, (const uint8_t*)point, sizeof(io_point_config_t));
+        ok = fwrite(point, sizeof(io_point_config_t), 1, file) == 1;
     }
     
-    // Parse alarm configuration
-    cJSON* alarm_config = cJSON_GetObjectItem(json, "alarmConfig");
-    if (alarm_config) {
-        parse_alarm_config(alarm_config, &config->alarm_config);
+    for (int i = 0; ok && i < config->io_point_count; i++) {
+        const signal_config_t* signal = &config->io_points[i].signal_config;
+        if (signal->lookup_table && signal->lookup_table_count > 0) {
+            size_t table_size = signal->lookup_table_count * sizeof(lookup_table_entry_t);
+            crc = esp_rom_crc32_le(crc, (const uint8_t*)signal->lookup_table, table_size);
+            ok = fwrite(signal->lookup_table, table_size, 1, file) == 1;
+            header.lookup_entry_count += signal->lookup_table_count;
+        }
     }
     
-    return ESP_OK;
+    header.crc = crc;
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = (fclose(file) == 0) && ok;
+    psram_smart_free(point);
+    
+    if (!ok) {
+        storage_manager_delete_file(temp_path);
+        return ESP_FAIL;
+    }
+    
+    return storage_manager_rename_file(temp_path, manager->cache_file_path);
 }
 
 esp_err_t config_manager_init(config_manager_t* manager, const char* config_file_path) {
@@ -286,6 +1286,15 @@ esp_err_t config_manager_init(config_manager_t* manager, const char* config_file
     
     memset(manager, 0, sizeof(config_manager_t));
     strncpy(manager->config_file_path, config_file_path, sizeof(manager->config_file_path) - 1);
+    point_id_index_clear(&manager->id_index);
+    
+    // Binary cache lives next to the JSON: foo.json -> foo.bin
+    strncpy(manager->cache_file_path, manager->config_file_path, sizeof(manager->cache_file_path) - 5);
+    char* extension = strrchr(manager->cache_file_path, '.');
+    if (extension && strcmp(extension, ".json") == 0) {
+        *extension = '\0';
+    }
+    strcat(manager->cache_file_path, ".bin");
     
     manager->initialized = true;
     
@@ -297,104 +1306,98 @@ esp_err_t config_manager_init(config_manager_t* manager, const char* config_file
 }
 
 esp_err_t config_manager_load(config_manager_t* manager) {
+    return config_manager_load_from(manager, CONFIG_LOAD_AUTO);
+}
+
+esp_err_t config_manager_load_from(config_manager_t* manager, config_load_source_t source) {
     if (!manager || !manager->initialized) {
         ESP_LOGE(TAG, "Config manager not initialized");
         return ESP_ERR_INVALID_STATE;
     }
     
     ESP_LOGI(TAG, "Loading configuration from: %s", manager->config_file_path);
+    int64_t start_time = esp_timer_get_time();
     
-    // Read file content
-    char* file_content = NULL;
-    size_t file_size = 0;
-    
-    esp_err_t ret = storage_manager_read_file(manager->config_file_path, &file_content, &file_size);
-    if (ret != ESP_OK) {
-        manager->error_count++;
-        ESP_LOGE(TAG, "Failed to read config file '%s': %s", manager->config_file_path, esp_err_to_name(ret));
-        return ret;
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    config_load_source_t used_source = source;
+    int parsed_count = 0;
+    int failed_count = 0;
+    int total_count = 0;
+    
+    if (source == CONFIG_LOAD_AUTO || source == CONFIG_LOAD_BINARY_CACHE) {
+        used_source = CONFIG_LOAD_BINARY_CACHE;
+        ret = load_cache(manager, source == CONFIG_LOAD_AUTO);
+        if (ret == ESP_OK) {
+            parsed_count = manager->config.io_point_count;
+            total_count = parsed_count;
+        } else if (source == CONFIG_LOAD_AUTO) {
+            ESP_LOGI(TAG, "Binary config cache not used (%s), parsing JSON", 
+                     ret == ESP_ERR_INVALID_STATE ? "JSON is newer" : esp_err_to_name(ret));
+        }
     }
     
-    ESP_LOGI(TAG, "Successfully read config file: %zu bytes", file_size);
-    
-    // Parse JSON
-    cJSON* json = cJSON_Parse(file_content);
-    if (!json) {
-        manager->error_count++;
-        ESP_LOGE(TAG, "Failed to parse JSON config - invalid JSON format");
-        ESP_LOGE(TAG, "JSON content preview (first 200 chars): %.200s", file_content);
-        free(file_content);
-        return ESP_ERR_INVALID_ARG;
+    if (ret != ESP_OK && source != CONFIG_LOAD_BINARY_CACHE) {
+        used_source = (source == CONFIG_LOAD_JSON_DOM) ? CONFIG_LOAD_JSON_DOM : CONFIG_LOAD_JSON_STREAM;
+        reset_config(manager);
+        
+        lookup_table_entry_t* scratch = psram_smart_malloc(CONFIG_MAX_LOOKUP_ENTRIES * sizeof(lookup_table_entry_t), 
+                                                           ALLOC_LARGE_BUFFER);
+        if (!scratch) {
+            ret = ESP_ERR_NO_MEM;
+        } else if (used_source == CONFIG_LOAD_JSON_DOM) {
+            ret = load_json_dom(manager, scratch, &parsed_count, &failed_count, &total_count);
+        } else {
+            ret = load_json_stream(manager, scratch, &parsed_count, &failed_count, &total_count);
+        }
+        psram_smart_free(scratch);
+        
+        if (ret != ESP_OK) {
+            reset_config(manager);
+        } else if (source == CONFIG_LOAD_AUTO) {
+            esp_err_t cache_ret = write_cache(manager);
+            if (cache_ret != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to write binary config cache '%s': %s", 
+                         manager->cache_file_path, esp_err_to_name(cache_ret));
+            }
+        }
     }
     
-    free(file_content);
-    ESP_LOGI(TAG, "Successfully parsed JSON configuration");
-    
-    // Clear current configuration
-    memset(&manager->config, 0, sizeof(io_config_t));
-    
-    // Parse shift register configuration
-    ret = parse_shift_register_config(json, &manager->config.shift_register_config);
     if (ret != ESP_OK) {
-        ESP_LOGW(TAG, "No shift register config found in JSON");
-    } else {
-        ESP_LOGI(TAG, "Loaded shift register config: %d output registers, %d input registers", 
-                 manager->config.shift_register_config.num_output_registers,
-                 manager->config.shift_register_config.num_input_registers);
-    }
-    
-    // Parse IO points
-    cJSON* io_points = cJSON_GetObjectItem(json, "ioPoints");
-    if (!io_points) {
-        ESP_LOGE(TAG, "No 'ioPoints' array found in JSON");
-        cJSON_Delete(json);
-        return ESP_ERR_NOT_FOUND;
-    }
-    
-    if (!cJSON_IsArray(io_points)) {
-        ESP_LOGE(TAG, "'ioPoints' is not an array in JSON");
-        cJSON_Delete(json);
-        return ESP_ERR_INVALID_ARG;
+        manager->error_count++;
+        return ret;
     }
     
-    int array_size = cJSON_GetArraySize(io_points);
-    ESP_LOGI(TAG, "Found ioPoints array with %d items", array_size);
-    
-    int parsed_count = 0;
-    int failed_count = 0;
-    
-    for (int i = 0; i < array_size && parsed_count < CONFIG_MAX_IO_POINTS; i++) {
-        cJSON* point_json = cJSON_GetArrayItem(io_points, i);
-        if (point_json) {
-            io_point_config_t* point_config = &manager->config.io_points[parsed_count];
-            esp_err_t parse_ret = parse_io_point(point_json, point_config);
-            if (parse_ret == ESP_OK) {
-                ESP_LOGI(TAG, "  [%d] Parsed IO point: %s (type: %d)", 
-                         parsed_count, point_config->id, point_config->type);
-                parsed_count++;
-            } else {
-                ESP_LOGW(TAG, "  [%d] Failed to parse IO point at index %d: %s", 
-                         failed_count, i, esp_err_to_name(parse_ret));
-                failed_count++;
-            }
-        } else {
-            ESP_LOGW(TAG, "  [%d] NULL IO point at index %d", failed_count, i);
-            failed_count++;
-        }
+    io_config_t* config = &manager->config;
+    ESP_LOGI(TAG, "Loaded shift register config: %d output registers, %d input registers, %s backend", 
+             config->shift_register_config.num_output_registers,
+             config->shift_register_config.num_input_registers,
+             config->shift_register_config.backend == SHIFT_REGISTER_BACKEND_SPI ? "SPI" : "GPIO");
+    ESP_LOGI(TAG, "Scan class intervals: fast %lu ms, slow %lu ms",
+             config->scan_class_config.fast_interval_ms, config->scan_class_config.slow_interval_ms);
+    ESP_LOGI(TAG, "ADC acquisition: %s, %dx oversample, %lu Hz",
+             config->adc_config.mode == ADC_ACQUISITION_CONTINUOUS ? "continuous" : "one-shot",
+             config->adc_config.oversample, config->adc_config.sample_freq_hz);
+    
+    // Build ID index for lookups
+    ret = config_manager_rebuild_index(manager);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "IO point ID index incomplete (duplicate IDs?): %s", esp_err_to_name(ret));
     }
     
-    manager->config.io_point_count = parsed_count;
+    manager->last_load_source = used_source;
+    manager->last_load_time_us = (uint32_t)(esp_timer_get_time() - start_time);
     
-    ESP_LOGI(TAG, "Configuration loading complete:");
+    ESP_LOGI(TAG, "Configuration loading complete (%s, %lu us):", 
+             used_source == CONFIG_LOAD_BINARY_CACHE ? "binary cache" : 
+             used_source == CONFIG_LOAD_JSON_DOM ? "JSON DOM" : "JSON stream", manager->last_load_time_us);
     ESP_LOGI(TAG, "  - Successfully parsed: %d IO points", parsed_count);
     ESP_LOGI(TAG, "  - Failed to parse: %d IO points", failed_count);
-    ESP_LOGI(TAG, "  - Total in file: %d IO points", array_size);
+    ESP_LOGI(TAG, "  - Total in file: %d IO points", total_count);
     
     if (parsed_count == 0) {
         ESP_LOGE(TAG, "No IO points were successfully parsed!");
     }
     
-    cJSON_Delete(json);
     manager->load_count++;
     
     return ESP_OK;
@@ -409,19 +1412,112 @@ esp_err_t config_manager_get_shift_register_config(config_manager_t* manager, sh
     return ESP_OK;
 }
 
+esp_err_t config_manager_get_scan_class_config(config_manager_t* manager, scan_class_config_t* config) {
+    if (!manager || !manager->initialized || !config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *config = manager->config.scan_class_config;
+    return ESP_OK;
+}
+
+esp_err_t config_manager_get_adc_config(config_manager_t* manager, adc_acquisition_config_t* config) {
+    if (!manager || !manager->initialized || !config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *config = manager->config.adc_config;
+    return ESP_OK;
+}
+
 esp_err_t config_manager_get_io_point_config(config_manager_t* manager, const char* id, io_point_config_t* config) {
     if (!manager || !manager->initialized || !id || !config) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    for (int i = 0; i < manager->config.io_point_count; i++) {
-        if (strcmp(manager->config.io_points[i].id, id) == 0) {
-            *config = manager->config.io_points[i];
-            return ESP_OK;
-        }
+    int index = config_manager_find_io_point_index(manager, id);
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    *config = manager->config.io_points[index];
+    return ESP_OK;
+}
+
+int config_manager_find_io_point_index(config_manager_t* manager, const char* id) {
+    if (!manager || !manager->initialized || !id || !manager->config.io_points) {
+        return -1;
+    }
+    
+    return point_id_index_find(&manager->id_index, manager->config.io_points[0].id, 
+                               sizeof(io_point_config_t), id);
+}
+
+esp_err_t config_manager_get_io_point_config_by_index(config_manager_t* manager, int index, io_point_config_t* config) {
+    if (!manager || !manager->initialized || !config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (index < 0 || index >= manager->config.io_point_count) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    *config = manager->config.io_points[index];
+    return ESP_OK;
+}
+
+esp_err_t config_manager_rebuild_index(config_manager_t* manager) {
+    if (!manager || !manager->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!manager->config.io_points) {
+        point_id_index_clear(&manager->id_index);
+        return ESP_OK;
     }
     
-    return ESP_ERR_NOT_FOUND;
+    return point_id_index_build(&manager->id_index, manager->config.io_points[0].id, 
+                                sizeof(io_point_config_t), manager->config.io_point_count);
+}
+
+esp_err_t config_manager_reserve_io_points(io_config_t* config, int capacity) {
+    if (!config || capacity < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (capacity > CONFIG_MAX_IO_POINTS) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (capacity <= config->io_point_capacity) {
+        return ESP_OK;
+    }
+    
+    // Cold data: read once per load and on lookups, never in the scan
+    io_point_config_t* io_points = psram_smart_malloc(capacity * sizeof(io_point_config_t), ALLOC_LARGE_BUFFER);
+    if (!io_points) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (config->io_points) {
+        memcpy(io_points, config->io_points, config->io_point_count * sizeof(io_point_config_t));
+        psram_smart_free(config->io_points);
+    }
+    
+    config->io_points = io_points;
+    config->io_point_capacity = capacity;
+    return ESP_OK;
+}
+
+void config_manager_release_io_points(io_config_t* config) {
+    if (!config) {
+        return;
+    }
+    
+    psram_smart_free(config->io_points);
+    config->io_points = NULL;
+    config->io_point_capacity = 0;
+    config->io_point_count = 0;
+}
+
+int config_manager_get_io_point_count(config_manager_t* manager) {
+    return (manager && manager->initialized) ? manager->config.io_point_count : 0;
 }
 
 esp_err_t config_manager_get_all_io_points(config_manager_t* manager, io_point_config_t* configs, int max_configs, int* actual_count) {
@@ -473,6 +1569,9 @@ esp_err_t config_manager_get_statistics(config_manager_t* manager, uint32_t* loa
 
 void config_manager_destroy(config_manager_t* manager) {
     if (manager && manager->initialized) {
+        free_lookup_tables(manager);
+        config_manager_release_io_points(&manager->config);
+        point_id_index_release(&manager->id_index);
         manager->initialized = false;
         
 #ifdef DEBUG_CONFIG_MANAGER
@@ -497,13 +1596,17 @@ esp_err_t config_manager_update_io_point(config_manager_t* manager, const io_poi
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Find and update existing point
-    for (int i = 0; i < manager->config.io_point_count; i++) {
-        if (strcmp(manager->config.io_points[i].id, config->id) == 0) {
-            manager->config.io_points[i] = *config;
-            return ESP_OK;
-        }
+    // Find and update existing point (ID unchanged, so the index stays valid)
+    int index = config_manager_find_io_point_index(manager, config->id);
+    if (index < 0) {
+        return ESP_ERR_NOT_FOUND;
     }
     
-    return ESP_ERR_NOT_FOUND;
+    lookup_table_entry_t* previous_table = manager->config.io_points[index].signal_config.lookup_table;
+    if (previous_table && previous_table != config->signal_config.lookup_table) {
+        psram_smart_free(previous_table);
+    }
+    
+    manager->config.io_points[index] = *config;
+    return ESP_OK;
 }
@@ -0,0 +1,358 @@
+/**
+ * @file config_stream.c
+ * @brief Streaming JSON reader implementation for SNRv9 Irrigation Control System
+ */
+
+#include "config_stream.h"
+#include "storage_manager.h"
+#include <string.h>
+#include <stdlib.h>
+
+/**
+ * @brief Longest number literal accepted
+ */
+#define CONFIG_STREAM_MAX_NUMBER 40
+
+/**
+ * @brief Next byte without consuming it (-1 at end of file)
+ */
+static int peek_byte(config_stream_t* stream) {
+    if (stream->position >= stream->length) {
+        if (stream->error || !stream->file) {
+            return -1;
+        }
+        stream->length = fread(stream->buffer, 1, sizeof(stream->buffer), stream->file);
+        stream->position = 0;
+        stream->bytes_read += stream->length;
+        if (stream->length == 0) {
+            return -1;
+        }
+    }
+    return (unsigned char)stream->buffer[stream->position];
+}
+
+/**
+ * @brief Consume and return the next byte (-1 at end of file)
+ */
+static int next_byte(config_stream_t* stream) {
+    int c = peek_byte(stream);
+    if (c >= 0) {
+        stream->position++;
+    }
+    return c;
+}
+
+/**
+ * @brief Skip whitespace and return the next byte without consuming it
+ */
+static int skip_whitespace(config_stream_t* stream) {
+    int c = peek_byte(stream);
+    while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+        stream->position++;
+        c = peek_byte(stream);
+    }
+    return c;
+}
+
+/**
+ * @brief Consume an expected byte, flagging an error otherwise
+ */
+static bool expect_byte(config_stream_t* stream, int expected) {
+    if (skip_whitespace(stream) != expected) {
+        stream->error = true;
+        return false;
+    }
+    stream->position++;
+    return true;
+}
+
+/**
+ * @brief Append a code point to a string buffer as UTF-8 (truncating silently)
+ */
+static void append_code_point(char* out, size_t out_size, size_t* length, uint32_t code_point) {
+    char encoded[3];
+    size_t count;
+
+    if (code_point < 0x80) {
+        encoded[0] = (char)code_point;
+        count = 1;
+    } else if (code_point < 0x800) {
+        encoded[0] = (char)(0xC0 | (code_point >> 6));
+        encoded[1] = (char)(0x80 | (code_point & 0x3F));
+        count = 2;
+    } else {
+        encoded[0] = (char)(0xE0 | (code_point >> 12));
+        encoded[1] = (char)(0x80 | ((code_point >> 6) & 0x3F));
+        encoded[2] = (char)(0x80 | (code_point & 0x3F));
+        count = 3;
+    }
+
+    if (*length + count < out_size) {
+        memcpy(out + *length, encoded, count);
+        *length += count;
+    }
+}
+
+/**
+ * @brief Read a string literal into out
+ */
+static bool read_string(config_stream_t* stream, char* out, size_t out_size) {
+    size_t length = 0;
+
+    if (!expect_byte(stream, '"')) {
+        return false;
+    }
+
+    for (;;) {
+        int c = next_byte(stream);
+        if (c < 0) {
+            stream->error = true;
+            return false;
+        }
+        if (c == '"') {
+            break;
+        }
+
+        if (c == '\\') {
+            int escape = next_byte(stream);
+            switch (escape) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case '/': case '\\': case '"': c = escape; break;
+                case 'u': {
+                    uint32_t code_point = 0;
+                    for (int i = 0; i < 4; i++) {
+                        int hex = next_byte(stream);
+                        code_point <<= 4;
+                        if (hex >= '0' && hex <= '9') code_point |= (uint32_t)(hex - '0');
+                        else if (hex >= 'a' && hex <= 'f') code_point |= (uint32_t)(hex - 'a' + 10);
+                        else if (hex >= 'A' && hex <= 'F') code_point |= (uint32_t)(hex - 'A' + 10);
+                        else {
+                            stream->error = true;
+                            return false;
+                        }
+                    }
+                    // Surrogate pairs are not needed for configuration text
+                    append_code_point(out, out_size, &length,
+                                      (code_point >= 0xD800 && code_point <= 0xDFFF) ? '?' : code_point);
+                    continue;
+                }
+                default:
+                    stream->error = true;
+                    return false;
+            }
+        }
+
+        if (length + 1 < out_size) {
+            out[length++] = (char)c;
+        }
+    }
+
+    out[length] = '\0';
+    return true;
+}
+
+/**
+ * @brief Consume a bare literal (number, true, false, null) into out
+ */
+static size_t read_literal(config_stream_t* stream, char* out, size_t out_size) {
+    size_t length = 0;
+    int c = peek_byte(stream);
+
+    while (c >= 0 && c != ',' && c != '}' && c != ']' && c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+        if (length + 1 >= out_size) {
+            stream->error = true;
+            return 0;
+        }
+        out[length++] = (char)c;
+        stream->position++;
+        c = peek_byte(stream);
+    }
+
+    out[length] = '\0';
+    return length;
+}
+
+esp_err_t config_stream_open(config_stream_t* stream, const char* file_path) {
+    if (!stream || !file_path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stream, 0, sizeof(config_stream_t));
+    stream->file = storage_manager_open_file(file_path, "r");
+    return stream->file ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void config_stream_close(config_stream_t* stream) {
+    if (stream && stream->file) {
+        fclose(stream->file);
+        stream->file = NULL;
+    }
+}
+
+config_value_type_t config_stream_peek_type(config_stream_t* stream) {
+    int c = skip_whitespace(stream);
+
+    switch (c) {
+        case '{': return CONFIG_VALUE_OBJECT;
+        case '[': return CONFIG_VALUE_ARRAY;
+        case '"': return CONFIG_VALUE_STRING;
+        case 't': case 'f': return CONFIG_VALUE_BOOL;
+        default:
+            return (c == '-' || (c >= '0' && c <= '9')) ? CONFIG_VALUE_NUMBER : CONFIG_VALUE_NULL;
+    }
+}
+
+bool config_stream_enter_object(config_stream_t* stream) {
+    if (skip_whitespace(stream) != '{') {
+        config_stream_skip_value(stream);
+        return false;
+    }
+
+    stream->position++;
+    stream->first_member = true;
+    return true;
+}
+
+bool config_stream_next_member(config_stream_t* stream) {
+    int c = skip_whitespace(stream);
+    if (stream->error || c < 0) {
+        stream->error = true;
+        return false;
+    }
+
+    if (c == '}') {
+        stream->position++;
+        stream->first_member = false;
+        return false;
+    }
+
+    if (!stream->first_member && !expect_byte(stream, ',')) {
+        return false;
+    }
+    stream->first_member = false;
+
+    return read_string(stream, stream->key, sizeof(stream->key)) && expect_byte(stream, ':');
+}
+
+bool config_stream_enter_array(config_stream_t* stream) {
+    if (skip_whitespace(stream) != '[') {
+        config_stream_skip_value(stream);
+        return false;
+    }
+
+    stream->position++;
+    stream->first_member = true;
+    return true;
+}
+
+bool config_stream_next_element(config_stream_t* stream) {
+    int c = skip_whitespace(stream);
+    if (stream->error || c < 0) {
+        stream->error = true;
+        return false;
+    }
+
+    if (c == ']') {
+        stream->position++;
+        stream->first_member = false;
+        return false;
+    }
+
+    if (!stream->first_member && !expect_byte(stream, ',')) {
+        return false;
+    }
+    stream->first_member = false;
+
+    return true;
+}
+
+void config_stream_read_value(config_stream_t* stream, config_value_t* value) {
+    char literal[CONFIG_STREAM_MAX_NUMBER];
+
+    memset(value, 0, sizeof(config_value_t));
+    value->type = config_stream_peek_type(stream);
+
+    switch (value->type) {
+        case CONFIG_VALUE_OBJECT:
+        case CONFIG_VALUE_ARRAY:
+            config_stream_skip_value(stream);
+            break;
+
+        case CONFIG_VALUE_STRING:
+            if (read_string(stream, stream->string, sizeof(stream->string))) {
+                value->string = stream->string;
+            } else {
+                value->type = CONFIG_VALUE_NULL;
+            }
+            break;
+
+        case CONFIG_VALUE_BOOL:
+            read_literal(stream, literal, sizeof(literal));
+            value->boolean = strcmp(literal, "true") == 0;
+            if (!value->boolean && strcmp(literal, "false") != 0) {
+                stream->error = true;
+            }
+            break;
+
+        case CONFIG_VALUE_NUMBER: {
+            char* end = NULL;
+            read_literal(stream, literal, sizeof(literal));
+            value->number = strtod(literal, &end);
+            if (end == literal || *end != '\0') {
+                stream->error = true;
+            }
+            break;
+        }
+
+        default:
+            read_literal(stream, literal, sizeof(literal));
+            if (strcmp(literal, "null") != 0) {
+                stream->error = true;
+            }
+            break;
+    }
+}
+
+void config_stream_skip_value(config_stream_t* stream) {
+    int c = skip_whitespace(stream);
+
+    if (c == '"') {
+        read_string(stream, stream->string, sizeof(stream->string));
+        return;
+    }
+
+    if (c != '{' && c != '[') {
+        char literal[CONFIG_STREAM_MAX_NUMBER];
+        if (read_literal(stream, literal, sizeof(literal)) == 0) {
+            stream->error = true;
+        }
+        return;
+    }
+
+    // Containers: track nesting depth, stepping over strings so brackets inside them are ignored
+    int depth = 0;
+    do {
+        c = next_byte(stream);
+        if (c < 0) {
+            stream->error = true;
+            return;
+        }
+
+        if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            depth--;
+        } else if (c == '"') {
+            stream->position--;
+            if (!read_string(stream, stream->string, sizeof(stream->string))) {
+                return;
+            }
+        }
+    } while (depth > 0);
+
+    stream->first_member = false;
+}
@@ -13,6 +13,7 @@
 #include <stdbool.h>
 #include "esp_err.h"
 #include "cJSON.h"
+#include "point_id_index.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,13 +30,15 @@ extern "C" {
 
 /**
  * @brief Maximum number of IO points supported
+ * 
+ * Upper bound only: point tables are allocated to the loaded point count.
  */
-#define CONFIG_MAX_IO_POINTS 32
+#define CONFIG_MAX_IO_POINTS 256
 
 /**
- * @brief Maximum number of lookup table entries
+ * @brief Maximum number of lookup table entries per point
  */
-#define CONFIG_MAX_LOOKUP_ENTRIES 16
+#define CONFIG_MAX_LOOKUP_ENTRIES 256
 
 /**
  * @brief IO Point Types
@@ -65,15 +68,75 @@ typedef enum {
  */
 typedef enum {
     SIGNAL_FILTER_NONE = 0,         ///< No filtering
-    SIGNAL_FILTER_SMA               ///< Simple Moving Average
+    SIGNAL_FILTER_SMA,              ///< Simple Moving Average
+    SIGNAL_FILTER_EMA,              ///< Exponential Moving Average
+    SIGNAL_FILTER_MEDIAN,           ///< Windowed median (spike rejection)
+    SIGNAL_FILTER_HAMPEL,           ///< Hampel outlier rejection
+    SIGNAL_FILTER_BIQUAD            ///< Second-order IIR section
 } signal_filter_type_t;
 
+/**
+ * @brief Default EMA smoothing factor
+ */
+#define CONFIG_DEFAULT_EMA_ALPHA 0.2f
+
+/**
+ * @brief Default median/Hampel window size
+ */
+#define CONFIG_DEFAULT_MEDIAN_WINDOW_SIZE 5
+
+/**
+ * @brief Default Hampel threshold in scaled median absolute deviations
+ */
+#define CONFIG_DEFAULT_HAMPEL_THRESHOLD 3.0f
+
+/**
+ * @brief IO Point Scan Classes
+ */
+typedef enum {
+    IO_SCAN_CLASS_FAST = 0,         ///< Fast scan (float switches, pulse inputs)
+    IO_SCAN_CLASS_NORMAL,           ///< Normal scan at the polling interval
+    IO_SCAN_CLASS_SLOW,             ///< Slow scan (temperature probes)
+    IO_SCAN_CLASS_COUNT             ///< Number of scan classes
+} io_scan_class_t;
+
+/**
+ * @brief GPIO Binary Input Acquisition Modes
+ */
+typedef enum {
+    IO_INPUT_MODE_POLLED = 0,       ///< Level sampled at each scan
+    IO_INPUT_MODE_EDGE,             ///< Interrupt-driven debounced edges (short pulses are not missed)
+    IO_INPUT_MODE_COUNTER           ///< Pulse counter; value is the pulse rate, raw value the total
+} io_input_mode_t;
+
+/**
+ * @brief Default debounce windows per input mode (microseconds)
+ */
+#define CONFIG_DEFAULT_EDGE_DEBOUNCE_US     20000
+#define CONFIG_DEFAULT_COUNTER_DEBOUNCE_US  100
+
+/**
+ * @brief Default counter rate time base (seconds): rates are per minute
+ */
+#define CONFIG_DEFAULT_RATE_TIME_BASE_S 60.0f
+
+/**
+ * @brief Default fast scan class interval in milliseconds
+ */
+#define CONFIG_DEFAULT_FAST_SCAN_INTERVAL_MS 50
+
+/**
+ * @brief Default slow scan class interval in milliseconds
+ */
+#define CONFIG_DEFAULT_SLOW_SCAN_INTERVAL_MS 10000
+
 /**
  * @brief Lookup Table Entry
  */
 typedef struct {
     float input;                    ///< Input value
     float output;                   ///< Output value
+    float slope;                    ///< Output change per input unit up to the next entry (0 for the last)
 } lookup_table_entry_t;
 
 /**
@@ -86,12 +149,18 @@ typedef struct {
     float offset;                                           ///< Offset value
     float scaling_factor;                                   ///< Scaling factor
     int sma_window_size;                                    ///< SMA window size
+    float ema_alpha;                                        ///< EMA smoothing factor (0-1, 1 = no smoothing)
+    int median_window_size;                                 ///< Median/Hampel window size
+    float hampel_threshold;                                 ///< Hampel rejection threshold in scaled MADs
+    float biquad_coefficients[5];                           ///< Biquad b0, b1, b2, a1, a2 (a0 normalised to 1)
     int precision_digits;                                   ///< Precision digits
     char units[CONFIG_MAX_UNITS_LENGTH];                    ///< Engineering units
     int history_buffer_size;                                ///< History buffer size
     bool lookup_table_enabled;                             ///< Enable lookup table
     int lookup_table_count;                                 ///< Number of lookup entries
-    lookup_table_entry_t lookup_table[CONFIG_MAX_LOOKUP_ENTRIES]; ///< Lookup table
+    lookup_table_entry_t* lookup_table;                     ///< Entries sorted by input (PSRAM; the IO manager keeps its own copy)
+    float deadband;                                         ///< Change-of-value deadband in engineering units (0 = any change)
+    uint32_t cov_heartbeat_ms;                              ///< Report unchanged values after this long (0 = never)
 } signal_config_t;
 
 /**
@@ -107,6 +176,8 @@ typedef struct {
     bool check_stuck_signal;                               ///< Enable stuck signal alarm
     int stuck_signal_window_samples;                       ///< Stuck signal window
     float stuck_signal_delta_threshold;                    ///< Stuck signal delta threshold
+    bool check_noise_band;                                 ///< Enable noise band alarm
+    float noise_band_threshold;                            ///< Largest standard deviation over the history window
     int alarm_persistence_samples;                         ///< Alarm persistence samples
     float alarm_clear_hysteresis_value;                    ///< Alarm clear hysteresis
     bool requires_manual_reset;                            ///< Requires manual reset
@@ -114,15 +185,60 @@ typedef struct {
     int consecutive_good_samples_to_restore_trust;         ///< Samples to restore trust
 } alarm_rules_t;
 
+/**
+ * @brief Maximum interlocks per analog input
+ */
+#define CONFIG_MAX_POINT_INTERLOCKS 4
+
+/**
+ * @brief Interlock alarm type bits ("alarmType"), in alarm type order
+ */
+#define CONFIG_INTERLOCK_RATE_OF_CHANGE (1U << 0)
+#define CONFIG_INTERLOCK_DISCONNECTED   (1U << 1)
+#define CONFIG_INTERLOCK_MAX_VALUE      (1U << 2)
+#define CONFIG_INTERLOCK_STUCK_SIGNAL   (1U << 3)
+#define CONFIG_INTERLOCK_NOISE_BAND     (1U << 4)
+#define CONFIG_INTERLOCK_ANY            0x1FU
+
+/**
+ * @brief Interlock Configuration
+ * 
+ * While an alarm of alarm_mask is active on the point, the output is held
+ * in forced_state and writes to it are refused.
+ */
+typedef struct {
+    char output_point_id[CONFIG_MAX_ID_LENGTH];            ///< Binary output to force
+    uint32_t alarm_mask;                                   ///< Alarm types that trip the interlock
+    bool forced_state;                                     ///< Output state while tripped
+} interlock_config_t;
+
 /**
  * @brief Alarm Configuration
  */
 typedef struct {
     bool enabled;                                          ///< Enable alarm system
-    int history_samples_for_analysis;                     ///< History samples for analysis
+    int history_samples_for_analysis;                     ///< Analysis window (samples) for rate, stuck and noise checks
     alarm_rules_t rules;                                   ///< Alarm rules
+    int interlock_count;                                   ///< Number of interlocks
+    interlock_config_t interlocks[CONFIG_MAX_POINT_INTERLOCKS]; ///< Outputs forced by this point's alarms
 } alarm_config_t;
 
+/**
+ * @brief Default trend sample interval of analog points (seconds)
+ */
+#define CONFIG_DEFAULT_TREND_INTERVAL_S 10
+
+/**
+ * @brief Trend Configuration
+ * 
+ * Analog points (and counter-mode inputs) are sampled every
+ * sample_interval_s; binary points record every state change.
+ */
+typedef struct {
+    bool enabled;                                          ///< Record the point's history
+    uint32_t sample_interval_s;                            ///< Analog sample interval (seconds)
+} trend_config_t;
+
 /**
  * @brief IO Point Configuration
  */
@@ -135,9 +251,16 @@ typedef struct {
     int chip_index;                                        ///< Chip index (for shift register types)
     int bit_index;                                         ///< Bit index (for shift register types)
     bool is_inverted;                                      ///< Invert logic
+    io_scan_class_t scan_class;                            ///< Scan class (inputs only)
     float range_min;                                       ///< Minimum range value (AI only)
     float range_max;                                       ///< Maximum range value (AI only)
     
+    // Binary Input specific configuration (GPIO BI)
+    io_input_mode_t input_mode;                            ///< Acquisition mode
+    uint32_t debounce_us;                                  ///< Debounce window (0 = mode default)
+    float pulses_per_unit;                                 ///< Counter: pulses per engineering unit (K-factor)
+    float rate_time_base_s;                                ///< Counter: rate is units per this many seconds
+    
     // Binary Output specific configuration
     bo_type_t bo_type;                                     ///< Binary output type
     float lph_per_emitter_flow;                            ///< Liters per hour per emitter
@@ -155,8 +278,22 @@ typedef struct {
     
     signal_config_t signal_config;                         ///< Signal conditioning config
     alarm_config_t alarm_config;                           ///< Alarm configuration
+    trend_config_t trend_config;                           ///< Trend configuration
 } io_point_config_t;
 
+/**
+ * @brief Shift Register Backends
+ */
+typedef enum {
+    SHIFT_REGISTER_BACKEND_GPIO = 0,    ///< Bit-banged GPIO clocking
+    SHIFT_REGISTER_BACKEND_SPI          ///< SPI master, one DMA transaction per cycle
+} shift_register_backend_t;
+
+/**
+ * @brief Default shift register SPI clock in Hz
+ */
+#define CONFIG_DEFAULT_SHIFT_REGISTER_SPI_CLOCK_HZ 1000000
+
 /**
  * @brief Shift Register Configuration
  */
@@ -170,24 +307,71 @@ typedef struct {
     int input_data_pin;                                    ///< Input data pin
     int num_output_registers;                              ///< Number of output registers
     int num_input_registers;                               ///< Number of input registers
+    shift_register_backend_t backend;                      ///< Clocking backend
+    int spi_host;                                          ///< SPI peripheral (2 or 3, SPI backend only)
+    int spi_clock_hz;                                      ///< SPI clock in Hz (SPI backend only)
 } shift_register_config_t;
 
+/**
+ * @brief Scan Class Configuration
+ * 
+ * The normal class runs at the polling interval given to the IO manager.
+ */
+typedef struct {
+    uint32_t fast_interval_ms;                             ///< Fast scan class interval
+    uint32_t slow_interval_ms;                             ///< Slow scan class interval
+} scan_class_config_t;
+
+/**
+ * @brief ADC Acquisition Modes
+ */
+typedef enum {
+    ADC_ACQUISITION_ONESHOT = 0,    ///< One conversion per read
+    ADC_ACQUISITION_CONTINUOUS      ///< DMA round-robin sampling with oversampling
+} adc_acquisition_mode_t;
+
+/**
+ * @brief ADC Acquisition Configuration
+ */
+typedef struct {
+    adc_acquisition_mode_t mode;                           ///< Acquisition mode
+    int oversample;                                        ///< Samples averaged per reading (4-64, continuous only)
+    uint32_t sample_freq_hz;                               ///< Total conversion rate across channels (continuous only)
+} adc_acquisition_config_t;
+
 /**
  * @brief Complete IO Configuration
  */
 typedef struct {
     shift_register_config_t shift_register_config;         ///< Shift register configuration
+    scan_class_config_t scan_class_config;                 ///< Scan class configuration
+    adc_acquisition_config_t adc_config;                   ///< ADC acquisition configuration
     int io_point_count;                                    ///< Number of IO points
-    io_point_config_t io_points[CONFIG_MAX_IO_POINTS];     ///< IO point configurations
+    int io_point_capacity;                                 ///< Entries allocated in io_points
+    io_point_config_t* io_points;                          ///< IO point configurations (PSRAM)
 } io_config_t;
 
+/**
+ * @brief Configuration load source
+ */
+typedef enum {
+    CONFIG_LOAD_AUTO = 0,                                  ///< Binary cache if current, else streamed JSON (then refresh the cache)
+    CONFIG_LOAD_JSON_DOM,                                  ///< Whole file parsed into a cJSON DOM
+    CONFIG_LOAD_JSON_STREAM,                               ///< File streamed straight into io_config_t
+    CONFIG_LOAD_BINARY_CACHE                               ///< CRC-checked binary cache image only
+} config_load_source_t;
+
 /**
  * @brief Configuration Manager Structure
  */
 typedef struct {
     bool initialized;                                      ///< Initialization status
     io_config_t config;                                    ///< Current configuration
+    point_id_index_t id_index;                             ///< IO point ID index into config.io_points
     char config_file_path[256];                            ///< Configuration file path
+    char cache_file_path[256];                             ///< Binary cache path (config file with .bin extension)
+    config_load_source_t last_load_source;                 ///< Source used by the last successful load
+    uint32_t last_load_time_us;                            ///< Duration of the last successful load
     uint32_t load_count;                                   ///< Number of loads
     uint32_t save_count;                                   ///< Number of saves
     uint32_t error_count;                                  ///< Number of errors
@@ -205,11 +389,31 @@ esp_err_t config_manager_init(config_manager_t* manager, const char* config_file
 /**
  * @brief Load configuration from file
  * 
+ * Same as config_manager_load_from() with CONFIG_LOAD_AUTO: the binary
+ * cache is used when it is valid and the JSON file has not changed since
+ * it was written; otherwise the JSON is streamed and the cache rewritten.
+ * 
+ * Lookup tables from the previous load are freed, so point configuration
+ * copies taken before the reload must not be used for lookups afterwards.
+ * 
  * @param manager Pointer to configuration manager structure
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t config_manager_load(config_manager_t* manager);
 
+/**
+ * @brief Load configuration from a specific source
+ * 
+ * CONFIG_LOAD_BINARY_CACHE does not check the JSON file's age. On failure
+ * the configuration is left empty.
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @param source Source to load from
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_CRC or
+ *         ESP_ERR_INVALID_VERSION for a bad cache, other error code on failure
+ */
+esp_err_t config_manager_load_from(config_manager_t* manager, config_load_source_t source);
+
 /**
  * @brief Save configuration to file
  * 
@@ -227,6 +431,24 @@ esp_err_t config_manager_save(config_manager_t* manager);
  */
 esp_err_t config_manager_get_shift_register_config(config_manager_t* manager, shift_register_config_t* config);
 
+/**
+ * @brief Get scan class configuration
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @param config Pointer to store scan class configuration
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t config_manager_get_scan_class_config(config_manager_t* manager, scan_class_config_t* config);
+
+/**
+ * @brief Get ADC acquisition configuration
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @param config Pointer to store ADC acquisition configuration
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t config_manager_get_adc_config(config_manager_t* manager, adc_acquisition_config_t* config);
+
 /**
  * @brief Get IO point configuration by ID
  * 
@@ -237,6 +459,56 @@ esp_err_t config_manager_get_shift_register_config(config_manager_t* manager, sh
  */
 esp_err_t config_manager_get_io_point_config(config_manager_t* manager, const char* id, io_point_config_t* config);
 
+/**
+ * @brief Find the configuration index of an IO point
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @param id IO point ID
+ * @return int Index into the loaded IO points, or -1 if not found
+ */
+int config_manager_find_io_point_index(config_manager_t* manager, const char* id);
+
+/**
+ * @brief Get IO point configuration by configuration index
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @param index Index returned by config_manager_find_io_point_index
+ * @param config Pointer to store IO point configuration
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t config_manager_get_io_point_config_by_index(config_manager_t* manager, int index, io_point_config_t* config);
+
+/**
+ * @brief Rebuild the IO point ID index
+ * 
+ * Called by config_manager_load; call it after filling config.io_points directly.
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE on duplicate IDs
+ */
+esp_err_t config_manager_rebuild_index(config_manager_t* manager);
+
+/**
+ * @brief Grow the IO point table of a configuration
+ * 
+ * Existing points are kept; the table is never shrunk.
+ * 
+ * @param config Configuration to grow
+ * @param capacity Number of points the table must hold (at most CONFIG_MAX_IO_POINTS)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_SIZE above CONFIG_MAX_IO_POINTS,
+ *         ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t config_manager_reserve_io_points(io_config_t* config, int capacity);
+
+/**
+ * @brief Free the IO point table of a configuration
+ * 
+ * Lookup tables referenced by the points are not freed.
+ * 
+ * @param config Configuration to release
+ */
+void config_manager_release_io_points(io_config_t* config);
+
 /**
  * @brief Get all IO point configurations
  * 
@@ -248,9 +520,20 @@ esp_err_t config_manager_get_io_point_config(config_manager_t* manager, const ch
  */
 esp_err_t config_manager_get_all_io_points(config_manager_t* manager, io_point_config_t* configs, int max_configs, int* actual_count);
 
+/**
+ * @brief Get the number of loaded IO points
+ * 
+ * @param manager Pointer to configuration manager structure
+ * @return int Number of IO points (0 if not initialized)
+ */
+int config_manager_get_io_point_count(config_manager_t* manager);
+
 /**
  * @brief Update IO point configuration
  * 
+ * The stored point takes ownership of config->lookup_table; its previous
+ * table is freed if the pointer differs.
+ * 
  * @param manager Pointer to configuration manager structure
  * @param config Pointer to IO point configuration to update
  * @return esp_err_t ESP_OK on success, error code on failure
@@ -279,6 +562,8 @@ esp_err_t config_manager_get_statistics(config_manager_t* manager, uint32_t* loa
 /**
  * @brief Destroy configuration manager and cleanup resources
  * 
+ * Frees the lookup tables owned by the manager.
+ * 
  * @param manager Pointer to configuration manager structure
  */
 void config_manager_destroy(config_manager_t* manager);
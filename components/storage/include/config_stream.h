@@ -0,0 +1,157 @@
+/**
+ * @file config_stream.h
+ * @brief Streaming JSON reader for SNRv9 Irrigation Control System
+ *
+ * Pull-style JSON reader over a file read in small chunks. The caller walks
+ * the document with enter/next calls and receives scalar values one at a
+ * time, so configuration can be parsed straight into its destination
+ * structures without holding the file or a DOM in memory. Memory use is
+ * the reader structure itself, independent of file size.
+ */
+
+#ifndef CONFIG_STREAM_H
+#define CONFIG_STREAM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bytes read from the file per refill
+ */
+#define CONFIG_STREAM_CHUNK_SIZE 512
+
+/**
+ * @brief Longest string value (longer values are truncated)
+ */
+#define CONFIG_STREAM_MAX_STRING 256
+
+/**
+ * @brief Longest object key (longer keys are truncated)
+ */
+#define CONFIG_STREAM_MAX_KEY 64
+
+/**
+ * @brief JSON value types
+ */
+typedef enum {
+    CONFIG_VALUE_NULL = 0,          ///< null (or an unreadable value)
+    CONFIG_VALUE_BOOL,              ///< true / false
+    CONFIG_VALUE_NUMBER,            ///< Number
+    CONFIG_VALUE_STRING,            ///< String
+    CONFIG_VALUE_OBJECT,            ///< Object (contents not read)
+    CONFIG_VALUE_ARRAY              ///< Array (contents not read)
+} config_value_type_t;
+
+/**
+ * @brief Scalar JSON value
+ */
+typedef struct {
+    config_value_type_t type;       ///< Value type
+    bool boolean;                   ///< Value (CONFIG_VALUE_BOOL)
+    double number;                  ///< Value (CONFIG_VALUE_NUMBER)
+    const char* string;             ///< Value (CONFIG_VALUE_STRING, valid until the next read)
+} config_value_t;
+
+/**
+ * @brief Streaming reader state
+ */
+typedef struct {
+    FILE* file;                                 ///< Source file
+    char buffer[CONFIG_STREAM_CHUNK_SIZE];      ///< Read buffer
+    size_t length;                              ///< Valid bytes in buffer
+    size_t position;                            ///< Next byte in buffer
+    bool first_member;                          ///< Next member/element is the first of its container
+    bool error;                                 ///< Syntax or read error seen
+    size_t bytes_read;                          ///< Total bytes read from the file
+    char key[CONFIG_STREAM_MAX_KEY];            ///< Current object member key
+    char string[CONFIG_STREAM_MAX_STRING];      ///< Last string value
+} config_stream_t;
+
+/**
+ * @brief Open a LittleFS file for streaming
+ *
+ * @param stream Reader state
+ * @param file_path Path relative to /littlefs
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the file cannot be opened
+ */
+esp_err_t config_stream_open(config_stream_t* stream, const char* file_path);
+
+/**
+ * @brief Close the file
+ *
+ * @param stream Reader state
+ */
+void config_stream_close(config_stream_t* stream);
+
+/**
+ * @brief Type of the next value without consuming it
+ *
+ * @param stream Reader state
+ * @return config_value_type_t Type of the next value (CONFIG_VALUE_NULL on error)
+ */
+config_value_type_t config_stream_peek_type(config_stream_t* stream);
+
+/**
+ * @brief Consume the opening brace of an object
+ *
+ * @param stream Reader state
+ * @return bool True if the next value was an object; otherwise the value is skipped
+ */
+bool config_stream_enter_object(config_stream_t* stream);
+
+/**
+ * @brief Advance to the next object member
+ *
+ * On true, the key is in stream->key and the member's value is next.
+ * The value must be consumed (read, entered or skipped) before the next call.
+ *
+ * @param stream Reader state
+ * @return bool True if a member follows, false at the closing brace or on error
+ */
+bool config_stream_next_member(config_stream_t* stream);
+
+/**
+ * @brief Consume the opening bracket of an array
+ *
+ * @param stream Reader state
+ * @return bool True if the next value was an array; otherwise the value is skipped
+ */
+bool config_stream_enter_array(config_stream_t* stream);
+
+/**
+ * @brief Advance to the next array element
+ *
+ * @param stream Reader state
+ * @return bool True if an element follows, false at the closing bracket or on error
+ */
+bool config_stream_next_element(config_stream_t* stream);
+
+/**
+ * @brief Read the next value
+ *
+ * Objects and arrays are skipped and reported by type only.
+ *
+ * @param stream Reader state
+ * @param value Pointer to store the value
+ */
+void config_stream_read_value(config_stream_t* stream, config_value_t* value);
+
+/**
+ * @brief Skip the next value, including nested containers
+ *
+ * @param stream Reader state
+ */
+void config_stream_skip_value(config_stream_t* stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CONFIG_STREAM_H
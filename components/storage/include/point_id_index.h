@@ -0,0 +1,120 @@
+/**
+ * @file point_id_index.h
+ * @brief IO point ID hash index for SNRv9 Irrigation Control System
+ *
+ * Open-addressing (linear probing) FNV-1a index mapping IO point ID strings
+ * to table positions. The index stores hashes and values only; the ID
+ * strings stay in the owner's table, which is passed as a base pointer and
+ * stride on every call. The slot array is sized at build time to keep the
+ * load factor at or below 1/2 for the owner's point count.
+ */
+
+#ifndef POINT_ID_INDEX_H
+#define POINT_ID_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Smallest slot array allocated
+ */
+#define POINT_ID_INDEX_MIN_SLOTS 16
+
+/**
+ * @brief Index slot
+ */
+typedef struct {
+    uint32_t hash;                      ///< FNV-1a hash of the ID
+    int16_t value;                      ///< Owner table position (-1 when empty)
+} point_id_index_slot_t;
+
+/**
+ * @brief Point ID Index Structure
+ */
+typedef struct {
+    point_id_index_slot_t* slots;       ///< Hash slots (slot_count entries, NULL until reserved)
+    uint32_t slot_count;                ///< Number of slots (power of two)
+    int count;                          ///< Number of indexed IDs
+} point_id_index_t;
+
+/**
+ * @brief Compute the FNV-1a hash of a point ID
+ *
+ * @param id Null-terminated point ID
+ * @return uint32_t Hash value
+ */
+uint32_t point_id_index_hash(const char* id);
+
+/**
+ * @brief Size the slot array for a number of IDs and clear the index
+ *
+ * The slot array is reallocated only when it is too small.
+ *
+ * @param index Pointer to index structure
+ * @param capacity Number of IDs the index must hold
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if allocation fails
+ */
+esp_err_t point_id_index_reserve(point_id_index_t* index, int capacity);
+
+/**
+ * @brief Free the slot array
+ *
+ * @param index Pointer to index structure
+ */
+void point_id_index_release(point_id_index_t* index);
+
+/**
+ * @brief Clear the index
+ *
+ * @param index Pointer to index structure
+ */
+void point_id_index_clear(point_id_index_t* index);
+
+/**
+ * @brief Insert a point ID
+ *
+ * @param index Pointer to index structure
+ * @param ids Base address of the first ID in the owner's table
+ * @param stride Distance in bytes between consecutive IDs in the owner's table
+ * @param value Table position of the ID being inserted
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if the ID is
+ *         already indexed, ESP_ERR_NO_MEM if the index is full
+ */
+esp_err_t point_id_index_insert(point_id_index_t* index, const char* ids, size_t stride, int value);
+
+/**
+ * @brief Find the table position of a point ID
+ *
+ * @param index Pointer to index structure
+ * @param ids Base address of the first ID in the owner's table
+ * @param stride Distance in bytes between consecutive IDs in the owner's table
+ * @param id Point ID to look up
+ * @return int Table position, or -1 if not found
+ */
+int point_id_index_find(const point_id_index_t* index, const char* ids, size_t stride, const char* id);
+
+/**
+ * @brief Rebuild the index over an owner's table
+ *
+ * Reserves slots for count IDs first.
+ *
+ * @param index Pointer to index structure
+ * @param ids Base address of the first ID in the owner's table
+ * @param stride Distance in bytes between consecutive IDs in the owner's table
+ * @param count Number of IDs in the owner's table
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the slots cannot be
+ *         allocated, error from point_id_index_insert on the first duplicate
+ *         (earlier IDs remain indexed)
+ */
+esp_err_t point_id_index_build(point_id_index_t* index, const char* ids, size_t stride, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POINT_ID_INDEX_H
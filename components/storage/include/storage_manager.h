@@ -1,6 +1,8 @@
 #ifndef STORAGE_MANAGER_H
 #define STORAGE_MANAGER_H
 
+#include <stdio.h>
+#include <stdint.h>
 #include "esp_err.h"
 
 /**
@@ -36,4 +38,44 @@ void storage_manager_list_filesystem(void);
  */
 esp_err_t storage_manager_read_file(const char* file_path, char** content, size_t* size);
 
+/**
+ * @brief Opens a file in the LittleFS filesystem.
+ *
+ * For callers that stream a file instead of reading it whole. The caller
+ * closes the returned stream with fclose().
+ *
+ * @param file_path Path to the file (relative to /littlefs)
+ * @param mode fopen() mode string
+ * @return FILE* Open stream, or NULL on failure
+ */
+FILE* storage_manager_open_file(const char* file_path, const char* mode);
+
+/**
+ * @brief Gets the size and modification time of a file.
+ *
+ * @param file_path Path to the file (relative to /littlefs)
+ * @param size Pointer to store the file size in bytes (can be NULL)
+ * @param mtime Pointer to store the modification time (can be NULL; 0 if
+ *              the filesystem does not record it)
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the file does not exist
+ */
+esp_err_t storage_manager_stat_file(const char* file_path, size_t* size, int64_t* mtime);
+
+/**
+ * @brief Renames a file, replacing the destination if it exists.
+ *
+ * @param from_path Current path (relative to /littlefs)
+ * @param to_path New path (relative to /littlefs)
+ * @return ESP_OK on success, ESP_FAIL on failure
+ */
+esp_err_t storage_manager_rename_file(const char* from_path, const char* to_path);
+
+/**
+ * @brief Deletes a file.
+ *
+ * @param file_path Path to the file (relative to /littlefs)
+ * @return ESP_OK on success, ESP_ERR_NOT_FOUND if the file could not be removed
+ */
+esp_err_t storage_manager_delete_file(const char* file_path);
+
 #endif // STORAGE_MANAGER_H
@@ -0,0 +1,135 @@
+/**
+ * @file point_id_index.c
+ * @brief IO point ID hash index implementation for SNRv9 Irrigation Control System
+ */
+
+#include "point_id_index.h"
+#include "psram_manager.h"
+#include <string.h>
+
+uint32_t point_id_index_hash(const char* id) {
+    uint32_t hash = 2166136261u;
+    while (*id) {
+        hash ^= (uint8_t)*id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+esp_err_t point_id_index_reserve(point_id_index_t* index, int capacity) {
+    if (!index || capacity < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t slot_count = POINT_ID_INDEX_MIN_SLOTS;
+    while (slot_count < 2 * (uint32_t)capacity) {
+        slot_count <<= 1;
+    }
+
+    if (slot_count > index->slot_count) {
+        point_id_index_slot_t* slots = psram_smart_malloc(slot_count * sizeof(point_id_index_slot_t), ALLOC_NORMAL);
+        if (!slots) {
+            return ESP_ERR_NO_MEM;
+        }
+        psram_smart_free(index->slots);
+        index->slots = slots;
+        index->slot_count = slot_count;
+    }
+
+    point_id_index_clear(index);
+    return ESP_OK;
+}
+
+void point_id_index_release(point_id_index_t* index) {
+    if (!index) {
+        return;
+    }
+
+    psram_smart_free(index->slots);
+    index->slots = NULL;
+    index->slot_count = 0;
+    index->count = 0;
+}
+
+void point_id_index_clear(point_id_index_t* index) {
+    if (!index) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < index->slot_count; i++) {
+        index->slots[i].hash = 0;
+        index->slots[i].value = -1;
+    }
+    index->count = 0;
+}
+
+esp_err_t point_id_index_insert(point_id_index_t* index, const char* ids, size_t stride, int value) {
+    if (!index || !ids || value < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Keep load factor at or below 1/2 so probes stay short
+    if ((uint32_t)index->count >= index->slot_count / 2) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    const char* id = ids + (size_t)value * stride;
+    uint32_t hash = point_id_index_hash(id);
+    uint32_t mask = index->slot_count - 1;
+
+    for (uint32_t probe = 0; probe < index->slot_count; probe++) {
+        point_id_index_slot_t* slot = &index->slots[(hash + probe) & mask];
+
+        if (slot->value < 0) {
+            slot->hash = hash;
+            slot->value = (int16_t)value;
+            index->count++;
+            return ESP_OK;
+        }
+
+        if (slot->hash == hash && strcmp(ids + (size_t)slot->value * stride, id) == 0) {
+            return ESP_ERR_INVALID_STATE; // Duplicate ID
+        }
+    }
+
+    return ESP_ERR_NO_MEM;
+}
+
+int point_id_index_find(const point_id_index_t* index, const char* ids, size_t stride, const char* id) {
+    if (!index || !ids || !id || index->count == 0) {
+        return -1;
+    }
+
+    uint32_t hash = point_id_index_hash(id);
+    uint32_t mask = index->slot_count - 1;
+
+    for (uint32_t probe = 0; probe < index->slot_count; probe++) {
+        const point_id_index_slot_t* slot = &index->slots[(hash + probe) & mask];
+
+        if (slot->value < 0) {
+            return -1;
+        }
+
+        if (slot->hash == hash && strcmp(ids + (size_t)slot->value * stride, id) == 0) {
+            return slot->value;
+        }
+    }
+
+    return -1;
+}
+
+esp_err_t point_id_index_build(point_id_index_t* index, const char* ids, size_t stride, int count) {
+    esp_err_t ret = point_id_index_reserve(index, count);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    for (int i = 0; i < count; i++) {
+        ret = point_id_index_insert(index, ids, stride, i);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    return ESP_OK;
+}
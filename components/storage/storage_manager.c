@@ -207,3 +207,73 @@ esp_err_t storage_manager_read_file(const char* file_path, char** content, size_
     ESP_LOGI(TAG, "Successfully read file: %s (%zu bytes)", file_path, (size_t)file_size);
     return ESP_OK;
 }
+
+/**
+ * @brief Build the full filesystem path for a LittleFS-relative path
+ */
+static void build_full_path(const char* file_path, char* full_path, size_t full_path_size)
+{
+    snprintf(full_path, full_path_size, "/littlefs/%s", file_path);
+}
+
+FILE* storage_manager_open_file(const char* file_path, const char* mode)
+{
+    if (!file_path || !mode) {
+        return NULL;
+    }
+
+    char full_path[512];
+    build_full_path(file_path, full_path, sizeof(full_path));
+    return fopen(full_path, mode);
+}
+
+esp_err_t storage_manager_stat_file(const char* file_path, size_t* size, int64_t* mtime)
+{
+    if (!file_path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char full_path[512];
+    build_full_path(file_path, full_path, sizeof(full_path));
+
+    struct stat st;
+    if (stat(full_path, &st) != 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (size) *size = (size_t)st.st_size;
+    if (mtime) *mtime = (int64_t)st.st_mtime;
+    return ESP_OK;
+}
+
+esp_err_t storage_manager_rename_file(const char* from_path, const char* to_path)
+{
+    if (!from_path || !to_path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char full_from[512];
+    char full_to[512];
+    build_full_path(from_path, full_from, sizeof(full_from));
+    build_full_path(to_path, full_to, sizeof(full_to));
+
+    // LittleFS rename does not replace an existing destination
+    remove(full_to);
+    if (rename(full_from, full_to) != 0) {
+        ESP_LOGE(TAG, "Failed to rename %s to %s", full_from, full_to);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t storage_manager_delete_file(const char* file_path)
+{
+    if (!file_path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char full_path[512];
+    build_full_path(file_path, full_path, sizeof(full_path));
+    return remove(full_path) == 0 ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
@@ -0,0 +1,448 @@
+/**
+ * @file alarm_controller.c
+ * @brief Alarm Controller implementation for SNRv9 Irrigation Control System
+ */
+
+#include "alarm_controller.h"
+#include "point_id_index.h"
+#include "debug_config.h"
+#include "esp_log.h"
+#include "cJSON.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+static const char* TAG = "ALARM_CTRL";
+
+#define ALARM_HISTORY_CHUNK_SIZE 1024   ///< Response bytes buffered per HTTP chunk
+#define ALARM_HISTORY_RECORD_MAX 160    ///< Longest formatted record
+
+// Global references
+static alarm_manager_t* g_alarm_manager = NULL;
+static alarm_journal_t* g_alarm_journal = NULL;
+
+/**
+ * @brief Streaming state of a history request
+ */
+typedef struct {
+    httpd_req_t* req;                           ///< Request being answered
+    char buffer[ALARM_HISTORY_CHUNK_SIZE];      ///< Pending response bytes
+    size_t length;                              ///< Bytes in buffer
+    uint32_t count;                             ///< Records sent
+    uint32_t limit;                             ///< Records allowed
+    bool truncated;                             ///< Stopped at the limit
+    bool send_failed;                           ///< Client went away
+    const char* point_id;                       ///< Queried point (NULL = all)
+    uint32_t cached_key;                        ///< Key of cached_id
+    char cached_id[CONFIG_MAX_ID_LENGTH];       ///< Last resolved point ID
+} alarm_history_stream_t;
+
+/**
+ * @brief Convert alarm type to string
+ */
+static const char* alarm_type_to_string(uint8_t type) {
+    switch (type) {
+        case ALARM_TYPE_RATE_OF_CHANGE: return "RATE_OF_CHANGE";
+        case ALARM_TYPE_DISCONNECTED: return "DISCONNECTED";
+        case ALARM_TYPE_MAX_VALUE: return "MAX_VALUE";
+        case ALARM_TYPE_STUCK_SIGNAL: return "STUCK_SIGNAL";
+        case ALARM_TYPE_NOISE_BAND: return "NOISE_BAND";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Parse an alarm type name ("ALL" = every type)
+ */
+static bool alarm_type_from_string(const char* name, alarm_type_t* type) {
+    if (strcmp(name, "ALL") == 0) {
+        *type = ALARM_TYPE_COUNT;
+        return true;
+    }
+    for (int t = 0; t < ALARM_TYPE_COUNT; t++) {
+        if (strcmp(name, alarm_type_to_string((uint8_t)t)) == 0) {
+            *type = (alarm_type_t)t;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Add the names of the alarm types in a mask as a JSON array
+ */
+static void add_alarm_types(cJSON* parent, const char* name, uint32_t mask) {
+    cJSON* types = cJSON_AddArrayToObject(parent, name);
+    for (int t = 0; t < ALARM_TYPE_COUNT; t++) {
+        if (mask & ALARM_RULE_BIT(t)) {
+            cJSON_AddItemToArray(types, cJSON_CreateString(alarm_type_to_string((uint8_t)t)));
+        }
+    }
+}
+
+/**
+ * @brief Convert journal event to string
+ */
+static const char* alarm_event_to_string(uint8_t event) {
+    switch (event) {
+        case ALARM_JOURNAL_ACTIVATED: return "ACTIVATED";
+        case ALARM_JOURNAL_CLEARED: return "CLEARED";
+        case ALARM_JOURNAL_SHELVED: return "SHELVED";
+        case ALARM_JOURNAL_UNSHELVED: return "UNSHELVED";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Send the buffered bytes as one chunk
+ */
+static bool history_flush(alarm_history_stream_t* stream) {
+    if (stream->length > 0 && !stream->send_failed) {
+        if (httpd_resp_send_chunk(stream->req, stream->buffer, stream->length) != ESP_OK) {
+            stream->send_failed = true;
+        }
+    }
+    stream->length = 0;
+    return !stream->send_failed;
+}
+
+/**
+ * @brief Append text to the response, sending a chunk when the buffer fills
+ */
+static bool history_write(alarm_history_stream_t* stream, const char* text, size_t length) {
+    if (stream->length + length > sizeof(stream->buffer) && !history_flush(stream)) {
+        return false;
+    }
+    memcpy(stream->buffer + stream->length, text, length);
+    stream->length += length;
+    return true;
+}
+
+/**
+ * @brief Journal visitor: format one record into the response
+ */
+static bool history_visit(const alarm_journal_record_t* record, void* context) {
+    alarm_history_stream_t* stream = (alarm_history_stream_t*)context;
+
+    if (stream->count >= stream->limit) {
+        stream->truncated = true;
+        return false;
+    }
+
+    // Records carry a key; resolve it to the point ID (one entry cache, records cluster by point)
+    const char* point_id = stream->point_id;
+    char unknown_id[16];
+    if (!point_id) {
+        if (stream->cached_id[0] == '\0' || stream->cached_key != record->point_key) {
+            if (alarm_manager_find_point_by_key(g_alarm_manager, record->point_key, stream->cached_id,
+                                                sizeof(stream->cached_id)) == ESP_OK) {
+                stream->cached_key = record->point_key;
+            } else {
+                stream->cached_id[0] = '\0';
+            }
+        }
+        if (stream->cached_id[0] != '\0') {
+            point_id = stream->cached_id;
+        } else {
+            // Point no longer monitored: report the key
+            snprintf(unknown_id, sizeof(unknown_id), "#%08" PRIx32, record->point_key);
+            point_id = unknown_id;
+        }
+    }
+
+    char line[ALARM_HISTORY_RECORD_MAX];
+    int length = snprintf(line, sizeof(line),
+                          "%s{\"sequence\":%" PRIu32 ",\"timestamp\":%" PRId64 ",\"pointId\":\"%s\","
+                          "\"type\":\"%s\",\"event\":\"%s\",\"value\":%.3f}",
+                          stream->count > 0 ? "," : "", record->sequence, record->timestamp_ms, point_id,
+                          alarm_type_to_string(record->alarm_type),
+                          alarm_event_to_string(record->event),
+                          (double)record->value);
+    if (length <= 0 || length >= (int)sizeof(line)) {
+        return true;
+    }
+
+    stream->count++;
+    return history_write(stream, line, (size_t)length);
+}
+
+esp_err_t alarm_get_history(httpd_req_t *req) {
+    if (!g_alarm_manager || !g_alarm_journal) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Alarm journal not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    alarm_history_stream_t* stream = calloc(1, sizeof(alarm_history_stream_t));
+    if (!stream) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
+    stream->req = req;
+    stream->limit = ALARM_HISTORY_DEFAULT_LIMIT;
+
+    // ?from=&to= in Unix milliseconds, ?point=<id>, ?limit=<records>
+    int64_t from_ms = 0;
+    int64_t to_ms = INT64_MAX;
+    uint32_t point_key = 0;
+    char point_id[CONFIG_MAX_ID_LENGTH] = {0};
+    char query[160];
+    char value[24];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "from", value, sizeof(value)) == ESP_OK) {
+            from_ms = strtoll(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "to", value, sizeof(value)) == ESP_OK) {
+            to_ms = strtoll(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK) {
+            unsigned long limit = strtoul(value, NULL, 10);
+            stream->limit = (limit == 0 || limit > ALARM_HISTORY_MAX_LIMIT) ? ALARM_HISTORY_MAX_LIMIT : (uint32_t)limit;
+        }
+        if (httpd_query_key_value(query, "point", point_id, sizeof(point_id)) == ESP_OK && point_id[0] != '\0') {
+            point_key = point_id_index_hash(point_id);
+            stream->point_id = point_id;
+        }
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    static const char header[] = "{\"status\":\"success\",\"records\":[";
+    history_write(stream, header, sizeof(header) - 1);
+
+    esp_err_t ret = alarm_journal_query(g_alarm_journal, from_ms, to_ms, point_key, history_visit, stream);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Alarm history query failed: %s", esp_err_to_name(ret));
+    }
+
+    alarm_journal_stats_t stats = {0};
+    alarm_journal_get_stats(g_alarm_journal, &stats);
+
+    char footer[320];
+    int length = snprintf(footer, sizeof(footer),
+                          "],\"count\":%" PRIu32 ",\"truncated\":%s,\"complete\":%s,"
+                          "\"journal\":{\"appended\":%" PRIu32 ",\"dropped\":%" PRIu32 ",\"flushed\":%" PRIu32 ","
+                          "\"pending\":%" PRIu32 ",\"flushCount\":%" PRIu32 ",\"writeErrors\":%" PRIu32 ","
+                          "\"maxFlushUs\":%" PRIu32 "}}",
+                          stream->count, stream->truncated ? "true" : "false", ret == ESP_OK ? "true" : "false",
+                          stats.appended, stats.dropped, stats.flushed, stats.pending, stats.flush_count,
+                          stats.write_errors, stats.max_flush_us);
+    history_write(stream, footer, (size_t)length);
+    history_flush(stream);
+
+    if (!stream->send_failed) {
+        httpd_resp_send_chunk(req, NULL, 0);
+    }
+
+    ret = stream->send_failed ? ESP_FAIL : ESP_OK;
+    free(stream);
+    return ret;
+}
+
+esp_err_t alarm_get_summary(httpd_req_t *req) {
+    if (!g_alarm_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Alarm manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    alarm_point_summary_t* points = malloc(ALARM_SUMMARY_MAX_POINTS * sizeof(alarm_point_summary_t));
+    if (!points) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
+
+    alarm_summary_t summary;
+    int point_count = 0;
+    esp_err_t ret = alarm_manager_get_summary(g_alarm_manager, &summary, points, ALARM_SUMMARY_MAX_POINTS,
+                                              &point_count);
+    if (ret != ESP_OK) {
+        free(points);
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "Alarm state busy", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddStringToObject(json, "status", "success");
+    cJSON_AddNumberToObject(json, "monitoredPoints", summary.monitored_points);
+    cJSON_AddNumberToObject(json, "pointsInAlarm", summary.points_in_alarm);
+    cJSON_AddNumberToObject(json, "activeAlarms", summary.active_alarms);
+    cJSON_AddNumberToObject(json, "notifiedAlarms", summary.notified_alarms);
+    cJSON_AddNumberToObject(json, "shelvedAlarms", summary.shelved_alarms);
+
+    cJSON *by_type = cJSON_AddObjectToObject(json, "activeByType");
+    for (int t = 0; t < ALARM_TYPE_COUNT; t++) {
+        cJSON_AddNumberToObject(by_type, alarm_type_to_string((uint8_t)t), summary.active_by_type[t]);
+    }
+
+    cJSON *suppression = cJSON_AddObjectToObject(json, "suppression");
+    cJSON_AddNumberToObject(suppression, "notifiedTransitions", summary.notified_transitions);
+    cJSON_AddNumberToObject(suppression, "rateLimited", summary.rate_limited);
+    cJSON_AddNumberToObject(suppression, "shelvedSuppressed", summary.shelved_suppressed);
+    cJSON_AddNumberToObject(suppression, "grouped", summary.grouped);
+
+    cJSON *point_array = cJSON_AddArrayToObject(json, "points");
+    for (int i = 0; i < point_count; i++) {
+        cJSON *point = cJSON_CreateObject();
+        cJSON_AddStringToObject(point, "pointId", points[i].point_id);
+        add_alarm_types(point, "active", points[i].active_mask);
+        add_alarm_types(point, "notified", points[i].notified_mask);
+        add_alarm_types(point, "shelved", points[i].shelved_mask);
+        if (points[i].first_out_type != ALARM_FIRST_OUT_NONE) {
+            cJSON_AddStringToObject(point, "firstOut", alarm_type_to_string(points[i].first_out_type));
+        }
+        cJSON_AddItemToArray(point_array, point);
+    }
+    free(points);
+
+    char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_string, HTTPD_RESP_USE_STRLEN);
+
+    free(json_string);
+    cJSON_Delete(json);
+    return ESP_OK;
+}
+
+esp_err_t alarm_shelve(httpd_req_t *req) {
+    if (!g_alarm_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Alarm manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Read request body
+    char content[256];
+    int content_len = httpd_req_recv(req, content, sizeof(content) - 1);
+    if (content_len <= 0) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Invalid request body", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+    content[content_len] = '\0';
+
+    cJSON *json = cJSON_Parse(content);
+    if (!json) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Invalid JSON", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // {"pointId": "...", "type": "DISCONNECTED" | "ALL", "durationMinutes": n (0 = unshelve)}
+    cJSON *point_item = cJSON_GetObjectItem(json, "pointId");
+    cJSON *type_item = cJSON_GetObjectItem(json, "type");
+    cJSON *duration_item = cJSON_GetObjectItem(json, "durationMinutes");
+    alarm_type_t type = ALARM_TYPE_COUNT;
+    if (!cJSON_IsString(point_item) || !cJSON_IsNumber(duration_item) ||
+        (type_item && (!cJSON_IsString(type_item) || !alarm_type_from_string(type_item->valuestring, &type)))) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Missing or invalid 'pointId', 'type' or 'durationMinutes' field", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    double minutes = duration_item->valuedouble;
+    if (minutes < 0 || minutes * 60000.0 > (double)ALARM_SHELVE_MAX_MS) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Shelve duration out of range", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char point_id[CONFIG_MAX_ID_LENGTH];
+    strncpy(point_id, point_item->valuestring, sizeof(point_id) - 1);
+    point_id[sizeof(point_id) - 1] = '\0';
+    cJSON_Delete(json);
+
+    uint32_t duration_ms = (uint32_t)(minutes * 60000.0);
+    esp_err_t ret = alarm_manager_shelve(g_alarm_manager, point_id, type, duration_ms);
+    if (ret != ESP_OK) {
+        httpd_resp_set_status(req, ret == ESP_ERR_NOT_FOUND ? "404 Not Found" : "500 Internal Server Error");
+        httpd_resp_send(req, ret == ESP_ERR_NOT_FOUND ? "Point not monitored" : "Failed to shelve alarm",
+                        HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "%s %s alarms %s", point_id, type == ALARM_TYPE_COUNT ? "ALL" : alarm_type_to_string(type),
+             duration_ms > 0 ? "shelved" : "unshelved");
+
+    cJSON *response = cJSON_CreateObject();
+    cJSON_AddStringToObject(response, "status", "success");
+    cJSON_AddStringToObject(response, "pointId", point_id);
+    cJSON_AddStringToObject(response, "type", type == ALARM_TYPE_COUNT ? "ALL" : alarm_type_to_string(type));
+    cJSON_AddNumberToObject(response, "durationMs", duration_ms);
+
+    char *json_string = cJSON_PrintUnformatted(response);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_string, HTTPD_RESP_USE_STRLEN);
+
+    free(json_string);
+    cJSON_Delete(response);
+    return ESP_OK;
+}
+
+esp_err_t alarm_controller_init(alarm_manager_t* alarm_manager, alarm_journal_t* journal) {
+    if (!alarm_manager || !journal) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    g_alarm_manager = alarm_manager;
+    g_alarm_journal = journal;
+
+    ESP_LOGI(TAG, "Alarm Controller initialized with alarm journal reference");
+
+    return ESP_OK;
+}
+
+esp_err_t alarm_controller_register_routes(httpd_handle_t server) {
+    if (!server || !g_alarm_manager || !g_alarm_journal) {
+        ESP_LOGE(TAG, "Server handle or alarm journal is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+
+    httpd_uri_t get_history_uri = {
+        .uri = "/api/alarms/history",
+        .method = HTTP_GET,
+        .handler = alarm_get_history,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_history_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/alarms/history: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/alarms/history");
+
+    httpd_uri_t get_summary_uri = {
+        .uri = "/api/alarms/summary",
+        .method = HTTP_GET,
+        .handler = alarm_get_summary,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_summary_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/alarms/summary: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/alarms/summary");
+
+    httpd_uri_t shelve_uri = {
+        .uri = "/api/alarms/shelve",
+        .method = HTTP_POST,
+        .handler = alarm_shelve,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &shelve_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register POST /api/alarms/shelve: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: POST /api/alarms/shelve");
+
+    return ESP_OK;
+}
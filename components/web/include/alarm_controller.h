@@ -0,0 +1,92 @@
+/**
+ * @file alarm_controller.h
+ * @brief Alarm Controller for SNRv9 Irrigation Control System
+ *
+ * Provides web endpoints for alarm history from the alarm journal, the
+ * alarm summary and alarm shelving.
+ */
+
+#ifndef ALARM_CONTROLLER_H
+#define ALARM_CONTROLLER_H
+
+#include <esp_err.h>
+#include <esp_http_server.h>
+#include "alarm_manager.h"
+#include "alarm_journal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Records returned by a history query when no limit is given
+ */
+#define ALARM_HISTORY_DEFAULT_LIMIT 500
+
+/**
+ * @brief Largest accepted history query limit
+ */
+#define ALARM_HISTORY_MAX_LIMIT 5000
+
+/**
+ * @brief Most points listed by a summary request
+ */
+#define ALARM_SUMMARY_MAX_POINTS 64
+
+/**
+ * @brief Initialize alarm controller
+ *
+ * @param alarm_manager Pointer to alarm manager instance (resolves point IDs)
+ * @param journal Pointer to alarm journal instance
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_controller_init(alarm_manager_t* alarm_manager, alarm_journal_t* journal);
+
+/**
+ * @brief Register alarm routes with HTTP server
+ *
+ * @param server HTTP server handle
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_controller_register_routes(httpd_handle_t server);
+
+/**
+ * @brief Get alarm history
+ *
+ * GET /api/alarms/history?from=&to=&point=&limit= streams the journal
+ * records in [from, to] (Unix milliseconds, both optional) as a chunked
+ * JSON response, optionally for a single point ID, up to limit records
+ * (default ALARM_HISTORY_DEFAULT_LIMIT).
+ *
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_get_history(httpd_req_t *req);
+
+/**
+ * @brief Get alarm summary
+ *
+ * GET /api/alarms/summary returns alarm counts, suppression counters and
+ * the points with active or shelved alarms (up to ALARM_SUMMARY_MAX_POINTS).
+ *
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_get_summary(httpd_req_t *req);
+
+/**
+ * @brief Shelve or unshelve alarms of a point
+ *
+ * POST /api/alarms/shelve with {"pointId", "type" (alarm type name or
+ * "ALL", default "ALL"), "durationMinutes" (0 = unshelve)}.
+ *
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t alarm_shelve(httpd_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALARM_CONTROLLER_H
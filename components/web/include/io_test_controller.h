@@ -43,6 +43,9 @@ esp_err_t io_test_get_all_points(httpd_req_t *req);
 /**
  * @brief Get specific IO point status
  * 
+ * Served by the GET /api/io/points/{id} wildcard route; the point ID is
+ * resolved through the IO manager's ID index.
+ * 
  * @param req HTTP request
  * @return esp_err_t ESP_OK on success, error code on failure
  */
@@ -51,11 +54,29 @@ esp_err_t io_test_get_point(httpd_req_t *req);
 /**
  * @brief Set binary output state
  * 
+ * Served by the POST /api/io/points/{id}/set wildcard route. Replies 404
+ * for unknown points or paths, 400 for non-output points and 409 while an
+ * interlock holds the output.
+ * 
  * @param req HTTP request
  * @return esp_err_t ESP_OK on success, error code on failure
  */
 esp_err_t io_test_set_output(httpd_req_t *req);
 
+/**
+ * @brief Set several binary outputs in one latch
+ * 
+ * Body: {"outputs": [{"pointId": "...", "state": true}, ...]}. All points are
+ * validated before anything is written; an output held by an interlock at
+ * that point refuses the whole batch with 409. If an interlock trips
+ * between staging and the latch, the other outputs still switch and the
+ * reply is 409 with "applied" and the "refused" point IDs.
+ * 
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_test_set_outputs_batch(httpd_req_t *req);
+
 /**
  * @brief Get IO system statistics
  * 
@@ -64,6 +85,18 @@ esp_err_t io_test_set_output(httpd_req_t *req);
  */
 esp_err_t io_test_get_statistics(httpd_req_t *req);
 
+/**
+ * @brief Get scan timing histograms
+ * 
+ * Log2-bucket histograms of wake-up jitter, shift register I/O, input reads,
+ * conditioning, mutex wait and whole scan passes, with mean, p50, p99 and
+ * max per metric. ?reset=1 clears the histograms after the read.
+ * 
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t io_test_get_timing(httpd_req_t *req);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,85 @@
+/**
+ * @file trend_controller.h
+ * @brief Trend Controller for SNRv9 Irrigation Control System
+ *
+ * Provides web endpoints for the trend history kept by the trending manager.
+ */
+
+#ifndef TREND_CONTROLLER_H
+#define TREND_CONTROLLER_H
+
+#include <esp_err.h>
+#include <esp_http_server.h>
+#include "trending_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Samples returned by a data query when no limit is given
+ */
+#define TREND_DATA_DEFAULT_LIMIT 2000
+
+/**
+ * @brief Largest accepted data query limit
+ */
+#define TREND_DATA_MAX_LIMIT 20000
+
+/**
+ * @brief Most points listed by a status request
+ */
+#define TREND_STATUS_MAX_POINTS 128
+
+/**
+ * @brief Initialize trend controller
+ *
+ * @param trending_manager Pointer to trending manager instance
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trend_controller_init(trending_manager_t* trending_manager);
+
+/**
+ * @brief Register trend routes with HTTP server
+ *
+ * @param server HTTP server handle
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trend_controller_register_routes(httpd_handle_t server);
+
+/**
+ * @brief Get trend samples of a point
+ *
+ * GET /api/trends/data?point=&from=&to=&limit= streams the samples of a
+ * trended point in [from, to] (Unix milliseconds, both optional) as a
+ * chunked JSON response of [time, value] pairs, up to limit samples
+ * (default TREND_DATA_DEFAULT_LIMIT). Binary points return their state
+ * changes, starting with the state at from.
+ *
+ * With resolution=<seconds>, or points=<count> to spread that many buckets
+ * over the range, the response instead carries "tier", "bucketMs" and
+ * "buckets" of [start, min, max, mean, count] read from the coarsest rollup
+ * tier at least that fine (raw samples below 1 min, as buckets of one).
+ *
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trend_get_data(httpd_req_t *req);
+
+/**
+ * @brief Get trending status
+ *
+ * GET /api/trends/status returns pool usage and, per trended point (up to
+ * TREND_STATUS_MAX_POINTS), the samples held, time span and bytes per sample,
+ * and the buckets held and time span of each rollup tier.
+ *
+ * @param req HTTP request
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t trend_get_status(httpd_req_t *req);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREND_CONTROLLER_H
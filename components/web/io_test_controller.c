@@ -8,16 +8,23 @@
 #include "esp_log.h"
 #include "cJSON.h"
 #include <string.h>
+#include <stdlib.h>
 
 static const char* TAG = "IO_TEST_CTRL";
 
+#define IO_BATCH_MAX_BODY 2048  ///< Largest accepted output batch request body
+
 // Global IO manager reference
 static io_manager_t* g_io_manager = NULL;
 
 /**
  * @brief Parse point ID from URI
+ * 
+ * @param action Expected action after the ID ("set"), or NULL for none
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the path after the
+ *         ID is not the expected action, ESP_ERR_INVALID_SIZE for a bad ID
  */
-static esp_err_t parse_point_id_from_uri(const char* uri, char* point_id, size_t max_len) {
+static esp_err_t parse_point_id_from_uri(const char* uri, const char* action, char* point_id, size_t max_len) {
     // URI format: /api/io/points/{point_id} or /api/io/points/{point_id}/set
     const char* prefix = "/api/io/points/";
     size_t prefix_len = strlen(prefix);
@@ -27,19 +34,26 @@ static esp_err_t parse_point_id_from_uri(const char* uri, char* point_id, size_t
     }
     
     const char* id_start = uri + prefix_len;
-    const char* id_end = strchr(id_start, '/');  // Look for next '/' (for /set)
-    if (!id_end) {
-        id_end = strchr(id_start, '?');  // Look for query parameters
-    }
-    if (!id_end) {
-        id_end = id_start + strlen(id_start);  // End of string
-    }
+    const char* id_end = id_start + strcspn(id_start, "/?");
     
     size_t id_len = id_end - id_start;
     if (id_len >= max_len || id_len == 0) {
         return ESP_ERR_INVALID_SIZE;
     }
     
+    // One wildcard route serves every point, so the rest of the path must match here
+    const char* rest = id_end;
+    if (action) {
+        size_t action_len = strlen(action);
+        if (rest[0] != '/' || strncmp(rest + 1, action, action_len) != 0) {
+            return ESP_ERR_NOT_FOUND;
+        }
+        rest += 1 + action_len;
+    }
+    if (rest[0] != '\0' && rest[0] != '?') {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
     strncpy(point_id, id_start, id_len);
     point_id[id_len] = '\0';
     
@@ -60,6 +74,18 @@ static const char* io_point_type_to_string(io_point_type_t type) {
     }
 }
 
+/**
+ * @brief Convert scan class to string
+ */
+static const char* scan_class_to_string(io_scan_class_t scan_class) {
+    switch (scan_class) {
+        case IO_SCAN_CLASS_FAST: return "FAST";
+        case IO_SCAN_CLASS_NORMAL: return "NORMAL";
+        case IO_SCAN_CLASS_SLOW: return "SLOW";
+        default: return "UNKNOWN";
+    }
+}
+
 /**
  * @brief Convert BO type to string
  */
@@ -82,31 +108,74 @@ esp_err_t io_test_get_all_points(httpd_req_t *req) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    // Get all point IDs
-    char point_ids[32][CONFIG_MAX_ID_LENGTH];
+    // Get all point IDs (buffers sized to the configured point count)
+    int capacity = g_io_manager->active_point_count > 0 ? g_io_manager->active_point_count : 1;
+    char (*point_ids)[CONFIG_MAX_ID_LENGTH] = malloc(capacity * CONFIG_MAX_ID_LENGTH);
+    io_point_snapshot_t* snapshot = malloc(capacity * sizeof(io_point_snapshot_t));
     int point_count = 0;
+    int snapshot_count = 0;
+    uint32_t snapshot_sequence = 0;
+    if (!point_ids || !snapshot) {
+        free(point_ids);
+        free(snapshot);
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
     
-    esp_err_t ret = io_manager_get_all_point_ids(g_io_manager, point_ids, 32, &point_count);
+    esp_err_t ret = io_manager_get_all_point_ids(g_io_manager, point_ids, capacity, &point_count);
     if (ret != ESP_OK) {
+        free(point_ids);
+        free(snapshot);
         httpd_resp_set_status(req, "500 Internal Server Error");
         httpd_resp_send(req, "Failed to get IO points", HTTPD_RESP_USE_STRLEN);
         return ret;
     }
     
+    // Get a consistent view of all runtime states in one call
+    ret = io_manager_get_snapshot(g_io_manager, snapshot, capacity, &snapshot_count, &snapshot_sequence);
+    if (ret != ESP_OK) {
+        free(point_ids);
+        free(snapshot);
+        httpd_resp_set_status(req, "503 Service Unavailable");
+        httpd_resp_send(req, "IO snapshot unavailable", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    if (snapshot_count < point_count) {
+        point_count = snapshot_count;
+    }
+    
+    // Optional ?since=<changeSequence>: report only points that changed after it
+    bool changes_only = false;
+    uint32_t since = 0;
+    char query[48];
+    char since_value[16];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "since", since_value, sizeof(since_value)) == ESP_OK) {
+        changes_only = true;
+        since = (uint32_t)strtoul(since_value, NULL, 10);
+    }
+    
     // Create JSON response
     cJSON *json = cJSON_CreateObject();
     cJSON *points_array = cJSON_CreateArray();
+    int returned_count = 0;
+    uint32_t latest_change = since;
     
     for (int i = 0; i < point_count; i++) {
+        if (snapshot[i].change_sequence > latest_change) {
+            latest_change = snapshot[i].change_sequence;
+        }
+        if (changes_only && snapshot[i].change_sequence <= since) {
+            continue;
+        }
+        
         // Get point configuration
         io_point_config_t config;
         ret = config_manager_get_io_point_config(g_io_manager->config_manager, point_ids[i], &config);
         if (ret != ESP_OK) continue;
         
-        // Get runtime state
-        io_point_runtime_state_t state;
-        ret = io_manager_get_runtime_state(g_io_manager, point_ids[i], &state);
-        if (ret != ESP_OK) continue;
+        const io_point_snapshot_t* state = &snapshot[i];
         
         // Create point object
         cJSON *point = cJSON_CreateObject();
@@ -118,6 +187,7 @@ esp_err_t io_test_get_all_points(httpd_req_t *req) {
         cJSON_AddNumberToObject(point, "chipIndex", config.chip_index);
         cJSON_AddNumberToObject(point, "bitIndex", config.bit_index);
         cJSON_AddBoolToObject(point, "isInverted", config.is_inverted);
+        cJSON_AddStringToObject(point, "scanClass", scan_class_to_string(config.scan_class));
         
         // Add BO specific fields
         if (config.type == IO_POINT_TYPE_GPIO_BO || config.type == IO_POINT_TYPE_SHIFT_REG_BO) {
@@ -128,21 +198,27 @@ esp_err_t io_test_get_all_points(httpd_req_t *req) {
         
         // Add runtime state
         cJSON *runtime = cJSON_CreateObject();
-        cJSON_AddNumberToObject(runtime, "rawValue", state.raw_value);
-        cJSON_AddNumberToObject(runtime, "conditionedValue", state.conditioned_value);
-        cJSON_AddBoolToObject(runtime, "digitalState", state.digital_state);
-        cJSON_AddBoolToObject(runtime, "errorState", state.error_state);
-        cJSON_AddNumberToObject(runtime, "lastUpdateTime", (double)state.last_update_time);
-        cJSON_AddNumberToObject(runtime, "updateCount", state.update_count);
-        cJSON_AddNumberToObject(runtime, "errorCount", state.error_count);
-        cJSON_AddBoolToObject(runtime, "alarmActive", state.alarm_active);
+        cJSON_AddNumberToObject(runtime, "rawValue", state->raw_value);
+        cJSON_AddNumberToObject(runtime, "conditionedValue", state->conditioned_value);
+        cJSON_AddBoolToObject(runtime, "digitalState", state->digital_state);
+        cJSON_AddBoolToObject(runtime, "errorState", state->error_state);
+        cJSON_AddNumberToObject(runtime, "lastUpdateTime", (double)state->last_update_time);
+        cJSON_AddNumberToObject(runtime, "updateCount", state->update_count);
+        cJSON_AddNumberToObject(runtime, "errorCount", state->error_count);
+        cJSON_AddBoolToObject(runtime, "alarmActive", state->alarm_active);
+        cJSON_AddNumberToObject(runtime, "changeSequence", state->change_sequence);
         cJSON_AddItemToObject(point, "runtime", runtime);
         
         cJSON_AddItemToArray(points_array, point);
+        returned_count++;
     }
+    free(point_ids);
+    free(snapshot);
     
     cJSON_AddItemToObject(json, "points", points_array);
-    cJSON_AddNumberToObject(json, "totalCount", point_count);
+    cJSON_AddNumberToObject(json, "totalCount", returned_count);
+    cJSON_AddNumberToObject(json, "snapshotSequence", snapshot_sequence);
+    cJSON_AddNumberToObject(json, "changeSequence", latest_change);
     cJSON_AddStringToObject(json, "status", "success");
     
     // Send response
@@ -166,16 +242,25 @@ esp_err_t io_test_get_point(httpd_req_t *req) {
     
     // Parse point ID from URI
     char point_id[CONFIG_MAX_ID_LENGTH];
-    esp_err_t ret = parse_point_id_from_uri(req->uri, point_id, sizeof(point_id));
+    esp_err_t ret = parse_point_id_from_uri(req->uri, NULL, point_id, sizeof(point_id));
+    if (ret == ESP_ERR_NOT_FOUND) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "Unknown point route", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "400 Bad Request");
         httpd_resp_send(req, "Invalid point ID", HTTPD_RESP_USE_STRLEN);
         return ret;
     }
     
-    // Get point configuration
+    // Resolve through the hashed ID indexes of the IO and config managers
+    io_point_handle_t handle;
     io_point_config_t config;
-    ret = config_manager_get_io_point_config(g_io_manager->config_manager, point_id, &config);
+    ret = io_manager_resolve_handle(g_io_manager, point_id, &handle);
+    if (ret == ESP_OK) {
+        ret = config_manager_get_io_point_config(g_io_manager->config_manager, point_id, &config);
+    }
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "404 Not Found");
         httpd_resp_send(req, "Point not found", HTTPD_RESP_USE_STRLEN);
@@ -184,7 +269,7 @@ esp_err_t io_test_get_point(httpd_req_t *req) {
     
     // Get runtime state
     io_point_runtime_state_t state;
-    ret = io_manager_get_runtime_state(g_io_manager, point_id, &state);
+    ret = io_manager_get_runtime_state_by_handle(g_io_manager, handle, &state);
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "500 Internal Server Error");
         httpd_resp_send(req, "Failed to get runtime state", HTTPD_RESP_USE_STRLEN);
@@ -201,6 +286,7 @@ esp_err_t io_test_get_point(httpd_req_t *req) {
     cJSON_AddNumberToObject(json, "chipIndex", config.chip_index);
     cJSON_AddNumberToObject(json, "bitIndex", config.bit_index);
     cJSON_AddBoolToObject(json, "isInverted", config.is_inverted);
+    cJSON_AddStringToObject(json, "scanClass", scan_class_to_string(config.scan_class));
     
     // Add BO specific fields
     if (config.type == IO_POINT_TYPE_GPIO_BO || config.type == IO_POINT_TYPE_SHIFT_REG_BO) {
@@ -219,6 +305,13 @@ esp_err_t io_test_get_point(httpd_req_t *req) {
     cJSON_AddNumberToObject(runtime, "updateCount", state.update_count);
     cJSON_AddNumberToObject(runtime, "errorCount", state.error_count);
     cJSON_AddBoolToObject(runtime, "alarmActive", state.alarm_active);
+    cJSON_AddNumberToObject(runtime, "changeSequence", state.change_sequence);
+    if (config.type == IO_POINT_TYPE_GPIO_BO || config.type == IO_POINT_TYPE_SHIFT_REG_BO) {
+        cJSON *pulse = cJSON_AddObjectToObject(runtime, "timedPulse");
+        cJSON_AddBoolToObject(pulse, "active", state.timed_pulse_active);
+        cJSON_AddNumberToObject(pulse, "requestedUs", (double)state.timed_pulse_requested_us);
+        cJSON_AddNumberToObject(pulse, "achievedUs", (double)state.timed_pulse_achieved_us);
+    }
     cJSON_AddItemToObject(json, "runtime", runtime);
     
     cJSON_AddStringToObject(json, "status", "success");
@@ -244,13 +337,25 @@ esp_err_t io_test_set_output(httpd_req_t *req) {
     
     // Parse point ID from URI
     char point_id[CONFIG_MAX_ID_LENGTH];
-    esp_err_t ret = parse_point_id_from_uri(req->uri, point_id, sizeof(point_id));
+    esp_err_t ret = parse_point_id_from_uri(req->uri, "set", point_id, sizeof(point_id));
+    if (ret == ESP_ERR_NOT_FOUND) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "Unknown point route", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "400 Bad Request");
         httpd_resp_send(req, "Invalid point ID", HTTPD_RESP_USE_STRLEN);
         return ret;
     }
     
+    io_point_handle_t handle;
+    if (io_manager_resolve_handle(g_io_manager, point_id, &handle) != ESP_OK) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "Point not found", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NOT_FOUND;
+    }
+    
     // Read request body
     char content[256];
     int content_len = httpd_req_recv(req, content, sizeof(content) - 1);
@@ -281,7 +386,23 @@ esp_err_t io_test_set_output(httpd_req_t *req) {
     cJSON_Delete(json);
     
     // Set output state
-    ret = io_manager_set_binary_output(g_io_manager, point_id, state);
+    ret = io_manager_set_binary_output_by_handle(g_io_manager, handle, state);
+    if (ret == ESP_ERR_NOT_FOUND) {
+        // Configuration reloaded since the handle was resolved
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "Point not found", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    if (ret == ESP_ERR_INVALID_ARG) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Point is not a binary output", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    if (ret == ESP_ERR_INVALID_STATE) {
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_send(req, "Output held by an interlock", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "500 Internal Server Error");
         httpd_resp_send(req, "Failed to set output state", HTTPD_RESP_USE_STRLEN);
@@ -306,6 +427,164 @@ esp_err_t io_test_set_output(httpd_req_t *req) {
     return ESP_OK;
 }
 
+esp_err_t io_test_set_outputs_batch(httpd_req_t *req) {
+    if (!g_io_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "IO Manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (req->content_len == 0 || req->content_len > IO_BATCH_MAX_BODY) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Invalid request body size", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    
+    // Read request body
+    char *content = malloc(req->content_len + 1);
+    if (!content) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    int received = 0;
+    while (received < (int)req->content_len) {
+        int len = httpd_req_recv(req, content + received, req->content_len - received);
+        if (len <= 0) {
+            free(content);
+            httpd_resp_set_status(req, "400 Bad Request");
+            httpd_resp_send(req, "Invalid request body", HTTPD_RESP_USE_STRLEN);
+            return ESP_ERR_INVALID_ARG;
+        }
+        received += len;
+    }
+    content[received] = '\0';
+    
+    // Parse JSON
+    cJSON *json = cJSON_Parse(content);
+    free(content);
+    if (!json) {
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Invalid JSON", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    cJSON *outputs = cJSON_GetObjectItem(json, "outputs");
+    if (!outputs || !cJSON_IsArray(outputs) || cJSON_GetArraySize(outputs) == 0) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Missing or empty 'outputs' array", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // Stage everything first so a bad entry rejects the whole batch
+    io_output_batch_t batch;
+    esp_err_t ret = io_manager_begin_outputs(g_io_manager, &batch);
+    
+    cJSON *entry = NULL;
+    cJSON_ArrayForEach(entry, outputs) {
+        if (ret != ESP_OK) {
+            break;
+        }
+        
+        cJSON *id_item = cJSON_GetObjectItem(entry, "pointId");
+        cJSON *state_item = cJSON_GetObjectItem(entry, "state");
+        if (!cJSON_IsString(id_item) || !state_item || !cJSON_IsBool(state_item)) {
+            ret = ESP_ERR_INVALID_ARG;
+            break;
+        }
+        
+        io_point_handle_t handle;
+        ret = io_manager_resolve_handle(g_io_manager, id_item->valuestring, &handle);
+        if (ret == ESP_OK) {
+            ret = io_manager_set_output(g_io_manager, &batch, handle, cJSON_IsTrue(state_item));
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Rejected output batch entry '%s': %s", id_item->valuestring, esp_err_to_name(ret));
+        }
+    }
+    
+    if (ret == ESP_ERR_INVALID_STATE) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_send(req, "Output held by an interlock, batch not applied", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    if (ret != ESP_OK) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "400 Bad Request");
+        httpd_resp_send(req, "Invalid output entry (unknown point, not a binary output, or bad 'state')", 
+                        HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    
+    int staged_count = batch.staged_count;
+    uint32_t generation = batch.generation;
+    ret = io_manager_commit_outputs(g_io_manager, &batch);
+    if (ret == ESP_ERR_INVALID_STATE && generation != g_io_manager->point_generation) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_send(req, "Configuration reloaded, batch not applied", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    if (ret == ESP_ERR_INVALID_STATE || ret == ESP_ERR_INVALID_ARG) {
+        // Interlocked (tripped since staging) or unmapped outputs were refused, the rest latched
+        cJSON *response = cJSON_CreateObject();
+        cJSON_AddStringToObject(response, "status", "partial");
+        cJSON *refused = cJSON_AddArrayToObject(response, "refused");
+        int applied = 0;
+        cJSON_ArrayForEach(entry, outputs) {
+            const char* point_id = cJSON_GetObjectItem(entry, "pointId")->valuestring;
+            io_point_handle_t handle;
+            if (io_manager_resolve_handle(g_io_manager, point_id, &handle) == ESP_OK &&
+                io_manager_output_staged(&batch, handle)) {
+                applied++;
+            } else {
+                cJSON_AddItemToArray(refused, cJSON_CreateString(point_id));
+            }
+        }
+        cJSON_AddNumberToObject(response, "applied", applied);
+        cJSON_AddStringToObject(response, "message", ret == ESP_ERR_INVALID_STATE ? 
+                                "Outputs held by an interlock were refused, the rest latched" : 
+                                "Outputs outside the shift register chain were refused, the rest latched");
+        cJSON_Delete(json);
+        
+        char *json_string = cJSON_Print(response);
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_set_type(req, "application/json");
+        httpd_resp_send(req, json_string, strlen(json_string));
+        
+        free(json_string);
+        cJSON_Delete(response);
+        return ret;
+    }
+    if (ret != ESP_OK) {
+        cJSON_Delete(json);
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Failed to commit output batch", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    
+    // Create success response echoing the applied outputs
+    cJSON *response = cJSON_CreateObject();
+    cJSON_AddStringToObject(response, "status", "success");
+    cJSON_AddNumberToObject(response, "committed", staged_count);
+    cJSON_AddItemToObject(response, "outputs", cJSON_DetachItemFromObject(json, "outputs"));
+    cJSON_AddStringToObject(response, "message", "Output batch latched successfully");
+    cJSON_Delete(json);
+    
+    char *json_string = cJSON_Print(response);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    // Cleanup
+    free(json_string);
+    cJSON_Delete(response);
+    
+    return ESP_OK;
+}
+
 esp_err_t io_test_get_statistics(httpd_req_t *req) {
     if (!g_io_manager) {
         httpd_resp_set_status(req, "500 Internal Server Error");
@@ -318,7 +597,7 @@ esp_err_t io_test_get_statistics(httpd_req_t *req) {
     uint32_t total_errors = 0;
     uint64_t last_update_time = 0;
     
-    esp_err_t ret = io_manager_get_statistics(g_io_manager, &update_cycles, &total_errors, &last_update_time);
+    esp_err_t ret = io_manager_get_statistics(g_io_manager, &update_cycles, &total_errors, &last_update_time, NULL);
     if (ret != ESP_OK) {
         httpd_resp_set_status(req, "500 Internal Server Error");
         httpd_resp_send(req, "Failed to get statistics", HTTPD_RESP_USE_STRLEN);
@@ -346,6 +625,84 @@ esp_err_t io_test_get_statistics(httpd_req_t *req) {
     return ESP_OK;
 }
 
+esp_err_t io_test_get_timing(httpd_req_t *req) {
+    static const char* const metric_names[IO_TIMING_METRIC_COUNT] = {
+        "wakeJitter", "shiftRegister", "inputReads", "conditioning", "mutexWait", "scanCycle",
+        "interlockLatency"
+    };
+    
+    if (!g_io_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "IO Manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    io_scan_timing_t* timing = malloc(sizeof(io_scan_timing_t));
+    if (!timing) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    uint32_t update_cycles = 0;
+    esp_err_t ret = io_manager_get_statistics(g_io_manager, &update_cycles, NULL, NULL, timing);
+    if (ret != ESP_OK) {
+        free(timing);
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Failed to get timing", HTTPD_RESP_USE_STRLEN);
+        return ret;
+    }
+    
+    // ?reset=1 clears the histograms after this read
+    char query[32];
+    char reset_value[8];
+    bool reset = httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+                 httpd_query_key_value(query, "reset", reset_value, sizeof(reset_value)) == ESP_OK &&
+                 (strcmp(reset_value, "1") == 0 || strcmp(reset_value, "true") == 0);
+    if (reset) {
+        io_manager_reset_timing(g_io_manager);
+    }
+    
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddStringToObject(json, "status", "success");
+    cJSON_AddNumberToObject(json, "updateCycles", update_cycles);
+    cJSON_AddNumberToObject(json, "deadlineMisses", timing->deadline_misses);
+    cJSON_AddBoolToObject(json, "reset", reset);
+    
+    // Bucket k holds samples below bucketUpperUs[k] (the last bucket is open-ended)
+    cJSON *bounds = cJSON_AddArrayToObject(json, "bucketUpperUs");
+    for (int b = 0; b < IO_TIMING_BUCKETS; b++) {
+        cJSON_AddItemToArray(bounds, cJSON_CreateNumber((double)(1U << b)));
+    }
+    
+    cJSON *metrics = cJSON_AddObjectToObject(json, "metrics");
+    for (int m = 0; m < IO_TIMING_METRIC_COUNT; m++) {
+        const io_timing_histogram_t* histogram = &timing->histograms[m];
+        cJSON *metric = cJSON_AddObjectToObject(metrics, metric_names[m]);
+        cJSON_AddNumberToObject(metric, "count", histogram->count);
+        cJSON_AddNumberToObject(metric, "meanUs", histogram->count ? 
+                                (double)histogram->total_us / histogram->count : 0.0);
+        cJSON_AddNumberToObject(metric, "p50Us", io_manager_timing_percentile(histogram, 50.0f));
+        cJSON_AddNumberToObject(metric, "p99Us", io_manager_timing_percentile(histogram, 99.0f));
+        cJSON_AddNumberToObject(metric, "maxUs", histogram->max_us);
+        
+        cJSON *buckets = cJSON_AddArrayToObject(metric, "buckets");
+        for (int b = 0; b < IO_TIMING_BUCKETS; b++) {
+            cJSON_AddItemToArray(buckets, cJSON_CreateNumber(histogram->buckets[b]));
+        }
+    }
+    free(timing);
+    
+    char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_string, strlen(json_string));
+    
+    free(json_string);
+    cJSON_Delete(json);
+    
+    return ESP_OK;
+}
+
 esp_err_t io_test_controller_init(io_manager_t* io_manager) {
     if (!io_manager) {
         return ESP_ERR_INVALID_ARG;
@@ -364,7 +721,8 @@ esp_err_t io_test_controller_register_routes(httpd_handle_t server) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    ESP_LOGI(TAG, "Starting dynamic IO test controller route registration...");
+    ESP_LOGI(TAG, "Starting IO test controller route registration...");
+    esp_err_t ret;
 
     // Base routes
     httpd_uri_t get_all_points_uri = {
@@ -373,7 +731,11 @@ esp_err_t io_test_controller_register_routes(httpd_handle_t server) {
         .handler = io_test_get_all_points,
         .user_ctx = NULL
     };
-    httpd_register_uri_handler(server, &get_all_points_uri);
+    ret = httpd_register_uri_handler(server, &get_all_points_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/io/points: %s", esp_err_to_name(ret));
+        return ret;
+    }
     ESP_LOGI(TAG, "Registered: GET /api/io/points");
 
     httpd_uri_t get_statistics_uri = {
@@ -382,47 +744,65 @@ esp_err_t io_test_controller_register_routes(httpd_handle_t server) {
         .handler = io_test_get_statistics,
         .user_ctx = NULL
     };
-    httpd_register_uri_handler(server, &get_statistics_uri);
+    ret = httpd_register_uri_handler(server, &get_statistics_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/io/statistics: %s", esp_err_to_name(ret));
+        return ret;
+    }
     ESP_LOGI(TAG, "Registered: GET /api/io/statistics");
 
-    // Dynamically register routes for each IO point
-    char point_ids[32][CONFIG_MAX_ID_LENGTH];
-    int point_count = 0;
-    io_manager_get_all_point_ids(g_io_manager, point_ids, 32, &point_count);
+    httpd_uri_t get_timing_uri = {
+        .uri = "/api/io/timing",
+        .method = HTTP_GET,
+        .handler = io_test_get_timing,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_timing_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/io/timing: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/io/timing");
 
-    for (int i = 0; i < point_count; i++) {
-        io_point_config_t config;
-        if (config_manager_get_io_point_config(g_io_manager->config_manager, point_ids[i], &config) == ESP_OK) {
-            
-            // Register GET /api/io/points/{id}
-            char* get_uri = malloc(strlen("/api/io/points/") + strlen(config.id) + 1);
-            sprintf(get_uri, "/api/io/points/%s", config.id);
-            
-            httpd_uri_t get_point_uri = {
-                .uri = get_uri,
-                .method = HTTP_GET,
-                .handler = io_test_get_point,
-                .user_ctx = (void*)get_uri // Pass URI to be freed later
-            };
-            httpd_register_uri_handler(server, &get_point_uri);
-            ESP_LOGI(TAG, "Registered: GET %s", get_uri);
+    httpd_uri_t set_outputs_batch_uri = {
+        .uri = "/api/io/outputs/batch",
+        .method = HTTP_POST,
+        .handler = io_test_set_outputs_batch,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &set_outputs_batch_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register POST /api/io/outputs/batch: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: POST /api/io/outputs/batch");
 
-            // If it's a binary output, register the POST .../set route
-            if (config.type == IO_POINT_TYPE_GPIO_BO || config.type == IO_POINT_TYPE_SHIFT_REG_BO) {
-                char* set_uri = malloc(strlen("/api/io/points/") + strlen(config.id) + strlen("/set") + 1);
-                sprintf(set_uri, "/api/io/points/%s/set", config.id);
+    // One wildcard route per method serves every point (needs httpd_uri_match_wildcard)
+    httpd_uri_t get_point_uri = {
+        .uri = "/api/io/points/*",
+        .method = HTTP_GET,
+        .handler = io_test_get_point,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_point_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/io/points/*: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/io/points/*");
 
-                httpd_uri_t set_output_uri = {
-                    .uri = set_uri,
-                    .method = HTTP_POST,
-                    .handler = io_test_set_output,
-                    .user_ctx = (void*)set_uri // Pass URI to be freed later
-                };
-                httpd_register_uri_handler(server, &set_output_uri);
-                ESP_LOGI(TAG, "Registered: POST %s", set_uri);
-            }
-        }
+    httpd_uri_t set_output_uri = {
+        .uri = "/api/io/points/*",
+        .method = HTTP_POST,
+        .handler = io_test_set_output,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &set_output_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register POST /api/io/points/*/set: %s", esp_err_to_name(ret));
+        return ret;
     }
+    ESP_LOGI(TAG, "Registered: POST /api/io/points/*/set");
 
     ESP_LOGI(TAG, "IO Test Controller routes registered successfully");
     return ESP_OK;
@@ -0,0 +1,335 @@
+/**
+ * @file trend_controller.c
+ * @brief Trend Controller implementation for SNRv9 Irrigation Control System
+ */
+
+#include "trend_controller.h"
+#include "debug_config.h"
+#include "esp_log.h"
+#include "cJSON.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+static const char* TAG = "TREND_CTRL";
+
+#define TREND_DATA_CHUNK_SIZE 1024      ///< Response bytes buffered per HTTP chunk
+#define TREND_DATA_SAMPLE_MAX 96        ///< Longest formatted sample or bucket
+
+/**
+ * @brief Tier names as reported in responses
+ */
+static const char* const TREND_TIER_NAMES[TRENDING_TIER_COUNT] = { "raw", "1m", "15m", "1h" };
+
+// Global references
+static trending_manager_t* g_trending_manager = NULL;
+
+/**
+ * @brief Streaming state of a data request
+ */
+typedef struct {
+    httpd_req_t* req;                           ///< Request being answered
+    char buffer[TREND_DATA_CHUNK_SIZE];         ///< Pending response bytes
+    size_t length;                              ///< Bytes in buffer
+    uint32_t count;                             ///< Samples sent
+    uint32_t limit;                             ///< Samples allowed
+    bool truncated;                             ///< Stopped at the limit
+    bool send_failed;                           ///< Client went away
+} trend_data_stream_t;
+
+/**
+ * @brief Send the buffered bytes as one chunk
+ */
+static bool data_flush(trend_data_stream_t* stream) {
+    if (stream->length > 0 && !stream->send_failed) {
+        if (httpd_resp_send_chunk(stream->req, stream->buffer, stream->length) != ESP_OK) {
+            stream->send_failed = true;
+        }
+    }
+    stream->length = 0;
+    return !stream->send_failed;
+}
+
+/**
+ * @brief Append text to the response, sending a chunk when the buffer fills
+ */
+static bool data_write(trend_data_stream_t* stream, const char* text, size_t length) {
+    if (stream->length + length > sizeof(stream->buffer) && !data_flush(stream)) {
+        return false;
+    }
+    memcpy(stream->buffer + stream->length, text, length);
+    stream->length += length;
+    return true;
+}
+
+/**
+ * @brief Trend visitor: format one sample into the response
+ */
+static bool data_visit(int64_t time_ms, float value, void* context) {
+    trend_data_stream_t* stream = (trend_data_stream_t*)context;
+
+    if (stream->count >= stream->limit) {
+        stream->truncated = true;
+        return false;
+    }
+
+    char line[TREND_DATA_SAMPLE_MAX];
+    int length = snprintf(line, sizeof(line), "%s[%" PRId64 ",%.7g]",
+                          stream->count > 0 ? "," : "", time_ms, (double)value);
+    if (length <= 0 || length >= (int)sizeof(line)) {
+        return true;
+    }
+
+    stream->count++;
+    return data_write(stream, line, (size_t)length);
+}
+
+/**
+ * @brief Bucket visitor: format one bucket into the response
+ */
+static bool data_visit_bucket(const trending_bucket_t* bucket, void* context) {
+    trend_data_stream_t* stream = (trend_data_stream_t*)context;
+
+    if (stream->count >= stream->limit) {
+        stream->truncated = true;
+        return false;
+    }
+
+    char line[TREND_DATA_SAMPLE_MAX];
+    int length = snprintf(line, sizeof(line), "%s[%" PRId64 ",%.7g,%.7g,%.7g,%" PRIu32 "]",
+                          stream->count > 0 ? "," : "", bucket->start_ms, (double)bucket->min,
+                          (double)bucket->max, (double)bucket->mean, bucket->count);
+    if (length <= 0 || length >= (int)sizeof(line)) {
+        return true;
+    }
+
+    stream->count++;
+    return data_write(stream, line, (size_t)length);
+}
+
+esp_err_t trend_get_data(httpd_req_t *req) {
+    if (!g_trending_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Trending manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // ?point=<id> (required), ?from=&to= in Unix milliseconds, ?limit=<samples>,
+    // ?resolution=<seconds> or ?points=<buckets wanted> for rollups
+    int64_t from_ms = 0;
+    int64_t to_ms = INT64_MAX;
+    uint32_t limit = TREND_DATA_DEFAULT_LIMIT;
+    uint32_t resolution_ms = 0;
+    uint32_t points = 0;
+    char point_id[CONFIG_MAX_ID_LENGTH] = {0};
+    char query[160];
+    char value[24];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "from", value, sizeof(value)) == ESP_OK) {
+            from_ms = strtoll(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "to", value, sizeof(value)) == ESP_OK) {
+            to_ms = strtoll(value, NULL, 10);
+        }
+        if (httpd_query_key_value(query, "limit", value, sizeof(value)) == ESP_OK) {
+            unsigned long requested = strtoul(value, NULL, 10);
+            limit = (requested == 0 || requested > TREND_DATA_MAX_LIMIT) ? TREND_DATA_MAX_LIMIT : (uint32_t)requested;
+        }
+        if (httpd_query_key_value(query, "resolution", value, sizeof(value)) == ESP_OK) {
+            unsigned long seconds = strtoul(value, NULL, 10);
+            resolution_ms = (seconds > UINT32_MAX / 1000) ? UINT32_MAX : (uint32_t)seconds * 1000;
+        }
+        if (httpd_query_key_value(query, "points", value, sizeof(value)) == ESP_OK) {
+            unsigned long requested = strtoul(value, NULL, 10);
+            points = (requested > TREND_DATA_MAX_LIMIT) ? TREND_DATA_MAX_LIMIT : (uint32_t)requested;
+        }
+        httpd_query_key_value(query, "point", point_id, sizeof(point_id));
+    }
+
+    trending_handle_t handle;
+    trending_series_info_t info;
+    if (point_id[0] == '\0' ||
+        trending_manager_resolve_point(g_trending_manager, point_id, &handle) != ESP_OK ||
+        trending_manager_get_series_info(g_trending_manager, handle, &info) != ESP_OK) {
+        httpd_resp_set_status(req, "404 Not Found");
+        httpd_resp_send(req, "Point not trended", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    trend_data_stream_t* stream = calloc(1, sizeof(trend_data_stream_t));
+    if (!stream) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Out of memory", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_NO_MEM;
+    }
+    stream->req = req;
+    stream->limit = limit;
+
+    // Spread the wanted buckets over the range, open ends bounded by the raw history
+    if (points > 0 && resolution_ms == 0) {
+        int64_t from = (from_ms > 0) ? from_ms : info.first_ms;
+        int64_t to = (to_ms < info.last_ms) ? to_ms : info.last_ms;
+        int64_t spacing = (to > from) ? (to - from) / points : 0;
+        resolution_ms = (spacing > UINT32_MAX) ? UINT32_MAX : (uint32_t)spacing;
+    }
+    bool rollups = resolution_ms > 0;
+    trending_tier_t tier = rollups ? trending_manager_select_tier(resolution_ms) : TRENDING_TIER_RAW;
+
+    httpd_resp_set_type(req, "application/json");
+    char header[192];
+    int length;
+    if (rollups) {
+        length = snprintf(header, sizeof(header),
+                          "{\"status\":\"success\",\"pointId\":\"%s\",\"kind\":\"%s\",\"tier\":\"%s\","
+                          "\"bucketMs\":%" PRIu32 ",\"buckets\":[",
+                          info.point_id, info.kind == TRENDING_KIND_ANALOG ? "analog" : "binary",
+                          TREND_TIER_NAMES[tier], trending_manager_tier_duration_ms(tier));
+    } else {
+        length = snprintf(header, sizeof(header),
+                          "{\"status\":\"success\",\"pointId\":\"%s\",\"kind\":\"%s\",\"samples\":[",
+                          info.point_id, info.kind == TRENDING_KIND_ANALOG ? "analog" : "binary");
+    }
+    data_write(stream, header, (size_t)length);
+
+    esp_err_t ret;
+    if (rollups) {
+        ret = trending_manager_query_resolution(g_trending_manager, point_id, from_ms, to_ms, resolution_ms,
+                                                data_visit_bucket, stream, NULL);
+    } else {
+        ret = trending_manager_query(g_trending_manager, point_id, from_ms, to_ms, data_visit, stream);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Trend query failed: %s", esp_err_to_name(ret));
+    }
+
+    char footer[96];
+    length = snprintf(footer, sizeof(footer), "],\"count\":%" PRIu32 ",\"truncated\":%s}",
+                      stream->count, stream->truncated ? "true" : "false");
+    data_write(stream, footer, (size_t)length);
+    data_flush(stream);
+
+    if (!stream->send_failed) {
+        httpd_resp_send_chunk(req, NULL, 0);
+    }
+
+    ret = stream->send_failed ? ESP_FAIL : ESP_OK;
+    free(stream);
+    return ret;
+}
+
+esp_err_t trend_get_status(httpd_req_t *req) {
+    if (!g_trending_manager) {
+        httpd_resp_set_status(req, "500 Internal Server Error");
+        httpd_resp_send(req, "Trending manager not initialized", HTTPD_RESP_USE_STRLEN);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    trending_stats_t stats;
+    trending_manager_get_stats(g_trending_manager, &stats);
+
+    cJSON *json = cJSON_CreateObject();
+    cJSON_AddStringToObject(json, "status", "success");
+    cJSON_AddNumberToObject(json, "analogPoints", stats.analog_points);
+    cJSON_AddNumberToObject(json, "binaryPoints", stats.binary_points);
+    cJSON_AddNumberToObject(json, "poolBytes", stats.pool_bytes);
+    cJSON_AddNumberToObject(json, "bytesHeld", stats.bytes_held);
+    cJSON_AddNumberToObject(json, "samplesHeld", stats.samples_held);
+    cJSON_AddNumberToObject(json, "samplesRecorded", stats.samples_recorded);
+    cJSON_AddNumberToObject(json, "blocksRecycled", stats.blocks_recycled);
+    cJSON_AddNumberToObject(json, "rollupBytes", stats.rollup_bytes);
+    cJSON_AddNumberToObject(json, "rollupsHeld", stats.rollups_held);
+
+    cJSON *point_array = cJSON_AddArrayToObject(json, "points");
+    int count = trending_manager_get_series_count(g_trending_manager);
+    if (count > TREND_STATUS_MAX_POINTS) {
+        count = TREND_STATUS_MAX_POINTS;
+    }
+    for (int i = 0; i < count; i++) {
+        trending_series_info_t info;
+        if (trending_manager_get_series_info(g_trending_manager, i, &info) != ESP_OK) {
+            break;
+        }
+        cJSON *point = cJSON_CreateObject();
+        cJSON_AddStringToObject(point, "pointId", info.point_id);
+        cJSON_AddStringToObject(point, "kind", info.kind == TRENDING_KIND_ANALOG ? "analog" : "binary");
+        if (info.kind == TRENDING_KIND_ANALOG) {
+            cJSON_AddNumberToObject(point, "intervalMs", info.interval_ms);
+        }
+        cJSON_AddNumberToObject(point, "samples", info.samples);
+        cJSON_AddNumberToObject(point, "firstMs", (double)info.first_ms);
+        cJSON_AddNumberToObject(point, "lastMs", (double)info.last_ms);
+        cJSON_AddNumberToObject(point, "bytesUsed", info.bytes_used);
+        cJSON_AddNumberToObject(point, "bytesAllocated", info.bytes_allocated);
+        cJSON_AddNumberToObject(point, "bytesPerSample",
+                                info.samples > 0 ? (double)info.bytes_used / info.samples : 0.0);
+        cJSON *tier_array = cJSON_AddArrayToObject(point, "rollups");
+        for (int tier = 0; tier < TRENDING_ROLLUP_TIERS; tier++) {
+            cJSON *rollup = cJSON_CreateObject();
+            cJSON_AddStringToObject(rollup, "tier", TREND_TIER_NAMES[tier + 1]);
+            cJSON_AddNumberToObject(rollup, "held", info.rollup_held[tier]);
+            cJSON_AddNumberToObject(rollup, "capacity", info.rollup_capacity[tier]);
+            cJSON_AddNumberToObject(rollup, "spanHours", (double)info.rollup_capacity[tier] *
+                                    trending_manager_tier_duration_ms((trending_tier_t)(tier + 1)) / 3600000.0);
+            cJSON_AddItemToArray(tier_array, rollup);
+        }
+        cJSON_AddItemToArray(point_array, point);
+    }
+
+    char *json_string = cJSON_PrintUnformatted(json);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_send(req, json_string, HTTPD_RESP_USE_STRLEN);
+
+    free(json_string);
+    cJSON_Delete(json);
+    return ESP_OK;
+}
+
+esp_err_t trend_controller_init(trending_manager_t* trending_manager) {
+    if (!trending_manager) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    g_trending_manager = trending_manager;
+
+    ESP_LOGI(TAG, "Trend Controller initialized with trending manager reference");
+
+    return ESP_OK;
+}
+
+esp_err_t trend_controller_register_routes(httpd_handle_t server) {
+    if (!server || !g_trending_manager) {
+        ESP_LOGE(TAG, "Server handle or trending manager is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+
+    httpd_uri_t get_data_uri = {
+        .uri = "/api/trends/data",
+        .method = HTTP_GET,
+        .handler = trend_get_data,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_data_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/trends/data: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/trends/data");
+
+    httpd_uri_t get_status_uri = {
+        .uri = "/api/trends/status",
+        .method = HTTP_GET,
+        .handler = trend_get_status,
+        .user_ctx = NULL
+    };
+    ret = httpd_register_uri_handler(server, &get_status_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register GET /api/trends/status: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    ESP_LOGI(TAG, "Registered: GET /api/trends/status");
+
+    return ESP_OK;
+}
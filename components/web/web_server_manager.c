@@ -7,6 +7,8 @@
 #include "auth_controller.h"
 #include "system_controller.h"
 #include "io_test_controller.h"
+#include "alarm_controller.h"
+#include "trend_controller.h"
 #include "time_controller.h"
 #include "task_tracker.h"
 #include "debug_config.h"
@@ -131,6 +133,7 @@ bool web_server_manager_start(void)
     config.max_open_sockets = g_web_server.config.max_open_sockets;
     config.task_priority = g_web_server.config.task_priority;
     config.stack_size = 8192; // Increased stack size for large file operations
+    config.uri_match_fn = httpd_uri_match_wildcard; // /api/io/points/* serves every point
     
     ESP_LOGI(TAG, "HTTP server config: main_stack=%lu", 
              (unsigned long)config.stack_size);
@@ -188,6 +191,24 @@ bool web_server_manager_start(void)
         return false;
     }
 
+    // Register alarm controller routes (specific /api/alarms/* routes)
+    if (alarm_controller_register_routes(g_web_server.server_handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register alarm controller routes");
+        httpd_stop(g_web_server.server_handle);
+        g_web_server.server_handle = NULL;
+        g_web_server.status = WEB_SERVER_ERROR;
+        return false;
+    }
+
+    // Register trend controller routes (specific /api/trends/* routes)
+    if (trend_controller_register_routes(g_web_server.server_handle) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register trend controller routes");
+        httpd_stop(g_web_server.server_handle);
+        g_web_server.server_handle = NULL;
+        g_web_server.status = WEB_SERVER_ERROR;
+        return false;
+    }
+
     // Register static file handlers LAST (catch-all for remaining requests)
     if (!static_file_controller_register_handlers(g_web_server.server_handle)) {
         ESP_LOGE(TAG, "Failed to register static file handlers");
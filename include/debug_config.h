@@ -483,6 +483,19 @@ extern "C" {
  */
 #define DEBUG_IO_TEST_MANAGER 1
 
+/**
+ * @brief Enable/disable IO benchmark and self-test suite
+ * Set to 1 to run IO benchmarks after IO manager start, 0 to disable
+ */
+#define DEBUG_IO_TEST_SUITE 0
+
+/**
+ * @brief Enable/disable IO self-tests that energize live outputs
+ * Set to 1 to let the IO test suite pulse the first configured binary output
+ * (only on a bench with nothing connected to it), 0 to skip those tests
+ */
+#define DEBUG_IO_TEST_DRIVE_OUTPUTS 0
+
 /* =============================================================================
  * IO SYSTEM TIMING CONFIGURATION
  * =============================================================================
@@ -500,12 +513,6 @@ extern "C" {
  */
 #define DEBUG_IO_REPORT_INTERVAL_MS 10000
 
-/**
- * @brief Alarm check interval in milliseconds
- * How often to check for alarm conditions
- */
-#define DEBUG_ALARM_CHECK_INTERVAL_MS 5000
-
 /* =============================================================================
  * IO SYSTEM OUTPUT TAGS
  * =============================================================================
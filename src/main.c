@@ -25,7 +25,13 @@
 #include "storage_manager.h"
 #include "config_manager.h"
 #include "io_manager.h"
+#include "alarm_manager.h"
+#include "alarm_journal.h"
+#include "trending_manager.h"
 #include "io_test_controller.h"
+#include "alarm_controller.h"
+#include "trend_controller.h"
+#include "io_test_suite.h"
 #include "debug_config.h"
 #include "request_priority_manager.h"
 #include "request_queue.h"
@@ -37,6 +43,9 @@ static const char *TAG = "SNRv9_MAIN";
 // Global IO system instances
 static config_manager_t config_manager;
 static io_manager_t io_manager;
+static alarm_manager_t alarm_manager;
+static alarm_journal_t alarm_journal;
+static trending_manager_t trending_manager;
 
 // PSRAM test timer handle
 #if DEBUG_PSRAM_COMPREHENSIVE_TESTING
@@ -389,6 +398,31 @@ void app_main(void)
         return;
     }
     
+    // Alarm evaluation runs inside the IO scan, on every new sample
+    ESP_LOGI(TAG, "Initializing alarm manager...");
+    if (alarm_manager_init(&alarm_manager, &config_manager) != ESP_OK ||
+        io_manager_attach_alarm_manager(&io_manager, &alarm_manager) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to attach alarm manager");
+        return;
+    }
+    
+    // Alarm events are journaled to PSRAM and flushed to LittleFS in batches
+    ESP_LOGI(TAG, "Initializing alarm journal...");
+    if (alarm_journal_init(&alarm_journal, ALARM_JOURNAL_DEFAULT_PATH) != ESP_OK ||
+        alarm_journal_start(&alarm_journal, 1, 4096) != ESP_OK ||
+        alarm_manager_attach_journal(&alarm_manager, &alarm_journal) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start alarm journal");
+        return;
+    }
+    
+    // Trend history is recorded by the IO scan into compressed PSRAM rings
+    ESP_LOGI(TAG, "Initializing trending manager...");
+    if (trending_manager_init(&trending_manager, &config_manager) != ESP_OK ||
+        io_manager_attach_trending_manager(&io_manager, &trending_manager) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to attach trending manager");
+        return;
+    }
+    
     // Start IO polling
     ESP_LOGI(TAG, "Starting IO polling task...");
     if (io_manager_start_polling(&io_manager, 1000, 2, 4096) != ESP_OK) {
@@ -403,6 +437,26 @@ void app_main(void)
         return;
     }
 
+    ESP_LOGI(TAG, "Initializing alarm controller...");
+    if (alarm_controller_init(&alarm_manager, &alarm_journal) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize alarm controller");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Initializing trend controller...");
+    if (trend_controller_init(&trending_manager) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize trend controller");
+        return;
+    }
+
+#if DEBUG_IO_TEST_SUITE
+    // Run IO benchmarks and self-tests (outputs are only pulsed with DEBUG_IO_TEST_DRIVE_OUTPUTS)
+    ESP_LOGI(TAG, "Running IO test suite...");
+    if (!io_test_suite_run(&io_manager)) {
+        ESP_LOGW(TAG, "IO test suite reported failures (non-critical)");
+    }
+#endif
+
 #if DEBUG_REQUEST_PRIORITY
     // Initialize Request Priority Management System
     ESP_LOGI(TAG, "Initializing request priority management system...");